@@ -0,0 +1,71 @@
+"""
+This script compares two results of petrack_bench, written with the option --json-out, and reports benchmarks which
+got slower by more than the threshold.
+
+Parameters:
+arg1: JSON file of the baseline (e.g. from master)
+arg2: JSON file of the candidate (e.g. from the merge request)
+--threshold: (optional) allowed slowdown in percent, default 10
+
+Exits with 1 if at least one benchmark got slower than allowed.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_benchmarks(path):
+    with open(path, encoding="utf-8") as file:
+        results = json.load(file)
+    benchmarks = {(bench["testCase"], bench["name"]): bench for bench in results["benchmarks"]}
+    return results, benchmarks
+
+
+def format_ns(ns):
+    for unit, factor in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= factor:
+            return f"{ns / factor:.2f} {unit}"
+    return f"{ns:.0f} ns"
+
+
+def compare(baseline, candidate, threshold):
+    regressions = []
+    print(f"{'benchmark':<70} {'baseline':>12} {'candidate':>12} {'change':>8}")
+    for key in sorted(baseline.keys() & candidate.keys()):
+        old = baseline[key]["meanNs"]
+        new = candidate[key]["meanNs"]
+        change = (new - old) / old * 100 if old > 0 else 0.0
+        marker = ""
+        if change > threshold:
+            regressions.append(key)
+            marker = "  <-- slower"
+        name = f"{key[0]}: {key[1]}"
+        print(f"{name:<70} {format_ns(old):>12} {format_ns(new):>12} {change:>+7.1f}%{marker}")
+
+    for key in sorted(baseline.keys() - candidate.keys()):
+        print(f"missing in candidate: {key[0]}: {key[1]}")
+    for key in sorted(candidate.keys() - baseline.keys()):
+        print(f"new in candidate: {key[0]}: {key[1]}")
+    return regressions
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Compare two benchmark results of petrack_bench")
+    parser.add_argument("baseline", help="JSON file of the baseline")
+    parser.add_argument("candidate", help="JSON file of the candidate")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown in percent")
+    args = parser.parse_args()
+
+    baseline_info, baseline = load_benchmarks(args.baseline)
+    candidate_info, candidate = load_benchmarks(args.candidate)
+    print(f"baseline:  {baseline_info.get('version')} ({baseline_info.get('commit')}, {baseline_info.get('buildType')})")
+    print(f"candidate: {candidate_info.get('version')} ({candidate_info.get('commit')}, {candidate_info.get('buildType')})")
+    if baseline_info.get("buildType") != candidate_info.get("buildType"):
+        print("Warning: the results were measured with different build types")
+    print()
+
+    regressions = compare(baseline, candidate, args.threshold)
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower by more than {args.threshold}%")
+        sys.exit(1)
@@ -32,6 +32,7 @@ they can be represented in QT.
 #include "animation.h"
 
 #include "filter.h"
+#include "frameProfiler.h"
 #include "helper.h"
 #include "logger.h"
 #include "pMessageBox.h"
@@ -109,6 +110,7 @@ cv::Mat Animation::getPreviousFrame()
 /// Returns the frame at the index index
 cv::Mat Animation::getFrameAtIndex(int index)
 {
+    diagnostics::ScopedTimer timer(diagnostics::Stage::Decode);
     if(mCameraLiveStream)
     {
         return getFrameVideo(index);
@@ -1044,6 +1046,7 @@ cv::Mat Animation::getFrameVideo(int index)
 {
     if(mCameraLiveStream)
     {
+        detachSharedMat(mImage); // the last frame may still be displayed
         if(mVideoCapture.read(mImage /*tempMat*/))
         {
             if(mImage.empty()) // tempImg == NULL)
@@ -1080,8 +1083,10 @@ cv::Mat Animation::getFrameVideo(int index)
                     SPDLOG_ERROR("video file does not support skipping");
                     return cv::Mat();
                 }
+                diagnostics::FrameProfiler::global().count(diagnostics::Counter::Seeks);
             }
-            // Query the frame
+            // Query the frame; the last frame may still be displayed, so do not read into its buffer
+            detachSharedMat(mImage);
             if(mVideoCapture.read(mImage))
             {
                 if(mImage.empty()) // tempImg == NULL)
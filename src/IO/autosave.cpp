@@ -18,6 +18,7 @@
 
 #include "autosave.h"
 
+#include "logger.h"
 #include "petrack.h"
 
 #include <QDir>
@@ -214,7 +215,22 @@ void Autosave::savePet()
         return;
     }
     const auto &[autosaveName, finalAutosaveName] = autosaveNamesPet(projectName);
-    mPetrack.saveProject(autosaveName);
+
+    // nothing changed since the last autosave; only serialize the project if one of its settings was changed
+    if(mPetrack.projectChanged())
+    {
+        mPetrack.updateProjectFile();
+    }
+    const auto revision = mPetrack.getProjectFile().revision();
+    if(revision == mPetRevision && QFileInfo::exists(finalAutosaveName))
+    {
+        return;
+    }
+    if(!mPetrack.getProjectFile().write(autosaveName))
+    {
+        SPDLOG_WARN("Could not write autosave {}", autosaveName);
+        return;
+    }
 
     // first save to temp file, so crash during saving doesn't corrupt old autosave
     QFile tempAutosave{autosaveName};
@@ -229,6 +245,7 @@ void Autosave::savePet()
         {
             // we don't currently use it for loading, so we could remove it even if the copying fails...
             tempAutosave.remove();
+            mPetRevision = revision;
         }
     }
 }
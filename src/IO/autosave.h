@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QStringList>
+#include <cstdint>
 #include <memory>
 
 class Petrack;
@@ -83,9 +84,10 @@ private:
      */
     int changesTillAutosave = -1;
 
-    Petrack &mPetrack;
-    QTimer  *mTimer;
-    int      mChangeCounter = 0;
+    Petrack      &mPetrack;
+    QTimer       *mTimer;
+    int           mChangeCounter = 0;
+    std::uint64_t mPetRevision   = 0; ///< revision of the project (see ProjectFile) in the last pet autosave
 };
 
 #endif // AUTOSAVE_H
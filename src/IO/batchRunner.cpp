@@ -0,0 +1,570 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "batchRunner.h"
+
+#include "animation.h"
+#include "logger.h"
+#include "personStorage.h"
+#include "petrack.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace batch
+{
+namespace
+{
+const QString DEFAULT_SUMMARY_FILE = "petrack_batch_summary.json";
+
+double secondsSince(const QElapsedTimer &timer)
+{
+    return static_cast<double>(timer.nsecsElapsed()) * 1e-9;
+}
+
+void appendUnique(QStringList &list, const QString &entry)
+{
+    if(!list.contains(entry))
+    {
+        list.append(entry);
+    }
+}
+
+/// Expands a single wildcard pattern or project file; wildcards are only supported in the file name
+QStringList expandPattern(const QString &pattern, const QDir &baseDir)
+{
+    const QFileInfo info{baseDir, pattern};
+    if(!pattern.contains('*') && !pattern.contains('?') && !pattern.contains('['))
+    {
+        return {info.absoluteFilePath()};
+    }
+
+    QStringList projects;
+    for(const auto &file : QDir{info.absolutePath()}.entryInfoList({info.fileName()}, QDir::Files, QDir::Name))
+    {
+        projects.append(file.absoluteFilePath());
+    }
+    if(projects.isEmpty())
+    {
+        SPDLOG_WARN("No project matches {}", pattern);
+    }
+    return projects;
+}
+
+/// Reads a list file with one project or wildcard pattern per line; empty lines and lines starting with # are skipped
+QStringList readProjectList(const QString &listFile)
+{
+    QFile file{listFile};
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        SPDLOG_ERROR("Cannot read project list {}: {}", listFile, file.errorString());
+        return {};
+    }
+
+    const QDir  baseDir = QFileInfo{listFile}.absoluteDir();
+    QStringList projects;
+    QTextStream in{&file};
+    while(!in.atEnd())
+    {
+        const QString line = in.readLine().trimmed();
+        if(line.isEmpty() || line.startsWith('#'))
+        {
+            continue;
+        }
+        projects.append(expandPattern(line, baseDir));
+    }
+    return projects;
+}
+
+/// Appends the attributes of elem and all its descendants in a fixed order
+void appendElementSettings(QString &key, const QDomElement &elem)
+{
+    key += elem.tagName() + "{";
+    const auto  attributes = elem.attributes();
+    QStringList values;
+    for(int i = 0; i < attributes.count(); ++i)
+    {
+        const auto attr = attributes.item(i).toAttr();
+        values.append(attr.name() + "=" + attr.value());
+    }
+    values.sort();
+    key += values.join(";");
+    for(auto child = elem.firstChildElement(); !child.isNull(); child = child.nextSiblingElement())
+    {
+        appendElementSettings(key, child);
+    }
+    key += "}";
+}
+
+std::vector<ProjectResult> readReport(const QString &reportFile)
+{
+    QFile file{reportFile};
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+    std::vector<ProjectResult> results;
+    for(const auto &entry : QJsonDocument::fromJson(file.readAll()).object().value("results").toArray())
+    {
+        results.push_back(ProjectResult::fromJson(entry.toObject()));
+    }
+    return results;
+}
+
+bool writeJson(const QString &fileName, const QJsonObject &json)
+{
+    QFile file{fileName};
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        SPDLOG_ERROR("Cannot write {}: {}", fileName, file.errorString());
+        return false;
+    }
+    file.write(QJsonDocument{json}.toJson());
+    return true;
+}
+
+QJsonArray toJsonArray(const std::vector<ProjectResult> &results)
+{
+    QJsonArray array;
+    for(const auto &result : results)
+    {
+        array.append(result.toJson());
+    }
+    return array;
+}
+} // namespace
+
+QJsonObject ProjectResult::toJson() const
+{
+    return QJsonObject{
+        {"project", project},
+        {"trackerFile", trackerFile},
+        {"overlayFile", overlayFile},
+        {"success", success},
+        {"error", error},
+        {"worker", worker},
+        {"frames", frames},
+        {"trackedPersons", trackedPersons},
+        {"openSeconds", openSeconds},
+        {"trackSeconds", trackSeconds},
+        {"exportSeconds", exportSeconds},
+        {"totalSeconds", totalSeconds},
+        {"framesPerSecond", trackSeconds > 0 ? frames / trackSeconds : 0.}};
+}
+
+ProjectResult ProjectResult::fromJson(const QJsonObject &json)
+{
+    ProjectResult result;
+    result.project        = json.value("project").toString();
+    result.trackerFile    = json.value("trackerFile").toString();
+    result.overlayFile    = json.value("overlayFile").toString();
+    result.success        = json.value("success").toBool();
+    result.error          = json.value("error").toString();
+    result.worker         = json.value("worker").toInt();
+    result.frames         = json.value("frames").toInt();
+    result.trackedPersons = json.value("trackedPersons").toInt();
+    result.openSeconds    = json.value("openSeconds").toDouble();
+    result.trackSeconds   = json.value("trackSeconds").toDouble();
+    result.exportSeconds  = json.value("exportSeconds").toDouble();
+    result.totalSeconds   = json.value("totalSeconds").toDouble();
+    return result;
+}
+
+/**
+ * @brief Expands the batch arguments to a list of absolute project file names
+ *
+ * Each pattern is either a .pet file, a wildcard pattern (e.g. <kbd>data/run*.pet</kbd>) or a text file listing
+ * projects or patterns line by line. The order of the arguments is kept, duplicates are removed.
+ */
+QStringList expandProjectPatterns(const QStringList &patterns)
+{
+    QStringList projects;
+    for(const auto &pattern : patterns)
+    {
+        const bool isListFile = !pattern.endsWith(".pet", Qt::CaseInsensitive) && QFileInfo{pattern}.isFile();
+        for(const auto &project : isListFile ? readProjectList(pattern) : expandPattern(pattern, QDir::current()))
+        {
+            appendUnique(projects, project);
+        }
+    }
+    return projects;
+}
+
+/**
+ * @brief Key describing the settings which determine the reusable, expensive to create state of a project
+ *
+ * Projects with equal keys have the same intrinsic calibration (and thereby undistortion maps, if the image size
+ * matches) and the same YOLO model. Unreadable projects get an empty key.
+ */
+QString settingsKey(const QString &projectFile)
+{
+    QFile        file{projectFile};
+    QDomDocument doc;
+    if(!file.open(QIODevice::ReadOnly) || !doc.setContent(&file))
+    {
+        return {};
+    }
+
+    QString key;
+    if(const auto intrinsic = doc.elementsByTagName("INTRINSIC_PARAMETERS").item(0).toElement(); !intrinsic.isNull())
+    {
+        appendElementSettings(key, intrinsic);
+    }
+    const auto yolo = doc.elementsByTagName("YOLO_MARKER").item(0).toElement();
+    if(const auto params = yolo.firstChildElement("PARAMS"); !params.isNull())
+    {
+        key += "MODEL_FILE=" + QFileInfo{QFileInfo{projectFile}.absoluteDir(), params.attribute("MODEL_FILE")}
+                                   .absoluteFilePath();
+    }
+    return key;
+}
+
+/**
+ * @brief Distributes the projects over at most nbWorkers workers
+ *
+ * Projects with the same key are kept together, so a worker can reuse its caches. Groups larger than an even share
+ * of the projects are split, such that no worker idles while another one processes a large group. The chunks are
+ * assigned largest first to the least loaded worker; the result is deterministic.
+ *
+ * @param projects project files
+ * @param keys settings key per project, see settingsKey()
+ * @param nbWorkers maximum number of workers
+ * @return project lists of all workers which got at least one project
+ */
+std::vector<QStringList> scheduleProjects(const QStringList &projects, const QStringList &keys, int nbWorkers)
+{
+    nbWorkers = std::max(1, nbWorkers);
+
+    std::vector<QString>           keyOrder;
+    std::map<QString, QStringList> groups;
+    for(qsizetype i = 0; i < projects.size(); ++i)
+    {
+        if(!groups.contains(keys.at(i)))
+        {
+            keyOrder.push_back(keys.at(i));
+        }
+        groups[keys.at(i)].append(projects.at(i));
+    }
+
+    const qsizetype          chunkSize = (projects.size() + nbWorkers - 1) / nbWorkers;
+    std::vector<QStringList> chunks;
+    for(const auto &key : keyOrder)
+    {
+        const auto &group = groups.at(key);
+        for(qsizetype start = 0; start < group.size(); start += chunkSize)
+        {
+            chunks.push_back(group.mid(start, chunkSize));
+        }
+    }
+    std::stable_sort(
+        chunks.begin(), chunks.end(), [](const QStringList &a, const QStringList &b) { return a.size() > b.size(); });
+
+    std::vector<QStringList> workers(nbWorkers);
+    for(const auto &chunk : chunks)
+    {
+        auto leastLoaded = std::min_element(
+            workers.begin(),
+            workers.end(),
+            [](const QStringList &a, const QStringList &b) { return a.size() < b.size(); });
+        leastLoaded->append(chunk);
+    }
+    std::erase_if(workers, [](const QStringList &worker) { return worker.isEmpty(); });
+    return workers;
+}
+
+/// Trajectory file of a project: same base name with suffix .trc, in outputDir or next to the project
+QString trackerFileFor(const QString &projectFile, const QString &outputDir)
+{
+    const QFileInfo info{projectFile};
+    const QDir      dir = outputDir.isEmpty() ? info.absoluteDir() : QDir{outputDir};
+    return dir.absoluteFilePath(info.completeBaseName() + ".trc");
+}
+
+/// Video with the drawn trajectories of a project: <name>_overlay.mp4, in outputDir or next to the project
+QString overlayFileFor(const QString &projectFile, const QString &outputDir)
+{
+    const QFileInfo info{projectFile};
+    const QDir      dir = outputDir.isEmpty() ? info.absoluteDir() : QDir{outputDir};
+    return dir.absoluteFilePath(info.completeBaseName() + "_overlay.mp4");
+}
+
+/**
+ * @brief Opens, tracks and exports a single project
+ *
+ * Uses a fresh Petrack for every project, so no state (and no "save project?" question) carries over from the
+ * previous one. Process-wide caches like the undistortion maps and YOLO networks are kept.
+ *
+ * With exportOverlay, a video with the trajectories drawn by the offscreen OverlayRenderer is exported as well.
+ */
+ProjectResult
+runProject(const QString &petrackVersion, const QString &projectFile, const QString &outputDir, bool exportOverlay)
+{
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    ProjectResult result;
+    result.project     = projectFile;
+    result.trackerFile = trackerFileFor(projectFile, outputDir);
+
+    if(!QFileInfo{projectFile}.isReadable())
+    {
+        result.error = "Project file is not readable";
+        return result;
+    }
+    if(!outputDir.isEmpty() && !QDir{}.mkpath(outputDir))
+    {
+        result.error = QString("Cannot create output folder %1").arg(outputDir);
+        return result;
+    }
+
+    SPDLOG_INFO("Batch: processing {}", projectFile);
+    try
+    {
+        auto petrack = std::make_unique<Petrack>(petrackVersion);
+        petrack->show();
+
+        QElapsedTimer timer;
+        timer.start();
+        petrack->openProject(projectFile);
+        result.openSeconds = secondsSince(timer);
+        if(QFileInfo{petrack->getProFileName()} != QFileInfo{projectFile})
+        {
+            result.error = "Project could not be opened";
+            return result;
+        }
+        result.frames = petrack->getAnimation()->getNumFrames();
+
+        timer.restart();
+        petrack->trackAll();
+        result.trackSeconds = secondsSince(timer);
+
+        timer.restart();
+        // exportTracker does not report failures to the caller, so check that the file was written; a file of a
+        // previous run is removed first so that it is not taken for the result
+        QFile::remove(result.trackerFile);
+        petrack->exportTracker(result.trackerFile);
+        if(const QFileInfo trackerInfo{result.trackerFile}; !trackerInfo.exists() || trackerInfo.size() == 0)
+        {
+            result.error = QString("Cannot export trajectories to %1").arg(result.trackerFile);
+            return result;
+        }
+        if(exportOverlay)
+        {
+            result.overlayFile = overlayFileFor(projectFile, outputDir);
+            if(!petrack->exportOverlaySequence(result.overlayFile))
+            {
+                result.error = QString("Cannot export overlay video %1").arg(result.overlayFile);
+                return result;
+            }
+        }
+        result.exportSeconds = secondsSince(timer);
+
+        result.trackedPersons = static_cast<int>(petrack->getPersonStorage().nbPersons());
+        result.success        = true;
+    }
+    catch(const std::exception &e)
+    {
+        result.error = e.what();
+    }
+    result.totalSeconds = secondsSince(totalTimer);
+
+    if(!result.success)
+    {
+        SPDLOG_ERROR("Batch: {} failed: {}", projectFile, result.error);
+    }
+    return result;
+}
+
+/**
+ * @brief Worker side of the batch mode: processes all projects of the list and writes their results to reportFile
+ */
+int runBatchWorker(
+    const QString &petrackVersion,
+    const QString &projectListFile,
+    const QString &reportFile,
+    const QString &outputDir,
+    bool           exportOverlay)
+{
+    std::vector<ProjectResult> results;
+    for(const auto &project : readProjectList(projectListFile))
+    {
+        results.push_back(runProject(petrackVersion, project, outputDir, exportOverlay));
+    }
+    return writeJson(reportFile, QJsonObject{{"results", toJsonArray(results)}}) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Processes all projects given by the options and writes the summary
+ *
+ * With a single worker the projects are processed in this process, otherwise one PeTrack worker process is started
+ * per project list (see scheduleProjects()).
+ *
+ * @return EXIT_SUCCESS if all projects were tracked and exported, EXIT_FAILURE otherwise
+ */
+int runBatch(const QString &petrackVersion, const BatchOptions &options)
+{
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+
+    const QStringList projects = expandProjectPatterns(options.projectPatterns);
+    if(projects.isEmpty())
+    {
+        SPDLOG_ERROR("Batch: no projects given");
+        return EXIT_FAILURE;
+    }
+
+    QStringList keys;
+    for(const auto &project : projects)
+    {
+        keys.append(settingsKey(project));
+    }
+    const auto workers = scheduleProjects(projects, keys, options.nbWorkers);
+    SPDLOG_INFO("Batch: {} projects on {} workers", projects.size(), workers.size());
+
+    std::map<QString, ProjectResult> resultsByProject;
+    if(workers.size() == 1)
+    {
+        for(const auto &project : workers.front())
+        {
+            resultsByProject[project] =
+                runProject(petrackVersion, project, options.outputDir, options.exportOverlay);
+        }
+    }
+    else
+    {
+        QTemporaryDir tmpDir;
+        if(!tmpDir.isValid())
+        {
+            SPDLOG_ERROR("Batch: cannot create temporary folder: {}", tmpDir.errorString());
+            return EXIT_FAILURE;
+        }
+
+        std::vector<std::unique_ptr<QProcess>> processes;
+        for(size_t w = 0; w < workers.size(); ++w)
+        {
+            const QString listFile = tmpDir.filePath(QString("worker_%1.txt").arg(w));
+            QFile         file{listFile};
+            if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+            {
+                SPDLOG_ERROR("Batch: cannot write {}: {}", listFile, file.errorString());
+                return EXIT_FAILURE;
+            }
+            file.write(workers[w].join('\n').toUtf8());
+            file.close();
+
+            QStringList arguments{
+                "-batchWorker", listFile, "-batchWorkerReport", tmpDir.filePath(QString("worker_%1.json").arg(w))};
+            if(!options.outputDir.isEmpty())
+            {
+                arguments << "-batchOutputDir" << QDir{options.outputDir}.absolutePath();
+            }
+            if(options.exportOverlay)
+            {
+                arguments << "-batchExportOverlay";
+            }
+
+            auto process = std::make_unique<QProcess>();
+            process->setProcessChannelMode(QProcess::ForwardedChannels);
+            process->start(QCoreApplication::applicationFilePath(), arguments);
+            processes.push_back(std::move(process));
+        }
+
+        for(size_t w = 0; w < processes.size(); ++w)
+        {
+            auto &process = *processes[w];
+            process.waitForFinished(-1);
+
+            QString workerError = QString("Worker exited with code %1").arg(process.exitCode());
+            if(process.error() == QProcess::FailedToStart)
+            {
+                workerError = QString("Worker failed to start: %1").arg(process.errorString());
+            }
+            else if(process.exitStatus() == QProcess::CrashExit)
+            {
+                workerError = QString("Worker crashed: %1").arg(process.errorString());
+            }
+
+            for(auto result : readReport(tmpDir.filePath(QString("worker_%1.json").arg(w))))
+            {
+                result.worker                    = static_cast<int>(w);
+                resultsByProject[result.project] = result;
+            }
+            for(const auto &project : workers[w])
+            {
+                if(!resultsByProject.contains(project))
+                {
+                    ProjectResult &result = resultsByProject[project];
+                    result.project        = project;
+                    result.trackerFile    = trackerFileFor(project, options.outputDir);
+                    result.worker         = static_cast<int>(w);
+                    result.error          = workerError;
+                }
+            }
+        }
+    }
+
+    std::vector<ProjectResult> results;
+    int                        nbFailed    = 0;
+    qint64                     totalFrames = 0;
+    for(const auto &project : projects)
+    {
+        const auto &result = resultsByProject.at(project);
+        nbFailed += result.success ? 0 : 1;
+        totalFrames += result.frames;
+        results.push_back(result);
+    }
+
+    const double      wallSeconds = secondsSince(wallTimer);
+    const QJsonObject summary{
+        {"workers", static_cast<int>(workers.size())},
+        {"projects", static_cast<int>(projects.size())},
+        {"succeeded", static_cast<int>(projects.size()) - nbFailed},
+        {"failed", nbFailed},
+        {"totalFrames", totalFrames},
+        {"wallSeconds", wallSeconds},
+        {"results", toJsonArray(results)}};
+
+    const QString summaryFile = options.summaryFile.isEmpty() ?
+                                    QDir{options.outputDir}.absoluteFilePath(DEFAULT_SUMMARY_FILE) :
+                                    options.summaryFile;
+    if(!writeJson(summaryFile, summary))
+    {
+        return EXIT_FAILURE;
+    }
+    SPDLOG_INFO(
+        "Batch: {} of {} projects succeeded in {:.1f} s, summary written to {}",
+        projects.size() - nbFailed,
+        projects.size(),
+        wallSeconds,
+        summaryFile);
+
+    return nbFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+} // namespace batch
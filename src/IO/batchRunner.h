@@ -0,0 +1,87 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+/**
+ * @brief Unattended processing of many projects.
+ *
+ * The batch mode tracks a list of projects and writes one trajectory file per project as well as a JSON summary with
+ * timings, frame counts and the number of tracked persons. The projects are distributed over several worker
+ * processes (PeTrack itself started with <kbd>-batchWorker</kbd>), since one Petrack instance cannot be used from
+ * more than one thread. Projects with the same intrinsic calibration and YOLO model are handed to the same worker,
+ * so the process-wide caches for undistortion maps and networks are reused.
+ */
+namespace batch
+{
+struct BatchOptions
+{
+    QStringList projectPatterns;       ///< .pet files, wildcard patterns or text files listing one project per line
+    int         nbWorkers = 1;         ///< number of worker processes
+    QString     summaryFile;           ///< destination of the JSON summary; empty for petrack_batch_summary.json
+    QString     outputDir;             ///< folder for the trajectory files; empty to write them next to the projects
+    bool        exportOverlay = false; ///< also export a video with the trajectories drawn onto it
+};
+
+struct ProjectResult
+{
+    QString project;
+    QString trackerFile;
+    QString overlayFile; ///< empty if no overlay video was exported
+    bool    success = false;
+    QString error;
+    int     worker         = 0;
+    int     frames         = 0;
+    int     trackedPersons = 0;
+    double  openSeconds    = 0;
+    double  trackSeconds   = 0;
+    double  exportSeconds  = 0;
+    double  totalSeconds   = 0;
+
+    QJsonObject          toJson() const;
+    static ProjectResult fromJson(const QJsonObject &json);
+};
+
+QStringList              expandProjectPatterns(const QStringList &patterns);
+QString                  settingsKey(const QString &projectFile);
+std::vector<QStringList> scheduleProjects(const QStringList &projects, const QStringList &keys, int nbWorkers);
+QString                  trackerFileFor(const QString &projectFile, const QString &outputDir);
+QString                  overlayFileFor(const QString &projectFile, const QString &outputDir);
+
+ProjectResult runProject(
+    const QString &petrackVersion,
+    const QString &projectFile,
+    const QString &outputDir,
+    bool           exportOverlay = false);
+
+int runBatch(const QString &petrackVersion, const BatchOptions &options);
+int runBatchWorker(
+    const QString &petrackVersion,
+    const QString &projectListFile,
+    const QString &reportFile,
+    const QString &outputDir,
+    bool           exportOverlay = false);
+} // namespace batch
+
+#endif // BATCHRUNNER_H
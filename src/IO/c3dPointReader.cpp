@@ -0,0 +1,301 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "c3dPointReader.h"
+
+#include <QFile>
+#include <QtEndian>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+namespace
+{
+constexpr qint64 BLOCK_SIZE      = 512;
+constexpr int    C3D_KEY         = 0x50;
+constexpr int    INTEL_PROCESSOR = 84;
+constexpr qint64 CHUNK_SIZE      = 1 << 20; ///< bytes read at once by readFrames
+
+/// one parameter of the parameter section; data points into the loaded section
+struct C3dParameter
+{
+    int              type = 0; ///< -1 char, 1 byte, 2 int16, 4 float
+    std::vector<int> dims;
+    const char      *data = nullptr;
+};
+
+struct GroupedParameter
+{
+    int          group;
+    std::string  name;
+    C3dParameter parameter;
+};
+
+quint16 readWord(const char *data)
+{
+    return qFromLittleEndian<quint16>(data);
+}
+
+float readFloat(const char *data)
+{
+    return qFromLittleEndian<float>(data);
+}
+
+/**
+ * @brief Parses the parameters of one group of the parameter section
+ *
+ * @param section the whole parameter section, including its 4 byte header
+ * @param groupName name of the group, upper case
+ * @return parameters of the group by their upper case name
+ */
+std::map<std::string, C3dParameter> readGroup(const QByteArray &section, const std::string &groupName)
+{
+    std::map<int, std::string>    groups;
+    std::vector<GroupedParameter> parameters;
+
+    const qsizetype size = section.size();
+    qsizetype       pos  = 4;
+    while(pos + 2 <= size)
+    {
+        const int nameLength = std::abs(static_cast<int8_t>(section[pos]));
+        const int id         = static_cast<int8_t>(section[pos + 1]);
+        if(nameLength == 0 || id == 0 || pos + 2 + nameLength + 2 > size)
+        {
+            break;
+        }
+        const std::string name      = section.mid(pos + 2, nameLength).toUpper().toStdString();
+        const qsizetype   offsetPos = pos + 2 + nameLength;
+        const quint16     offset    = readWord(section.constData() + offsetPos);
+
+        if(id < 0)
+        {
+            groups[-id] = name;
+        }
+        else if(offsetPos + 4 <= size)
+        {
+            C3dParameter parameter;
+            parameter.type          = static_cast<int8_t>(section[offsetPos + 2]);
+            const int     dimCount  = static_cast<uint8_t>(section[offsetPos + 3]);
+            qsizetype     dataPos   = offsetPos + 4 + dimCount;
+            qsizetype     dataCount = 1;
+            for(int dim = 0; dim < dimCount && offsetPos + 4 + dim < size; ++dim)
+            {
+                parameter.dims.push_back(static_cast<uint8_t>(section[offsetPos + 4 + dim]));
+                dataCount *= parameter.dims.back();
+            }
+            if(dataPos + dataCount * std::abs(parameter.type) <= size)
+            {
+                parameter.data = section.constData() + dataPos;
+                parameters.push_back({id, name, parameter});
+            }
+        }
+
+        if(offset == 0)
+        {
+            break;
+        }
+        pos = offsetPos + offset;
+    }
+
+    std::map<std::string, C3dParameter> result;
+    for(const auto &[group, name, parameter] : parameters)
+    {
+        if(groups.contains(group) && groups[group] == groupName)
+        {
+            result[name] = parameter;
+        }
+    }
+    return result;
+}
+
+/// first value of a numeric parameter; int16 is read unsigned, as used for counts and block numbers
+std::optional<double> readNumber(const std::map<std::string, C3dParameter> &group, const std::string &name)
+{
+    const auto parameter = group.find(name);
+    if(parameter == group.end())
+    {
+        return std::nullopt;
+    }
+    switch(parameter->second.type)
+    {
+        case 1:
+            return static_cast<uint8_t>(*parameter->second.data);
+        case 2:
+            return readWord(parameter->second.data);
+        case 4:
+            return readFloat(parameter->second.data);
+        default:
+            return std::nullopt;
+    }
+}
+
+/// first string of a char parameter without the padding
+std::optional<std::string> readString(const std::map<std::string, C3dParameter> &group, const std::string &name)
+{
+    const auto parameter = group.find(name);
+    if(parameter == group.end() || parameter->second.type != -1)
+    {
+        return std::nullopt;
+    }
+    const int length = parameter->second.dims.empty() ? 1 : parameter->second.dims.front();
+    return QByteArray(parameter->second.data, length).replace('\0', "").trimmed().toStdString();
+}
+} // namespace
+
+/**
+ * @brief Opens a C3D file and reads its header and POINT parameters
+ *
+ * @param fileName name of the C3D file
+ * @return the reader or an error message, e.g. if the file is no C3D file or is not supported
+ */
+std::variant<C3dPointReader, std::string> C3dPointReader::open(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return "Cannot open " + fileName.toStdString() + ": " + file.errorString().toStdString();
+    }
+
+    const QByteArray header = file.read(BLOCK_SIZE);
+    if(header.size() < BLOCK_SIZE || static_cast<uint8_t>(header[1]) != C3D_KEY)
+    {
+        return fileName.toStdString() + " is no C3D file.";
+    }
+
+    const int parameterBlock = static_cast<uint8_t>(header[0]);
+    if(parameterBlock < 1 || !file.seek((parameterBlock - 1) * BLOCK_SIZE))
+    {
+        return "Invalid parameter section in " + fileName.toStdString() + ".";
+    }
+    QByteArray section = file.read(4);
+    if(section.size() < 4)
+    {
+        return "Invalid parameter section in " + fileName.toStdString() + ".";
+    }
+    if(section[3] != INTEL_PROCESSOR)
+    {
+        return "Only C3D files from Intel processors can be streamed.";
+    }
+    section += file.read(static_cast<uint8_t>(section[2]) * BLOCK_SIZE - 4);
+    const auto pointGroup = readGroup(section, "POINT");
+
+    // the parameters take precedence over the header
+    const quint16 headerPointCount = readWord(header.constData() + 2);
+    const float   headerScale      = readFloat(header.constData() + 12);
+    const float   headerFrameRate  = readFloat(header.constData() + 20);
+
+    C3dPointReader reader;
+    reader.mFileName    = fileName;
+    reader.mPointCount  = static_cast<size_t>(readNumber(pointGroup, "USED").value_or(headerPointCount));
+    reader.mAnalogCount = readWord(header.constData() + 4);
+    reader.mScale       = static_cast<float>(readNumber(pointGroup, "SCALE").value_or(headerScale));
+    reader.mFrameRate   = readNumber(pointGroup, "RATE").value_or(headerFrameRate);
+    reader.mUnit        = readString(pointGroup, "UNITS").value_or("mm");
+
+    const int firstFrame = readWord(header.constData() + 6);
+    const int lastFrame  = readWord(header.constData() + 8);
+    reader.mFirstFrame   = std::max(firstFrame - 1, 0);
+    // the header can only store 65535 frames, longer recordings have the number of frames in POINT:FRAMES
+    reader.mFrameCount = static_cast<size_t>(
+        readNumber(pointGroup, "FRAMES").value_or(lastFrame >= firstFrame ? lastFrame - firstFrame + 1 : 0));
+
+    const int dataBlock =
+        static_cast<int>(readNumber(pointGroup, "DATA_START").value_or(readWord(header.constData() + 16)));
+    if(dataBlock < 1)
+    {
+        return "Invalid data section in " + fileName.toStdString() + ".";
+    }
+    reader.mDataStart = (dataBlock - 1) * BLOCK_SIZE;
+
+    // do not read behind the end of truncated files
+    const qint64 wordSize   = reader.mScale < 0 ? 4 : 2;
+    const qint64 frameBytes = static_cast<qint64>(reader.mPointCount * 4 + reader.mAnalogCount) * wordSize;
+    if(frameBytes > 0)
+    {
+        reader.mFrameCount =
+            std::min<size_t>(reader.mFrameCount, std::max<qint64>(file.size() - reader.mDataStart, 0) / frameBytes);
+    }
+    return reader;
+}
+
+/**
+ * @brief Reads the given points of all frames
+ *
+ * The frames are read in chunks, but only the requested points are converted.
+ *
+ * @param points indices of the points to read
+ * @param callback called for every frame with the points in the order of points
+ * @return error message, if the file could not be read
+ */
+std::optional<std::string>
+C3dPointReader::readFrames(std::span<const size_t> points, const FrameCallback &callback) const
+{
+    if(std::any_of(points.begin(), points.end(), [this](size_t point) { return point >= mPointCount; }))
+    {
+        return mFileName.toStdString() + " does not contain all needed points.";
+    }
+
+    QFile file(mFileName);
+    if(!file.open(QIODevice::ReadOnly) || !file.seek(mDataStart))
+    {
+        return "Cannot read " + mFileName.toStdString() + ": " + file.errorString().toStdString();
+    }
+
+    const bool   isFloat        = mScale < 0;
+    const qint64 wordSize       = isFloat ? 4 : 2;
+    const qint64 frameBytes     = static_cast<qint64>(mPointCount * 4 + mAnalogCount) * wordSize;
+    const size_t framesPerChunk = std::max<qint64>(1, CHUNK_SIZE / std::max<qint64>(frameBytes, 1));
+
+    const auto readInt = [](const char *data) { return static_cast<float>(qFromLittleEndian<qint16>(data)); };
+
+    std::vector<cv::Point3f> framePoints(points.size());
+    for(size_t chunkStart = 0; chunkStart < mFrameCount; chunkStart += framesPerChunk)
+    {
+        const size_t     chunkFrames = std::min(framesPerChunk, mFrameCount - chunkStart);
+        const QByteArray chunk       = file.read(chunkFrames * frameBytes);
+        if(chunk.size() < static_cast<qsizetype>(chunkFrames * frameBytes))
+        {
+            return "Unexpected end of " + mFileName.toStdString() + ".";
+        }
+
+        for(size_t frame = 0; frame < chunkFrames; ++frame)
+        {
+            const char *frameData = chunk.constData() + frame * frameBytes;
+            for(size_t i = 0; i < points.size(); ++i)
+            {
+                const char *pointData = frameData + points[i] * 4 * wordSize;
+                if(isFloat)
+                {
+                    framePoints[i] = {readFloat(pointData), readFloat(pointData + 4), readFloat(pointData + 8)};
+                }
+                else
+                {
+                    framePoints[i] =
+                        cv::Point3f{readInt(pointData), readInt(pointData + 2), readInt(pointData + 4)} * mScale;
+                }
+            }
+            if(!callback(chunkStart + frame, framePoints))
+            {
+                return std::nullopt;
+            }
+        }
+    }
+    return std::nullopt;
+}
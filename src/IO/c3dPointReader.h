@@ -0,0 +1,71 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef C3DPOINTREADER_H
+#define C3DPOINTREADER_H
+
+#include <QString>
+#include <cstddef>
+#include <functional>
+#include <opencv2/core/types.hpp>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+
+/**
+ * @brief Streams selected 3D points out of a C3D file
+ *
+ * In contrast to ezc3d::c3d, which parses the whole file into its object model, this reader only parses the header
+ * and the POINT parameter group. readFrames() then reads the frames chunk by chunk and only converts the requested
+ * points, so memory usage does not depend on the length of the recording.
+ *
+ * Only files written by Intel processors (little endian, which is what MoCap systems like XSens export) are
+ * supported, with float or scaled integer data. open() fails for all other files, so they can be read with ezc3d.
+ */
+class C3dPointReader
+{
+public:
+    /// called for every frame with the requested points; returning false stops reading
+    using FrameCallback = std::function<bool(size_t frame, std::span<const cv::Point3f> points)>;
+
+    static std::variant<C3dPointReader, std::string> open(const QString &fileName);
+
+    size_t             getPointCount() const { return mPointCount; }
+    size_t             getFirstFrame() const { return mFirstFrame; }
+    size_t             getFrameCount() const { return mFrameCount; }
+    double             getFrameRate() const { return mFrameRate; }
+    const std::string &getUnit() const { return mUnit; }
+
+    std::optional<std::string> readFrames(std::span<const size_t> points, const FrameCallback &callback) const;
+
+private:
+    C3dPointReader() = default;
+
+    QString     mFileName;
+    size_t      mPointCount  = 0;
+    size_t      mAnalogCount = 0; ///< analog samples per frame of all channels together
+    size_t      mFirstFrame  = 0; ///< 0-based, like ezc3d::Header::firstFrame()
+    size_t      mFrameCount  = 0;
+    qint64      mDataStart   = 0;  ///< byte offset of the first frame
+    float       mScale       = -1; ///< negative for float data, otherwise the factor for the integer data
+    double      mFrameRate   = 0;
+    std::string mUnit;
+};
+
+#endif // C3DPOINTREADER_H
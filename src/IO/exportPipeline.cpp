@@ -0,0 +1,157 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "exportPipeline.h"
+
+#include <QThread>
+#include <algorithm>
+
+ExportPipeline::ExportPipeline(int nbWorkers, std::size_t maxQueued) :
+    mMaxQueued(std::max<std::size_t>(maxQueued, 1)), mStart(std::chrono::steady_clock::now()), mEnd(mStart)
+{
+    nbWorkers = std::max(nbWorkers, 1);
+    mWorkers.reserve(nbWorkers);
+    for(int i = 0; i < nbWorkers; ++i)
+    {
+        mWorkers.emplace_back(&ExportPipeline::work, this);
+    }
+}
+
+ExportPipeline::~ExportPipeline()
+{
+    finish();
+}
+
+/**
+ * @brief Number of workers for writing image files; one core is left for rendering
+ */
+int ExportPipeline::idealImageWorkerCount()
+{
+    return std::max(1, QThread::idealThreadCount() - 1);
+}
+
+/**
+ * @brief Adds a job, blocks while the queue is full
+ * @param job job to execute in a worker thread, returns false on failure
+ * @param description description of the job (e.g. the file name) reported by failedJob()
+ * @return false if the job was not accepted because a previous job failed or finish() was called
+ */
+bool ExportPipeline::enqueue(Job job, const QString &description)
+{
+    std::unique_lock lock(mMutex);
+    mSpaceAvailable.wait(lock, [this] { return mQueue.size() < mMaxQueued || mFailed || mFinishing; });
+    if(mFailed || mFinishing)
+    {
+        return false;
+    }
+    mQueue.push_back({std::move(job), description});
+    mJobAvailable.notify_one();
+    return true;
+}
+
+/**
+ * @brief Waits until all enqueued jobs are done and stops the workers
+ * @return true if all jobs succeeded
+ */
+bool ExportPipeline::finish()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mFinishing = true;
+    }
+    mJobAvailable.notify_all();
+    mSpaceAvailable.notify_all();
+    for(auto &worker : mWorkers)
+    {
+        if(worker.joinable())
+        {
+            worker.join();
+        }
+    }
+
+    std::lock_guard lock(mMutex);
+    if(!mWorkers.empty())
+    {
+        mWorkers.clear();
+        mEnd = std::chrono::steady_clock::now();
+    }
+    return !mFailed;
+}
+
+bool ExportPipeline::failed() const
+{
+    std::lock_guard lock(mMutex);
+    return mFailed;
+}
+
+QString ExportPipeline::failedJob() const
+{
+    std::lock_guard lock(mMutex);
+    return mFailedJob;
+}
+
+int ExportPipeline::completedJobs() const
+{
+    std::lock_guard lock(mMutex);
+    return mCompleted;
+}
+
+/**
+ * @brief Throughput since construction, until finish() or now
+ */
+double ExportPipeline::jobsPerSecond() const
+{
+    std::lock_guard lock(mMutex);
+    const auto                          end     = mWorkers.empty() ? mEnd : std::chrono::steady_clock::now();
+    const std::chrono::duration<double> seconds = end - mStart;
+    return seconds.count() > 0 ? mCompleted / seconds.count() : 0.;
+}
+
+void ExportPipeline::work()
+{
+    while(true)
+    {
+        Task task;
+        {
+            std::unique_lock lock(mMutex);
+            mJobAvailable.wait(lock, [this] { return !mQueue.empty() || mFinishing; });
+            if(mQueue.empty())
+            {
+                return;
+            }
+            task = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+        mSpaceAvailable.notify_one();
+
+        const bool success = task.job();
+
+        std::lock_guard lock(mMutex);
+        if(success)
+        {
+            ++mCompleted;
+        }
+        else if(!mFailed)
+        {
+            mFailed    = true;
+            mFailedJob = task.description;
+            mQueue.clear();
+            mSpaceAvailable.notify_all();
+        }
+    }
+}
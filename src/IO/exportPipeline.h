@@ -0,0 +1,89 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXPORTPIPELINE_H
+#define EXPORTPIPELINE_H
+
+#include <QString>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Writes exported frames in the background while the next frames are rendered
+ *
+ * The producer (the GUI thread rendering the frames) enqueues one job per frame. The jobs are executed by a fixed
+ * number of worker threads. Jobs are executed in the order they were enqueued; with a single worker (as needed for a
+ * video file) they also finish in this order. The queue is bounded, so enqueue() blocks while maxQueued jobs are
+ * waiting; this limits the memory used by rendered, but not yet written frames.
+ *
+ * A job returns false if it failed. After the first failure all waiting jobs are dropped and enqueue() does not
+ * accept new jobs anymore.
+ */
+class ExportPipeline
+{
+public:
+    using Job = std::function<bool()>;
+
+    static constexpr std::size_t DEFAULT_MAX_QUEUED = 16; ///< frames waiting to be written
+
+    explicit ExportPipeline(int nbWorkers, std::size_t maxQueued = DEFAULT_MAX_QUEUED);
+    ~ExportPipeline();
+
+    ExportPipeline(const ExportPipeline &)            = delete;
+    ExportPipeline &operator=(const ExportPipeline &) = delete;
+
+    static int idealImageWorkerCount();
+
+    bool enqueue(Job job, const QString &description);
+    bool finish();
+
+    bool    failed() const;
+    QString failedJob() const;
+    int     completedJobs() const;
+    double  jobsPerSecond() const;
+
+private:
+    struct Task
+    {
+        Job     job;
+        QString description;
+    };
+
+    void work();
+
+    std::size_t                           mMaxQueued;
+    std::vector<std::thread>              mWorkers;
+    mutable std::mutex                    mMutex;
+    std::condition_variable               mJobAvailable;
+    std::condition_variable               mSpaceAvailable;
+    std::deque<Task>                      mQueue;
+    bool                                  mFinishing = false;
+    bool                                  mFailed    = false;
+    QString                               mFailedJob;
+    int                                   mCompleted = 0;
+    std::chrono::steady_clock::time_point mStart;
+    std::chrono::steady_clock::time_point mEnd;
+};
+
+#endif // EXPORTPIPELINE_H
@@ -18,11 +18,13 @@
 
 #include "pIO.h"
 
+#include "c3dPointReader.h"
 #include "logger.h"
 #include "moCapPerson.h"
-#include "pMessageBox.h"
+#include "petrack.h"
 #include "skeletonTree.h"
 #include "skeletonTreeFactory.h"
+#include "trackPerson.h"
 
 #include <QFile>
 #include <QJsonArray>
@@ -30,7 +32,11 @@
 #include <QJsonObject>
 #include <QRegularExpression>
 #include <QTextStream>
+#include <algorithm>
+#include <array>
 #include <opencv2/opencv.hpp>
+#include <optional>
+#include <span>
 
 /**
  * @brief Reads individual heights for markerIDs from file.
@@ -134,53 +140,179 @@ std::variant<std::unordered_map<int, float>, std::string> IO::readHeightFile(con
     return "No file provided.";
 }
 
+namespace
+{
+/// number of points in the c3d files of XSens
+constexpr size_t XSENS_POINT_COUNT = 87;
+/// points of the XSens c3d files used for the skeleton, in the order of toXSenseStruct()
+constexpr std::array<size_t, 24> XSENS_POINTS{
+    78, 82, 0, 15, 69, 16, 17, 18, 71, 75, 73, 72, 77, 76, 32, 35, 79, 83, 80, 52, 57, 84, 58, 63};
+
+XSenseStruct toXSenseStruct(std::span<const cv::Point3f, XSENS_POINTS.size()> points)
+{
+    XSenseStruct skeletonStruct;
+    skeletonStruct.mHipR    = points[0];
+    skeletonStruct.mHipL    = points[1];
+    skeletonStruct.mRoot    = points[2];
+    skeletonStruct.mNeck1   = points[3];
+    skeletonStruct.mNeck2   = points[4];
+    skeletonStruct.mHeadTop = points[5];
+    skeletonStruct.mEarR    = points[6];
+    skeletonStruct.mEarL    = points[7];
+    skeletonStruct.mShldrR  = points[8];
+    skeletonStruct.mShldrL  = points[9];
+    skeletonStruct.mWristR  = points[10];
+    skeletonStruct.mElbowR  = points[11];
+    skeletonStruct.mWristL  = points[12];
+    skeletonStruct.mElbowL  = points[13];
+    skeletonStruct.mHandR   = points[14];
+    skeletonStruct.mHandL   = points[15];
+    skeletonStruct.mKneeR   = points[16];
+    skeletonStruct.mKneeL   = points[17];
+    skeletonStruct.mAnkleR  = points[18];
+    skeletonStruct.mHeelR   = points[19];
+    skeletonStruct.mToeR    = points[20];
+    skeletonStruct.mAnkleL  = points[21];
+    skeletonStruct.mHeelL   = points[22];
+    skeletonStruct.mToeL    = points[23];
+    return skeletonStruct;
+}
+
+void addXSensSample(MoCapPerson &person, std::span<const cv::Point3f, XSENS_POINTS.size()> points)
+{
+    std::array<cv::Point3f, SkeletonTreeFactory::XSENSE_JOINT_COUNT> joints;
+
+    const XSenseStruct skeletonStruct = toXSenseStruct(points);
+    SkeletonTreeFactory::generateJoints(skeletonStruct, joints);
+    person.addSample(joints, SkeletonTreeFactory::generateHeadDir(skeletonStruct), skeletonStruct.mHeadTop);
+}
+
+/// factor to convert the given c3d point unit to cm, as getImagePoint takes points in cm
+double unitToCm(const std::string &unit)
+{
+    if(unit == "cm")
+    {
+        return 1.0;
+    }
+    if(unit == "m")
+    {
+        return 100.0;
+    }
+    return 1e-1; // mm; default, since XSens uses this
+}
+
+/**
+ * @brief Reads a XSens c3d by streaming only the points of the skeleton
+ *
+ * @param reader opened c3d file
+ * @param person[out] the person which the skeletons are added to
+ * @param progress called with the read fraction of the file; returning false cancels reading
+ * @return error message, if the file could not be read
+ */
+std::optional<std::string> streamSkeletonC3D_XSENS(
+    const C3dPointReader              &reader,
+    MoCapPerson                       &person,
+    const std::function<bool(double)> &progress)
+{
+    if(reader.getPointCount() != XSENS_POINT_COUNT)
+    {
+        return "You need a C3D-File with joints for visualization in PeTrack.";
+    }
+
+    const double conversionFactor = unitToCm(reader.getUnit());
+    const size_t frameCount       = reader.getFrameCount();
+    bool         canceled         = false;
+
+    person.setTopology(SkeletonTreeFactory::xsenseTopology());
+    person.reserveSamples(frameCount);
+    std::array<cv::Point3f, XSENS_POINTS.size()> points;
+    auto error = reader.readFrames(
+        XSENS_POINTS,
+        [&](size_t frame, std::span<const cv::Point3f> framePoints)
+        {
+            std::transform(
+                framePoints.begin(),
+                framePoints.end(),
+                points.begin(),
+                [conversionFactor](const cv::Point3f &point) { return point * conversionFactor; });
+            addXSensSample(person, points);
+
+            constexpr size_t progressInterval = 1024;
+            if(progress && frame % progressInterval == 0)
+            {
+                canceled = !progress(static_cast<double>(frame) / frameCount);
+            }
+            return !canceled;
+        });
+    if(canceled)
+    {
+        return "Reading " + person.getFilename() + " was canceled.";
+    }
+    return error;
+}
+} // namespace
+
 /**
- * @brief Delegates the input c3d to the correct method for given system.
+ * @brief Reads a c3d file with the correct method for given system.
  *
  * This method calls the correct IO method for the MoCap system.
  * Currently only XSENS is supported.
  *
- * @param storage mMoCapStorage of petrack
- * @param metadata new MoCapPersonMetadata
+ * The file is streamed with C3dPointReader, so only the points needed for the
+ * skeleton are converted and stored. Files not supported by C3dPointReader are
+ * read completely with ezc3d. This method does not show any dialogs, so it can
+ * be used for reading several files in parallel.
+ *
+ * @param metadata metadata of the person to read
+ * @param progress called with the read fraction of the file; returning false cancels reading
+ * @return the read person or an error message
  */
-void IO::readMoCapC3D(MoCapStorage &storage, const MoCapPersonMetadata &metadata)
+std::variant<MoCapPerson, std::string>
+IO::readMoCapC3D(const MoCapPersonMetadata &metadata, const std::function<bool(double)> &progress)
 {
     MoCapPerson        person;
     const std::string &filename = metadata.getFilepath();
     MoCapSystem        fp       = metadata.getSystem();
     person.setMetadata(metadata);
 
+    auto reader = C3dPointReader::open(QString::fromStdString(filename));
+    if(const auto *streamReader = std::get_if<C3dPointReader>(&reader))
+    {
+        person.setFileTimeOffset(
+            -static_cast<double>(streamReader->getFirstFrame()) / person.getMetadata().getSamplerate());
+
+        std::optional<std::string> error;
+        switch(fp)
+        {
+            case XSensC3D:
+                error = streamSkeletonC3D_XSENS(*streamReader, person, progress);
+                break;
+            case END:
+                break; // So clang doesn't say it isn't handled
+        }
+        if(error)
+        {
+            return "Error while reading C3D File " + filename + ": " + *error;
+        }
+        return person;
+    }
+    SPDLOG_INFO("Reading {} completely: {}", filename, std::get<std::string>(reader));
+
     ezc3d::c3d c3d;
     try
     {
         c3d = ezc3d::c3d{filename};
     }
-    catch(const std::invalid_argument &e)
+    catch(const std::exception &e)
     {
-        std::stringstream ss;
-        ss << "Error while reading C3D File " << filename << ": " << e.what() << '\n';
-        PCritical(nullptr, "Error: Cannot load C3D File", ss.str().c_str());
-        return;
+        return "Error while reading C3D File " + filename + ": " + e.what();
     }
 
     size_t firstFrame = c3d.header().firstFrame();
     person.setFileTimeOffset(-static_cast<double>(firstFrame) / person.getMetadata().getSamplerate());
 
-    // getImagePoint takes points in cm -> cm as target unit
     const std::string unit             = c3d.parameters().group("POINT").parameter("UNITS").valuesAsString()[0];
-    double            conversionFactor = 1e-1; // default, since XSens uses this
-    if(unit == "mm")
-    {
-        conversionFactor = 1e-1;
-    }
-    else if(unit == "cm")
-    {
-        conversionFactor = 1.0;
-    }
-    else if(unit == "m")
-    {
-        conversionFactor = 100.0;
-    }
+    const double      conversionFactor = unitToCm(unit);
 
     const auto c3dToPoint3f = [conversionFactor](const ezc3d::DataNS::Points3dNS::Point &point)
     {
@@ -189,16 +321,22 @@ void IO::readMoCapC3D(MoCapStorage &storage, const MoCapPersonMetadata &metadata
                conversionFactor;
     };
 
-    switch(fp)
+    try
     {
-        case XSensC3D:
-            readSkeletonC3D_XSENS(c3d, person, c3dToPoint3f);
-            break;
-        case END:
-            break; // So clang doesn't say it isn't handled
+        switch(fp)
+        {
+            case XSensC3D:
+                readSkeletonC3D_XSENS(c3d, person, c3dToPoint3f);
+                break;
+            case END:
+                break; // So clang doesn't say it isn't handled
+        }
     }
-
-    storage.addPerson(person);
+    catch(const std::invalid_argument &e)
+    {
+        return "Error while reading C3D File " + filename + ": " + e.what();
+    }
+    return person;
 }
 
 /**
@@ -210,6 +348,7 @@ void IO::readMoCapC3D(MoCapStorage &storage, const MoCapPersonMetadata &metadata
  * @param c3d[in] c3d-oject corresponding to the XSens c3d-File
  * @param person[out] the person which the skeletons are added to
  * @param c3dToPoint3f[in] function which converts a c3d point to a cv::Point3f in cm
+ * @throw std::invalid_argument if the c3d does not have the points of the XSens skeleton
  */
 void IO::readSkeletonC3D_XSENS(
     const ezc3d::c3d                                                           &c3d,
@@ -218,42 +357,24 @@ void IO::readSkeletonC3D_XSENS(
 {
     const auto &frames = c3d.data().frames();
 
+    person.setTopology(SkeletonTreeFactory::xsenseTopology());
+    person.reserveSamples(frames.size());
+    std::array<cv::Point3f, XSENS_POINTS.size()> points;
+
     for(const auto &frame : frames)
     {
-        const auto &points = frame.points().points();
-        if(points.size() != 87)
+        const auto &framePoints = frame.points().points();
+        if(framePoints.size() != XSENS_POINT_COUNT)
         {
-            PCritical(nullptr, "Wrong C3D", "You need a C3D-File with joints for visualization in PeTrack.");
-            break;
+            throw std::invalid_argument("You need a C3D-File with joints for visualization in PeTrack.");
         }
 
-        XSenseStruct skeletonStruct;
-        skeletonStruct.mHipR    = c3dToPoint3f(points[78]);
-        skeletonStruct.mHipL    = c3dToPoint3f(points[82]);
-        skeletonStruct.mRoot    = c3dToPoint3f(points[0]);
-        skeletonStruct.mNeck1   = c3dToPoint3f(points[15]);
-        skeletonStruct.mNeck2   = c3dToPoint3f(points[69]);
-        skeletonStruct.mHeadTop = c3dToPoint3f(points[16]);
-        skeletonStruct.mEarR    = c3dToPoint3f(points[17]);
-        skeletonStruct.mEarL    = c3dToPoint3f(points[18]);
-        skeletonStruct.mShldrR  = c3dToPoint3f(points[71]);
-        skeletonStruct.mShldrL  = c3dToPoint3f(points[75]);
-        skeletonStruct.mWristR  = c3dToPoint3f(points[73]);
-        skeletonStruct.mElbowR  = c3dToPoint3f(points[72]);
-        skeletonStruct.mWristL  = c3dToPoint3f(points[77]);
-        skeletonStruct.mElbowL  = c3dToPoint3f(points[76]);
-        skeletonStruct.mHandR   = c3dToPoint3f(points[32]);
-        skeletonStruct.mHandL   = c3dToPoint3f(points[35]);
-        skeletonStruct.mKneeR   = c3dToPoint3f(points[79]);
-        skeletonStruct.mKneeL   = c3dToPoint3f(points[83]);
-        skeletonStruct.mAnkleR  = c3dToPoint3f(points[80]);
-        skeletonStruct.mHeelR   = c3dToPoint3f(points[52]);
-        skeletonStruct.mToeR    = c3dToPoint3f(points[57]);
-        skeletonStruct.mAnkleL  = c3dToPoint3f(points[84]);
-        skeletonStruct.mHeelL   = c3dToPoint3f(points[58]);
-        skeletonStruct.mToeL    = c3dToPoint3f(points[63]);
-
-        person.addSkeleton(SkeletonTreeFactory::generateTree(skeletonStruct));
+        std::transform(
+            XSENS_POINTS.begin(),
+            XSENS_POINTS.end(),
+            points.begin(),
+            [&](size_t index) { return c3dToPoint3f(framePoints[index]); });
+        addXSensSample(person, points);
     }
 }
 
@@ -379,3 +500,114 @@ std::vector<std::string> IO::readAuthors(const QString &authorsFile)
 
     return authors;
 }
+
+/**
+ * @brief Reads the trajectories of a TRC file
+ *
+ * Petrack::trcVersion is set to the version of the file, since the TrackPersons and TrackPoints are parsed according
+ * to it.
+ *
+ * @param trcFileName name of the TRC file
+ * @param recoMethod recognition method the trajectories were tracked with
+ * @return the trajectories if parsing was successful, error message otherwise
+ */
+std::variant<std::vector<TrackPerson>, std::string>
+IO::readTrcFile(const QString &trcFileName, reco::RecognitionMethod recoMethod)
+{
+    QFile file(trcFileName);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return "Cannot open " + trcFileName.toStdString() + ":\n" + file.errorString().toStdString();
+    }
+
+    // read all lines at once
+    QTextStream in(&file);
+    QStringList allLines;
+    while(!in.atEnd())
+    {
+        allLines.append(in.readLine());
+    }
+    file.close();
+    if(allLines.isEmpty())
+    {
+        return "File " + trcFileName.toStdString() + " is empty";
+    }
+    int currentLineIndex = 0;
+    // Parse header
+    const QString firstLine = allLines[currentLineIndex++];
+    bool          ok;
+    int           sz = firstLine.toInt(&ok);
+
+    if(!ok)
+    {
+        // Parse version header
+        if(firstLine.contains("version 5", Qt::CaseInsensitive))
+        {
+            Petrack::trcVersion = 5;
+        }
+        else if(firstLine.contains("version 4", Qt::CaseInsensitive))
+        {
+            Petrack::trcVersion = 4;
+        }
+        else if(firstLine.contains("version 3", Qt::CaseInsensitive))
+        {
+            Petrack::trcVersion = 3;
+        }
+        else if(firstLine.contains("version 2", Qt::CaseInsensitive))
+        {
+            Petrack::trcVersion = 2;
+        }
+        else
+        {
+            return "Not supported trc version in file: " + trcFileName.toStdString();
+        }
+
+        // Read size from next line
+        if(currentLineIndex >= allLines.size())
+        {
+            return "Expected size after version header but reached end of file";
+        }
+
+        sz = allLines[currentLineIndex++].toInt(&ok);
+        if(!ok)
+        {
+            return "Expected valid number of persons but found: " + allLines[currentLineIndex - 1].toStdString();
+        }
+    }
+    else
+    {
+        Petrack::trcVersion = 1;
+    }
+
+    // Validate size
+    if(sz < 0)
+    {
+        return "Invalid number of persons: " + std::to_string(sz);
+    }
+
+    std::vector<TrackPerson> persons;
+    persons.reserve(sz);
+    for(int i = 0; i < sz; ++i)
+    {
+        TrackPerson tp;
+        ParseResult result = parseTrackPerson(allLines, currentLineIndex, tp, recoMethod);
+        if(!result.success)
+        {
+            std::string errorMsg = "Error parsing person " + std::to_string(i + 1) + " of " + std::to_string(sz) +
+                                   ":\n" + result.errorMessage.toStdString();
+            if(result.lineNumber > 0)
+            {
+                errorMsg += "\nAt line " + std::to_string(result.lineNumber);
+            }
+            return errorMsg;
+        }
+        persons.push_back(std::move(tp));
+        ++currentLineIndex; // skip the empty line after a person finish
+    }
+    // Verify we got all expected data
+    if(currentLineIndex < allLines.size())
+    {
+        SPDLOG_WARN("File contains {} extra lines after expected data", allLines.size() - currentLineIndex);
+    }
+    return persons;
+}
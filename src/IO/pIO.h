@@ -21,20 +21,28 @@
 
 #include <QString>
 #include <ezc3d_all.h>
+#include <functional>
 #include <opencv2/opencv.hpp>
 #include <string>
 #include <unordered_map>
 #include <variant>
-class MoCapStorage;
+#include <vector>
 class MoCapPerson;
 class MoCapPersonMetadata;
+class TrackPerson;
+namespace reco
+{
+enum class RecognitionMethod;
+}
 
 
 namespace IO
 {
 std::variant<std::unordered_map<int, float>, std::string> readHeightFile(const QString &heightFileName);
 
-void readMoCapC3D(MoCapStorage &storage, const MoCapPersonMetadata &metadata);
+std::variant<MoCapPerson, std::string>
+readMoCapC3D(const MoCapPersonMetadata &metadata, const std::function<bool(double)> &progress = {});
+
 void readSkeletonC3D_XSENS(
     const ezc3d::c3d                                                           &c3d,
     MoCapPerson                                                                &person,
@@ -43,5 +51,8 @@ void readSkeletonC3D_XSENS(
 std::variant<std::unordered_map<int, int>, std::string> readMarkerIDFile(const QString &markerFileName);
 
 std::vector<std::string> readAuthors(const QString &authorsFile);
+
+std::variant<std::vector<TrackPerson>, std::string>
+readTrcFile(const QString &trcFileName, reco::RecognitionMethod recoMethod);
 } // namespace IO
 #endif // IO_H
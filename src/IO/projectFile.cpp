@@ -0,0 +1,192 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "projectFile.h"
+
+#include "logger.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QXmlStreamWriter>
+#include <algorithm>
+
+namespace
+{
+constexpr int INDENT = 4;
+
+void setupWriter(QXmlStreamWriter &xmlStream)
+{
+    xmlStream.setAutoFormatting(true);
+    xmlStream.setAutoFormattingIndent(INDENT);
+}
+
+void writeAttributes(QXmlStreamWriter &xmlStream, const QDomElement &element)
+{
+    QVector<QString>       attributeNames;
+    const QDomNamedNodeMap attributes = element.attributes();
+    for(int i = 0; i < attributes.size(); ++i)
+    {
+        attributeNames.push_back(attributes.item(i).toAttr().name());
+    }
+
+    // TODO: check if sorting of elements fits our needs
+    std::stable_sort(attributeNames.begin(), attributeNames.end()); // for a canonical XML
+
+    for(const auto &name : attributeNames)
+    {
+        xmlStream.writeAttribute(name, element.attribute(name));
+    }
+}
+
+/// Serializes a top level section as it appears inside the root element
+QByteArray serializeSection(const QDomElement &element)
+{
+    QByteArray       byteArray;
+    QXmlStreamWriter xmlStream(&byteArray);
+    setupWriter(xmlStream);
+    ProjectFile::writeElement(xmlStream, element);
+
+    // a fragment is written without indentation; attribute values cannot contain line breaks (they are escaped)
+    const QByteArray indent(INDENT, ' ');
+    return indent + byteArray.replace('\n', "\n" + indent);
+}
+} // namespace
+
+/**
+ * @brief Updates the state to the given document
+ *
+ * @param doc complete project, see Petrack::saveXml()
+ * @return names of the sections which changed; all sections if the root element changed
+ */
+QStringList ProjectFile::update(const QDomDocument &doc)
+{
+    const QDomElement root = doc.documentElement();
+
+    QByteArray       header;
+    QXmlStreamWriter xmlStream(&header);
+    setupWriter(xmlStream);
+    xmlStream.writeStartDocument();
+    xmlStream.writeDTD(QString("<!DOCTYPE %1>").arg(root.tagName()));
+    xmlStream.writeStartElement(root.tagName());
+    writeAttributes(xmlStream, root);
+    xmlStream.writeCharacters(""); // closes the start tag
+
+    QStringList changed;
+    const bool  headerChanged = header != mHeader;
+    if(headerChanged)
+    {
+        mHeader   = header;
+        mRootName = root.tagName();
+    }
+
+    std::vector<Section> sections;
+    for(QDomElement elem = root.firstChildElement(); !elem.isNull(); elem = elem.nextSiblingElement())
+    {
+        Section    section{elem.tagName(), serializeSection(elem)};
+        const auto index = sections.size();
+        if(headerChanged || index >= mSections.size() || mSections[index].name != section.name ||
+           mSections[index].xml != section.xml)
+        {
+            changed.append(section.name);
+        }
+        sections.push_back(std::move(section));
+    }
+    if(!changed.isEmpty() || sections.size() != mSections.size())
+    {
+        mSections = std::move(sections);
+        ++mRevision;
+        SPDLOG_DEBUG("project sections changed: {}", changed.join(", "));
+    }
+    return changed;
+}
+
+/**
+ * @brief Returns whether the current state was already written to the given file by this ProjectFile
+ *
+ * The file has to exist with the modification time it had after writing.
+ */
+bool ProjectFile::isWritten(const QString &fileName) const
+{
+    const QFileInfo fileInfo(fileName);
+    const auto      written = mWritten.constFind(fileInfo.absoluteFilePath());
+    return written != mWritten.cend() && written->revision == mRevision && fileInfo.exists() &&
+           fileInfo.lastModified() == written->lastModified;
+}
+
+/**
+ * @brief Writes the current state to the given file, if it does not already contain it
+ *
+ * @param fileName file to write to
+ * @param errorString set to the reason if writing failed
+ * @return true if the file contains the current state
+ */
+bool ProjectFile::write(const QString &fileName, QString *errorString)
+{
+    if(isWritten(fileName))
+    {
+        SPDLOG_DEBUG("project unchanged, not writing {}", fileName);
+        return true;
+    }
+
+    QFile file(fileName);
+    if(!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+    {
+        if(errorString)
+        {
+            *errorString = file.errorString();
+        }
+        return false;
+    }
+    file.write(content());
+    file.close(); // also flushes the file
+
+    const QFileInfo fileInfo(fileName);
+    mWritten[fileInfo.absoluteFilePath()] = {mRevision, fileInfo.lastModified()};
+    return true;
+}
+
+/**
+ * @brief Assembles the file content from the (cached) sections
+ */
+QByteArray ProjectFile::content() const
+{
+    QByteArray byteArray = mHeader;
+    for(const auto &section : mSections)
+    {
+        byteArray += '\n';
+        byteArray += section.xml;
+    }
+    byteArray += QString("\n</%1>\n").arg(mRootName).toUtf8();
+    return byteArray;
+}
+
+/**
+ * @brief Writes the element with all of its children with attributes in a canonical (sorted) order
+ */
+void ProjectFile::writeElement(QXmlStreamWriter &xmlStream, const QDomElement &element)
+{
+    xmlStream.writeStartElement(element.tagName());
+    writeAttributes(xmlStream, element);
+
+    // order of child nodes is defined at creation
+    for(QDomElement child = element.firstChildElement(); !child.isNull(); child = child.nextSiblingElement())
+    {
+        writeElement(xmlStream, child);
+    }
+
+    xmlStream.writeEndElement();
+}
@@ -0,0 +1,74 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef PROJECTFILE_H
+#define PROJECTFILE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QDomDocument>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <cstdint>
+#include <vector>
+
+class QXmlStreamWriter;
+
+/**
+ * @brief Serialized state of a project (.pet file), split into its top level sections
+ *
+ * Each section (MAIN, CONTROL, PLAYER, ...) is kept in its serialized form. update() serializes a new state and
+ * only replaces the sections whose content changed; unchanged sections are reused when the file is assembled.
+ * Every change increases the revision. write() remembers which revision was written to which file and skips the
+ * write if the file already contains the current state, so e.g. saving an unchanged project again costs nothing. A
+ * file changed by others since it was written (different modification time) is always written again.
+ *
+ * The assembled file is identical to writing the whole document with writeElement().
+ */
+class ProjectFile
+{
+public:
+    QStringList   update(const QDomDocument &doc);
+    bool          isWritten(const QString &fileName) const;
+    bool          write(const QString &fileName, QString *errorString = nullptr);
+    QByteArray    content() const;
+    std::uint64_t revision() const { return mRevision; }
+
+    static void writeElement(QXmlStreamWriter &xmlStream, const QDomElement &element);
+
+private:
+    struct Section
+    {
+        QString    name;
+        QByteArray xml; ///< serialized section, indented for the first level of the document
+    };
+
+    struct Written
+    {
+        std::uint64_t revision;
+        QDateTime     lastModified;
+    };
+
+    QByteArray              mHeader; ///< xml declaration, doctype and start tag of the root element
+    QString                 mRootName;
+    std::vector<Section>    mSections;
+    std::uint64_t           mRevision = 0;
+    QHash<QString, Written> mWritten; ///< state of the files written by this ProjectFile, by absolute path
+};
+
+#endif // PROJECTFILE_H
@@ -0,0 +1,313 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "shardedTracking.h"
+
+#include "animation.h"
+#include "logger.h"
+#include "pIO.h"
+#include "personStorage.h"
+#include "petrack.h"
+#include "tracker.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <functional>
+#include <memory>
+
+namespace sharding
+{
+namespace
+{
+/**
+ * @brief Runs one PeTrack worker process per shard on the saved project and waits for all of them
+ *
+ * @param petrack petrack with the saved project
+ * @param shards frame ranges of the workers; passed with <kbd>-trackFrames</kbd>
+ * @param taskArguments returns the arguments for the task of the worker with the given index
+ * @param task name of the task for messages
+ * @return false if a worker failed
+ */
+bool runWorkers(
+    Petrack                                  &petrack,
+    const std::vector<stitching::FrameShard> &shards,
+    const std::function<QStringList(size_t)> &taskArguments,
+    const QString                            &task)
+{
+    std::vector<std::unique_ptr<QProcess>> processes;
+    for(size_t i = 0; i < shards.size(); ++i)
+    {
+        QStringList arguments{
+            "-project",
+            petrack.getProFileName(),
+            "-trackFrames",
+            QString("%1-%2").arg(shards[i].firstFrame).arg(shards[i].lastFrame)};
+        arguments << taskArguments(i);
+        if(!petrack.getSeqFileName().isEmpty())
+        {
+            arguments << "-sequence" << petrack.getSeqFileName();
+        }
+
+        auto process = std::make_unique<QProcess>();
+        process->setProcessChannelMode(QProcess::ForwardedChannels);
+        process->start(QCoreApplication::applicationFilePath(), arguments);
+        processes.push_back(std::move(process));
+    }
+
+    bool success = true;
+    for(size_t i = 0; i < processes.size(); ++i)
+    {
+        auto &process = *processes[i];
+        if(!process.waitForStarted(-1))
+        {
+            SPDLOG_ERROR(
+                "{}: worker for frames {} to {} failed to start: {}",
+                task,
+                shards[i].firstFrame,
+                shards[i].lastFrame,
+                process.errorString());
+            success = false;
+            continue;
+        }
+        process.waitForFinished(-1);
+        if(process.exitStatus() == QProcess::CrashExit)
+        {
+            SPDLOG_ERROR(
+                "{}: worker for frames {} to {} crashed: {}",
+                task,
+                shards[i].firstFrame,
+                shards[i].lastFrame,
+                process.errorString());
+            success = false;
+        }
+        else if(process.exitCode() != EXIT_SUCCESS)
+        {
+            SPDLOG_ERROR(
+                "{}: worker for frames {} to {} failed with exit code {}",
+                task,
+                shards[i].firstFrame,
+                shards[i].lastFrame,
+                process.exitCode());
+            success = false;
+        }
+    }
+    return success;
+}
+
+bool isProjectSaved(Petrack &petrack, const QString &task)
+{
+    const QString project = petrack.getProFileName();
+    if(project.isEmpty() || !QFileInfo{project}.isReadable())
+    {
+        SPDLOG_ERROR("{} needs a saved project", task);
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+/**
+ * @brief Tracks the whole sequence of the opened project in options.nbShards worker processes
+ *
+ * The project has to be saved, since the workers open it from disk. The stitched trajectories replace the ones of
+ * petrack. The trajectories of each worker are cropped to its shard, so trajectories already contained in the project
+ * are kept, but are tracked again in all shards. A detection cache of petrack is used by the workers as well.
+ *
+ * @return false if the project is not saved or a worker failed; the trajectories of petrack are unchanged then
+ */
+bool trackSharded(Petrack &petrack, const ShardOptions &options)
+{
+    if(!isProjectSaved(petrack, "Sharded tracking"))
+    {
+        return false;
+    }
+
+    const int  nbFrames = petrack.getAnimation()->getNumFrames();
+    const auto shards   = stitching::splitFrameRange(0, nbFrames - 1, options.nbShards, options.overlap);
+    if(shards.empty())
+    {
+        SPDLOG_ERROR("Sharded tracking: no frames to track");
+        return false;
+    }
+
+    QTemporaryDir tmpDir;
+    if(!tmpDir.isValid())
+    {
+        SPDLOG_ERROR("Sharded tracking: cannot create temporary folder: {}", tmpDir.errorString());
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    SPDLOG_INFO("Sharded tracking: {} frames in {} shards", nbFrames, shards.size());
+
+    const bool success = runWorkers(
+        petrack,
+        shards,
+        [&](size_t i)
+        {
+            QStringList arguments{"-autoTrack", tmpDir.filePath(QString("shard_%1.trc").arg(i))};
+            if(!petrack.getDetectionCacheFileName().isEmpty())
+            {
+                arguments << "-detectionCache" << petrack.getDetectionCacheFileName();
+            }
+            return arguments;
+        },
+        "Sharded tracking");
+    if(!success)
+    {
+        return false;
+    }
+
+    // read all shards before the trajectories of petrack are replaced
+    std::vector<std::vector<TrackPerson>> shardPersons;
+    for(size_t i = 0; i < shards.size(); ++i)
+    {
+        const QString shardFile = tmpDir.filePath(QString("shard_%1.trc").arg(i));
+        if(!QFileInfo::exists(shardFile))
+        {
+            SPDLOG_ERROR(
+                "Sharded tracking: worker for frames {} to {} wrote no trajectories",
+                shards[i].firstFrame,
+                shards[i].lastFrame);
+            return false;
+        }
+        auto trc = IO::readTrcFile(shardFile, petrack.getRecognizer().getRecoMethod());
+        if(std::holds_alternative<std::string>(trc))
+        {
+            SPDLOG_ERROR("Sharded tracking: cannot read {}: {}", shardFile, std::get<std::string>(trc));
+            return false;
+        }
+        auto persons = std::move(std::get<std::vector<TrackPerson>>(trc));
+        stitching::cropToFrameRange(persons, shards[i]);
+        shardPersons.push_back(std::move(persons));
+    }
+
+    stitching::StitchReport report;
+    auto persons = stitching::stitchShards(std::move(shardPersons), shards, options.stitch, report);
+    auto &storage = petrack.getPersonStorage();
+    storage.clear();
+    for(const auto &person : persons)
+    {
+        storage.addPerson(person);
+    }
+    petrack.setTrackChanged(true);
+    petrack.getTracker()->reset();
+
+    SPDLOG_INFO(
+        "Sharded tracking: {} persons in {:.1f} s; {} stitches, {} ambiguous, {} trajectories without partner",
+        storage.nbPersons(),
+        static_cast<double>(timer.nsecsElapsed()) * 1e-9,
+        report.nbStitches,
+        report.nbAmbiguous,
+        report.nbUnmatched);
+
+    if(!options.reportFile.isEmpty())
+    {
+        QFile file{options.reportFile};
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            SPDLOG_ERROR("Cannot write {}: {}", options.reportFile, file.errorString());
+            return false;
+        }
+        auto json = report.toJson();
+        json.insert("frames", nbFrames);
+        json.insert("overlap", shards.size() > 1 ? shards[0].lastFrame - shards[1].firstFrame + 1 : 0);
+        file.write(QJsonDocument{json}.toJson());
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the recognition on the whole sequence of the opened project in nbWorkers worker processes
+ *
+ * Every worker detects a part of the frames (see Petrack::detectAll()) and writes its own detection cache. These
+ * are merged into the detection cache of petrack, which is saved to its file afterwards. The project has to be saved
+ * with the current recognition parameters, since the workers open it from disk.
+ *
+ * @return false if the project is not saved, a worker failed or the detection cache could not be saved
+ */
+bool detectSharded(Petrack &petrack, int nbWorkers)
+{
+    if(!isProjectSaved(petrack, "Parallel detection"))
+    {
+        return false;
+    }
+
+    const int  nbFrames = petrack.getAnimation()->getNumFrames();
+    const auto shards   = stitching::splitFrameRange(0, nbFrames - 1, nbWorkers, 0);
+    if(shards.empty())
+    {
+        SPDLOG_ERROR("Parallel detection: no frames to detect");
+        return false;
+    }
+
+    QTemporaryDir tmpDir;
+    if(!tmpDir.isValid())
+    {
+        SPDLOG_ERROR("Parallel detection: cannot create temporary folder: {}", tmpDir.errorString());
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    SPDLOG_INFO("Parallel detection: {} frames in {} workers", nbFrames, shards.size());
+
+    auto partFile = [&tmpDir](size_t i) { return tmpDir.filePath(QString("part_%1.det").arg(i)); };
+    if(!runWorkers(
+           petrack,
+           shards,
+           [&](size_t i) { return QStringList{"-detectionCache", partFile(i), "-detectAll"}; },
+           "Parallel detection"))
+    {
+        return false;
+    }
+
+    const QByteArray     hash = petrack.recognitionParameterHash();
+    reco::DetectionCache cache{hash, 0, nbFrames - 1};
+    cache.merge(petrack.getDetectionCache());
+    for(size_t i = 0; i < shards.size(); ++i)
+    {
+        const auto part = reco::DetectionCache::load(partFile(i));
+        if(!part)
+        {
+            return false;
+        }
+        if(!cache.merge(*part))
+        {
+            SPDLOG_ERROR("Parallel detection: the saved project has other recognition parameters; save it first");
+            return false;
+        }
+    }
+    petrack.getDetectionCache() = std::move(cache);
+
+    SPDLOG_INFO(
+        "Parallel detection: {} of {} frames detected in {:.1f} s",
+        petrack.getDetectionCache().nbDetectedFrames(),
+        nbFrames,
+        static_cast<double>(timer.nsecsElapsed()) * 1e-9);
+
+    const QString &fileName = petrack.getDetectionCacheFileName();
+    return fileName.isEmpty() || petrack.getDetectionCache().save(fileName);
+}
+} // namespace sharding
@@ -0,0 +1,53 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHARDEDTRACKING_H
+#define SHARDEDTRACKING_H
+
+#include "trajectoryStitching.h"
+
+#include <QString>
+
+class Petrack;
+
+/**
+ * @brief Tracking of a long video in parallel by splitting it into overlapping frame ranges
+ *
+ * Every shard is tracked by its own PeTrack worker process (started with <kbd>-trackFrames</kbd> and
+ * <kbd>-autoTrack</kbd>), since one Petrack instance with its Tracker and Animation cannot be used from more than one
+ * thread. Afterwards the trajectories of all shards are stitched, see stitching::stitchShards().
+ *
+ * The recognition pre-pass (see Petrack::detectAll()) is parallelized the same way with frame ranges without overlap.
+ */
+namespace sharding
+{
+inline constexpr int DEFAULT_OVERLAP = 50;
+
+struct ShardOptions
+{
+    int                      nbShards = 1;               ///< number of worker processes
+    int                      overlap  = DEFAULT_OVERLAP; ///< frames tracked by both neighboring shards
+    QString                  reportFile;                 ///< JSON report of the stitching; empty for none
+    stitching::StitchOptions stitch;
+};
+
+bool trackSharded(Petrack &petrack, const ShardOptions &options);
+bool detectSharded(Petrack &petrack, int nbWorkers);
+} // namespace sharding
+
+#endif // SHARDEDTRACKING_H
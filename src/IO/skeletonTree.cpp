@@ -91,6 +91,108 @@ std::vector<SkeletonLine> SkeletonTree::getLines() const
     return lines;
 }
 
+namespace
+{
+void recurseTopology(const SkeletonNode &node, int parent, SkeletonTopology &topology, std::vector<cv::Point3f> *joints)
+{
+    const int index = static_cast<int>(topology.mIds.size());
+    topology.mIds.push_back(node.getId());
+    topology.mParents.push_back(parent);
+    if(joints)
+    {
+        joints->push_back(node.getPos());
+    }
+    for(const SkeletonNode &child : node.getChildren())
+    {
+        recurseTopology(child, index, topology, joints);
+    }
+}
+
+SkeletonNode buildNode(const SkeletonTopology &topology, std::span<const cv::Point3f> joints, int index)
+{
+    SkeletonNode node(topology.mIds[index], joints[index]);
+    for(size_t child = index + 1; child < topology.getJointCount(); ++child)
+    {
+        if(topology.mParents[child] == index)
+        {
+            node.addChild(buildNode(topology, joints, static_cast<int>(child)));
+        }
+    }
+    return node;
+}
+} // namespace
+
+/**
+ * @brief Finds the joint with the given id whose parent has the given id.
+ *
+ * If several joints match, the last one in prefix order is returned.
+ *
+ * @param[in] parentId  The id of the joint the bone starts at.
+ * @param[in] id  The id of the joint the bone ends at.
+ *
+ * @return The index of the joint or -1 if there is no such bone.
+ */
+int SkeletonTopology::findJoint(uint8_t parentId, uint8_t id) const
+{
+    for(int joint = static_cast<int>(getJointCount()) - 1; joint > 0; --joint)
+    {
+        if(mIds[joint] == id && mIds[mParents[joint]] == parentId)
+        {
+            return joint;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Constructs a skeleton from a topology and flat joint positions.
+ *
+ * @param[in] topology  The bone topology of the skeleton.
+ * @param[in] joints  The position of every joint of the topology.
+ * @param[in] dir  The direction the head is facing. The vector will be normalized.
+ * @param[in] rotationCenter  The center of rotation of the skeleton.
+ *
+ * @return The constructed skeleton.
+ * @throw std::invalid_argument if the number of joints does not match the topology
+ */
+SkeletonTree SkeletonTree::fromJoints(
+    const SkeletonTopology      &topology,
+    std::span<const cv::Point3f> joints,
+    const cv::Vec3f             &dir,
+    const cv::Point3f           &rotationCenter)
+{
+    if(topology.getJointCount() == 0 || joints.size() != topology.getJointCount())
+    {
+        throw std::invalid_argument("Number of joints does not match the skeleton topology");
+    }
+    return SkeletonTree(buildNode(topology, joints, 0), dir, rotationCenter);
+}
+
+/**
+ * @brief Returns the bone topology of this skeleton.
+ *
+ * @return The topology with the joints in prefix order.
+ */
+SkeletonTopology SkeletonTree::getTopology() const
+{
+    SkeletonTopology topology;
+    recurseTopology(mRoot, -1, topology, nullptr);
+    return topology;
+}
+
+/**
+ * @brief Returns the positions of all joints in the order of getTopology().
+ *
+ * @return The joint positions.
+ */
+std::vector<cv::Point3f> SkeletonTree::getJoints() const
+{
+    SkeletonTopology         topology;
+    std::vector<cv::Point3f> joints;
+    recurseTopology(mRoot, -1, topology, &joints);
+    return joints;
+}
+
 void transformTree(SkeletonNode &node, const cv::Affine3f &transform)
 {
     node.transform(transform);
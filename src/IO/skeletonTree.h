@@ -25,6 +25,7 @@
 #include <opencv2/core/affine.hpp>
 #include <opencv2/core/matx.hpp>
 #include <opencv2/core/types.hpp>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -149,6 +150,26 @@ struct SkeletonLine
     uint8_t     end_id;
 };
 
+/**
+ * @brief The bone topology of a skeleton, without any positions.
+ *
+ * The joints are numbered in the prefix order of SkeletonTree::getLines(), with the root as joint 0. Every joint
+ * except the root is the end of exactly one bone, which starts at its parent. So joint i > 0 stands for the bone
+ * mParents[i] -> i and the bones are in the same order as the lines of SkeletonTree::getLines().
+ *
+ * This allows storing the positions of many samples with the same topology as flat arrays of joints.
+ */
+struct SkeletonTopology
+{
+    std::vector<uint8_t> mIds;     /**< Id of every joint. */
+    std::vector<int>     mParents; /**< Index of the parent of every joint; -1 for the root. */
+
+    inline size_t getJointCount() const { return mIds.size(); }
+    int           findJoint(uint8_t parentId, uint8_t id) const;
+
+    friend bool operator==(const SkeletonTopology &lhs, const SkeletonTopology &rhs) = default;
+};
+
 /**
  * @brief The SkeletonTree class saves a Motion Capture Skeleton.
  *
@@ -189,7 +210,15 @@ public:
         mHeadDir = cv::normalize(mHeadDir);
     }
 
+    static SkeletonTree fromJoints(
+        const SkeletonTopology      &topology,
+        std::span<const cv::Point3f> joints,
+        const cv::Vec3f             &dir,
+        const cv::Point3f           &rotationCenter);
+
     std::vector<SkeletonLine> getLines() const;
+    SkeletonTopology          getTopology() const;
+    std::vector<cv::Point3f>  getJoints() const;
 
     /**
      * @brief Gets a reference to the root node of the skeleton.
@@ -213,6 +242,13 @@ public:
      */
     inline const cv::Vec3f &getHeadDir() const { return mHeadDir; }
 
+    /**
+     * @brief Gets the center of rotation (top of head) of the skeleton.
+     *
+     * @return The center of rotation.
+     */
+    inline const cv::Point3f &getRotationCenter() const { return mRotationCenter; }
+
     /**
      * @brief Returns a copy translated by translation
      * @param translation vector to add to each skeleton point
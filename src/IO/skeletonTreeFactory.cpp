@@ -19,6 +19,7 @@
 
 #include "vector.h"
 
+#include <array>
 #include <opencv2/core/matx.hpp>
 
 /**
@@ -33,47 +34,82 @@
  */
 SkeletonTree SkeletonTreeFactory::generateTree(const XSenseStruct &points)
 {
-    // Start from the root
-    SkeletonNode  root(0, points.mRoot);
-    SkeletonNode &neck = root.addChild(SkeletonNode(1, points.mNeck1));
+    std::array<cv::Point3f, XSENSE_JOINT_COUNT> joints;
+    generateJoints(points, joints);
+    return SkeletonTree::fromJoints(xsenseTopology(), joints, generateHeadDir(points), points.mHeadTop);
+}
 
-    // continue with the neck
-    SkeletonNode &neck2     = neck.addChild(SkeletonNode(19, points.mNeck2));
-    SkeletonNode &topOfHead = neck2.addChild(SkeletonNode(2, points.mHeadTop));
+/**
+ * @brief Returns the bone topology of skeletons from the XSense System.
+ *
+ * The root is the pelvis. The neck, left hip and right hip are its children. The neck continues with the head, the
+ * left arm and the right arm; the legs end at the toes.
+ *
+ * @return The topology used by generateTree() and generateJoints().
+ */
+const SkeletonTopology &SkeletonTreeFactory::xsenseTopology()
+{
+    static const SkeletonTopology topology{
+        /*.mIds =*/{0, 1, 19, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 20, 13, 14, 15, 16, 21, 17, 18},
+        /*.mParents =*/{-1, 0, 1, 2, 1, 4, 5, 6, 1, 8, 9, 10, 0, 12, 13, 14, 15, 0, 17, 18, 19, 20}};
+    return topology;
+}
 
-    // add the left arm
-    SkeletonNode &lShoulder = neck.addChild(SkeletonNode(3, points.mShldrL));
-    SkeletonNode &lElbow    = lShoulder.addChild(SkeletonNode(4, points.mElbowL));
-    SkeletonNode &lWrist    = lElbow.addChild(SkeletonNode(5, points.mWristL));
-    lWrist.addChild(SkeletonNode(6, points.mHandL));
+/**
+ * @brief Writes the joints of a skeleton from the XSense System in the order of xsenseTopology().
+ *
+ * This does the same as generateTree(), but without building a tree, so it can be used for every sample of a
+ * recording.
+ *
+ * @param[in] points  The struct with the data from the xsense system.
+ * @param[out] joints  The positions of the joints.
+ */
+void SkeletonTreeFactory::generateJoints(const XSenseStruct &points, std::span<cv::Point3f, XSENSE_JOINT_COUNT> joints)
+{
+    // Start from the root and continue with the neck and head
+    joints[0] = points.mRoot;
+    joints[1] = points.mNeck1;
+    joints[2] = points.mNeck2;
+    joints[3] = points.mHeadTop;
 
-    // add the right arm
-    SkeletonNode &rShoulder = neck.addChild(SkeletonNode(7, points.mShldrR));
-    SkeletonNode &rElbow    = rShoulder.addChild(SkeletonNode(8, points.mElbowR));
-    SkeletonNode &rWrist    = rElbow.addChild(SkeletonNode(9, points.mWristR));
-    rWrist.addChild(SkeletonNode(10, points.mHandR));
+    // left arm
+    joints[4] = points.mShldrL;
+    joints[5] = points.mElbowL;
+    joints[6] = points.mWristL;
+    joints[7] = points.mHandL;
 
-    // add the left leg
-    SkeletonNode &lHip   = root.addChild(SkeletonNode(11, points.mHipL));
-    SkeletonNode &lKnee  = lHip.addChild(SkeletonNode(12, points.mKneeL));
-    SkeletonNode &lAnkle = lKnee.addChild(SkeletonNode(20, points.mAnkleL));
-    SkeletonNode &lHeel  = lAnkle.addChild(SkeletonNode(13, points.mHeelL));
-    lHeel.addChild(SkeletonNode(14, points.mToeL));
+    // right arm
+    joints[8]  = points.mShldrR;
+    joints[9]  = points.mElbowR;
+    joints[10] = points.mWristR;
+    joints[11] = points.mHandR;
 
-    SkeletonNode &rHip   = root.addChild(SkeletonNode(15, points.mHipR));
-    SkeletonNode &rKnee  = rHip.addChild(SkeletonNode(16, points.mKneeR));
-    SkeletonNode &rAnkle = rKnee.addChild(SkeletonNode(21, points.mAnkleR));
-    SkeletonNode &rHeel  = rAnkle.addChild(SkeletonNode(17, points.mHeelR));
-    rHeel.addChild(SkeletonNode(18, points.mToeR));
+    // left leg
+    joints[12] = points.mHipL;
+    joints[13] = points.mKneeL;
+    joints[14] = points.mAnkleL;
+    joints[15] = points.mHeelL;
+    joints[16] = points.mToeL;
 
+    // right leg
+    joints[17] = points.mHipR;
+    joints[18] = points.mKneeR;
+    joints[19] = points.mAnkleR;
+    joints[20] = points.mHeelR;
+    joints[21] = points.mToeR;
+}
 
-    // calculate view direction of the head
+/**
+ * @brief Calculates the view direction of the head.
+ *
+ * @param[in] points  The struct with the data from the xsense system.
+ *
+ * @return The (not normalized) direction the head is facing to.
+ */
+cv::Vec3f SkeletonTreeFactory::generateHeadDir(const XSenseStruct &points)
+{
     cv::Point3f headUp      = points.mHeadTop - points.mNeck2;
     cv::Point3f rightVector = points.mEarR - points.mEarL;
     // the direction is calculated using the cross product
-    cv::Point3f dir = headUp.cross(rightVector);
-
-    SkeletonTree skeleton(std::move(root), dir, topOfHead.getPos());
-
-    return skeleton;
+    return headUp.cross(rightVector);
 }
@@ -22,6 +22,7 @@
 #include "skeletonTree.h"
 
 #include <opencv2/core/types.hpp>
+#include <span>
 
 /**
  * @brief This struct defines all the points needed to construct a skeleton from a person.
@@ -82,7 +83,12 @@ struct XSenseStruct
 class SkeletonTreeFactory
 {
 public:
-    static SkeletonTree generateTree(const XSenseStruct &points);
+    static constexpr size_t XSENSE_JOINT_COUNT = 22;
+
+    static SkeletonTree            generateTree(const XSenseStruct &points);
+    static const SkeletonTopology &xsenseTopology();
+    static void      generateJoints(const XSenseStruct &points, std::span<cv::Point3f, XSENSE_JOINT_COUNT> joints);
+    static cv::Vec3f generateHeadDir(const XSenseStruct &points);
 };
 
 #endif
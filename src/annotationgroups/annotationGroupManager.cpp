@@ -23,11 +23,40 @@
 #include "personStorage.h"
 #include "petrack.h"
 
+#include <QSignalBlocker>
+#include <algorithm>
 #include <utility>
 
 using namespace std;
 using namespace annotationGroups;
 
+namespace
+{
+/**
+ * Entries of all intervals of one trajectory, ordered by their start frame.
+ * The last interval has no end (-1).
+ */
+std::vector<TrajectoryGroupEntry> entriesOfTrajectory(const IntervalList<int> &groupList, int trajectory)
+{
+    const auto                       &entries = groupList.getEntries();
+    std::vector<TrajectoryGroupEntry> result;
+    result.reserve(entries.size());
+    for(size_t k = 0; k < entries.size(); ++k)
+    {
+        const int end = (k + 1 < entries.size()) ? entries[k + 1].start - 1 : -1;
+        result.push_back({entries[k].data, trajectory, entries[k].start, end});
+    }
+    return result;
+}
+} // namespace
+
+AnnotationGroupManager::AnnotationGroupManager(Petrack &petrack, Animation &animation, PersonStorage &personStorage) :
+    mPetrack(petrack), mAnimation(animation), mPersonStorage(personStorage)
+{
+    initDefaultGroups();
+    connect(&mPersonStorage, &PersonStorage::splitPersonAtFrame, this, &AnnotationGroupManager::onSplitPerson);
+}
+
 
 bool AnnotationGroupManager::addTrajectoryToGroup(size_t trajectory, int groupId, int frame)
 {
@@ -39,10 +68,12 @@ bool AnnotationGroupManager::addTrajectoryToGroup(size_t trajectory, int groupId
     {
         return false;
     }
+    groupIndex(); // bring the index up to date before changing the list
     auto &list  = mPersonStorage.getGroupList(trajectory);
     auto &group = mGroups.at(groupId);
 
     list.insert(frame, group.id);
+    reindexTrajectory(trajectory);
 
     emit trajectoryAssignmentChanged();
     return true;
@@ -67,12 +98,36 @@ bool AnnotationGroupManager::removeTrajectoryAssignment(size_t trajectory, int f
         return false;
     }
 
+    groupIndex();
     auto &list = mPersonStorage.getGroupList(trajectory);
     list.insert(frame, NO_GROUP.id);
+    reindexTrajectory(trajectory);
     emit trajectoryAssignmentChanged();
     return true;
 }
 
+std::vector<size_t> AnnotationGroupManager::addTrajectoriesToGroup(const std::vector<size_t> &trajectories, int groupId)
+{
+    std::vector<size_t> failed;
+    {
+        const QSignalBlocker blocker(this);
+        for(const size_t trajectory : trajectories)
+        {
+            const bool success = (groupId == NO_GROUP.id) ? removeTrajectoryAssignment(trajectory) :
+                                                            addTrajectoryToGroup(trajectory, groupId);
+            if(!success)
+            {
+                failed.push_back(trajectory);
+            }
+        }
+    }
+    if(failed.size() < trajectories.size())
+    {
+        emit trajectoryAssignmentChanged();
+    }
+    return failed;
+}
+
 void AnnotationGroupManager::addGroupToTopLevelGroup(int groupId, int tlgId)
 {
     if(isValidGroupId(groupId) && isValidTopLevelGroupId(tlgId))
@@ -174,6 +229,7 @@ void AnnotationGroupManager::loadConfig(const annotationGroups::GroupConfigurati
     {
         mPersonStorage.getGroupList(i).clear();
     }
+    mGroupIndexValid = false;
 
     for(const auto &entry : config.mTopLevelGroups)
     {
@@ -331,31 +387,120 @@ void AnnotationGroupManager::initDefaultGroups()
 
 std::vector<annotationGroups::TrajectoryGroupEntry> AnnotationGroupManager::getTrajectoriesOfGroup(int groupId) const
 {
-    std::vector<annotationGroups::TrajectoryGroupEntry> trajectories;
+    const auto &index = groupIndex();
+    if(auto it = index.find(groupId); it != index.end())
+    {
+        return it->second;
+    }
+    return {};
+}
+
+size_t AnnotationGroupManager::getTrajectoryCountOfGroup(int groupId) const
+{
+    const auto &index = groupIndex();
+    if(auto it = index.find(groupId); it != index.end())
+    {
+        return it->second.size();
+    }
+    return 0;
+}
 
-    for(size_t i = 0; i < mPersonStorage.nbPersons(); i++)
+/**
+ * Get the reverse index of the group assignments.
+ *
+ * The index is rebuilt, if the persons were replaced in the PersonStorage since it was built. Trajectories appended
+ * by the tracking or the recognition are added to it.
+ */
+const AnnotationGroupManager::GroupIndex &AnnotationGroupManager::groupIndex() const
+{
+    const size_t nbPersons = mPersonStorage.nbPersons();
+    if(!mGroupIndexValid || mGroupIndexRevision != mPersonStorage.getRevision() ||
+       mGroupsOfTrajectory.size() > nbPersons)
+    {
+        rebuildGroupIndex();
+    }
+    for(size_t i = mGroupsOfTrajectory.size(); i < nbPersons; ++i)
     {
-        const auto &groupList = mPersonStorage.getGroupList(i);
-        const auto &entries   = groupList.getEntries();
+        reindexTrajectory(i);
+    }
+    return mGroupIndex;
+}
+
+void AnnotationGroupManager::rebuildGroupIndex() const
+{
+    mGroupIndex.clear();
+    mGroupsOfTrajectory.assign(mPersonStorage.nbPersons(), {});
 
-        for(size_t k = 0; k < entries.size() - 1; ++k)
+    for(size_t i = 0; i < mPersonStorage.nbPersons(); ++i)
+    {
+        auto &groups = mGroupsOfTrajectory[i];
+        for(const auto &entry : entriesOfTrajectory(mPersonStorage.getGroupList(i), static_cast<int>(i)))
         {
-            const auto &entry = entries.at(k);
+            mGroupIndex[entry.groupId].push_back(entry);
+            groups.push_back(entry.groupId);
+        }
+        std::sort(groups.begin(), groups.end());
+        groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+    }
 
-            if(entry.data == groupId)
-            {
-                const auto &next = entries.at(k + 1);
-                trajectories.push_back({groupId, (int) i, entry.start, next.start - 1});
-            }
+    mGroupIndexValid    = true;
+    mGroupIndexRevision = mPersonStorage.getRevision();
+}
+
+/**
+ * Replace the entries of one trajectory in the group index by the ones of its current group list.
+ *
+ * Only the groups the trajectory was or is assigned to are touched.
+ */
+void AnnotationGroupManager::reindexTrajectory(size_t trajectory) const
+{
+    if(!mGroupIndexValid)
+    {
+        return;
+    }
+    if(trajectory >= mGroupsOfTrajectory.size())
+    {
+        mGroupsOfTrajectory.resize(trajectory + 1);
+    }
+
+    const int id           = static_cast<int>(trajectory);
+    auto      byTrajectory = [](const TrajectoryGroupEntry &entry, int trajectoryId)
+    { return entry.trackPersonId < trajectoryId; };
+
+    auto &groups = mGroupsOfTrajectory[trajectory];
+    for(const int groupId : groups)
+    {
+        auto &entries = mGroupIndex[groupId];
+        auto  first   = std::lower_bound(entries.begin(), entries.end(), id, byTrajectory);
+        auto  last    = std::lower_bound(first, entries.end(), id + 1, byTrajectory);
+        entries.erase(first, last);
+        if(entries.empty())
+        {
+            mGroupIndex.erase(groupId);
         }
-        if(entries.back().data == groupId)
+    }
+    groups.clear();
+
+    for(const auto &entry : entriesOfTrajectory(mPersonStorage.getGroupList(trajectory), id))
+    {
+        auto &entries = mGroupIndex[entry.groupId];
+        // behind the entries of this trajectory inserted before, which have smaller start frames
+        auto pos = std::lower_bound(entries.begin(), entries.end(), id + 1, byTrajectory);
+        entries.insert(pos, entry);
+        if(std::find(groups.begin(), groups.end(), entry.groupId) == groups.end())
         {
-            trajectories.push_back({groupId, (int) i, entries.back().start, -1});
+            groups.push_back(entry.groupId);
         }
     }
+}
 
-    return trajectories;
+void AnnotationGroupManager::onSplitPerson(size_t index, size_t newIndex, int /*frame*/)
+{
+    groupIndex(); // indexes the appended trajectory
+    reindexTrajectory(index);
+    reindexTrajectory(newIndex);
 }
+
 void AnnotationGroupManager::deleteGroup(int id)
 {
     // early return when group is not present to prevent calculation and signal
@@ -380,6 +525,7 @@ void AnnotationGroupManager::deleteGroup(int id)
     for(const auto &p : people)
     {
         mPersonStorage.getGroupList(p).compact();
+        reindexTrajectory(p);
     }
     emit groupsChanged();
 }
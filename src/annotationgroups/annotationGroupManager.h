@@ -41,6 +41,8 @@ class AnnotationGroupManager : public QObject
 {
     Q_OBJECT
 private:
+    using GroupIndex = std::map<int, std::vector<annotationGroups::TrajectoryGroupEntry>>;
+
     Petrack         &mPetrack;
     const Animation &mAnimation;
     PersonStorage   &mPersonStorage;
@@ -54,12 +56,15 @@ private:
     bool         mVisualization       = false;
     unsigned int mVisualizationRadius = 50;
 
+    // reverse index of the assignments: group id -> entries, sorted by trajectory and start frame
+    mutable GroupIndex mGroupIndex;
+    // ids of the groups (including NO_GROUP) each trajectory is assigned to, i.e. its keys in mGroupIndex
+    mutable std::vector<std::vector<int>> mGroupsOfTrajectory;
+    mutable bool                          mGroupIndexValid    = false;
+    mutable size_t                        mGroupIndexRevision = 0; ///< PersonStorage revision of mGroupIndex
+
 public:
-    AnnotationGroupManager(Petrack &petrack, Animation &animation, PersonStorage &personStorage) :
-        mPetrack(petrack), mAnimation(animation), mPersonStorage(personStorage)
-    {
-        initDefaultGroups();
-    }
+    AnnotationGroupManager(Petrack &petrack, Animation &animation, PersonStorage &personStorage);
 
     /**
      * Add a trajectory to a group at the current frame.
@@ -86,6 +91,14 @@ public:
     bool removeTrajectoryAssignment(size_t trajectory);
     bool removeTrajectoryAssignment(size_t trajectory, int frame);
 
+    /**
+     * Add several trajectories to a group at the current frame. For NO_GROUP their assignments are removed.
+     * trajectoryAssignmentChanged is emitted only once.
+     *
+     * @return the trajectories which could not be assigned
+     */
+    std::vector<size_t> addTrajectoriesToGroup(const std::vector<size_t> &trajectories, int groupId);
+
 
     void addGroupToTopLevelGroup(int groupId, int tlgId);
     void addGroupToTopLevelGroup(annotationGroups::Group &group, int tlgId);
@@ -98,6 +111,11 @@ public:
      */
     std::vector<annotationGroups::TrajectoryGroupEntry> getTrajectoriesOfGroup(int groupId) const;
 
+    /**
+     * Get the number of entries getTrajectoriesOfGroup would return, without copying them.
+     */
+    size_t getTrajectoryCountOfGroup(int groupId) const;
+
     bool isValidGroupId(int id) const;
 
     /**
@@ -183,6 +201,11 @@ private:
     annotationGroups::Group &createGroup(int id, const std::string &name, const std::string &type);
 
     void initDefaultGroups();
+
+    const GroupIndex &groupIndex() const;
+    void              rebuildGroupIndex() const;
+    void              reindexTrajectory(size_t trajectory) const;
+    void              onSplitPerson(size_t index, size_t newIndex, int frame);
 };
 
 
@@ -26,6 +26,10 @@
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QProgressDialog>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
 #include <opencv2/highgui.hpp>
 
 /// definieren, wenn das Schachbrett im Mainwindow und nicht separat angezeigt werden soll:
@@ -44,6 +48,16 @@ AutoCalib::AutoCalib()
 
 AutoCalib::~AutoCalib() {}
 
+namespace
+{
+/// frame of the calibration video, which is searched for a chessboard by one of the worker threads
+struct CalibCandidate
+{
+    cv::Mat                      view;
+    std::optional<calib::Sample> sample;
+};
+} // namespace
+
 void AutoCalib::setMainWindow(Petrack *mw)
 {
     mMainWindow = mw;
@@ -338,21 +352,50 @@ bool AutoCalib::isGoodSample(
     return minDifference > 0.1 || diffCoverage > 0.1;
 }
 
+/**
+ * @brief Searches a chessboard in view and evaluates it as calibration sample
+ *
+ * Only reads its arguments, so it can be called for several frames in parallel.
+ *
+ * @param view[in] frame of the calibration video
+ * @param boardSize[in] Size of the chessboard (width x height in squares)
+ * @param gridSize[in] Number of grid divisions along each axis used for the coverage
+ * @return sample without subpixel refinement or std::nullopt, if no chessboard was found
+ */
+std::optional<calib::Sample> AutoCalib::detectSample(const cv::Mat &view, cv::Size boardSize, int gridSize)
+{
+    std::vector<cv::Point2f> corners;
+    if(!cv::findChessboardCorners(view, boardSize, corners, cv::CALIB_CB_ADAPTIVE_THRESH))
+    {
+        return std::nullopt;
+    }
+
+    calib::Sample sample;
+    sample.corners = corners;
+    // evaluate how good the frame is (balance between x and y distribution, varying coverage, skew)
+    auto outerCorners = getOuterChessboardCorners(corners, boardSize);
+    sample.area       = calcInnerAreaOfChessboard(outerCorners) / view.size().area();
+    sample.skew       = calcSkewOfChessboard(outerCorners);
+    sample.coverage   = calcXYCoverage(corners, view.size(), gridSize);
+    return sample;
+}
+
 /**
  * @brief Analyzes a video to find and save frames with good chessboard samples
  *
  * Processes the video frame by frame, detects chessboard corners, evaluates their quality,
  * and saves good samples as images.
  *
+ * The video is decoded sequentially, as seeking is slow for most codecs. Every stepSize-th frame is a candidate; the
+ * chessboard search of a batch of candidates runs on the global thread pool while the next batch is decoded. The
+ * candidates are then judged in frame order, so the selected samples are the same as with a serial search.
+ *
  * @param boardSize[in] Size of the chessboard (width x height in squares)
  */
 void AutoCalib::findGoodCalibrationSamplesFromVideo(cv::Size boardSize)
 {
-    cv::Mat                    view, viewGray;
-    bool                       found = false;
+    cv::Mat                    viewGray;
     cv::Mat                    origImg;
-    cv::Size                   imgSize;
-    std::vector<cv::Point2f>   corners;
     std::vector<calib::Sample> goodSamples;
     int                        stepSize = 10;
     cv::VideoCapture           video(mCalibVideo.toStdString());
@@ -386,76 +429,92 @@ void AutoCalib::findGoodCalibrationSamplesFromVideo(cv::Size boardSize)
         origImg = mMainWindow->getImg().clone();
     }
 
-    QProgressDialog progress(
-        "Searching for good samples...",
-        "Abort search",
-        0,
-        video.get(cv::CAP_PROP_FRAME_COUNT) / stepSize,
-        mMainWindow);
+    const int       frameCount = static_cast<int>(video.get(cv::CAP_PROP_FRAME_COUNT));
+    QProgressDialog progress("Searching for good samples...", "Abort search", 0, frameCount / stepSize, mMainWindow);
     progress.setWindowModality(Qt::WindowModal); // blocks main window
     int               gridSize = 10;
     std::vector<bool> totalCovered(gridSize * gridSize);
-    // search for chessbord corners in every image
-    for(int i = 0; i < video.get(cv::CAP_PROP_FRAME_COUNT); i += stepSize)
+
+    // one candidate per worker thread keeps the number of decoded frames in memory low
+    const size_t batchSize = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    int          frame     = 0;
+    auto         readBatch = [&]()
     {
-        progress.setValue(i / stepSize);
-        qApp->processEvents();
-        if(progress.wasCanceled())
+        std::vector<CalibCandidate> batch;
+        for(; frame < frameCount && batch.size() < batchSize; ++frame)
         {
-            break;
+            if(!video.grab())
+            {
+                frame = frameCount;
+                break;
+            }
+            if(frame % stepSize == 0)
+            {
+                CalibCandidate candidate;
+                video.retrieve(candidate.view);
+                // cannot load image
+                if(candidate.view.empty())
+                {
+                    frame = frameCount;
+                    break;
+                }
+                batch.push_back(std::move(candidate));
+            }
         }
+        return batch;
+    };
+    auto detect = [&](CalibCandidate &candidate)
+    { candidate.sample = detectSample(candidate.view, boardSize, gridSize); };
+
+    // search for chessbord corners in every candidate
+    std::vector<CalibCandidate> inFlight  = readBatch();
+    QFuture<void>               detection = QtConcurrent::map(inFlight, detect);
+    while(!inFlight.empty())
+    {
+        // decoding the next batch overlaps with the search in the current one
+        std::vector<CalibCandidate> nextBatch = readBatch();
+        detection.waitForFinished();
 
-        video.set(cv::CAP_PROP_POS_FRAMES, i);
-        video >> view;
-        // cannot load image
-        if(view.empty())
+        for(auto &candidate : inFlight)
         {
-            progress.setValue(video.get(cv::CAP_PROP_FRAME_COUNT) / stepSize);
-            // reset view to animation image
-            if(!origImg.empty())
+            if(!candidate.sample || !isGoodSample(goodSamples, *candidate.sample, totalCovered))
             {
-                mMainWindow->updateImage(origImg); // now the last view will be deleted
+                continue;
             }
-            break;
+            calib::Sample &sample = *candidate.sample;
+            cv::Mat       &view   = candidate.view;
+            cv::cvtColor(view, viewGray, cv::COLOR_BGR2GRAY);
+            cv::cornerSubPix(
+                viewGray,
+                sample.corners,
+                cv::Size(11, 11),
+                cv::Size(-1, -1),
+                cv::TermCriteria(CV_TERMCRIT_EPS + CV_TERMCRIT_ITER, 30, 0.1));
+            goodSamples.push_back(sample);
+            totalCovered = mergeCoverages(totalCovered, sample.coverage);
+
+            // handle Output
+            QString outputPath = QString("%1/%2.png").arg(outputDir).arg(goodSamples.size());
+            cv::imwrite(outputPath.toStdString(), view);
+            calibFiles.push_back(outputPath);
+
+            cv::drawChessboardCorners(view, boardSize, sample.corners, true);
+            progress.setLabelText(
+                QString("Searching for good samples... \n Samples found: %1").arg(goodSamples.size()));
+            mMainWindow->updateImage(view);
         }
-        imgSize = cv::Size(video.get(cv::CAP_PROP_FRAME_WIDTH), video.get(cv::CAP_PROP_FRAME_HEIGHT));
 
-        found = cv::findChessboardCorners(view, boardSize, corners, cv::CALIB_CB_ADAPTIVE_THRESH);
-        if(found)
+        progress.setValue(frame / stepSize);
+        qApp->processEvents();
+        if(progress.wasCanceled())
         {
-            calib::Sample sample;
-            sample.corners = corners;
-            // evaluate how good the frame is (balance between x and y distribution, varying coverage, skew)
-            auto outerCorners = getOuterChessboardCorners(corners, boardSize);
-            sample.area       = calcInnerAreaOfChessboard(outerCorners) / imgSize.area();
-            sample.skew       = calcSkewOfChessboard(outerCorners);
-            sample.coverage   = calcXYCoverage(corners, imgSize, gridSize);
-
-            if(isGoodSample(goodSamples, sample, totalCovered))
-            {
-                cv::cvtColor(view, viewGray, cv::COLOR_BGR2GRAY);
-                cv::cornerSubPix(
-                    viewGray,
-                    sample.corners,
-                    cv::Size(11, 11),
-                    cv::Size(-1, -1),
-                    cv::TermCriteria(CV_TERMCRIT_EPS + CV_TERMCRIT_ITER, 30, 0.1));
-                goodSamples.push_back(sample);
-                totalCovered = mergeCoverages(totalCovered, sample.coverage);
-
-                // handle Output
-                QString outputPath = QString("%1/%2.png").arg(outputDir).arg(goodSamples.size());
-                cv::imwrite(outputPath.toStdString(), view);
-                calibFiles.push_back(outputPath);
-
-                cv::drawChessboardCorners(view, boardSize, sample.corners, found);
-                progress.setLabelText(
-                    QString("Searching for good samples... \n Samples found: %1").arg(goodSamples.size()));
-                mMainWindow->updateImage(view);
-                qApp->processEvents();
-            }
+            break;
         }
+        inFlight  = std::move(nextBatch);
+        detection = QtConcurrent::map(inFlight, detect);
     }
+    progress.setValue(frameCount / stepSize);
+
     if(calibFiles.empty())
     {
         PCritical(
@@ -483,6 +542,9 @@ void AutoCalib::findGoodCalibrationSamplesFromVideo(cv::Size boardSize)
  * detection is successful at least in one image, the detected points are used
  * for the intrinsic calibration of the camera.
  *
+ * The refined corners are cached per file, so recalibrating with other flags skips the detection. The old and the
+ * extended model are calibrated concurrently.
+ *
  * @param quadAspectRatio whether to fix the aspect ratio
  * @param fixCenter whether to fix the center/focal point
  * @param tangDist whether to use non-zero tangential distortion
@@ -547,57 +609,67 @@ std::optional<IntrinsicModelsParameters> AutoCalib::autoCalib(bool quadAspectRat
             }
 
 
-            // cannot load image
-            view = cv::imread(mCalibFiles.at(i).toStdString(), cv::IMREAD_COLOR);
-            if(view.empty())
+            // corners of unchanged files are taken from the last run, so only changed calibration flags are cheap
+            const QFileInfo calibFile{mCalibFiles.at(i)};
+            auto            cached = mCornerCache.find(calibFile.absoluteFilePath());
+            if(cached == mCornerCache.end() || cached->second.lastModified != calibFile.lastModified() ||
+               cached->second.boardSize != board_size)
             {
-                progress.setValue(mCalibFiles.size());
-                PCritical(
-                    mMainWindow,
-                    Petrack::tr("Petrack"),
-                    Petrack::tr("Cannot load %1.\nTerminate Calibration.").arg(mCalibFiles.at(i)));
-#ifdef SHOW_CALIB_MAINWINDOW
-                // reset view to animation image
-                if(!origImg.empty())
+                // cannot load image
+                view = cv::imread(mCalibFiles.at(i).toStdString(), cv::IMREAD_COLOR);
+                if(view.empty())
                 {
-                    mMainWindow->updateImage(origImg); // now the last view will be deleted
-                }
+                    progress.setValue(mCalibFiles.size());
+                    PCritical(
+                        mMainWindow,
+                        Petrack::tr("Petrack"),
+                        Petrack::tr("Cannot load %1.\nTerminate Calibration.").arg(mCalibFiles.at(i)));
+#ifdef SHOW_CALIB_MAINWINDOW
+                    // reset view to animation image
+                    if(!origImg.empty())
+                    {
+                        mMainWindow->updateImage(origImg); // now the last view will be deleted
+                    }
 #endif
-                return std::nullopt;
-            }
+                    return std::nullopt;
+                }
 
-            // muss nur bei einem bild gemacht werden
-            if(i == 0)
-            {
-                imgSize = cv::Size(view.rows, view.cols);
-            }
-            // search for chessboard corners
-            found = findChessboardCorners(view, board_size, corners, cv::CALIB_CB_ADAPTIVE_THRESH);
+                calib::CachedCorners entry{calibFile.lastModified(), board_size, view.size(), {}};
+                // search for chessboard corners
+                found = findChessboardCorners(view, board_size, corners, cv::CALIB_CB_ADAPTIVE_THRESH);
 
-            if(found)
-            {
-                // improve the found corners' coordinate accuracy
-                cv::cvtColor(view, view_gray, cv::COLOR_BGR2GRAY);
-                cv::cornerSubPix(
-                    view_gray,
-                    corners,
-                    cv::Size(11, 11),
-                    cv::Size(-1, -1),
-                    cv::TermCriteria(CV_TERMCRIT_EPS + CV_TERMCRIT_ITER, 30, 0.1));
-
-                image_points.push_back(corners);
-                drawChessboardCorners(view, board_size, corners, found);
+                if(found)
+                {
+                    // improve the found corners' coordinate accuracy
+                    cv::cvtColor(view, view_gray, cv::COLOR_BGR2GRAY);
+                    cv::cornerSubPix(
+                        view_gray,
+                        corners,
+                        cv::Size(11, 11),
+                        cv::Size(-1, -1),
+                        cv::TermCriteria(CV_TERMCRIT_EPS + CV_TERMCRIT_ITER, 30, 0.1));
+
+                    entry.corners = corners;
+                    drawChessboardCorners(view, board_size, corners, found);
 
 #ifndef SHOW_CALIB_MAINWINDOW
-                namedWindow("img", CV_WINDOW_AUTOSIZE); // 0 wenn skalierbar sein soll
-                imShow("img", view);
-                // cvWaitKey( 0 ); // zahl statt null, wenn nach bestimmter zeit weitergegangen werden soll
+                    namedWindow("img", CV_WINDOW_AUTOSIZE); // 0 wenn skalierbar sein soll
+                    imShow("img", view);
+                    // cvWaitKey( 0 ); // zahl statt null, wenn nach bestimmter zeit weitergegangen werden soll
 #endif
 #ifdef SHOW_CALIB_MAINWINDOW
-                // show image in view to show calculation
-                mMainWindow->updateImage(view);
+                    // show image in view to show calculation
+                    mMainWindow->updateImage(view);
 #endif
-                qApp->processEvents(); // to allow events and update sceen for viewing new image
+                    qApp->processEvents(); // to allow events and update sceen for viewing new image
+                }
+                cached = mCornerCache.insert_or_assign(calibFile.absoluteFilePath(), entry).first;
+            }
+
+            imgSize = cached->second.imageSize;
+            if(!cached->second.corners.empty())
+            {
+                image_points.push_back(cached->second.corners);
                 min_one_pattern_found = true;
             }
             else
@@ -631,16 +703,39 @@ std::optional<IntrinsicModelsParameters> AutoCalib::autoCalib(bool quadAspectRat
             flags |= CV_CALIB_ZERO_TANGENT_DIST;
         }
 
-        bool ok = runCalibration(
-            image_points,
-            view.size(),
-            board_size,
-            square_size,
-            aspect_ratio,
-            flags,
-            camera_matrix,
-            distortion_coeffs,
-            &reproj_errs);
+        const int extFlags = flags | CV_CALIB_RATIONAL_MODEL | CV_CALIB_THIN_PRISM_MODEL | CV_CALIB_TILTED_MODEL;
+
+        // both models are calibrated with the same points independently of each other
+        QFuture<int> oldModel = QtConcurrent::run(
+            [&]()
+            {
+                return runCalibration(
+                    image_points,
+                    imgSize,
+                    board_size,
+                    square_size,
+                    aspect_ratio,
+                    flags,
+                    camera_matrix,
+                    distortion_coeffs,
+                    &reproj_errs);
+            });
+        QFuture<int> extModel = QtConcurrent::run(
+            [&]()
+            {
+                return runCalibration(
+                    image_points,
+                    imgSize,
+                    board_size,
+                    square_size,
+                    aspect_ratio,
+                    extFlags,
+                    camera_matrix_ext,
+                    distortion_coeffs_ext,
+                    &reproj_errs_ext);
+            });
+        bool ok     = oldModel.result();
+        bool ok_ext = extModel.result();
 
         SPDLOG_INFO("OLD MODEL CALIBRATION");
         SPDLOG_INFO("{}", ok ? "Calibration succeeded." : "Calibration failed.");
@@ -672,19 +767,6 @@ std::optional<IntrinsicModelsParameters> AutoCalib::autoCalib(bool quadAspectRat
         SPDLOG_INFO("taux: {} tauy: {}", distortion_coeffs.at<double>(0, 12), distortion_coeffs.at<double>(0, 13));
 
 
-        flags |= CV_CALIB_RATIONAL_MODEL + CV_CALIB_THIN_PRISM_MODEL + CV_CALIB_TILTED_MODEL;
-
-        bool ok_ext = runCalibration(
-            image_points,
-            view.size(),
-            board_size,
-            square_size,
-            aspect_ratio,
-            flags,
-            camera_matrix_ext,
-            distortion_coeffs_ext,
-            &reproj_errs_ext);
-
         SPDLOG_INFO("NEW MODEL CALIBRATION");
         SPDLOG_INFO("{}", ok_ext ? "Calibration succeeded." : "Calibration failed.");
         SPDLOG_INFO("Intrinsic reprojection error is: {:f}", reproj_errs_ext);
@@ -21,8 +21,11 @@
 
 #include "intrinsicCameraParams.h"
 
+#include <QDateTime>
 #include <QString>
 #include <QStringList>
+#include <map>
+#include <opencv2/core/mat.hpp>
 #include <opencv2/core/types.hpp>
 #include <optional>
 
@@ -45,6 +48,15 @@ struct Sample
         return diff;
     }
 };
+
+/// refined chessboard corners of a calibration image; valid as long as the file and the board size do not change
+struct CachedCorners
+{
+    QDateTime                lastModified;
+    cv::Size                 boardSize;
+    cv::Size                 imageSize;
+    std::vector<cv::Point2f> corners; ///< empty, if no chessboard was found
+};
 } // namespace calib
 
 
@@ -118,6 +130,9 @@ private:
     int                      getCovered(std::vector<bool> covered);
     std::vector<bool>        calcXYCoverage(std::vector<cv::Point2f> &corners, cv::Size imageSize, int gridSize);
     bool isGoodSample(std::vector<calib::Sample> &goodSamples, calib::Sample &sample, std::vector<bool> &totalCoverage);
+
+    std::optional<calib::Sample> detectSample(const cv::Mat &view, cv::Size boardSize, int gridSize);
+
     void findGoodCalibrationSamplesFromVideo(cv::Size boardSize);
     int  runCalibration(
          std::vector<std::vector<cv::Point2f>> corners,
@@ -136,6 +151,8 @@ private:
     int         mBoardSizeX, mBoardSizeY;
     float       mSquareSize;
     QString     mLastDir;
+
+    std::map<QString, calib::CachedCorners> mCornerCache; ///< keyed by absolute file path
 };
 
 #endif
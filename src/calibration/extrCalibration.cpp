@@ -838,9 +838,9 @@ cv::Point3f ExtrCalibration::get3DPoint(const cv::Point2f &p2d, double h) const
 }
 
 
-cv::Point3f ExtrCalibration::get3DPoint(const cv::Point2f &p2d, double h, const ExtrinsicParameters &extrParams) const
+cv::Point3f CalibrationSnapshot::get3DPoint(const cv::Point2f &p2d, double h) const
 {
-    int bS = mMainWindow->getImage() ? mMainWindow->getImageBorderSize() : 0;
+    const int bS = borderSize;
 
     cv::Point3f resultPoint, tmpPoint;
 
@@ -854,12 +854,6 @@ cv::Point3f ExtrCalibration::get3DPoint(const cv::Point2f &p2d, double h, const
     // Create translation vector
     cv::Vec3d translation{extrParams.trans1, extrParams.trans2, extrParams.trans3};
 
-    const auto camMat = mControlWidget->getIntrinsicCameraParams();
-    const auto fx     = camMat.getFx();
-    const auto fy     = camMat.getFy();
-    const auto cx     = camMat.getCx();
-    const auto cy     = camMat.getCy();
-
     // Subtract principal point and border, so we can assume pinhole camera
     const cv::Vec2d centeredImagePoint{p2d.x - (cx - bS), p2d.y - (cy - bS)};
 
@@ -923,17 +917,79 @@ cv::Point3f ExtrCalibration::get3DPoint(const cv::Point2f &p2d, double h, const
 
 
     // Coordinate Transformations
-    auto trans = mControlWidget->getCalibCoord3DTrans();
-    resultPoint -= trans.toCvPoint();
+    resultPoint -= coord3DTrans;
 
-    auto swap = mControlWidget->getCalibCoord3DSwap();
-    resultPoint.x *= swap.x ? -1 : 1;
-    resultPoint.y *= swap.y ? -1 : 1;
-    resultPoint.z *= swap.z ? -1 : 1;
+    resultPoint.x *= coord3DSwap[0] ? -1 : 1;
+    resultPoint.y *= coord3DSwap[1] ? -1 : 1;
+    resultPoint.z *= coord3DSwap[2] ? -1 : 1;
 
     return resultPoint;
 }
 
+/**
+ * @brief Returns the side length of a pixel at (px, py) at height h in cm, see CoordinateSystemBox::getCmPerPixel()
+ */
+QPointF CalibrationSnapshot::getCmPerPixel(float px, float py, float h) const
+{
+    cv::Point3f p3x1 = get3DPoint(cv::Point2f(px - 0.5, py), h);
+    cv::Point3f p3x2 = get3DPoint(cv::Point2f(px + 0.5, py), h);
+
+    cv::Point3f p3y1 = get3DPoint(cv::Point2f(px, py - 0.5), h);
+    cv::Point3f p3y2 = get3DPoint(cv::Point2f(px, py + 0.5), h);
+
+    return QPointF(norm(p3x1 - p3x2), norm(p3y1 - p3y2));
+}
+
+/**
+ * @brief Returns the angle between the line from the camera to (px, py) at the given height and the ground
+ *
+ * See CoordinateSystemBox::getAngleToGround(); the point contains the border.
+ */
+double CalibrationSnapshot::getAngleToGround(float px, float py, float height) const
+{
+    cv::Point3f cam(
+        -coord3DTrans.x - extrParams.trans1, -coord3DTrans.y - extrParams.trans2, -coord3DTrans.z - extrParams.trans3);
+
+    cv::Point3f posInImage = get3DPoint(cv::Point2f(px - borderSize, py - borderSize), height);
+
+    cv::Point3f a(cam.x - posInImage.x, cam.y - posInImage.y, cam.z - posInImage.z), b(0, 0, 1);
+
+    // NOTE: in C++20 can be replaced with numbers import
+    const double pi = std::atan(1.0) * 4;
+    return asin(
+               (a.x * b.x + a.y * b.y + a.z * b.z) / (abs(sqrt(pow(a.x, 2) + pow(a.y, 2) + pow(a.z, 2))) *
+                                                      abs(sqrt(pow(b.x, 2) + pow(b.y, 2) + pow(b.z, 2))))) *
+           180 / pi;
+}
+
+cv::Point3f ExtrCalibration::get3DPoint(const cv::Point2f &p2d, double h, const ExtrinsicParameters &extrParams) const
+{
+    auto calibration       = snapshot();
+    calibration.extrParams = extrParams;
+    return calibration.get3DPoint(p2d, h);
+}
+
+/**
+ * @brief Copies the current calibration from the widgets; must be called from the GUI thread
+ */
+CalibrationSnapshot ExtrCalibration::snapshot() const
+{
+    CalibrationSnapshot calibration;
+    calibration.extrParams = mControlWidget->getExtrinsicParameters();
+
+    const auto camMat = mControlWidget->getIntrinsicCameraParams();
+    calibration.fx    = camMat.getFx();
+    calibration.fy    = camMat.getFy();
+    calibration.cx    = camMat.getCx();
+    calibration.cy    = camMat.getCy();
+
+    calibration.borderSize   = mMainWindow->getImage() ? mMainWindow->getImageBorderSize() : 0;
+    calibration.coord3DTrans = mControlWidget->getCalibCoord3DTrans().toCvPoint();
+    const auto swap          = mControlWidget->getCalibCoord3DSwap();
+    calibration.coord3DSwap  = {swap.x, swap.y, swap.z};
+    return calibration;
+}
+
 bool ExtrCalibration::isOutsideImage(cv::Point2f p2d) const
 {
     int bS = mMainWindow->getImage() ? mMainWindow->getImageBorderSize() : 0;
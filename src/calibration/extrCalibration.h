@@ -22,6 +22,7 @@
 #include "extrinsicParameters.h"
 
 #include <QDomElement>
+#include <QPointF>
 #include <QString>
 #include <array>
 #include <iostream>
@@ -131,6 +132,28 @@ public:
 };
 
 
+/**
+ * @brief Copy of the calibration needed to map image points to world coordinates
+ *
+ * The calibration is held by the widgets, which must only be read from the GUI thread. A snapshot taken there (see
+ * ExtrCalibration::snapshot()) can be used by worker threads, e.g. in the recognition.
+ */
+struct CalibrationSnapshot
+{
+    ExtrinsicParameters extrParams;
+    double              fx         = 0;
+    double              fy         = 0;
+    double              cx         = 0;
+    double              cy         = 0;
+    int                 borderSize = 0;
+    cv::Point3f         coord3DTrans;
+    std::array<bool, 3> coord3DSwap{};
+
+    cv::Point3f get3DPoint(const cv::Point2f &p2d, double h) const;
+    QPointF     getCmPerPixel(float px, float py, float h) const;
+    double      getAngleToGround(float px, float py, float height) const;
+};
+
 /**
  * @brief The ExtrCalibration class manages the extrinsic calibration
  *
@@ -174,8 +197,9 @@ public:
     virtual cv::Point2f                getImagePoint(cv::Point3f p3d) const;
     virtual cv::Point2f                getImagePoint(cv::Point3f p3d, const ExtrinsicParameters &extrParams) const;
 
-    cv::Point3f get3DPoint(const cv::Point2f &p2d, double h) const;
-    cv::Point3f get3DPoint(const cv::Point2f &p2d, double h, const ExtrinsicParameters &extrParams) const;
+    cv::Point3f         get3DPoint(const cv::Point2f &p2d, double h) const;
+    cv::Point3f         get3DPoint(const cv::Point2f &p2d, double h, const ExtrinsicParameters &extrParams) const;
+    CalibrationSnapshot snapshot() const;
     cv::Point3f transformRT(cv::Point3f p);
     cv::Vec3d   camToWorldRotation(const cv::Vec3d &vec) const;
     bool        isOutsideImage(cv::Point2f p2d) const;
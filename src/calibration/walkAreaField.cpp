@@ -0,0 +1,186 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "walkAreaField.h"
+
+#include <QLineF>
+#include <cmath>
+#include <limits>
+#include <opencv2/imgproc.hpp>
+#include <vector>
+
+namespace walkarea
+{
+namespace
+{
+constexpr double MAX_SEGMENT_LENGTH = 10.; ///< maximum length of an edge in pixels before it is transformed
+constexpr int    FRACTION_BITS      = 4;   ///< fractional bits of the vertices passed to cv::fillPoly
+
+/// vertices of the polygon (without the closing one) after subdividing its edges and applying transform
+QPolygonF transformed(const Polygon &polygon, const WalkAreaField::Transform &transform)
+{
+    const int count = polygon.isClosed() ? polygon.size() - 1 : polygon.size();
+    if(!transform)
+    {
+        return polygon.mid(0, count);
+    }
+
+    QPolygonF result;
+    for(int i = 0; i < count; ++i)
+    {
+        const QPointF from  = polygon[i];
+        const QPointF to    = polygon[(i + 1) % count];
+        const int     steps = std::max(1, static_cast<int>(std::ceil(QLineF(from, to).length() / MAX_SEGMENT_LENGTH)));
+        for(int k = 0; k < steps; ++k)
+        {
+            result.append(transform(from + (to - from) * (static_cast<double>(k) / steps)));
+        }
+    }
+    return result;
+}
+} // namespace
+
+WalkAreaField::WalkAreaField(
+    const std::optional<Polygon>  &walkable,
+    const std::map<int, Polygon> &obstacles,
+    const QRectF                  &bounds,
+    double                         cellSize,
+    const Transform               &transform) :
+    mCellSize(cellSize)
+{
+    std::optional<QPolygonF> walkablePolygon;
+    if(walkable && !walkable->disabled() && walkable->size() > 2)
+    {
+        walkablePolygon = transformed(*walkable, transform);
+    }
+    std::vector<QPolygonF> obstaclePolygons;
+    for(const auto &[id, obstacle] : obstacles)
+    {
+        if(!obstacle.disabled() && obstacle.size() > 2)
+        {
+            obstaclePolygons.push_back(transformed(obstacle, transform));
+        }
+    }
+    if(!walkablePolygon && obstaclePolygons.empty())
+    {
+        return;
+    }
+
+    QRectF area = bounds;
+    if(walkablePolygon)
+    {
+        area = area.united(walkablePolygon->boundingRect());
+    }
+    for(const auto &obstacle : obstaclePolygons)
+    {
+        area = area.united(obstacle.boundingRect());
+    }
+    // one cell of margin, so that there always is a wall around the walkable area
+    area.adjust(-cellSize, -cellSize, cellSize, cellSize);
+
+    mOrigin        = area.topLeft();
+    const int cols = static_cast<int>(std::ceil(area.width() / cellSize));
+    const int rows = static_cast<int>(std::ceil(area.height() / cellSize));
+    mStatus        = cv::Mat(
+        rows,
+        cols,
+        CV_8U,
+        cv::Scalar(static_cast<int>(walkablePolygon ? FieldStatus::OutsideWalkable : FieldStatus::Walkable)));
+
+    auto fill = [this](const QPolygonF &polygon, FieldStatus status)
+    {
+        // cell centers are at integer coordinates for cv::fillPoly
+        constexpr double       scale = 1 << FRACTION_BITS;
+        std::vector<cv::Point> points;
+        points.reserve(polygon.size());
+        for(const auto &point : polygon)
+        {
+            points.emplace_back(
+                cvRound(((point.x() - mOrigin.x()) / mCellSize - 0.5) * scale),
+                cvRound(((point.y() - mOrigin.y()) / mCellSize - 0.5) * scale));
+        }
+        cv::fillPoly(
+            mStatus,
+            std::vector<std::vector<cv::Point>>{points},
+            cv::Scalar(static_cast<int>(status)),
+            cv::LINE_8,
+            FRACTION_BITS);
+    };
+
+    if(walkablePolygon)
+    {
+        fill(*walkablePolygon, FieldStatus::Walkable);
+    }
+    for(const auto &obstacle : obstaclePolygons)
+    {
+        fill(obstacle, FieldStatus::InsideObstacle);
+    }
+
+    const cv::Mat walkableMask = (mStatus == static_cast<int>(FieldStatus::Walkable));
+    cv::Mat       inside;
+    cv::Mat       outside;
+    cv::distanceTransform(walkableMask, inside, cv::DIST_L2, cv::DIST_MASK_PRECISE);
+    cv::distanceTransform(~walkableMask, outside, cv::DIST_L2, cv::DIST_MASK_PRECISE);
+    mDistance = (inside - outside) * cellSize;
+}
+
+bool WalkAreaField::cellOf(const QPointF &pos, int &row, int &col) const
+{
+    if(isEmpty() || !std::isfinite(pos.x()) || !std::isfinite(pos.y()))
+    {
+        return false;
+    }
+    const double x = std::floor((pos.x() - mOrigin.x()) / mCellSize);
+    const double y = std::floor((pos.y() - mOrigin.y()) / mCellSize);
+    if(x < 0 || y < 0 || x >= mStatus.cols || y >= mStatus.rows)
+    {
+        return false;
+    }
+    col = static_cast<int>(x);
+    row = static_cast<int>(y);
+    return true;
+}
+
+FieldStatus WalkAreaField::status(const QPointF &pos) const
+{
+    int row;
+    int col;
+    if(!cellOf(pos, row, col))
+    {
+        return FieldStatus::Unknown;
+    }
+    return static_cast<FieldStatus>(mStatus.at<uchar>(row, col));
+}
+
+double WalkAreaField::signedDistance(const QPointF &pos) const
+{
+    int row;
+    int col;
+    if(!cellOf(pos, row, col))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return mDistance.at<float>(row, col);
+}
+
+QRectF WalkAreaField::getBounds() const
+{
+    return {mOrigin, QSizeF(mStatus.cols * mCellSize, mStatus.rows * mCellSize)};
+}
+
+} // namespace walkarea
@@ -0,0 +1,88 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef WALKAREAFIELD_H
+#define WALKAREAFIELD_H
+
+#include "util/polygon.h"
+
+#include <QPointF>
+#include <QRectF>
+#include <functional>
+#include <map>
+#include <opencv2/core/mat.hpp>
+#include <optional>
+
+namespace walkarea
+{
+
+enum class FieldStatus : unsigned char
+{
+    Unknown,         ///< outside of the rasterized area
+    Walkable,        ///< inside the walkable area (or anywhere, if there is none) and not inside an obstacle
+    OutsideWalkable, ///< outside of the walkable area
+    InsideObstacle
+};
+
+/**
+ * @brief Raster of the walk area for fast queries of many positions
+ *
+ * The enabled walkable area and obstacles are drawn into a regular grid once. Every cell stores its FieldStatus and
+ * the signed distance to the nearest wall or obstacle edge: positive for walkable cells, negative outside of the
+ * walkable area or inside an obstacle. The distance is accurate to about one cell.
+ *
+ * The polygons are given in pixel coordinates. With a transform (e.g. to world coordinates) the edges are subdivided
+ * before transforming the vertices, so that curved edges (lens distortion) are approximated.
+ *
+ * All queries are const and can be used from several threads at once.
+ */
+class WalkAreaField
+{
+public:
+    using Transform = std::function<QPointF(const QPointF &)>;
+
+    WalkAreaField() = default;
+    WalkAreaField(
+        const std::optional<Polygon>  &walkable,
+        const std::map<int, Polygon> &obstacles,
+        const QRectF                  &bounds,
+        double                         cellSize,
+        const Transform               &transform = {});
+
+    /// true, if there is no enabled polygon, i.e. there are no walls to check against
+    bool isEmpty() const { return mStatus.empty(); }
+
+    FieldStatus status(const QPointF &pos) const;
+    /// signed distance to the nearest wall or obstacle in units of the positions; NaN if the status is Unknown
+    double signedDistance(const QPointF &pos) const;
+
+    double getCellSize() const { return mCellSize; }
+    QRectF getBounds() const;
+
+private:
+    bool cellOf(const QPointF &pos, int &row, int &col) const;
+
+    cv::Mat mStatus;   ///< CV_8U with the FieldStatus of each cell
+    cv::Mat mDistance; ///< CV_32F with the signed distance of each cell
+    QPointF mOrigin;   ///< position of the upper left corner of the first cell
+    double  mCellSize = 1.;
+};
+
+} // namespace walkarea
+
+#endif // WALKAREAFIELD_H
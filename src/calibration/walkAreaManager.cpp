@@ -24,8 +24,17 @@
 #include "polygon.h"
 #include "util/wktParser.h"
 #include "walkAreaWidget.h"
+#include "worldImageCorrespondence.h"
 
 #include <QDomDocument>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr double MIN_WORLD_CELL_SIZE = 1.;      ///< cm
+constexpr double MAX_WORLD_CELLS     = 4096000; ///< limits the memory of the world field to about 20 MB
+} // namespace
 
 WalkAreaManager::WalkAreaManager(WalkAreaWidget *parent) : mParent(parent)
 {
@@ -39,6 +48,15 @@ WalkAreaManager::WalkAreaManager(WalkAreaWidget *parent) : mParent(parent)
     mSelection.setShowCurMousePos(true);
     connect(this, &WalkAreaManager::visibilityChanged, this, &WalkAreaManager::imageUpdate);
     connect(this, &WalkAreaManager::geometryChanged, this, &WalkAreaManager::imageUpdate);
+    connect(
+        this,
+        &WalkAreaManager::geometryChanged,
+        this,
+        [this]()
+        {
+            mPixelField.reset();
+            mWorldField.reset();
+        });
 }
 
 void WalkAreaManager::setVisible(bool val)
@@ -186,11 +204,15 @@ void WalkAreaManager::updatePolygon(const walkarea::Polygon &poly, bool validate
     if(mWalkableArea.has_value() && mWalkableArea->id() == poly.id())
     {
         mWalkableArea = poly;
+        mPixelField.reset();
+        mWorldField.reset();
         emit imageUpdate();
     }
     else if(mObstacles.find(poly.id()) != mObstacles.end())
     {
         mObstacles[poly.id()] = poly;
+        mPixelField.reset();
+        mWorldField.reset();
         emit imageUpdate();
     }
 
@@ -262,6 +284,63 @@ void WalkAreaManager::validatePolygons()
     emit validationChanged();
 }
 
+/**
+ * @brief Returns the walk area rasterized in pixel coordinates with a cell size of one pixel
+ *
+ * The field is cached until the polygons change.
+ *
+ * @param imageRect rect of the image without border
+ */
+std::shared_ptr<const walkarea::WalkAreaField> WalkAreaManager::getPixelField(const QRectF &imageRect) const
+{
+    if(!mPixelField || mPixelFieldRect != imageRect)
+    {
+        mPixelField     = std::make_shared<const walkarea::WalkAreaField>(mWalkableArea, mObstacles, imageRect, 1.);
+        mPixelFieldRect = imageRect;
+    }
+    return mPixelField;
+}
+
+/**
+ * @brief Returns the walk area rasterized on the floor in world coordinates (cm)
+ *
+ * The field covers at least the floor seen in the image. Its cell size is 1 cm, unless that would need too much
+ * memory. The field is cached until the polygons or the calibration change.
+ *
+ * @param worldImageCorr current calibration
+ * @param imageRect rect of the image without border
+ * @param borderSize size of the border of the image
+ */
+std::shared_ptr<const walkarea::WalkAreaField> WalkAreaManager::getWorldField(
+    const WorldImageCorrespondence &worldImageCorr,
+    const QRectF                   &imageRect,
+    int                             borderSize) const
+{
+    if(mWorldField && mWorldFieldRect == imageRect && mWorldFieldBorder == borderSize)
+    {
+        return mWorldField;
+    }
+
+    const QPointF border(borderSize, borderSize);
+    auto          toWorld = [&worldImageCorr, border](const QPointF &pixel)
+    { return worldImageCorr.getPosReal(pixel + border, 0.); };
+
+    const QPolygonF corners{
+        toWorld(imageRect.topLeft()),
+        toWorld(imageRect.topRight()),
+        toWorld(imageRect.bottomRight()),
+        toWorld(imageRect.bottomLeft())};
+    const QRectF bounds = corners.boundingRect();
+    const double cellSize =
+        std::max(MIN_WORLD_CELL_SIZE, std::sqrt(bounds.width() * bounds.height() / MAX_WORLD_CELLS));
+
+    mWorldField       = std::make_shared<const walkarea::WalkAreaField>(
+        mWalkableArea, mObstacles, bounds, cellSize, walkarea::WalkAreaField::Transform(toWorld));
+    mWorldFieldRect   = imageRect;
+    mWorldFieldBorder = borderSize;
+    return mWorldField;
+}
+
 void WalkAreaManager::setXml(QDomElement &elem) const
 {
     QDomDocument doc = elem.ownerDocument();
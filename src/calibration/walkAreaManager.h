@@ -21,9 +21,12 @@
 
 #include "polygonSelection.h"
 #include "util/polygon.h"
+#include "walkAreaField.h"
 
 #include <QObject>
+#include <QRectF>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 
@@ -64,9 +67,17 @@ public:
     bool          isValid() const { return mIsValid; }
     std::set<int> getInvalidObstacleIds() const { return mInvalidObstacleIds; }
 
+    std::shared_ptr<const walkarea::WalkAreaField> getPixelField(const QRectF &imageRect) const;
+    std::shared_ptr<const walkarea::WalkAreaField>
+    getWorldField(const WorldImageCorrespondence &worldImageCorr, const QRectF &imageRect, int borderSize) const;
+
     void setXml(QDomElement &elem) const;
     void getXml(const QDomElement &elem);
 
+public slots:
+    /// the calibration changed, so the world field has to be rasterized again
+    void invalidateWorldField() { mWorldField.reset(); }
+
 signals:
     void visibilityChanged(bool visible, bool walkableVisible, bool obstacleVisible);
     void editModeChanged(bool);
@@ -93,5 +104,12 @@ private:
 
     std::set<int> mInvalidObstacleIds;
     bool          mIsValid = true;
+
+    // rasterized polygons, rebuilt lazily after the geometry or the calibration changed
+    mutable std::shared_ptr<const walkarea::WalkAreaField> mPixelField;
+    mutable std::shared_ptr<const walkarea::WalkAreaField> mWorldField;
+    mutable QRectF                                         mPixelFieldRect;
+    mutable QRectF                                         mWorldFieldRect;
+    mutable int                                            mWorldFieldBorder = 0;
 };
 #endif
@@ -90,6 +90,7 @@ void BackgroundFilter::reset()
     {
         mBgModel->clear();
     }
+    mLearnedWholeImage = false;
 
     setChanged(true);
 }
@@ -339,6 +340,30 @@ bool BackgroundFilter::update() const
     return mUpdate;
 }
 
+/**
+ * @brief Restricts learning to region of the following images
+ *
+ * The rest of these images is not filtered (see Petrack::processingRegion()) and must not become part of the
+ * background. Outside of region, the model is shown its own background image, so it stays as it is and nothing is
+ * detected as foreground there.
+ *
+ * @param region part of the image which is valid; empty for the whole image
+ */
+void BackgroundFilter::setRegion(const cv::Rect &region)
+{
+    mRegion = region;
+}
+
+/**
+ * @brief Whether the model learned a whole image since the last reset
+ *
+ * Until then, the model has no background outside of a region to keep, so it has to learn a whole image first.
+ */
+bool BackgroundFilter::learnedWholeImage() const
+{
+    return mLearnedWholeImage;
+}
+
 void BackgroundFilter::setStereoContext(pet::StereoContext **sc)
 {
     mStereoContext = sc;
@@ -451,6 +476,7 @@ cv::Mat BackgroundFilter::act(cv::Mat &img, cv::Mat &res)
             mForeground.create(cv::Size(img.cols, img.rows), CV_8UC1);
 
             mBgModel->apply(img, mForeground, 1);
+            mLearnedWholeImage = mRegion.empty();
 
 #ifdef SHOW_TMP_IMG
             namedWindow("BackgroundFilter");
@@ -546,7 +572,18 @@ cv::Mat BackgroundFilter::act(cv::Mat &img, cv::Mat &res)
             // ---------------------------------------------------------------------------------------------------------------------
 
 
-            mBgModel->apply(img, mForeground, update() ? -1 : 0);
+            cv::Mat input = img;
+            if(!mRegion.empty() && mLearnedWholeImage)
+            {
+                // img is the result of this filter as well, the background must not be written into it
+                const cv::Rect region = mRegion & cv::Rect({}, img.size());
+                cv::Mat        background;
+                mBgModel->getBackgroundImage(background);
+                img(region).copyTo(background(region));
+                input = background;
+            }
+            mBgModel->apply(input, mForeground, update() ? -1 : 0);
+            mLearnedWholeImage = mLearnedWholeImage || mRegion.empty();
 
 #ifdef SHOW_TMP_IMG
             imshow("BackgroundFilter", img);
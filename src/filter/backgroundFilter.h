@@ -38,6 +38,8 @@ private:
     cv::Mat              mForeground;
     QString              mLastFile;
     double               mDefaultHeight;
+    cv::Rect             mRegion;                    ///< part of the image the model learns from; empty for all
+    bool                 mLearnedWholeImage = false; ///< model learned a whole image since the last reset
 
 public:
     BackgroundFilter();
@@ -48,6 +50,9 @@ public:
     void setUpdate(bool b);
     bool update() const;
 
+    void setRegion(const cv::Rect &region);
+    bool learnedWholeImage() const;
+
     QString getFilename();
     void    setFilename(const QString &fn);
 
@@ -54,6 +54,39 @@ cv::Mat BorderFilter::act(cv::Mat &img, cv::Mat &res)
     return res;
 }
 
+/**
+ * @brief Fills region with the border color and copies the part of img inside of it
+ */
+cv::Mat BorderFilter::actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region)
+{
+    int s = mSize.getValue();
+    int r = mRed.getValue();
+    int g = mGreen.getValue();
+    int b = mBlue.getValue();
+
+    res(region).setTo(cv::Scalar(b, g, r));
+
+    const cv::Rect inner = region & cv::Rect(s, s, img.cols, img.rows);
+    if(!inner.empty())
+    {
+        cv::Mat resInner = res(inner);
+        img(inner - cv::Point(s, s)).copyTo(resInner);
+    }
+    return res;
+}
+
+cv::Size BorderFilter::resultSize(const cv::Size &imgSize) const
+{
+    const int s = mSize.getValue();
+    return {imgSize.width + 2 * s, imgSize.height + 2 * s};
+}
+
+cv::Rect BorderFilter::sourceRegion(const cv::Rect &region, const cv::Size &imgSize)
+{
+    const int s = mSize.getValue();
+    return (region - cv::Point(s, s)) & cv::Rect({}, imgSize);
+}
+
 Parameter<int> &BorderFilter::getBorderSize()
 {
     return mSize;
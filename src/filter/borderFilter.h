@@ -32,7 +32,10 @@ private:
 public:
     BorderFilter();
 
-    cv::Mat act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region) override;
+    cv::Size resultSize(const cv::Size &imgSize) const override;
+    cv::Rect sourceRegion(const cv::Rect &region, const cv::Size &imgSize) override;
 
     Parameter<int> &getBorderSize();
     Parameter<int> &getBorderColR();
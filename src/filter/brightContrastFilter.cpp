@@ -30,7 +30,10 @@ BrightContrastFilter::BrightContrastFilter() : Filter()
     mContrast.setValue(0.);
 }
 
-cv::Mat BrightContrastFilter::act(cv::Mat &img, cv::Mat &res)
+/**
+ * @brief Factor and offset of the linear transformation of the pixel values
+ */
+std::pair<double, double> BrightContrastFilter::linearTransform() const
 {
     double delta, a, b;
     /*
@@ -49,11 +52,30 @@ cv::Mat BrightContrastFilter::act(cv::Mat &img, cv::Mat &res)
         a     = (256. - delta * 2.) / 255.;
         b     = a * mBrightness.getValue() + delta;
     }
+    return {a, b};
+}
 
+cv::Mat BrightContrastFilter::act(cv::Mat &img, cv::Mat &res)
+{
+    const auto [a, b] = linearTransform();
     img.convertTo(res, -1, a, b);
     return res;
 }
 
+cv::Mat BrightContrastFilter::actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region)
+{
+    const auto [a, b] = linearTransform();
+
+    cv::Mat resRegion = res(region);
+    img(region).convertTo(resRegion, -1, a, b);
+    return res;
+}
+
+cv::Rect BrightContrastFilter::sourceRegion(const cv::Rect &region, const cv::Size & /*imgSize*/)
+{
+    return region;
+}
+
 Parameter<double> &BrightContrastFilter::getBrightness()
 {
     return mBrightness;
@@ -22,6 +22,8 @@
 #include "filter.h"
 #include "helper.h"
 
+#include <utility>
+
 
 class BrightContrastFilter : public Filter
 {
@@ -29,10 +31,14 @@ private:
     Parameter<double> mBrightness{this};
     Parameter<double> mContrast{this};
 
+    std::pair<double, double> linearTransform() const;
+
 public:
     BrightContrastFilter();
 
-    cv::Mat act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region) override;
+    cv::Rect sourceRegion(const cv::Rect &region, const cv::Size &imgSize) override;
 
     Parameter<double> &getBrightness();
     Parameter<double> &getContrast();
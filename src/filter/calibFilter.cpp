@@ -18,8 +18,69 @@
 
 #include "calibFilter.h"
 
+#include <algorithm>
+#include <deque>
+#include <mutex>
 #include <opencv2/calib3d.hpp>
+#include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
+#include <vector>
+
+namespace
+{
+struct UndistortMaps
+{
+    cv::Mat  camera;
+    cv::Mat  dist;
+    cv::Size size;
+    cv::Mat  map1;
+    cv::Mat  map2;
+};
+
+constexpr size_t MAX_CACHED_UNDISTORT_MAPS = 4;
+
+bool equalMats(const cv::Mat &lhs, const cv::Mat &rhs)
+{
+    return lhs.size() == rhs.size() && lhs.type() == rhs.type() &&
+           (lhs.empty() || cv::norm(lhs, rhs, cv::NORM_INF) == 0);
+}
+
+/**
+ * @brief Returns the undistortion maps for the given intrinsics and image size
+ *
+ * Computing the maps is expensive for large images. Projects recorded with the same camera (e.g. processed one after
+ * another in batch mode) share the same maps, so the last few are kept process-wide.
+ */
+UndistortMaps undistortMaps(const cv::Mat &camera, const cv::Mat &dist, const cv::Size &size)
+{
+    static std::mutex                cacheMutex;
+    static std::deque<UndistortMaps> cache;
+
+    std::scoped_lock lock{cacheMutex};
+    auto             iter = std::find_if(
+        cache.begin(),
+        cache.end(),
+        [&](const UndistortMaps &maps)
+        { return maps.size == size && equalMats(maps.camera, camera) && equalMats(maps.dist, dist); });
+    if(iter != cache.end())
+    {
+        UndistortMaps maps = *iter;
+        cache.erase(iter);
+        cache.push_front(maps);
+        return maps;
+    }
+
+    UndistortMaps maps{camera.clone(), dist.clone(), size, {}, {}};
+    cv::initUndistortRectifyMap(
+        camera, dist, cv::Mat_<double>::eye(3, 3), camera, size, CV_16SC2, maps.map1, maps.map2);
+    cache.push_front(maps);
+    if(cache.size() > MAX_CACHED_UNDISTORT_MAPS)
+    {
+        cache.pop_back();
+    }
+    return maps;
+}
+} // namespace
 
 
 Parameter<IntrinsicCameraParams> &CalibFilter::getCamParams()
@@ -46,7 +107,8 @@ CalibFilter::CalibFilter() : Filter(), mCamParams(this)
 /**
  * @brief Undistorts the image.
  *
- * This method calculates and caches the mapping for undistortion.
+ * This method calculates and caches the mapping for undistortion; the mapping itself is shared with other
+ * CalibFilters using the same intrinsics.
  * The mapping is applied to the input image
  *
  * @param img[in]
@@ -55,20 +117,69 @@ CalibFilter::CalibFilter() : Filter(), mCamParams(this)
  */
 cv::Mat CalibFilter::act(cv::Mat &img, cv::Mat &res)
 {
-    if(this->changed() || map1.size() != img.size())
-    {
-        cv::Mat camera;
-        // conversion to CV_32F such that regression tests don't fail
-        mCamParams.getValue().cameraMatrix.convertTo(camera, CV_32F);
-        const cv::Mat dist = mCamParams.getValue().distortionCoeffs;
-
-        cv::initUndistortRectifyMap(
-            camera, dist, cv::Mat_<double>::eye(3, 3), camera, img.size(), CV_16SC2, map1, map2);
-    }
+    updateMaps(img.size());
 
     cv::remap(img, res, map1, map2, cv::INTER_LINEAR, cv::BORDER_CONSTANT);
     return res;
 }
+
+/**
+ * @brief Undistorts the image only inside region
+ *
+ * @param img[in] distorted image, only needs to be valid inside sourceRegion(region, img.size())
+ * @param res[out] undistorted image, only written inside region
+ * @param region part of the undistorted image to compute
+ * @return res
+ */
+cv::Mat CalibFilter::actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region)
+{
+    updateMaps(img.size());
+
+    cv::Mat resRegion = res(region);
+    cv::remap(img, resRegion, map1(region), map2(region), cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+    return res;
+}
+
+/**
+ * @brief Bounding box of the distorted pixels used for region of the undistorted image
+ *
+ * map1 holds the integer part of the source position of every pixel; the bilinear interpolation also reads the next
+ * pixel in both directions.
+ */
+cv::Rect CalibFilter::sourceRegion(const cv::Rect &region, const cv::Size &imgSize)
+{
+    updateMaps(imgSize);
+
+    std::vector<cv::Mat> coords;
+    cv::split(map1(region), coords);
+    double minX, maxX, minY, maxY;
+    cv::minMaxLoc(coords[0], &minX, &maxX);
+    cv::minMaxLoc(coords[1], &minY, &maxY);
+
+    const cv::Point topLeft(static_cast<int>(minX), static_cast<int>(minY));
+    const cv::Point bottomRight(static_cast<int>(maxX) + 2, static_cast<int>(maxY) + 2);
+    return cv::Rect(topLeft, bottomRight) & cv::Rect({}, imgSize);
+}
+
+/**
+ * @brief Computes the mapping for undistortion, if the parameters or the image size changed
+ */
+void CalibFilter::updateMaps(const cv::Size &size)
+{
+    if(mMapsVersion == getVersion() && map1.size() == size)
+    {
+        return;
+    }
+    cv::Mat camera;
+    // conversion to CV_32F such that regression tests don't fail
+    mCamParams.getValue().cameraMatrix.convertTo(camera, CV_32F);
+    const cv::Mat dist = mCamParams.getValue().distortionCoeffs;
+
+    const auto maps = undistortMaps(camera, dist, size);
+    map1            = maps.map1;
+    map2            = maps.map2;
+    mMapsVersion    = getVersion();
+}
 /**
  * @brief Returns the first output map of function "initUndistortRectifyMap"
  *
@@ -22,24 +22,33 @@
 #include "filter.h"
 #include "intrinsicCameraParams.h"
 
+#include <cstdint>
+
 /**
  * @brief Undistortion filter
  *
  * This class is a filter which undistorts the image using the camera matrix from intrinsic calibration.
  * It caches the mapping from distorted to undistorted image.
+ * With the mapping, the part of the distorted image needed for a region of the undistorted image is known, so
+ * regions can be undistorted on their own.
  */
 class CalibFilter : public Filter
 {
 private:
     Parameter<IntrinsicCameraParams> mCamParams;
 
-    cv::Mat map1;
-    cv::Mat map2;
+    cv::Mat       map1;
+    cv::Mat       map2;
+    std::uint64_t mMapsVersion = 0; // parameter version of map1 and map2
+
+    void updateMaps(const cv::Size &size);
 
 public:
     CalibFilter();
 
-    cv::Mat act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region) override;
+    cv::Rect sourceRegion(const cv::Rect &region, const cv::Size &imgSize) override;
 
     Parameter<IntrinsicCameraParams> &getCamParams();
     cv::Mat                           getMap1();
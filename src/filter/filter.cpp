@@ -18,6 +18,8 @@
 
 #include "filter.h"
 
+#include "helper.h"
+
 
 Filter::Filter()
 {
@@ -48,6 +50,21 @@ bool Filter::getChanged()
 void Filter::setChanged(bool b)
 {
     mChg = b;
+    if(b)
+    {
+        ++mVersion;
+    }
+}
+
+/**
+ * @brief Version of the parameters, which is increased with every change
+ *
+ * Unlike changed(), the version is not reset when the filter is applied. So it can be used to check, whether a
+ * stored result was computed with the current parameters.
+ */
+std::uint64_t Filter::getVersion() const
+{
+    return mVersion;
 }
 
 /**
@@ -64,6 +81,7 @@ void Filter::setChanged(bool b)
  */
 cv::Mat Filter::apply(cv::Mat &img)
 {
+    mResKey.reset();
     if(getEnabled())
     {
         if(getOnCopy())
@@ -87,6 +105,170 @@ cv::Mat Filter::apply(cv::Mat &img)
     }
 }
 
+/**
+ * @brief Returns the image for the next region result with size and type, zero everywhere
+ *
+ * The same image is used for all region results of the filter. Only the part written by the last region result is
+ * cleared again, so the whole image is not set to zero for every frame. If the last region result is still used
+ * outside of the filter (e.g. shown via shareToQImage()), a new image is allocated instead.
+ */
+cv::Mat Filter::regionResult(const cv::Size &size, int type)
+{
+    if(mRes.u && mRes.u == mRegionRes.u)
+    {
+        mRes.release(); // replaced by the new result anyway
+    }
+    detachSharedMat(mRegionRes);
+    if(mRegionRes.size() != size || mRegionRes.type() != type)
+    {
+        mRegionRes = cv::Mat::zeros(size, type);
+    }
+    else
+    {
+        mRegionRes(mRegionResRect).setTo(cv::Scalar::all(0));
+    }
+    mRegionResRect = cv::Rect();
+    return mRegionRes;
+}
+
+/**
+ * @brief Applies the filter to img only inside region of the result
+ *
+ * The result always has the full size; outside of region it is zero. img only has to be valid inside the source
+ * region, see Filter::getSourceRegion(). The result is written to an image which is reused for the next region, unless
+ * a copy of the result is still referenced then, independent of Filter::getOnCopy().
+ *
+ * @param img image to be transformed
+ * @param region part of the result to compute
+ * @return if enabled the partly transformed image else just img without changes
+ */
+cv::Mat Filter::applyRegion(cv::Mat &img, const cv::Rect &region)
+{
+    mResKey.reset();
+    mChg = false;
+    if(!getEnabled())
+    {
+        return mRes = img;
+    }
+    cv::Mat res    = regionResult(resultSize(img.size()), CV_8UC(img.channels()));
+    mRegionResRect = region & cv::Rect({}, res.size());
+    return mRes = actRegion(img, res, mRegionResRect);
+}
+
+/**
+ * @brief Applies the filter to img and caches the result under key
+ *
+ * Like Filter::apply(cv::Mat &), but the result is also stored in the LRU cache of the filter, so it can be taken
+ * from Filter::getCachedResult() when the same frame is filtered again with the same parameters. Results of a
+ * disabled filter are not stored, as they are just the unchanged img.
+ *
+ * If the key has a region, only this region of the result is computed, see Filter::applyRegion(). A filter working
+ * in place (see Filter::getOnCopy()) works on a copy of img, if img is shared with other images, so cached results
+ * are never changed.
+ *
+ * @param img image to be transformed
+ * @param key identifies the result, see FilterCacheKey
+ * @return if enabled the transformed image else just img without changes
+ */
+cv::Mat Filter::apply(cv::Mat &img, const FilterCacheKey &key)
+{
+    // img may be shared with another result (e.g. cached by the previous filter), which must not be changed in place
+    const bool inPlace = getEnabled() && !getOnCopy() && key.region.empty();
+    cv::Mat    input   = inPlace && img.u && CV_XADD(&img.u->refcount, 0) > 1 ? img.clone() : img;
+    cv::Mat    res     = key.region.empty() ? apply(input) : applyRegion(input, key.region);
+    mResKey            = key;
+    if(getEnabled() && key.frame != FilterCacheKey::NO_FRAME)
+    {
+        // the image of a region result is reused, so only a copy of the computed part is stored
+        mCache.insert(key, key.region.empty() ? res : res(mRegionResRect).clone());
+    }
+    return res;
+}
+
+/**
+ * @brief Returns the result for key, if it is the last result or still in the cache
+ *
+ * A found result becomes the last result and changed() is reset, as if the filter was applied. For a key with a
+ * region, the result of the whole image is taken as well.
+ *
+ * @param key identifies the result, see FilterCacheKey
+ * @param imgSize size of the input, needed to restore the full size of a cached region result
+ * @return the result or std::nullopt, if the filter has to be applied
+ */
+std::optional<cv::Mat> Filter::getCachedResult(const FilterCacheKey &key, const cv::Size &imgSize)
+{
+    FilterCacheKey wholeImageKey = key;
+    wholeImageKey.region         = cv::Rect();
+
+    if(mResKey != key && mResKey != wholeImageKey)
+    {
+        if(key.frame == FilterCacheKey::NO_FRAME)
+        {
+            return std::nullopt;
+        }
+        auto cached = mCache.get(key);
+        if(cached && !key.region.empty())
+        {
+            // only the computed part of a region result is stored, see apply()
+            cv::Mat res    = regionResult(getResultSize(imgSize), cached->type());
+            mRegionResRect = key.region;
+            cached->copyTo(res(mRegionResRect));
+            cached = res;
+        }
+        else if(!cached && !key.region.empty())
+        {
+            cached = mCache.get(wholeImageKey);
+        }
+        if(!cached)
+        {
+            return std::nullopt;
+        }
+        mRes    = *cached;
+        mResKey = key;
+    }
+    mChg = false;
+    return mRes;
+}
+
+/**
+ * @brief Size of the result for an input of size imgSize
+ */
+cv::Size Filter::getResultSize(const cv::Size &imgSize) const
+{
+    return getEnabled() ? resultSize(imgSize) : imgSize;
+}
+
+/**
+ * @brief Part of the input needed to compute region of the result
+ *
+ * @param region part of the result
+ * @param imgSize size of the input
+ * @return region of the input; the whole input if the filter cannot compute parts of its result
+ */
+cv::Rect Filter::getSourceRegion(const cv::Rect &region, const cv::Size &imgSize)
+{
+    return getEnabled() ? sourceRegion(region, imgSize) & cv::Rect({}, imgSize) : region;
+}
+
+/**
+ * @brief Sets the memory limit of the result cache in bytes; 0 disables the cache
+ */
+void Filter::setCacheSize(std::size_t maxBytes)
+{
+    mCache.setMaxBytes(maxBytes);
+}
+
+std::size_t Filter::getCacheUsage() const
+{
+    return mCache.bytes();
+}
+
+void Filter::clearCache()
+{
+    mCache.clear();
+    mResKey.reset();
+}
+
 cv::Mat Filter::getLastResult()
 {
     return mRes;
@@ -94,17 +276,17 @@ cv::Mat Filter::getLastResult()
 
 void Filter::enable()
 {
-    mChg    = true;
+    setChanged(true);
     mEnable = true;
 }
 void Filter::disable()
 {
-    mChg    = true;
+    setChanged(true);
     mEnable = false;
 }
 void Filter::setEnabled(bool b)
 {
-    mChg    = true;
+    setChanged(true);
     mEnable = b;
 }
 bool Filter::getEnabled() const
@@ -114,7 +296,7 @@ bool Filter::getEnabled() const
 
 void Filter::setOnCopy(bool b)
 {
-    mChg    = true;
+    setChanged(true);
     mOnCopy = b;
 }
 bool Filter::getOnCopy() const
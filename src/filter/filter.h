@@ -19,7 +19,11 @@
 #ifndef FILTER_H
 #define FILTER_H
 
+#include "filterCache.h"
+
+#include <cstdint>
 #include <opencv2/core.hpp>
+#include <optional>
 
 
 /**
@@ -31,6 +35,14 @@
  * to apply the different filters, caching of the results,
  * activation/deactivation as well as automated detection
  * of changed parameters.
+ *
+ * Every change of the parameters increases the parameter version.
+ * Together with a FilterCacheKey, the results of recent frames
+ * are kept in an LRU cache (see FilterGraph).
+ *
+ * A filter can also compute only a region of its result, if it
+ * knows which part of its input is needed for this region (see
+ * Filter::getSourceRegion()). By default, the whole input is needed.
  */
 class Filter
 {
@@ -40,10 +52,29 @@ private:
     bool    mOnCopy; // if filter works on a copy
     cv::Mat mRes;
 
+    std::uint64_t                 mVersion = 0; // increased with every change of the parameters
+    std::optional<FilterCacheKey> mResKey;      // key of mRes, if it was computed with a key
+    FilterResultCache             mCache;
+    cv::Mat                       mRegionRes;     // reused for all region results, zero outside of mRegionResRect
+    cv::Rect                      mRegionResRect; // part of mRegionRes written by the last region result
+
     // pure virtual function, where to implement the filter conversion
     // returns the result over pointer res and as result
     virtual cv::Mat act(cv::Mat &img, cv::Mat &res) = 0;
 
+    // computes the result only inside region; res has the result size and is zero outside region
+    // the default computes the whole result
+    virtual cv::Mat actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect & /*region*/) { return act(img, res); }
+
+    // size of the result for an input of size imgSize
+    virtual cv::Size resultSize(const cv::Size &imgSize) const { return imgSize; }
+
+    // part of the input of size imgSize needed to compute region of the result
+    virtual cv::Rect sourceRegion(const cv::Rect & /*region*/, const cv::Size &imgSize) { return {{}, imgSize}; }
+
+    cv::Mat regionResult(const cv::Size &size, int type);
+    cv::Mat applyRegion(cv::Mat &img, const cv::Rect &region);
+
 public:
     Filter();
     virtual ~Filter() = default;
@@ -52,9 +83,20 @@ public:
     bool getChanged();
     void setChanged(bool b);
 
+    std::uint64_t getVersion() const;
+
 
     // apply on original Data
     cv::Mat apply(cv::Mat &img);
+    cv::Mat apply(cv::Mat &img, const FilterCacheKey &key);
+
+    cv::Size getResultSize(const cv::Size &imgSize) const;
+    cv::Rect getSourceRegion(const cv::Rect &region, const cv::Size &imgSize);
+
+    std::optional<cv::Mat> getCachedResult(const FilterCacheKey &key, const cv::Size &imgSize);
+    void                   setCacheSize(std::size_t maxBytes);
+    std::size_t            getCacheUsage() const;
+    void                   clearCache();
 
     cv::Mat getLastResult();
 
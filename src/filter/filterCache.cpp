@@ -0,0 +1,107 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "filterCache.h"
+
+#include <functional>
+
+namespace
+{
+std::size_t byteSize(const cv::Mat &mat)
+{
+    return mat.total() * mat.elemSize();
+}
+} // namespace
+
+std::size_t FilterCacheKeyHash::operator()(const FilterCacheKey &key) const
+{
+    std::size_t seed = std::hash<int>{}(key.frame);
+    for(const std::uint64_t value : {key.generation, key.parameters})
+    {
+        seed ^= std::hash<std::uint64_t>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    for(const int value : {key.region.x, key.region.y, key.region.width, key.region.height})
+    {
+        seed ^= std::hash<int>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+/**
+ * @brief Returns the cached result for key and marks it as most recently used
+ */
+std::optional<cv::Mat> FilterResultCache::get(const FilterCacheKey &key)
+{
+    auto iter = mIndex.find(key);
+    if(iter == mIndex.end())
+    {
+        return std::nullopt;
+    }
+    mEntries.splice(mEntries.begin(), mEntries, iter->second);
+    return iter->second->second;
+}
+
+/**
+ * @brief Stores result for key, dropping the least recently used results if the memory limit is exceeded
+ */
+void FilterResultCache::insert(const FilterCacheKey &key, const cv::Mat &result)
+{
+    if(auto iter = mIndex.find(key); iter != mIndex.end())
+    {
+        mBytes -= byteSize(iter->second->second);
+        mEntries.erase(iter->second);
+        mIndex.erase(iter);
+    }
+
+    const std::size_t size = byteSize(result);
+    if(result.empty() || size > mMaxBytes)
+    {
+        return;
+    }
+    evict(mMaxBytes - size);
+
+    mEntries.emplace_front(key, result);
+    mIndex.emplace(key, mEntries.begin());
+    mBytes += size;
+}
+
+void FilterResultCache::clear()
+{
+    mEntries.clear();
+    mIndex.clear();
+    mBytes = 0;
+}
+
+void FilterResultCache::setMaxBytes(std::size_t maxBytes)
+{
+    mMaxBytes = maxBytes;
+    evict(mMaxBytes);
+}
+
+/**
+ * @brief Drops the least recently used results until at most maxBytes are used
+ */
+void FilterResultCache::evict(std::size_t maxBytes)
+{
+    while(mBytes > maxBytes && !mEntries.empty())
+    {
+        mBytes -= byteSize(mEntries.back().second);
+        mIndex.erase(mEntries.back().first);
+        mEntries.pop_back();
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILTERCACHE_H
+#define FILTERCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <opencv2/core.hpp>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * @brief Identifies the result of a filter
+ *
+ * A result is determined by the source frame and by the parameter versions of the filter and of all filters before
+ * it (see FilterGraph). Results of frames which cannot be identified by their number (e.g. of a live stream) use
+ * frame NO_FRAME and the generation of the source image instead.
+ *
+ * Results computed only for a region of the image are stored separately from results of the whole image.
+ */
+struct FilterCacheKey
+{
+    static constexpr int NO_FRAME = -1;
+
+    int           frame      = NO_FRAME; ///< frame number of the source image
+    std::uint64_t generation = 0;        ///< generation of the source image, only used with NO_FRAME
+    std::uint64_t parameters = 0;        ///< combined parameter version of the filter and its inputs
+    cv::Rect      region;                ///< computed region of the result; empty for the whole image
+
+    bool operator==(const FilterCacheKey &other) const = default;
+};
+
+struct FilterCacheKeyHash
+{
+    std::size_t operator()(const FilterCacheKey &key) const;
+};
+
+/**
+ * @brief Least recently used cache of filter results with a memory limit
+ *
+ * The images are stored as shallow copies, the memory usage is the size of their pixel data. If inserting a result
+ * exceeds the limit, the least recently used results are dropped. Results larger than the limit are not stored.
+ */
+class FilterResultCache
+{
+public:
+    explicit FilterResultCache(std::size_t maxBytes = 0) : mMaxBytes(maxBytes) {}
+
+    std::optional<cv::Mat> get(const FilterCacheKey &key);
+    void                   insert(const FilterCacheKey &key, const cv::Mat &result);
+    void                   clear();
+
+    void        setMaxBytes(std::size_t maxBytes);
+    std::size_t maxBytes() const { return mMaxBytes; }
+    std::size_t bytes() const { return mBytes; }
+    std::size_t size() const { return mEntries.size(); }
+
+private:
+    using Entry = std::pair<FilterCacheKey, cv::Mat>;
+
+    void evict(std::size_t maxBytes);
+
+    std::list<Entry> mEntries; ///< most recently used first
+    std::unordered_map<FilterCacheKey, std::list<Entry>::iterator, FilterCacheKeyHash> mIndex;
+    std::size_t                                                                        mBytes = 0;
+    std::size_t                                                                        mMaxBytes;
+};
+
+#endif
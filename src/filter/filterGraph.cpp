@@ -0,0 +1,186 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "filterGraph.h"
+
+#include <stdexcept>
+
+namespace
+{
+/**
+ * @brief Clamps region to an image of the given size
+ *
+ * An empty region stands for the whole image, so a region covering the whole image becomes empty and a region
+ * outside of the image becomes a single pixel.
+ */
+cv::Rect clampRegion(const cv::Rect &region, const cv::Size &size)
+{
+    const cv::Rect wholeImage{{}, size};
+    const cv::Rect clamped = region & wholeImage;
+    if(region.empty() || wholeImage.empty() || clamped == wholeImage)
+    {
+        return {};
+    }
+    return clamped.empty() ? cv::Rect(0, 0, 1, 1) : clamped;
+}
+} // namespace
+
+FilterGraph::FilterGraph(std::size_t memoryLimit) : mMemoryLimit(memoryLimit) {}
+
+/**
+ * @brief Adds filter as a new node which gets its image from input
+ *
+ * @param filter filter to apply, has to outlive the graph
+ * @param input node whose result is filtered, SOURCE for the source image
+ * @param stage stage of the frame pipeline, for which the time of applying the filter is measured
+ * @return id of the new node
+ */
+FilterGraph::NodeId FilterGraph::addFilter(Filter &filter, NodeId input, diagnostics::Stage stage)
+{
+    if(input != SOURCE && input >= mNodes.size())
+    {
+        throw std::invalid_argument("Input of a filter has to be added to the graph before the filter");
+    }
+    mNodes.push_back({&filter, input, stage});
+    setMemoryLimit(mMemoryLimit);
+    return mNodes.size() - 1;
+}
+
+/**
+ * @brief Sets the image all filters are applied to
+ *
+ * @param img the unfiltered image
+ * @param frame frame number of img, FilterCacheKey::NO_FRAME if the image cannot be identified by the frame number
+ *              (e.g. for a live stream); then the results are not cached
+ */
+void FilterGraph::setSource(const cv::Mat &img, int frame)
+{
+    mSource = img;
+    mFrame  = frame;
+    ++mGeneration;
+}
+
+/**
+ * @brief Returns the result of node for the current source image
+ *
+ * The result is taken from the filter, if it was computed before with the same key. Otherwise the input is computed
+ * (or taken from its cache) and the filter is applied.
+ */
+cv::Mat FilterGraph::result(NodeId node)
+{
+    return result(node, cv::Rect());
+}
+
+/**
+ * @brief Returns the result of node for the current source image, computed at least inside region
+ *
+ * Only the parts of the inputs needed for region are computed. The result has the full size, but outside of the
+ * computed region it is zero. A result of the whole image is used, if it was computed before.
+ *
+ * @param node node whose result is returned
+ * @param region needed part of the result; an empty region for the whole image
+ */
+cv::Mat FilterGraph::result(NodeId node, const cv::Rect &region)
+{
+    if(node == SOURCE)
+    {
+        return mSource;
+    }
+    const Node    &current = mNodes.at(node);
+    FilterCacheKey nodeKey = key(node);
+
+    const cv::Size inputSize = resultSize(current.input);
+    nodeKey.region           = clampRegion(region, current.filter->getResultSize(inputSize));
+    if(auto cached = current.filter->getCachedResult(nodeKey, inputSize))
+    {
+        return *cached;
+    }
+
+    cv::Rect inputRegion; // whole input
+    if(!nodeKey.region.empty())
+    {
+        inputRegion = current.filter->getSourceRegion(nodeKey.region, inputSize);
+    }
+    cv::Mat                  input = result(current.input, inputRegion);
+    diagnostics::ScopedTimer timer(current.stage);
+    return current.filter->apply(input, nodeKey);
+}
+
+/**
+ * @brief Size of the result of node for the current source image
+ */
+cv::Size FilterGraph::resultSize(NodeId node) const
+{
+    if(node == SOURCE)
+    {
+        return mSource.size();
+    }
+    const Node &current = mNodes.at(node);
+    return current.filter->getResultSize(resultSize(current.input));
+}
+
+/**
+ * @brief Key of the result of node, combining the versions of its filter and all filters it depends on
+ */
+FilterCacheKey FilterGraph::key(NodeId node) const
+{
+    FilterCacheKey nodeKey;
+    nodeKey.frame      = mFrame;
+    nodeKey.generation = mFrame == FilterCacheKey::NO_FRAME ? mGeneration : 0;
+    for(; node != SOURCE; node = mNodes.at(node).input)
+    {
+        const std::uint64_t version = mNodes.at(node).filter->getVersion();
+        nodeKey.parameters ^= version + 0x9e3779b97f4a7c15 + (nodeKey.parameters << 6) + (nodeKey.parameters >> 2);
+    }
+    return nodeKey;
+}
+
+/**
+ * @brief Drops all cached results, e.g. when another video is opened
+ */
+void FilterGraph::clearCache()
+{
+    for(const auto &node : mNodes)
+    {
+        node.filter->clearCache();
+    }
+}
+
+/**
+ * @brief Sets the memory which may be used by the cached results of all filters together
+ *
+ * @param bytes memory limit in bytes; 0 disables the caches (the last result of each filter is still kept)
+ */
+void FilterGraph::setMemoryLimit(std::size_t bytes)
+{
+    mMemoryLimit = bytes;
+    for(const auto &node : mNodes)
+    {
+        node.filter->setCacheSize(bytes / mNodes.size());
+    }
+}
+
+std::size_t FilterGraph::memoryUsage() const
+{
+    std::size_t usage = 0;
+    for(const auto &node : mNodes)
+    {
+        usage += node.filter->getCacheUsage();
+    }
+    return usage;
+}
@@ -0,0 +1,83 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILTERGRAPH_H
+#define FILTERGRAPH_H
+
+#include "filter.h"
+#include "filterCache.h"
+#include "frameProfiler.h"
+
+#include <cstddef>
+#include <limits>
+#include <opencv2/core.hpp>
+#include <vector>
+
+/**
+ * @brief Chain of filters with explicit dependencies and cached results
+ *
+ * Each node applies one filter to the result of its input node (or the source image). The result of a node is
+ * identified by the source frame and the parameter versions of its filter and of all filters it depends on, see
+ * FilterCacheKey. A node is only applied again, if its key is neither the last result of the filter nor in its LRU
+ * cache. So changing a filter only reruns this filter and the ones depending on it, and going back to a recently
+ * shown frame takes the results from the caches.
+ *
+ * The memory limit is shared equally by the caches of all filters in the graph.
+ *
+ * A result can be requested for a region only (e.g. the ROIs used for tracking and recognition). Then every node only
+ * computes the part of its result, which the following nodes need for this region, see Filter::getSourceRegion().
+ */
+class FilterGraph
+{
+public:
+    using NodeId = std::size_t;
+
+    static constexpr NodeId      SOURCE               = std::numeric_limits<NodeId>::max();
+    static constexpr std::size_t DEFAULT_MEMORY_LIMIT = std::size_t{512} << 20; // 512 MiB
+
+    explicit FilterGraph(std::size_t memoryLimit = DEFAULT_MEMORY_LIMIT);
+
+    NodeId addFilter(Filter &filter, NodeId input, diagnostics::Stage stage);
+
+    void           setSource(const cv::Mat &img, int frame);
+    cv::Mat        result(NodeId node);
+    cv::Mat        result(NodeId node, const cv::Rect &region);
+    cv::Size       resultSize(NodeId node) const;
+    FilterCacheKey key(NodeId node) const;
+
+    void        clearCache();
+    void        setMemoryLimit(std::size_t bytes);
+    std::size_t memoryLimit() const { return mMemoryLimit; }
+    std::size_t memoryUsage() const;
+
+private:
+    struct Node
+    {
+        Filter            *filter;
+        NodeId             input;
+        diagnostics::Stage stage; ///< stage measured when the filter is applied
+    };
+
+    std::vector<Node> mNodes;
+    cv::Mat           mSource;
+    int               mFrame      = FilterCacheKey::NO_FRAME;
+    std::uint64_t     mGeneration = 0; ///< increased with every new source image
+    std::size_t       mMemoryLimit;
+};
+
+#endif
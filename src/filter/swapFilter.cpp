@@ -54,6 +54,42 @@ cv::Mat SwapFilter::act(cv::Mat &img, cv::Mat &res)
     return res;
 }
 
+/**
+ * @brief Flips only the part of img mirrored to region
+ */
+cv::Mat SwapFilter::actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region)
+{
+    bool sV = mSwapVertically.getValue();
+    bool sH = mSwapHorizontally.getValue();
+
+    if(!sV && !sH)
+    {
+        return img; // nothing to do
+    }
+
+    const int flipCode  = sV && sH ? -1 : (sV ? 0 : 1);
+    cv::Mat   resRegion = res(region);
+    cv::flip(img(sourceRegion(region, img.size())), resRegion, flipCode);
+    return res;
+}
+
+/**
+ * @brief Region of img, which is mirrored to region
+ */
+cv::Rect SwapFilter::sourceRegion(const cv::Rect &region, const cv::Size &imgSize)
+{
+    cv::Rect source = region;
+    if(mSwapHorizontally.getValue())
+    {
+        source.x = imgSize.width - region.x - region.width;
+    }
+    if(mSwapVertically.getValue())
+    {
+        source.y = imgSize.height - region.y - region.height;
+    }
+    return source;
+}
+
 Parameter<bool> &SwapFilter::getSwapHorizontally()
 {
     return mSwapHorizontally;
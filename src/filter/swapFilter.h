@@ -31,7 +31,9 @@ private:
 public:
     SwapFilter();
 
-    cv::Mat act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  act(cv::Mat &img, cv::Mat &res);
+    cv::Mat  actRegion(cv::Mat &img, cv::Mat &res, const cv::Rect &region) override;
+    cv::Rect sourceRegion(const cv::Rect &region, const cv::Size &imgSize) override;
 
     Parameter<bool> &getSwapHorizontally();
     Parameter<bool> &getSwapVertically();
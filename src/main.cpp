@@ -16,14 +16,19 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "batchRunner.h"
 #include "compilerInformation.h"
 #include "control.h"
+#include "frameProfiler.h"
 #include "helper.h"
 #include "logger.h"
 #include "pIO.h"
 #include "petrack.h"
 #include "petrackApplication.h"
+#include "player.h"
+#include "shardedTracking.h"
 #include "tracker.h"
+#include "trackingDiagnostics.h"
 
 #include <QDir>
 #include <QMessageBox>
@@ -69,6 +74,8 @@ int main(int argc, char *argv[])
     QString     autoSaveDest;
     bool        autoSave = false;
     QString     autoTrackDest;
+    QString     autoTrackDiagnosticsFile;
+    QString     autoTrackProfileFile;
     QString     autoPlayDest;
     bool        autoTrack     = false;
     bool        autoPlay      = false;
@@ -84,8 +91,20 @@ int main(int argc, char *argv[])
     bool        autoSaveTracker = false;
     bool        autoExportView  = false;
     QString     exportViewFile;
+    QString     exportOverlayDest;
     bool        didAutosave = false;
 
+    batch::BatchOptions batchOptions;
+    QString             batchWorkerList;
+    QString             batchWorkerReport;
+
+    sharding::ShardOptions shardOptions;
+    int                    trackFirstFrame = 0;
+    int                    trackLastFrame  = -1;
+    QString                detectionCacheFile;
+    bool                   detectAll       = false;
+    int                    nbDetectWorkers = 1;
+
     for(int i = 1; i < arg.size(); ++i) // i=0 ist Programmname
     {
         if(arg.at(i) == "-help" || arg.at(i) == "-?")
@@ -116,6 +135,45 @@ int main(int argc, char *argv[])
             // hat tracker_file bestimmte Dateiendung txt oder trc, dann wird nur genau diese exportiert, sonst beide
             autoTrackDest = arg.at(++i);
         }
+        else if(arg.at(i) == "-trackFrames")
+        {
+            // first-last, e.g. 100-499; used by -trackShards for the worker processes
+            const auto range = arg.at(++i).split('-');
+            trackFirstFrame  = range.value(0).toInt();
+            trackLastFrame   = range.size() > 1 ? range.value(1).toInt() : -1;
+        }
+        else if(arg.at(i) == "-trackShards")
+        {
+            shardOptions.nbShards = arg.at(++i).toInt();
+        }
+        else if(arg.at(i) == "-trackShardOverlap")
+        {
+            shardOptions.overlap = arg.at(++i).toInt();
+        }
+        else if(arg.at(i) == "-trackShardReport")
+        {
+            shardOptions.reportFile = arg.at(++i);
+        }
+        else if(arg.at(i) == "-detectionCache")
+        {
+            detectionCacheFile = arg.at(++i);
+        }
+        else if(arg.at(i) == "-detectAll")
+        {
+            detectAll = true;
+        }
+        else if(arg.at(i) == "-detectWorkers")
+        {
+            nbDetectWorkers = arg.at(++i).toInt();
+        }
+        else if(arg.at(i) == "-autoTrackDiagnostics")
+        {
+            autoTrackDiagnosticsFile = arg.at(++i);
+        }
+        else if(arg.at(i) == "-autoTrackProfile")
+        {
+            autoTrackProfileFile = arg.at(++i);
+        }
         else if((arg.at(i) == "-autoPlay") || (arg.at(i) == "-autoplay"))
         { // nur abspielen und keine aenderungen an control track and reco, um zB groessenbestimmung nachtraeglich
           // vorzunehmen, nachdem haendisch kontrolliert
@@ -169,6 +227,42 @@ int main(int argc, char *argv[])
             exportViewFile = arg.at(++i);
             didAutosave    = true;
         }
+        else if(arg.at(i) == "-autoExportOverlay")
+        {
+            // like -autoExportView, but drawn without the view, so it also works without a display
+            exportOverlayDest = arg.at(++i);
+            didAutosave       = true;
+        }
+        else if(arg.at(i) == "-batch")
+        {
+            // may be given several times; each argument is a project, a wildcard pattern or a list file
+            batchOptions.projectPatterns.append(arg.at(++i));
+        }
+        else if(arg.at(i) == "-batchJobs")
+        {
+            batchOptions.nbWorkers = arg.at(++i).toInt();
+        }
+        else if(arg.at(i) == "-batchSummary")
+        {
+            batchOptions.summaryFile = arg.at(++i);
+        }
+        else if(arg.at(i) == "-batchOutputDir")
+        {
+            batchOptions.outputDir = arg.at(++i);
+        }
+        else if(arg.at(i) == "-batchExportOverlay")
+        {
+            batchOptions.exportOverlay = true;
+        }
+        else if(arg.at(i) == "-batchWorker")
+        {
+            // internal: used by -batch to start the worker processes
+            batchWorkerList = arg.at(++i);
+        }
+        else if(arg.at(i) == "-batchWorkerReport")
+        {
+            batchWorkerReport = arg.at(++i);
+        }
         else
         {
             // hier koennte je nach dateiendung *pet oder *avi oder *png angenommern werden
@@ -185,6 +279,16 @@ int main(int argc, char *argv[])
     SPDLOG_INFO("Compile date: {}", COMPILE_TIMESTAMP);
     SPDLOG_INFO("Build with: {} ({})", COMPILER_ID, COMPILER_VERSION);
 
+    if(!batchWorkerList.isEmpty())
+    {
+        return batch::runBatchWorker(
+            PETRACK_VERSION, batchWorkerList, batchWorkerReport, batchOptions.outputDir, batchOptions.exportOverlay);
+    }
+    if(!batchOptions.projectPatterns.isEmpty())
+    {
+        return batch::runBatch(PETRACK_VERSION, batchOptions);
+    }
+
     Petrack petrack(PETRACK_VERSION);
     petrack.setGitInformation(GIT_COMMIT_HASH, GIT_COMMIT_DATE, GIT_BRANCH);
     petrack.setCompileInformation(COMPILE_OS, COMPILE_TIMESTAMP, COMPILER_ID, COMPILER_VERSION);
@@ -265,6 +369,11 @@ int main(int argc, char *argv[])
         petrack.getControlWidget()->loadExtrinsicCalibFile();
     }
 
+    if(!exportOverlayDest.isEmpty())
+    {
+        return petrack.exportOverlaySequence(exportOverlayDest) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     if(autoExportView)
     {
         QFile outputFile{exportViewFile};
@@ -272,10 +381,54 @@ int main(int argc, char *argv[])
         return EXIT_SUCCESS;
     }
 
+    if(detectAll && detectionCacheFile.isEmpty())
+    {
+        detectionCacheFile = petrack.defaultDetectionCacheFileName();
+    }
+    if(!detectionCacheFile.isEmpty() && !petrack.setDetectionCacheFileName(detectionCacheFile))
+    {
+        return EXIT_FAILURE;
+    }
+    if(detectAll)
+    {
+        const bool detected = nbDetectWorkers > 1 ? sharding::detectSharded(petrack, nbDetectWorkers) :
+                                                    petrack.detectAll(trackFirstFrame, trackLastFrame);
+        if(!detected)
+        {
+            return EXIT_FAILURE;
+        }
+        if(!autoTrack && !autoPlay)
+        {
+            return EXIT_SUCCESS;
+        }
+    }
+
+    if(!autoTrackDiagnosticsFile.isEmpty())
+    {
+        // the diagnostics of the whole run are exported, so no event may be overwritten
+        diagnostics::TrackingDiagnostics::global().setKeepAllEvents(true);
+    }
+
     // hat tracker_file bestimmte Dateiendung txt oder trc, dann wird nur genau diese exportiert, sonst beide
     if(autoTrack)
     {
-        petrack.trackAll();
+        if(shardOptions.nbShards > 1)
+        {
+            if(!sharding::trackSharded(petrack, shardOptions))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            if(trackFirstFrame > 0)
+            {
+                // jump to the first frame without tracking the frames in between
+                petrack.getControlWidget()->setTrackActiveChecked(false);
+                petrack.getPlayer()->skipToFrame(trackFirstFrame);
+            }
+            petrack.trackAll(trackFirstFrame, trackLastFrame);
+        }
 
         if(autoReadMarkerID)
         {
@@ -309,6 +462,14 @@ int main(int argc, char *argv[])
         }
 
         petrack.exportTracker(autoTrackDest);
+        if(!autoTrackDiagnosticsFile.isEmpty())
+        {
+            diagnostics::TrackingDiagnostics::global().exportFile(autoTrackDiagnosticsFile);
+        }
+        if(!autoTrackProfileFile.isEmpty())
+        {
+            diagnostics::FrameProfiler::global().exportFile(autoTrackProfileFile);
+        }
         if(autoSave && (autoSaveDest.endsWith(".pet", Qt::CaseInsensitive)))
         {
             petrack.saveProject(autoSaveDest);
@@ -321,6 +482,14 @@ int main(int argc, char *argv[])
     {
         petrack.playAll();
         petrack.exportTracker(autoPlayDest);
+        if(!autoTrackDiagnosticsFile.isEmpty())
+        {
+            diagnostics::TrackingDiagnostics::global().exportFile(autoTrackDiagnosticsFile);
+        }
+        if(!autoTrackProfileFile.isEmpty())
+        {
+            diagnostics::FrameProfiler::global().exportFile(autoTrackProfileFile);
+        }
         if(autoSave && (autoSaveDest.endsWith(".pet", Qt::CaseInsensitive)))
         {
             petrack.saveProject(autoSaveDest);
@@ -28,8 +28,61 @@
 #include "petrack.h"
 #include "roiItem.h"
 #include "stereoWidget.h"
+#include "trackingDiagnostics.h"
 
 #include <QMessageBox>
+#include <QtConcurrent/QtConcurrentMap>
+#include <numeric>
+
+namespace
+{
+/// number of persons processed in parallel between two calls of the progress hook
+constexpr size_t PARALLEL_BATCH_SIZE = 1024;
+} // namespace
+
+/**
+ * @brief Applies func to the indices of all persons in parallel
+ *
+ * The persons are processed in batches of PARALLEL_BATCH_SIZE, the progress hook is called after each batch from the
+ * calling thread. func must only modify the person with the given index, so the result does not depend on the
+ * scheduling of the threads.
+ *
+ * @param func function which gets called with the index of each person
+ * @param progress optional progress hook, may request cancellation
+ * @return false if the operation was cancelled via the progress hook, else true
+ */
+template <typename Func>
+bool PersonStorage::forEachPersonParallel(Func func, const PersonProgressCallback &progress)
+{
+    const size_t total = mPersons.size();
+    for(size_t begin = 0; begin < total; begin += PARALLEL_BATCH_SIZE)
+    {
+        std::vector<size_t> indices(std::min(PARALLEL_BATCH_SIZE, total - begin));
+        std::iota(indices.begin(), indices.end(), begin);
+        QtConcurrent::blockingMap(indices, [&func](size_t index) { func(index); });
+
+        if(progress && !progress(begin + indices.size(), total))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Restores the persons saved by the last onManualAction()
+ *
+ * Used to roll back an operation which was cancelled via its progress hook.
+ */
+void PersonStorage::restoreLastManualAction()
+{
+    if(!mUndo.empty())
+    {
+        mPersons = mUndo.pop();
+        rebuildFrameIndex();
+        ++mRevision;
+    }
+}
 
 /**
  * @brief split trajectorie pers before frame frame
@@ -45,6 +98,7 @@ void PersonStorage::splitPerson(size_t pers, int frame)
         if(mPersons.at(pers).firstFrame() < frame)
         {
             mPersons.push_back(mPersons.at(pers));
+            updateFrameIndex(mPersons.size() - 1);
 
             // alte trj einkuerzen und ab aktuellem frame zukunft loeschen
             deletePersonFrameRange(pers, frame, mPersons[pers].lastFrame());
@@ -480,6 +534,20 @@ int PersonStorage::calcPosition(int frame)
 }
 
 
+void PersonStorage::addPerson(const TrackPerson &person)
+{
+    mPersons.push_back(person);
+    updateFrameIndex(mPersons.size() - 1);
+    ++mRevision;
+}
+
+void PersonStorage::clear()
+{
+    mPersons.clear();
+    mFrameIndex.clear();
+    ++mRevision;
+}
+
 /**
  * @brief Adds the point to the PersonStorage, either to exising person or creating a new one.
  *
@@ -577,10 +645,13 @@ bool PersonStorage::addPoint(
             {
                 if(found)
                 {
-                    SPDLOG_WARN("multiple possible TrackPoints for point");
-                    SPDLOG_WARN("         {} in frame {} with low distance:", point, frame);
-                    SPDLOG_WARN("         person {} (distance: {})", i + 1, dist);
-                    SPDLOG_WARN("         person {} (distance: {})", iNearest + 1, minDist);
+                    diagnostics::TrackingDiagnostics::global().record(
+                        diagnostics::TrackingEventKind::AmbiguousAssignment,
+                        frame,
+                        i + 1,
+                        static_cast<float>(dist),
+                        static_cast<float>(minDist),
+                        iNearest + 1);
                     if(minDist > dist)
                     {
                         minDist  = dist;
@@ -625,6 +696,8 @@ bool PersonStorage::addPoint(
             }
         }
 
+        updateFrameIndex(iNearest);
+
         if(pers != nullptr)
         {
             *pers = iNearest;
@@ -645,6 +718,7 @@ bool PersonStorage::addPoint(
             frame,
             point,
             codeMarker ? codeMarker->mMarkerId : -1); // 0 is person number/markerID; newReco is set to true by default
+        updateFrameIndex(iNearest);
     }
     if((z > 0) && ((onlyVisible.empty()) || found))
     {
@@ -692,40 +766,31 @@ void PersonStorage::addPoints(QList<TrackPoint> &pL, int frame, reco::Recognitio
 /// Number of visible (TrackPoint exists in current frame) people
 int PersonStorage::visible(int frameNum) const
 {
-    return static_cast<int>(std::count_if(
-        mPersons.begin(),
-        mPersons.end(),
-        [frameNum](const TrackPerson &pers) { return pers.trackPointExist(frameNum); }));
+    return static_cast<int>(mFrameIndex.count(frameNum));
 }
 
 /// Returns the largest first frame of **all** TrackPersons
 int PersonStorage::largestFirstFrame() const
 {
-    auto maxElement = std::max_element(
-        mPersons.cbegin(),
-        mPersons.cend(),
-        [](const TrackPerson &lhs, const TrackPerson &rhs) { return lhs.firstFrame() < rhs.firstFrame(); });
-    return maxElement != mPersons.cend() ? (*maxElement).firstFrame() : -1;
+    return mFrameIndex.largestFirstFrame();
 }
 
 /// Returns the largest last frame of **all** TrackPersons
 int PersonStorage::largestLastFrame() const
 {
-    auto maxElement = std::max_element(
-        mPersons.cbegin(),
-        mPersons.cend(),
-        [](const TrackPerson &lhs, const TrackPerson &rhs) { return lhs.lastFrame() < rhs.lastFrame(); });
-    return maxElement != mPersons.cend() ? (*maxElement).lastFrame() : -1;
+    return mFrameIndex.largestLastFrame();
 }
 
 /// Returns the smallest first frame of **all** TrackPersons
 int PersonStorage::smallestFirstFrame() const
 {
-    auto minElement = std::min_element(
-        mPersons.cbegin(),
-        mPersons.cend(),
-        [](const TrackPerson &lhs, const TrackPerson &rhs) { return lhs.firstFrame() < rhs.firstFrame(); });
-    return minElement != mPersons.cend() ? (*minElement).firstFrame() : -1;
+    return mFrameIndex.smallestFirstFrame();
+}
+
+/// Returns the indices of all TrackPersons with a TrackPoint in [fromFrame, toFrame] in ascending order
+std::vector<size_t> PersonStorage::personsInFrameRange(int fromFrame, int toFrame) const
+{
+    return mFrameIndex.find(fromFrame, toFrame);
 }
 
 /**
@@ -751,8 +816,10 @@ std::vector<PersonFrame>
 PersonStorage::getProximalPersons(const QPointF &pos, QSet<size_t> selected, const FrameRange &frameRange) const
 {
     std::vector<PersonFrame> result;
-    for(int i = 0; i < static_cast<int>(mPersons.size()); ++i)
+    for(size_t index :
+        personsInFrameRange(frameRange.current - frameRange.before, frameRange.current + frameRange.after))
     {
+        const int i = static_cast<int>(index);
         if(!selected.empty() && !selected.contains(i))
         {
             continue;
@@ -787,54 +854,73 @@ PersonStorage::getProximalPersons(const QPointF &pos, QSet<size_t> selected, con
 /**
  * @brief Recalcs the height of all persons (used with stereo)
  * @param altitude altitude of the camera (assumes orthogonal view?)
+ * @param progress optional progress hook; on cancellation all persons are restored
+ * @return false if cancelled, else true
  */
-void PersonStorage::recalcHeight(float altitude)
+bool PersonStorage::recalcHeight(float altitude, const PersonProgressCallback &progress)
 {
     onManualAction();
 
-    for(auto &person : mPersons)
+    if(!forEachPersonParallel([this, altitude](size_t i) { mPersons[i].recalcHeight(altitude); }, progress))
     {
-        person.recalcHeight(altitude);
+        restoreLastManualAction();
+        return false;
     }
+    return true;
 }
 
-/// optimize color for all persons
-void PersonStorage::optimizeColor()
+/// optimize color for all persons; on cancellation via progress all persons are restored
+bool PersonStorage::optimizeColor(const PersonProgressCallback &progress)
 {
     onManualAction();
 
-    for(auto &person : mPersons)
+    auto optimize = [this](size_t i)
     {
-        if(person.color().isValid())
+        if(mPersons[i].color().isValid())
         {
-            person.optimizeColor();
+            mPersons[i].optimizeColor();
         }
+    };
+    if(!forEachPersonParallel(optimize, progress))
+    {
+        restoreLastManualAction();
+        return false;
     }
+    return true;
 }
 
-/// reset the height of all persons, but not the pos of the trackpoints
-void PersonStorage::resetHeight()
+/// reset the height of all persons, but not the pos of the trackpoints; on cancellation all persons are restored
+bool PersonStorage::resetHeight(const PersonProgressCallback &progress)
 {
     onManualAction();
 
-    for(auto &person : mPersons)
+    if(!forEachPersonParallel([this](size_t i) { mPersons[i].resetHeight(); }, progress))
     {
-        person.resetHeight();
+        restoreLastManualAction();
+        return false;
     }
+    return true;
 }
 
-/// reset the pos of the tzrackpoints, but not the heights
-void PersonStorage::resetPos()
+/// reset the pos of the tzrackpoints, but not the heights; on cancellation all persons are restored
+bool PersonStorage::resetPos(const PersonProgressCallback &progress)
 {
     onManualAction();
 
-    for(auto &person : mPersons)
+    auto reset = [this](size_t i)
     {
+        auto &person = mPersons[i];
         for(int frame = person.firstFrame(); frame <= person.lastFrame(); ++frame)
         {
             person.updateStereoPoint(frame, {-1, -1, -1});
         }
+    };
+    if(!forEachPersonParallel(reset, progress))
+    {
+        restoreLastManualAction();
+        return false;
     }
+    return true;
 }
 
 /**
@@ -896,13 +982,21 @@ bool PersonStorage::printHeightDistribution()
 /**
  * Sets the heights based on the values contained in \p heights.
  * @param heights Map between marker ID and corresponding height
+ * @param progress optional progress hook; on cancellation all persons are restored
+ * @return false if cancelled, else true
  */
-void PersonStorage::setMarkerHeights(const std::unordered_map<int, float> &heights)
+bool PersonStorage::setMarkerHeights(
+    const std::unordered_map<int, float> &heights,
+    const PersonProgressCallback         &progress)
 {
     onManualAction();
 
-    for(auto &person : mPersons) // over TrackPerson
+    // marker IDs missing in heights per person; logged afterwards to keep the output in order of the persons
+    std::vector<std::vector<int>> missingMarkerIDs(mPersons.size());
+
+    auto setHeight = [this, &heights, &missingMarkerIDs](size_t i)
     {
+        auto &person = mPersons[i];
         for(const auto &point : person) // over TrackPoints
         {
             if(auto codeMarker = point.getCodeMarker())
@@ -910,18 +1004,32 @@ void PersonStorage::setMarkerHeights(const std::unordered_map<int, float> &heigh
                 // markerID of current person at current TrackPoint:
                 int markerID = codeMarker->mMarkerId;
                 // find index of mID within List of MarkerIDs that were read from txt-file:
-                if(heights.find(markerID) != std::end(heights))
+                if(auto height = heights.find(markerID); height != std::end(heights))
                 {
-                    person.setHeight(heights.at(markerID));
+                    person.setHeight(height->second);
                 }
                 else
                 {
-                    SPDLOG_WARN("The following markerID was not part of the height-file: {}", markerID);
-                    SPDLOG_WARN("No height set for personNR: {}", person.nr());
+                    missingMarkerIDs[i].push_back(markerID);
                 }
             }
         }
+    };
+    if(!forEachPersonParallel(setHeight, progress))
+    {
+        restoreLastManualAction();
+        return false;
     }
+
+    for(size_t i = 0; i < mPersons.size(); ++i)
+    {
+        for(int markerID : missingMarkerIDs[i])
+        {
+            SPDLOG_WARN("The following markerID was not part of the height-file: {}", markerID);
+            SPDLOG_WARN("No height set for personNR: {}", mPersons[i].nr());
+        }
+    }
+    return true;
 }
 
 /**
@@ -1012,6 +1120,8 @@ void PersonStorage::undo()
     {
         mRedo.push(std::move(mPersons));
         mPersons = mUndo.pop();
+        rebuildFrameIndex();
+        ++mRevision;
     }
 }
 
@@ -1021,6 +1131,8 @@ void PersonStorage::redo()
     {
         mUndo.push(std::move(mPersons));
         mPersons = mRedo.pop();
+        rebuildFrameIndex();
+        ++mRevision;
     }
 }
 
@@ -1056,14 +1168,16 @@ void PersonStorage::smoothHeight(size_t i, int j)
         {
             ++nrFor;
         }
-        std::optional<StereoMarker> nrForStereoMarker = mPersons[i].at(j + nrFor).getStereoMarker();
+        std::optional<StereoMarker> nrForStereoMarker =
+            (j + nrFor < tsize) ? mPersons[i].at(j + nrFor).getStereoMarker() : std::nullopt;
 
         // nach && wird nur ausgefuehrt, wenn erstes true == size() also nicht
         while((j - nrRew >= 0) && (!mPersons[i].at(j - nrRew).getStereoMarker()))
         {
             ++nrRew;
         }
-        std::optional<StereoMarker> nrRewStereoMarker = mPersons[i].at(j - nrRew).getStereoMarker();
+        std::optional<StereoMarker> nrRewStereoMarker =
+            (j - nrRew >= 0) ? mPersons[i].at(j - nrRew).getStereoMarker() : std::nullopt;
 
         // nur oder eher in Vergangenheit hoeheninfo gefunden
         if(((j - nrRew >= 0) && (j + nrFor == tsize)) || ((j - nrRew >= 0) && (nrRew < nrFor)))
@@ -1121,6 +1235,27 @@ void PersonStorage::smoothHeight(size_t i, int j)
     }
 }
 
+/**
+ * @brief Smooths the heights of all stereo points of all persons
+ *
+ * The points of one person are smoothed in order, as each smoothing step uses the already smoothed predecessors.
+ * The persons are independent of each other and are processed in parallel.
+ *
+ * @param progress optional progress hook; a cancelled smoothing leaves the already processed persons smoothed
+ * @return false if cancelled, else true
+ */
+bool PersonStorage::smoothHeights(const PersonProgressCallback &progress)
+{
+    auto smooth = [this](size_t i)
+    {
+        for(int j = 0; j < mPersons[i].size(); ++j)
+        {
+            smoothHeight(i, j);
+        }
+    };
+    return forEachPersonParallel(smooth, progress);
+}
+
 /**
  * @brief Inserts the points to the corresponding person
  * @param person index of person to which to add a point
@@ -1145,6 +1280,7 @@ void PersonStorage::insertFeaturePoint(
     {
         mPersons[person].setHeight(z, height);
     }
+    updateFrameIndex(person);
 }
 
 /**
@@ -1194,6 +1330,8 @@ int PersonStorage::merge(int pers1, int pers2)
         keepIndex   = pers1;
     }
     deletePerson(deleteIndex);
+    // the kept person got the frames of the deleted one and moved forward, if the deleted one was before it
+    updateFrameIndex(keepIndex > deleteIndex ? keepIndex - 1 : keepIndex);
     emit changedPerson(keepIndex);
 
     return deleteIndex;
@@ -1202,6 +1340,8 @@ int PersonStorage::merge(int pers1, int pers2)
 std::vector<TrackPerson>::iterator PersonStorage::deletePerson(size_t index)
 {
     auto retIt = mPersons.erase(mPersons.begin() + index);
+    mFrameIndex.erase(index);
+    ++mRevision;
     emit deletedPerson(index);
     return retIt;
 }
@@ -1209,5 +1349,42 @@ std::vector<TrackPerson>::iterator PersonStorage::deletePerson(size_t index)
 void PersonStorage::deletePersonFrameRange(size_t index, int startFrame, int endFrame)
 {
     mPersons[index].removeFramesBetween(startFrame, endFrame);
+    updateFrameIndex(index);
     emit deletedPersonFrameRange(index, startFrame, endFrame);
 }
+
+/**
+ * @brief Rebuilds the index over the frame ranges after all persons were replaced, e.g. by undo
+ */
+void PersonStorage::rebuildFrameIndex()
+{
+    std::vector<FrameRangeIndex::Range> ranges;
+    ranges.reserve(mPersons.size());
+    for(const auto &person : mPersons)
+    {
+        ranges.push_back({person.firstFrame(), person.lastFrame()});
+    }
+    mFrameIndex.rebuild(ranges);
+}
+
+/**
+ * @brief Updates the frame range of the person with the given index in the frame index
+ *
+ * Has to be called after the frame range of a person changed or a person was appended.
+ */
+void PersonStorage::updateFrameIndex(size_t index)
+{
+    const auto &person = mPersons.at(index);
+    if(index < mFrameIndex.size())
+    {
+        mFrameIndex.update(index, person.firstFrame(), person.lastFrame());
+    }
+    else if(index == mFrameIndex.size())
+    {
+        mFrameIndex.pushBack(person.firstFrame(), person.lastFrame());
+    }
+    else
+    {
+        rebuildFrameIndex();
+    }
+}
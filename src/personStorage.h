@@ -21,8 +21,10 @@
 
 #include "circularStack.h"
 #include "frameRange.h"
+#include "frameRangeIndex.h"
 #include "tracker.h"
 
+#include <functional>
 #include <vector>
 
 class Petrack;
@@ -34,6 +36,14 @@ struct PersonFrame
     int frame;
 };
 
+/**
+ * @brief Progress hook for operations over all persons
+ *
+ * Is called from the calling thread with the number of already processed persons and the total number of persons.
+ * Returning false requests the cancellation of the operation.
+ */
+using PersonProgressCallback = std::function<bool(size_t processed, size_t total)>;
+
 class PersonStorage : public QObject
 {
     Q_OBJECT
@@ -64,18 +74,21 @@ public:
 
     size_t             nbPersons() const { return mPersons.size(); }
     const TrackPerson &at(size_t i) const { return mPersons.at(i); }
-    cv::KalmanFilter  &getKalmanFilterOf(size_t i) { return mPersons.at(i).getKalmanFilter(); }
+    PointKalmanFilter &getKalmanFilterOf(size_t i) { return mPersons.at(i).getKalmanFilter(); }
     bool isKalmanFilterOfPersonInitialized(size_t i) const { return mPersons.at(i).isKalmanInitialized(); }
     void initKalmanFilterOfPerson(size_t i, const TrackPoint &firstPoint, const TrackPoint &secondPoint)
     {
         mPersons.at(i).initKalmanFilter(firstPoint, secondPoint);
     }
-    void                            addPerson(const TrackPerson &person) { mPersons.push_back(person); }
+    void                            addPerson(const TrackPerson &person);
     const std::vector<TrackPerson> &getPersons() const { return mPersons; }
 
     IntervalList<int>       &getGroupList(size_t person) { return mPersons.at(person).getGroups(); }
     const IntervalList<int> &getGroupList(size_t person) const { return mPersons.at(person).getGroups(); }
 
+    /// changes whenever persons are added, deleted or replaced as a whole (e.g. by undo), not by split or new points
+    size_t getRevision() const { return mRevision; }
+
     // used for calculation of 3D point for all points in frame
     // returns number of found points or -1 if no stereoContext available (also points without disp found are counted)
     int calcPosition(int frame);
@@ -99,11 +112,14 @@ public:
     std::vector<PersonFrame>
     getProximalPersons(const QPointF &pos, QSet<size_t> selected, const FrameRange &frameRange) const;
 
-    void recalcHeight(float altitude);
+    std::vector<size_t> personsInFrameRange(int fromFrame, int toFrame) const;
+
+    bool recalcHeight(float altitude, const PersonProgressCallback &progress = {});
 
-    void clear() { mPersons.clear(); }
+    void clear();
 
     void smoothHeight(size_t i, int j);
+    bool smoothHeights(const PersonProgressCallback &progress = {});
 
     void insertFeaturePoint(
         size_t            person,
@@ -116,18 +132,18 @@ public:
         float             height);
     int merge(int pers1, int pers2);
 
-    void optimizeColor();
+    bool optimizeColor(const PersonProgressCallback &progress = {});
 
     // reset the height of all persons, but not the pos of the trackpoints
-    void resetHeight();
+    bool resetHeight(const PersonProgressCallback &progress = {});
 
     // reset the pos of the tzrackpoints, but not the heights
-    void resetPos();
+    bool resetPos(const PersonProgressCallback &progress = {});
 
     // gibt groessenverteilung der personen auf stdout aus
     // rueckgabewert false wenn keine hoeheninformationen in tracker datensatz vorliegt
     bool printHeightDistribution();
-    void setMarkerHeights(const std::unordered_map<int, float> &heights);
+    bool setMarkerHeights(const std::unordered_map<int, float> &heights, const PersonProgressCallback &progress = {});
     void setMarkerID(size_t personIndex, int markerIDs, bool manual = false);
     void setMarkerIDs(const std::unordered_map<int, int> &markerIDs);
     void purge(int frame);
@@ -153,6 +169,18 @@ private:
     CircularStack<std::vector<TrackPerson>, 10> mUndo;
     CircularStack<std::vector<TrackPerson>, 10> mRedo;
 
+    // frame ranges of mPersons; kept up to date with every change of mPersons
+    FrameRangeIndex mFrameIndex;
+
+    size_t mRevision = 0;
+
+    void updateFrameIndex(size_t index);
+    void rebuildFrameIndex();
+
+    template <typename Func>
+    bool forEachPersonParallel(Func func, const PersonProgressCallback &progress);
+    void restoreLastManualAction();
+
     std::vector<TrackPerson>::iterator deletePerson(size_t index);
     void                               deletePersonFrameRange(size_t index, int startFrame, int endFrame);
 };
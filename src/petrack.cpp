@@ -42,8 +42,10 @@
 #include "coordItem.h"
 #include "coordinateSystemBox.h"
 #include "editMoCapDialog.h"
+#include "exportPipeline.h"
 #include "extrinsicBox.h"
 #include "filterBeforeBox.h"
+#include "frameProfiler.h"
 #include "gridItem.h"
 #include "imageItem.h"
 #include "importHelper.h"
@@ -56,8 +58,10 @@
 #include "multiColorMarkerItem.h"
 #include "multiColorMarkerWidget.h"
 #include "openMoCapDialog.h"
+#include "overlayRenderer.h"
 #include "pIO.h"
 #include "pMessageBox.h"
+#include "pProgressDialog.h"
 #include "person.h"
 #include "petrack.h"
 #include "player.h"
@@ -68,11 +72,17 @@
 #include "tracker.h"
 #include "trackerItem.h"
 #include "trackerReal.h"
+#include "trackingDiagnostics.h"
 #include "view.h"
 #include "walkAreaManager.h"
 #include "walkAreaWidget.h"
 #include "worldImageCorrespondence.h"
 
+#include <QAbstractButton>
+#include <QAbstractSlider>
+#include <QComboBox>
+#include <QDir>
+#include <QDoubleSpinBox>
 #include <QFileDialog>
 #include <QFontDialog>
 #include <QInputDialog>
@@ -82,8 +92,10 @@
 #include <QMessageBox>
 #include <QProgressDialog>
 #include <QScrollBar>
+#include <QSpinBox>
 #include <QSplitter>
 #include <QStatusBar>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtPrintSupport/QPrintDialog>
 #include <QtPrintSupport/QPrinter>
 #include <cmath>
@@ -108,6 +120,7 @@ Petrack::Petrack(QString petrackVersion) :
     mTracker             = nullptr;
     mTrackerReal         = nullptr; // damit beim zeichnen von control mit analysePlot nicht auf einen feheler laeuft
     mStatusLabelFPS      = nullptr;
+    mStatusLabelTiming   = nullptr;
     mStatusPosRealHeight = nullptr;
     mStatusLabelPosReal  = nullptr;
     mImageItem           = nullptr;
@@ -127,6 +140,14 @@ Petrack::Petrack(QString petrackVersion) :
     mBackgroundFilter.disable();
     mStereoContext = nullptr;
     mCalibFilter.disable();
+
+    // When applying the filter, the order is important!
+    // Computation heavy filter should be applied early.
+    const auto swapNode = mFilterGraph.addFilter(mSwapFilter, FilterGraph::SOURCE, diagnostics::Stage::SwapFilter);
+    const auto brightContrastNode =
+        mFilterGraph.addFilter(mBrightContrastFilter, swapNode, diagnostics::Stage::BrightContrastFilter);
+    mBorderNode = mFilterGraph.addFilter(mBorderFilter, brightContrastNode, diagnostics::Stage::BorderFilter);
+    mCalibNode  = mFilterGraph.addFilter(mCalibFilter, mBorderNode, diagnostics::Stage::CalibFilter);
     mScene = new QGraphicsScene(this);
 
     mTrackingRoiItem = new RoiItem(this, Qt::blue);
@@ -371,6 +392,7 @@ Petrack::Petrack(QString petrackVersion) :
     createActions();
     createMenus();
     createStatusBar();
+    connectProjectChangeSignals();
 
     auto *exportShortCut = new QShortcut{QKeySequence("Shift+e"), this};
     connect(exportShortCut, &QShortcut::activated, this, [this]() { exportTracker(); });
@@ -514,6 +536,8 @@ void Petrack::openXml(QDomDocument &doc, bool openSeq)
     int         zoom = 250, rotate = 0, hScroll = 0, vScroll = 0;
     Camera      cam = Camera::cameraUnset;
     setLoading(true);
+    // the settings are applied in bulk; the widgets changed on the way would update the image several times
+    mDeferImageUpdates = true;
     auto petVersion       = root.attribute("VERSION");
     bool playerLooping    = false;
     bool playerSpeedFixed = false;
@@ -679,21 +703,15 @@ void Petrack::openXml(QDomDocument &doc, bool openSeq)
             // reset background and first skip to selected frame
             mBackgroundFilter.reset();
         }
-        if(frame == mAnimation.getCurrentFrameNum())
-        {
-            //  needed such that e.g. the calibration is marked as known
-            //  else, the first updateImage call would be after loading the trajectories
-            //  and they would be immediately deleted, because the intrinsic is new
-            //  skipToFrame only calls it if we are not already there
-            updateImage();
-        }
-        // will call updateImage and update bg
         mPlayerWidget->skipToFrame(frame);
     }
-    else if(loaded)
-    {
-        updateImage();
-    }
+
+    // update the image once for all settings applied so far
+    //  needed such that e.g. the calibration is marked as known
+    //  else, the first updateImage call would be after loading the trajectories
+    //  and they would be immediately deleted, because the intrinsic is new
+    flushImageUpdates(frame != -1 || loaded);
+    mDeferImageUpdates = true;
 
     // nicht schon in control, sonst loescht opensequence wieder tracker
     if(mTrcFileName != "")
@@ -733,10 +751,29 @@ void Petrack::openXml(QDomDocument &doc, bool openSeq)
         setSequenceFPS(sequenceFps); // set here to override the fps from the default fps of the sequence
     }
 
-    updateImage(); // needed to undistort, draw border, etc. for first display
+    mDeferImageUpdates = false;
+    updateImage(mPendingImageChanged); // needed to undistort, draw border, etc. for first display
+    mImageUpdatePending  = false;
+    mPendingImageChanged = false;
     setLoading(false);
 }
 
+/**
+ * @brief Stops deferring image updates and performs the deferred update (if any)
+ *
+ * @param force update the image even if no update was deferred
+ */
+void Petrack::flushImageUpdates(bool force)
+{
+    mDeferImageUpdates = false;
+    if(mImageUpdatePending || force)
+    {
+        updateImage(mPendingImageChanged);
+    }
+    mImageUpdatePending  = false;
+    mPendingImageChanged = false;
+}
+
 /**
  * Open a petrack project.
  * When mProFileName is set and a file, this method will ask to save the project before opening the new one.
@@ -835,6 +872,11 @@ void Petrack::openProject(QString fileName, bool openSeq) // default fileName=""
             return;
         }
         mLastTrackerExport = mTrcFileName;
+        // use the detections of a previous -detectAll
+        if(QFileInfo::exists(defaultDetectionCacheFileName()))
+        {
+            setDetectionCacheFileName(defaultDetectionCacheFileName());
+        }
         updateWindowTitle();
     }
 }
@@ -947,6 +989,53 @@ void Petrack::saveXml(QDomDocument &doc)
     root.appendChild(elem);
 }
 
+/**
+ * @brief Updates the serialized project state (mProjectFile) to the current settings
+ * @return names of the sections of the .pet file which changed since the last update
+ */
+QStringList Petrack::updateProjectFile()
+{
+    QDomDocument doc("PETRACK"); // eigentlich Pfad zu Beschreibungsdatei fuer Dateiaufbau
+    saveXml(doc);
+    mProjectChanged = false;
+    return mProjectFile.update(doc);
+}
+
+/**
+ * @brief Flags the project as changed whenever one of the settings widgets is edited
+ *
+ * Together with updateImage(), which is called for all changes of the image (filters, ROIs, calibration, frame),
+ * this lets the autosave skip serializing an unchanged project.
+ */
+void Petrack::connectProjectChangeSignals()
+{
+    const auto changed = [this]() { setProjectChanged(); };
+    for(auto *button : findChildren<QAbstractButton *>())
+    {
+        connect(button, &QAbstractButton::toggled, this, changed);
+    }
+    for(auto *spinBox : findChildren<QSpinBox *>())
+    {
+        connect(spinBox, &QSpinBox::valueChanged, this, changed);
+    }
+    for(auto *spinBox : findChildren<QDoubleSpinBox *>())
+    {
+        connect(spinBox, &QDoubleSpinBox::valueChanged, this, changed);
+    }
+    for(auto *slider : findChildren<QAbstractSlider *>())
+    {
+        connect(slider, &QAbstractSlider::valueChanged, this, changed);
+    }
+    for(auto *comboBox : findChildren<QComboBox *>())
+    {
+        connect(comboBox, &QComboBox::currentIndexChanged, this, changed);
+    }
+    for(auto *lineEdit : findChildren<QLineEdit *>())
+    {
+        connect(lineEdit, &QLineEdit::textChanged, this, changed);
+    }
+}
+
 /// rueckgabewert zeigt an, ob gesichert werden konnte
 bool Petrack::saveSameProject()
 {
@@ -983,32 +1072,15 @@ bool Petrack::saveProject(QString fileName) // default fileName=""
     }
 
     setProFileName(fileName);
-    QDomDocument doc("PETRACK"); // eigentlich Pfad zu Beschreibungsdatei fuer Dateiaufbau
-    saveXml(doc);
-
-    // file output
-    QByteArray       byteArray;
-    QXmlStreamWriter xmlStream(&byteArray);
-    xmlStream.setAutoFormatting(true);
-    xmlStream.setAutoFormattingIndent(4);
+    updateProjectFile();
 
-    xmlStream.writeStartDocument();
-    xmlStream.writeDTD("<!DOCTYPE PETRACK>");
-
-    QDomElement element = doc.documentElement();
-    writeXmlElement(xmlStream, element);
-
-    xmlStream.writeEndDocument();
-
-    QFile file(fileName);
-    if(!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+    // only writes, if the file does not already contain the current state
+    QString errorString;
+    if(!mProjectFile.write(fileName, &errorString))
     {
-        PCritical(this, tr("PeTrack"), tr("Cannot save %1:\n%2.").arg(fileName, file.errorString()));
-        file.close();
+        PCritical(this, tr("PeTrack"), tr("Cannot save %1:\n%2.").arg(fileName, errorString));
         return false;
     }
-    file.write(byteArray);
-    file.close(); // also flushes the file
 
     SPDLOG_INFO("save project to {}", fileName);
 
@@ -1016,40 +1088,6 @@ bool Petrack::saveProject(QString fileName) // default fileName=""
     return true;
 }
 
-void Petrack::writeXmlElement(QXmlStreamWriter &xmlStream, QDomElement element)
-{
-    xmlStream.writeStartElement(element.tagName());
-
-    QVector<QString>       attribute_names;
-    const QDomNamedNodeMap attributes = element.attributes();
-    for(int i = 0; i < attributes.size(); ++i)
-    {
-        attribute_names.push_back(attributes.item(i).toAttr().name());
-    }
-
-    // TODO: check if sorting of elements fits our needs
-    std::stable_sort(attribute_names.begin(), attribute_names.end()); // for a canonical XML
-
-    // Wants this macro instead of range-based for loop
-    foreach(QString name, attribute_names)
-    {
-        QDomAttr attr = element.attributeNode(name);
-        xmlStream.writeAttribute(attr.name(), attr.value());
-    }
-
-    // order of child nodes is defined at creation
-    if(element.hasChildNodes())
-    {
-        const QDomNodeList children = element.childNodes();
-        for(int i = 0; i < children.size(); ++i)
-        {
-            writeXmlElement(xmlStream, children.at(i).toElement());
-        }
-    }
-
-    xmlStream.writeEndElement();
-}
-
 /**
  * @brief Opens camera livestream from cam with camID
  * @param camID id of camera to use (defaults to 0)
@@ -1272,43 +1310,46 @@ void Petrack::exportSequence(bool exportVideo, bool exportView, QString dest) //
 
     if(!dest.isEmpty() && mImage)
     {
-        int       rest             = mAnimation.getNumFrames() - 1;
-        int       numLength        = 1;
-        int       memPos           = mPlayerWidget->getPos();
-        QString   fileName         = "";
-        bool      formatIsSaveAble = false;
-        bool      saveRet;
-        QImage   *viewImage = nullptr;
-        QPainter *painter   = nullptr;
-        int       progEnd   = mAnimation.getSourceOutFrameNum() -
+        int     rest             = mAnimation.getNumFrames() - 1;
+        int     numLength        = 1;
+        int     memPos           = mPlayerWidget->getPos();
+        QString fileName         = "";
+        bool    formatIsSaveAble = false;
+        int     progEnd          = mAnimation.getSourceOutFrameNum() -
                       mPlayerWidget->getPos(); // nur wenn nicht an anfang gesprungen wird:-mPlayerWidget->getPos()
-        cv::Mat         iplImgFilteredBGR;
-        bool            writeFrameRet = false;
         cv::VideoWriter outputVideo;
 
-        if(exportVideo)
+        QSize viewSize;
+        if(exportView)
         {
-            if(exportView)
+            viewSize = mCropZoomViewAct->isChecked() ? mView->viewport()->size() :
+                                                       QSize((int) mScene->width(), (int) mScene->height());
+        }
+        // rendering has to happen in the gui thread, each frame gets its own image to be written in the background
+        auto renderView = [this, &viewSize]()
+        {
+            QImage   viewImage(viewSize, QImage::Format_RGB32);
+            QPainter painter(&viewImage);
+            if(mCropZoomViewAct->isChecked())
             {
-                if(mCropZoomViewAct->isChecked())
-                {
-                    viewImage =
-                        new QImage(mView->viewport()->width(), mView->viewport()->height(), QImage::Format_RGB32);
-                }
-                else
-                {
-                    viewImage = new QImage((int) mScene->width(), (int) mScene->height(), QImage::Format_RGB32);
-                }
-                painter = new QPainter();
+                mView->render(&painter);
+            }
+            else
+            {
+                mScene->render(&painter);
             }
+            return viewImage;
+        };
 
+        if(exportVideo)
+        {
             if(exportView)
             {
                 outputVideo = cv::VideoWriter(
                     dest.toStdString(),
                     fourcc,
                     mAnimation.getSequenceFPS(),
-                    cv::Size(viewImage->width(), viewImage->height()));
+                    cv::Size(viewSize.width(), viewSize.height()));
             }
             else
             {
@@ -1324,20 +1365,6 @@ void Petrack::exportSequence(bool exportVideo, bool exportView, QString dest) //
 
         if(!exportVideo)
         {
-            if(exportView)
-            {
-                if(mCropZoomViewAct->isChecked())
-                {
-                    viewImage =
-                        new QImage(mView->viewport()->width(), mView->viewport()->height(), QImage::Format_RGB32);
-                }
-                else
-                {
-                    viewImage = new QImage((int) mScene->width(), (int) mScene->height(), QImage::Format_RGB32);
-                }
-                painter = new QPainter();
-            }
-
             // test, if fileformat is supported
             if(mAnimation.isVideo())
             {
@@ -1354,40 +1381,14 @@ void Petrack::exportSequence(bool exportVideo, bool exportView, QString dest) //
                 fileName = dest + "/" + mAnimation.getCurrentFileName();
             }
 
-            if(exportView)
-            {
-                painter->begin(viewImage);
-                if(mCropZoomViewAct->isChecked())
-                {
-                    mView->render(painter);
-                }
-                else
-                {
-                    mScene->render(painter);
-                }
-                painter->end();
-
-                if(viewImage->save(fileName)) //, const char * format = 0 (format wird aus dateinamen geholt), int
-                                              // quality = -1 default normal (0..100)
-                {
-                    formatIsSaveAble = true;
-                    mPlayerWidget->frameForward();
-                }
-            }
-            else if(mImage->save(fileName)) //, const char * format = 0 (format wird aus dateinamen geholt), int quality
-                                            //= -1 default normal (0..100)
+            const QImage firstImage = exportView ? renderView() : *mImage;
+            if(firstImage.save(fileName)) //, const char * format = 0 (format wird aus dateinamen geholt), int
+                                          // quality = -1 default normal (0..100)
             {
                 formatIsSaveAble = true;
                 mPlayerWidget->frameForward();
             }
         }
-        else if((mImgFiltered.channels() == 1) /*&& convert8To24bit*/)
-        {
-            cv::Size size;
-            size.width  = mImgFiltered.cols;
-            size.height = mImgFiltered.rows;
-            iplImgFilteredBGR.create(size, CV_8UC3);
-        }
 
         QProgressDialog progress("", "Abort export", 0, progEnd, this);
         progress.setWindowModality(Qt::WindowModal); // blocks main window
@@ -1415,6 +1416,10 @@ void Petrack::exportSequence(bool exportVideo, bool exportView, QString dest) //
             }
         }
 
+        // the video is encoded by a single thread to keep the order of the frames, image files are compressed by
+        // several threads in parallel
+        ExportPipeline pipeline(exportVideo ? 1 : ExportPipeline::idealImageWorkerCount());
+
         do
         {
             progress.setValue(
@@ -1425,123 +1430,93 @@ void Petrack::exportSequence(bool exportVideo, bool exportView, QString dest) //
                 break;
             }
 
+            bool enqueued = false;
             if(exportVideo)
             {
                 // video sequence
                 if(exportView)
                 {
-                    painter->begin(viewImage);
-                    if(mCropZoomViewAct->isChecked())
-                    {
-                        mView->render(painter);
-                    }
-                    else
-                    {
-                        mScene->render(painter);
-                    }
-                    painter->end();
-                }
-
-                if(exportView)
-                {
-                    cv::Mat frame(
-                        viewImage->height(),
-                        viewImage->width(),
-                        CV_8UC4,
-                        (unsigned char *) viewImage->bits(),
-                        viewImage->bytesPerLine());
-                    cv::cvtColor(frame, frame, cv::COLOR_RGBA2RGB); // need for right image interpretation
-                    outputVideo.write(frame);
-                    writeFrameRet = true;
+                    enqueued = pipeline.enqueue(
+                        [&outputVideo, viewImage = renderView()]
+                        {
+                            cv::Mat frame(
+                                viewImage.height(),
+                                viewImage.width(),
+                                CV_8UC4,
+                                const_cast<uchar *>(viewImage.constBits()),
+                                viewImage.bytesPerLine());
+                            cv::Mat frameRGB;
+                            cv::cvtColor(frame, frameRGB, cv::COLOR_RGBA2RGB); // need for right image interpretation
+                            outputVideo.write(frameRGB);
+                            return outputVideo.isOpened();
+                        },
+                        dest);
                 }
                 else
                 {
-                    cv::Mat frame = mImgFiltered.clone();
-                    outputVideo.write(frame);
-                    writeFrameRet = true;
-                }
-
-                if(!writeFrameRet)
-                {
-                    progress.setValue(progEnd);
-                    PCritical(
-                        this,
-                        tr("PeTrack"),
-                        tr("Cannot export %1 maybe because of wrong file extension or unsupported codec.").arg(dest));
-                    break;
+                    enqueued = pipeline.enqueue(
+                        [&outputVideo, frame = mImgFiltered.clone()]
+                        {
+                            outputVideo.write(frame);
+                            return outputVideo.isOpened();
+                        },
+                        dest);
                 }
             }
             else
             {
                 // single frame sequence
-                if(exportView)
-                {
-                    painter->begin(viewImage);
-                    if(mCropZoomViewAct->isChecked())
-                    {
-                        mView->render(painter);
-                    }
-                    else
-                    {
-                        mScene->render(painter);
-                    }
-                    painter->end();
-                }
+                // QImage is implicitly shared; mImage is replaced and its frame buffer not modified by the next frame
+                const QImage image  = exportView ? renderView() : *mImage;
+                const char  *format = nullptr;
                 if(mAnimation.isVideo())
                 {
                     fileName = (dest + "/" + mAnimation.getFileBase() + "%1.png")
                                    .arg(mPlayerWidget->getPos(), numLength, 10, QChar('0'));
-                    if(exportView)
-                    {
-                        saveRet = viewImage->save(fileName);
-                    }
-                    else
-                    {
-                        saveRet = mImage->save(fileName);
-                    }
                 }
                 else if(formatIsSaveAble)
                 {
                     fileName = dest + "/" + mAnimation.getCurrentFileName();
-                    if(exportView)
-                    {
-                        saveRet = viewImage->save(fileName);
-                    }
-                    else
-                    {
-                        saveRet = mImage->save(fileName);
-                    }
                 }
                 else
                 {
                     fileName = dest + "/" + QFileInfo(mAnimation.getCurrentFileName()).completeBaseName() + ".png";
-                    if(exportView)
-                    {
-                        saveRet = viewImage->save(fileName);
-                    }
-                    else
-                    {
-                        saveRet = mImage->save(fileName, "PNG"); //, int quality = -1 default normal (0..100)
-                    }
-                }
-                if(!saveRet)
-                {
-                    progress.setValue(progEnd);
-                    PCritical(this, tr("PeTrack"), tr("Cannot export %1.").arg(fileName));
-                    break;
+                    format   = exportView ? nullptr : "PNG"; //, int quality = -1 default normal (0..100)
                 }
+                enqueued = pipeline.enqueue(
+                    [image, fileName, format] { return image.save(fileName, format); }, fileName);
+            }
+
+            if(!enqueued)
+            {
+                break;
             }
         } while(mPlayerWidget->frameForward());
 
-        if(!exportVideo && exportView)
+        const bool success = pipeline.finish();
+        if(!success)
         {
-            delete viewImage;
-            delete painter;
+            progress.setValue(progEnd);
+            if(exportVideo)
+            {
+                PCritical(
+                    this,
+                    tr("PeTrack"),
+                    tr("Cannot export %1 maybe because of wrong file extension or unsupported codec.").arg(dest));
+            }
+            else
+            {
+                PCritical(this, tr("PeTrack"), tr("Cannot export %1.").arg(pipeline.failedJob()));
+            }
         }
 
         // bei abbruch koennen es auch mPlayerWidget->getPos() frames sein, die bisher geschrieben wurden
         //-memPos nur, wenn nicht an den anfang gesprungen wird
-        SPDLOG_INFO("wrote {} of {} frames.", mPlayerWidget->getPos() + 1 - memPos, mAnimation.getNumFrames());
+        SPDLOG_INFO(
+            "wrote {} of {} frames ({:.1f} frames per second).",
+            mPlayerWidget->getPos() + 1 - memPos,
+            mAnimation.getNumFrames(),
+            pipeline.jobsPerSecond());
         progress.setValue(progEnd);
 
         if(exportVideo)
@@ -1554,6 +1529,108 @@ void Petrack::exportSequence(bool exportVideo, bool exportView, QString dest) //
     }
 }
 
+/**
+ * @brief Exports the sequence with trajectories and walk area drawn by an OverlayRenderer
+ *
+ * In contrast to exportSequence() with exportView, the overlays are not rendered through the scene and the view, so
+ * no visible window is needed (e.g. with QT_QPA_PLATFORM=offscreen in batch mode). The frames are rendered in parallel
+ * from the current frame on till the end. Tracking and recognition are paused meanwhile, since the trajectories are
+ * read by the render threads.
+ *
+ * @param dest video file (mp4 or avi) or folder for an image sequence (png)
+ * @return true if all frames were written
+ */
+bool Petrack::exportOverlaySequence(const QString &dest)
+{
+    if(dest.isEmpty() || !mImage)
+    {
+        return false;
+    }
+    const auto extension   = dest.right(4).toLower();
+    const bool exportVideo = (extension == ".mp4") || (extension == ".avi");
+    if(exportVideo && mAnimation.getSequenceFPS() <= 0)
+    {
+        SPDLOG_ERROR("Sequence FPS is not set, cannot export {}", dest);
+        return false;
+    }
+
+    const bool memTrackState = mControlWidget->isTrackActiveChecked();
+    const bool memRecoState  = mControlWidget->isRecoActiveChecked();
+    const int  memPos        = mPlayerWidget->getPos();
+    mControlWidget->setTrackActiveChecked(false);
+    mControlWidget->setRecoActiveChecked(false);
+
+    auto renderer = std::make_shared<const OverlayRenderer>(mPersonStorage, OverlaySettings::fromProject(*this));
+
+    cv::VideoWriter outputVideo;
+    if(exportVideo)
+    {
+        const int fourcc = (extension == ".mp4") ? cv::VideoWriter::fourcc('m', 'p', '4', 'v') :
+                                                   cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+        outputVideo.open(
+            dest.toStdString(), fourcc, mAnimation.getSequenceFPS(), cv::Size(mImgFiltered.cols, mImgFiltered.rows));
+    }
+    else
+    {
+        QDir().mkpath(dest);
+    }
+    const int numLength = static_cast<int>(QString::number(mAnimation.getNumFrames() - 1).size());
+
+    // the video is written by a single thread in frame order, the frames are rendered in parallel beforehand
+    ExportPipeline pipeline(exportVideo ? 1 : ExportPipeline::idealImageWorkerCount());
+    do
+    {
+        const int     frame = mAnimation.getCurrentFrameNum();
+        const cv::Mat img   = mImgFiltered.clone();
+        bool          enqueued;
+        if(exportVideo)
+        {
+            QFuture<cv::Mat> rendered =
+                QtConcurrent::run([renderer, img, frame] { return renderer->render(img, frame); });
+            enqueued = pipeline.enqueue(
+                [&outputVideo, rendered]
+                {
+                    outputVideo.write(rendered.result());
+                    return outputVideo.isOpened();
+                },
+                dest);
+        }
+        else
+        {
+            const QString fileName =
+                (dest + "/" + mAnimation.getFileBase() + "%1.png").arg(frame, numLength, 10, QChar('0'));
+            enqueued = pipeline.enqueue(
+                [renderer, img, frame, fileName]
+                { return cv::imwrite(fileName.toStdString(), renderer->render(img, frame)); },
+                fileName);
+        }
+        if(!enqueued)
+        {
+            break;
+        }
+    } while(mPlayerWidget->frameForward());
+
+    const bool success = pipeline.finish();
+    if(success)
+    {
+        SPDLOG_INFO(
+            "wrote {} frames with overlays to {} ({:.1f} frames per second).",
+            pipeline.completedJobs(),
+            dest,
+            pipeline.jobsPerSecond());
+    }
+    else
+    {
+        SPDLOG_ERROR("Cannot export {}", pipeline.failedJob());
+    }
+    outputVideo.release();
+
+    mPlayerWidget->skipToFrame(memPos);
+    mControlWidget->setRecoActiveChecked(memRecoState);
+    mControlWidget->setTrackActiveChecked(memTrackState);
+    return success;
+}
+
 /**
  * @brief Saves the current View, including visualizations, in a file (e.g. pdf)
  *
@@ -1998,6 +2075,16 @@ void Petrack::createActions()
     mAutosaveSettings = new QAction(tr("Autosave Settings"), this);
     connect(mAutosaveSettings, &QAction::triggered, this, &Petrack::openAutosaveSettings);
 
+    mFilterCacheSettings = new QAction(tr("Filter Cache Size"), this);
+    mFilterCacheSettings->setToolTip(tr("Memory for filtered images of recently shown frames"));
+    connect(mFilterCacheSettings, &QAction::triggered, this, &Petrack::openFilterCacheSettings);
+
+    mRestrictFiltersToRoiAct = new QAction(tr("Restrict Filters to ROIs"), this);
+    mRestrictFiltersToRoiAct->setCheckable(true);
+    mRestrictFiltersToRoiAct->setToolTip(
+        tr("While playing or tracking all frames, only the tracking and recognition ROIs are filtered; the rest of "
+           "the image stays black until the run ends"));
+
     mSetSequenceFPSAct = new QAction(tr("Set Sequence FPS"), this);
     mSetSequenceFPSAct->setEnabled(false);
     mSetSequenceFPSAct->setToolTip(tr("Set native FPS of sequence/video (not playback speed)"));
@@ -2200,6 +2287,8 @@ void Petrack::createMenus()
     mFileMenu->addSeparator();
     mFileMenu->addAction(mResetSettingsAct);
     mFileMenu->addAction(mAutosaveSettings);
+    mFileMenu->addAction(mFilterCacheSettings);
+    mFileMenu->addAction(mRestrictFiltersToRoiAct);
     mFileMenu->addSeparator();
     mFileMenu->addAction(mExitAct);
 
@@ -2311,6 +2400,7 @@ void Petrack::createStatusBar()
     statusBar()->addPermanentWidget(mFpsNum);
     statusBar()->addPermanentWidget(mFpsLabel);
     statusBar()->addPermanentWidget(mStatusLabelFPS = new QLabel(" "));
+    statusBar()->addPermanentWidget(mStatusLabelTiming = new QLabel(" "));
     statusBar()->addPermanentWidget(mStatusPosRealHeight = new QDoubleSpinBox());
     connect(
         mStatusPosRealHeight,
@@ -2329,6 +2419,8 @@ void Petrack::createStatusBar()
     mStatusLabelFPS->setMinimumWidth(80);
     mStatusLabelFPS->setAutoFillBackground(true);
     mStatusLabelFPS->setToolTip("Click to adapt play rate to fps rate");
+    mStatusLabelTiming->setFont(f2);
+    mStatusLabelTiming->setMinimumWidth(static_cast<int>(fm2.horizontalAdvance("999.9ms (optical_flow 99.9)") + 1));
     mStatusPosRealHeight->setRange(-999.9, 9999.9); // in cm
     mStatusPosRealHeight->setDecimals(1);
     mStatusPosRealHeight->setFont(f);
@@ -2407,6 +2499,51 @@ void Petrack::setStatusFPS()
         mStatusLabelFPS->setPalette(pal);
     }
 }
+/**
+ * @brief Shows the mean processing time of the last frames and the stage which took the most time
+ *
+ * The time of all stages and the counters are shown as tool tip. To keep the overhead low, the label is updated at
+ * most four times per second.
+ */
+void Petrack::setStatusFrameTiming()
+{
+    constexpr std::size_t nbFrames = 25;
+    static QElapsedTimer  lastUpdate;
+
+    if(!mStatusLabelTiming || (lastUpdate.isValid() && lastUpdate.elapsed() < 250))
+    {
+        return;
+    }
+    lastUpdate.start();
+
+    const auto timing = diagnostics::FrameProfiler::global().mean(nbFrames);
+    auto       toMs   = [](std::int64_t ns) { return static_cast<double>(ns) * 1e-6; };
+
+    QString toolTip = QString("Mean time per frame of the last %1 frames in ms:").arg(nbFrames);
+    auto    slowest = diagnostics::Stage::Decode;
+    for(std::size_t i = 0; i < diagnostics::NB_STAGES; ++i)
+    {
+        const auto stage = static_cast<diagnostics::Stage>(i);
+        toolTip += QString("\n%1: %2").arg(diagnostics::toString(stage)).arg(toMs(timing.ns(stage)), 0, 'f', 2);
+        if(timing.ns(stage) > timing.ns(slowest))
+        {
+            slowest = stage;
+        }
+    }
+    toolTip += QString("\nother: %1").arg(toMs(timing.otherNs()), 0, 'f', 2);
+    for(std::size_t i = 0; i < diagnostics::NB_COUNTERS; ++i)
+    {
+        const auto counter = static_cast<diagnostics::Counter>(i);
+        toolTip += QString("\n%1: %2").arg(diagnostics::toString(counter)).arg(timing.count(counter));
+    }
+
+    mStatusLabelTiming->setText(QString("%1ms (%2 %3)")
+                                    .arg(toMs(timing.totalNs()), 0, 'f', 1)
+                                    .arg(diagnostics::toString(slowest))
+                                    .arg(toMs(timing.ns(slowest)), 0, 'f', 1));
+    mStatusLabelTiming->setToolTip(toolTip);
+}
+
 void Petrack::setShowFPS(double fps)
 {
     if((fps == 0.) || (mShowFPS == 0))
@@ -2584,6 +2721,11 @@ void Petrack::readSettings()
     mSplitter->restoreState(settings.value("controlSplitterSizes").toByteArray());
     mAutosave.setPetSaveInterval(settings.value("petSaveInterval", 120).toDouble());
     mAutosave.setChangesTillAutosave(settings.value("changesTillAutosave", 10).toInt());
+    mFilterGraph.setMemoryLimit(
+        settings.value("filterCacheSizeMiB", static_cast<qulonglong>(FilterGraph::DEFAULT_MEMORY_LIMIT >> 20))
+            .toULongLong()
+        << 20);
+    mRestrictFiltersToRoiAct->setChecked(settings.value("restrictFiltersToRoi", false).toBool());
 }
 
 /**
@@ -2605,6 +2747,8 @@ void Petrack::writeSettings()
     settings.setValue("controlSplitterSizes", mSplitter->saveState());
     settings.setValue("petSaveInterval", mAutosave.getPetSaveInterval());
     settings.setValue("changesTillAutosave", mAutosave.getChangesTillAutosave());
+    settings.setValue("filterCacheSizeMiB", static_cast<qulonglong>(mFilterGraph.memoryLimit() >> 20));
+    settings.setValue("restrictFiltersToRoi", mRestrictFiltersToRoiAct->isChecked());
 }
 
 bool Petrack::maybeSave()
@@ -2778,127 +2922,33 @@ void Petrack::importTracker(QString dest) // default = ""
     {
         if(dest.endsWith(".trc", Qt::CaseInsensitive))
         {
-            QFile file(dest);
-
-            if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            auto trc = IO::readTrcFile(dest, mReco.getRecoMethod());
+            if(std::holds_alternative<std::string>(trc))
             {
-                // errorstring ist je nach Betriebssystem in einer anderen Sprache!!!!
-                PCritical(this, tr("PeTrack"), tr("Cannot open %1:\n%2").arg(dest).arg(file.errorString()));
+                PCritical(
+                    this,
+                    tr("PeTrack"),
+                    tr("Could not import tracker:\n%1").arg(QString::fromStdString(std::get<std::string>(trc))));
                 return;
             }
+            auto &persons = std::get<std::vector<TrackPerson>>(trc);
 
             setTrackChanged(true); // flag changes of track parameters
             mTracker->reset();
 
-            // read all lines at once
-            QTextStream in(&file);
-            QStringList allLines;
-            while(!in.atEnd())
+            if(!persons.empty() && (mPersonStorage.nbPersons() != 0))
             {
-                allLines.append(in.readLine());
+                SPDLOG_WARN("overlapping trajectories will be joined not until tracking adds new TrackPoints.");
             }
-            file.close();
-            if(allLines.isEmpty())
+            for(const auto &person : persons)
             {
-                PCritical(this, tr("PeTrack"), tr("File %1 is empty").arg(dest));
-                return;
-            }
-            int currentLineIndex = 0;
-            // Parse header
-            QString firstLine = allLines[currentLineIndex++];
-            bool    ok;
-            int     sz = firstLine.toInt(&ok);
-
-            if(!ok)
-            {
-                // Parse version header
-                if(firstLine.contains("version 5", Qt::CaseInsensitive))
-                {
-                    trcVersion = 5;
-                }
-                else if(firstLine.contains("version 4", Qt::CaseInsensitive))
-                {
-                    trcVersion = 4;
-                }
-                else if(firstLine.contains("version 3", Qt::CaseInsensitive))
-                {
-                    trcVersion = 3;
-                }
-                else if(firstLine.contains("version 2", Qt::CaseInsensitive))
-                {
-                    trcVersion = 2;
-                }
-                else
-                {
-                    SPDLOG_ERROR("wrong header while reading TRC file.");
-                    QMessageBox::critical(
-                        this,
-                        tr("PeTrack"),
-                        tr("Could not import tracker:\nNot supported trc version in file: %1.").arg(dest));
-                    return;
-                }
-
-                // Read size from next line
-                if(currentLineIndex >= allLines.size())
-                {
-                    PCritical(this, tr("PeTrack"), tr("Expected size after version header but reached end of file"));
-                    return;
-                }
-
-                sz = allLines[currentLineIndex++].toInt(&ok);
-                if(!ok)
-                {
-                    PCritical(
-                        this,
-                        tr("PeTrack"),
-                        tr("Expected valid number of persons but found: %1").arg(allLines[currentLineIndex - 1]));
-                    return;
-                }
-            }
-            else
-            {
-                trcVersion = 1;
-            }
-
-            // Validate size
-            if(sz < 0)
-            {
-                PCritical(this, tr("PeTrack"), tr("Invalid number of persons: %1").arg(sz));
-                return;
-            }
-
-            if((sz > 0) && (mPersonStorage.nbPersons() != 0))
-            {
-                SPDLOG_WARN("overlapping trajectories will be joined not until tracking adds new TrackPoints.");
-            }
-            for(int i = 0; i < sz; ++i)
-            {
-                TrackPerson tp;
-                ParseResult result = parseTrackPerson(allLines, currentLineIndex, tp, mReco.getRecoMethod());
-                if(!result.success)
-                {
-                    QString errorMsg =
-                        tr("Error parsing person %1 of %2:\n%3").arg(i + 1).arg(sz).arg(result.errorMessage);
-                    if(result.lineNumber > 0)
-                    {
-                        errorMsg += tr("\nAt line %1").arg(result.lineNumber);
-                    }
-                    PCritical(this, tr("PeTrack"), errorMsg);
-                    return;
-                }
-                mPersonStorage.addPerson(tp);
-                ++currentLineIndex; // skip the empty line after a person finish
-            }
-            // Verify we got all expected data
-            if(currentLineIndex < allLines.size())
-            {
-                SPDLOG_WARN("File contains {} extra lines after expected data", allLines.size() - currentLineIndex);
+                mPersonStorage.addPerson(person);
             }
 
             mControlWidget->setTrackShowOnlyNr(static_cast<int>(MAX(mPersonStorage.nbPersons(), 1)));
             updateStatusBarMsg();
             mControlWidget->replotColorplot();
-            SPDLOG_INFO("import {} ({} person(s), file version {})", dest, sz, trcVersion);
+            SPDLOG_INFO("import {} ({} person(s), file version {})", dest, persons.size(), trcVersion);
             mTrcFileName =
                 dest; // fuer Project-File, dann koennte track path direkt mitgeladen werden, wenn er noch da ist
         }
@@ -3370,7 +3420,12 @@ void Petrack::exportTracker(QString dest) // default = ""
                 }
                 else // 2D
                 {
-                    mPersonStorage.recalcHeight(mControlWidget->getCameraAltitude());
+                    PProgressDialog progress(tr("Recalculating the heights of all persons..."), this);
+                    if(!mPersonStorage.recalcHeight(mControlWidget->getCameraAltitude(), progress.callback()))
+                    {
+                        SPDLOG_WARN("export cancelled");
+                        return;
+                    }
                 }
             }
 
@@ -3424,6 +3479,17 @@ void Petrack::exportTracker(QString dest) // default = ""
                     }
                 }
             }
+            std::shared_ptr<const walkarea::WalkAreaField> wallDistance;
+            if(mControlWidget->isExportWallDistanceChecked())
+            {
+                const QRectF imageRect(
+                    0,
+                    0,
+                    mImgFiltered.cols - 2 * getImageBorderSize(),
+                    mImgFiltered.rows - 2 * getImageBorderSize());
+                wallDistance =
+                    mWalkAreaManager->getWorldField(*mWorldImageCorrespondence, imageRect, getImageBorderSize());
+            }
             mTrackerReal->exportTxt(
                 out,
                 mControlWidget->getTrackAlternateHeight(),
@@ -3431,7 +3497,8 @@ void Petrack::exportTracker(QString dest) // default = ""
                 mControlWidget->isExportViewDirChecked(),
                 mControlWidget->isExportAngleOfViewChecked(),
                 mControlWidget->isExportUseMeterChecked(),
-                mControlWidget->isExportMarkerIDChecked());
+                mControlWidget->isExportMarkerIDChecked(),
+                wallDistance.get());
             // out << *mTrackerReal;
             file.flush();
             file.close();
@@ -3519,7 +3586,12 @@ void Petrack::exportTracker(QString dest) // default = ""
             // in berechnung einfliessen zu lassen)
             if(mControlWidget->isTrackRecalcHeightChecked())
             {
-                mPersonStorage.recalcHeight(mControlWidget->getCameraAltitude());
+                PProgressDialog progress(tr("Recalculating the heights of all persons..."), this);
+                if(!mPersonStorage.recalcHeight(mControlWidget->getCameraAltitude(), progress.callback()))
+                {
+                    SPDLOG_WARN("export cancelled");
+                    return;
+                }
             }
             mTrackerReal->calculate(
                 this,
@@ -3571,7 +3643,12 @@ void Petrack::exportTracker(QString dest) // default = ""
             // in berechnung einfliessen zu lassen)
             if(mControlWidget->isTrackRecalcHeightChecked())
             {
-                mPersonStorage.recalcHeight(mControlWidget->getCameraAltitude());
+                PProgressDialog progress(tr("Recalculating the heights of all persons..."), this);
+                if(!mPersonStorage.recalcHeight(mControlWidget->getCameraAltitude(), progress.callback()))
+                {
+                    SPDLOG_WARN("export cancelled");
+                    return;
+                }
             }
 
             mTrackerReal->calculate(
@@ -3664,6 +3741,8 @@ void Petrack::playAll()
 
     QProgressDialog progress("Playing whole sequence...", "Abort playing", 0, mAnimation.getNumFrames(), this);
     progress.setWindowModality(Qt::WindowModal); // blocks main window
+    diagnostics::FrameProfiler::global().startRecording();
+    mProcessingSequence = true;
 
     // vorwaertslaufen ab aktueller Stelle und trackOnlineCalc zum tracken nutzen
     do
@@ -3676,7 +3755,11 @@ void Petrack::playAll()
         }
     } while(mPlayerWidget->frameForward());
 
+    mProcessingSequence = false;
+    diagnostics::FrameProfiler::global().stopRecording();
+    diagnostics::FrameProfiler::global().logRecordingSummary();
     mPlayerWidget->skipToFrame(memPos);
+    showWholeImage();
 }
 
 /**
@@ -3689,23 +3772,34 @@ void Petrack::playAll()
  *
  * The old settings for tracking and reco will be restored. No interaction with the
  * main window is possible for the time of tracking.
+ *
+ * With firstFrame and lastFrame only a part of the video is tracked (e.g. one shard of a sharded tracking): forward
+ * from the current frame till lastFrame and backward till firstFrame.
+ *
+ * The timing of every frame is recorded by the FrameProfiler and summarized in the log at the end.
+ *
+ * @param firstFrame frame where backward tracking stops
+ * @param lastFrame frame where forward tracking stops; -1 for the last frame of the video
  */
-void Petrack::trackAll()
+void Petrack::trackAll(int firstFrame, int lastFrame)
 {
+    if(lastFrame < 0)
+    {
+        lastFrame = mAnimation.getNumFrames() - 1;
+    }
     int  memPos        = mPlayerWidget->getPos();
     int  progVal       = 0;
+    int  progMax       = 2 * (lastFrame + 1) - memPos - firstFrame;
     bool memCheckState = mControlWidget->isTrackActiveChecked();
     bool memRecoState  = mControlWidget->isRecoActiveChecked();
 
     mControlWidget->setTrackActiveChecked(true);
     mControlWidget->setRecoActiveChecked(true);
+    diagnostics::TrackingDiagnostics::global().clear();
+    diagnostics::FrameProfiler::global().startRecording();
+    mProcessingSequence = true;
 
-    QProgressDialog progress(
-        "Tracking pedestrians through all frames...",
-        "Abort tracking",
-        0,
-        2 * mAnimation.getNumFrames() - memPos,
-        this);
+    QProgressDialog progress("Tracking pedestrians through all frames...", "Abort tracking", 0, progMax, this);
     progress.setWindowModality(Qt::WindowModal); // blocks main window
 
     // vorwaertslaufen ab aktueller Stelle und trackOnlineCalc zum tracken nutzen
@@ -3717,17 +3811,17 @@ void Petrack::trackAll()
         {
             break;
         }
-    } while(mPlayerWidget->frameForward());
+    } while(mPlayerWidget->getPos() < lastFrame && mPlayerWidget->frameForward());
 
     if(mAutoBackTrack)
     {
         // zuruecksprinegn an die stelle, wo der letzte trackPath nicht vollstaendig
         // etwas spaeter, da erste punkte in reco path meist nur ellipse ohne markererkennung
         mControlWidget->setTrackActiveChecked(false);
-        mPlayerWidget->skipToFrame(mPersonStorage.largestFirstFrame() + 5);
+        mPlayerWidget->skipToFrame(std::min(mPersonStorage.largestFirstFrame() + 5, lastFrame));
         mControlWidget->setTrackActiveChecked(true);
         // progVal = 2mAnimation.getNumFrames()-memPos-mPlayerWidget->getPos();
-        progVal += mAnimation.getNumFrames() - mPlayerWidget->getPos();
+        progVal += lastFrame + 1 - mPlayerWidget->getPos();
         progress.setValue(progVal); // mPlayerWidget->getPos()
 
         // recognition abstellen, bis an die stelle, wo trackAll begann
@@ -3738,7 +3832,7 @@ void Petrack::trackAll()
         // rueckwaertslaufen
         do
         {
-            if(progVal + 1 < 2 * mAnimation.getNumFrames() - memPos)
+            if(progVal + 1 < progMax)
             {
                 progress.setValue(++progVal); // mPlayerWidget->getPos()
             }
@@ -3751,21 +3845,202 @@ void Petrack::trackAll()
             {
                 mControlWidget->setRecoActiveChecked(true);
             }
-        } while(mPlayerWidget->frameBackward());
+        } while(mPlayerWidget->getPos() > firstFrame && mPlayerWidget->frameBackward());
 
         // bei abbruch koennen es auch mPlayerWidget->getPos() frames sein, die bisher geschrieben wurden
-        progress.setValue(2 * mAnimation.getNumFrames() - memPos);
+        progress.setValue(progMax);
     }
 
+    mProcessingSequence = false;
+    diagnostics::FrameProfiler::global().stopRecording();
+    diagnostics::FrameProfiler::global().logRecordingSummary();
+
     if(mAutoTrackOptimizeColor)
     {
-        mPersonStorage.optimizeColor();
+        PProgressDialog colorProgress(tr("Optimizing the colors of all persons..."), this);
+        mPersonStorage.optimizeColor(colorProgress.callback());
     }
 
     mControlWidget->setRecoActiveChecked(memRecoState);
     mControlWidget->setTrackActiveChecked(false);
     mPlayerWidget->skipToFrame(memPos);
     mControlWidget->setTrackActiveChecked(memCheckState);
+    showWholeImage();
+}
+
+/**
+ * @brief Runs the recognition on every frame from firstFrame to lastFrame and stores the results in the detection cache
+ *
+ * Frames already contained in the cache are skipped. If the cache was filled with other recognition parameters, it is
+ * replaced. Tracking and stepping through the video afterwards take the detections from the cache, see
+ * recognizeMarkers(). If a detection cache file is set, the cache is saved to it.
+ *
+ * Nothing is added to the trajectories. The recognition runs for all frames, independent of the recognition step.
+ *
+ * @param firstFrame first frame to detect
+ * @param lastFrame last frame to detect; -1 for the last frame of the video
+ * @return false if the cache could not be saved
+ */
+bool Petrack::detectAll(int firstFrame, int lastFrame)
+{
+    const int nbFrames = mAnimation.getNumFrames();
+    if(lastFrame < 0 || lastFrame >= nbFrames)
+    {
+        lastFrame = nbFrames - 1;
+    }
+    firstFrame = std::max(firstFrame, 0);
+
+    // apply pending changes, so the detections belong to the current parameters
+    updateImage();
+    const QByteArray hash = recognitionParameterHash();
+    if(mDetectionCache.parameterHash() != hash || mDetectionCache.lastFrame() != nbFrames - 1)
+    {
+        reco::DetectionCache cache{hash, 0, nbFrames - 1};
+        cache.merge(mDetectionCache); // keeps nothing, if the parameters changed
+        mDetectionCache = std::move(cache);
+    }
+
+    QRect roi(
+        myRound(mRecognitionRoiItem->rect().x() + getImageBorderSize()),
+        myRound(mRecognitionRoiItem->rect().y() + getImageBorderSize()),
+        myRound(mRecognitionRoiItem->rect().width()),
+        myRound(mRecognitionRoiItem->rect().height()));
+    // only the recognition ROI is needed, the frames are not shown
+    cv::Rect filterRegion;
+    if(mRestrictFiltersToRoiAct->isChecked() && !mStereoContext)
+    {
+        filterRegion = cv::Rect(roi.x(), roi.y(), roi.width(), roi.height());
+    }
+
+    const int       memPos = mPlayerWidget->getPos();
+    QProgressDialog progress(
+        "Detecting pedestrians in all frames...", "Abort detection", firstFrame, lastFrame + 1, this);
+    progress.setWindowModality(Qt::WindowModal); // blocks main window
+
+    QElapsedTimer timer;
+    timer.start();
+    int nbDetected = 0;
+    for(int frame = firstFrame; frame <= lastFrame; ++frame)
+    {
+        progress.setValue(frame);
+        qApp->processEvents();
+        if(progress.wasCanceled())
+        {
+            break;
+        }
+        if(mDetectionCache.contains(frame))
+        {
+            continue;
+        }
+
+        mImg = mAnimation.getFrameAtIndex(frame);
+        if(mImg.empty())
+        {
+            SPDLOG_WARN("Detection stopped, frame {} could not be read", frame);
+            break;
+        }
+        const auto processingStart = diagnostics::Clock::now();
+        getFilteredImage(true, false, false, false, false, filterRegion);
+        mCodeMarkerItem->resetSavedMarkers();
+        auto detections = mReco.getMarkerPos(
+            mImgFiltered,
+            roi,
+            mControlWidget,
+            getImageBorderSize(),
+            getBackgroundFilter(),
+            mControlWidget->getIntrinsicCameraParams());
+        diagnostics::FrameProfiler::global().count(
+            diagnostics::Counter::Detections, static_cast<int>(detections.size()));
+        mDetectionCache.insert(frame, detections);
+        diagnostics::FrameProfiler::global().finishFrame(frame, processingStart);
+        ++nbDetected;
+    }
+    progress.setValue(lastFrame + 1);
+
+    SPDLOG_INFO(
+        "Detected {} frames in {:.1f} s; {} of {} frames are cached",
+        nbDetected,
+        static_cast<double>(timer.nsecsElapsed()) * 1e-9,
+        mDetectionCache.nbDetectedFrames(),
+        nbFrames);
+
+    // show the frame as before
+    if(mAnimation.getCurrentFrameNum() == memPos)
+    {
+        mImg = mAnimation.getCurrentFrame();
+        updateImage(true);
+    }
+    else
+    {
+        mPlayerWidget->skipToFrame(memPos);
+    }
+
+    return mDetectionCacheFileName.isEmpty() || mDetectionCache.save(mDetectionCacheFileName);
+}
+
+/**
+ * @brief Hash of all settings which change the results of the recognition
+ *
+ * Besides the sequence, these are the settings of the calibration (filters, intrinsic and extrinsic) and the
+ * recognition including the settings of the marker dialogs, see reco::DetectionCache::parameterHashOf().
+ *
+ * The hash is cached until a setting of the recognition, a filter or the calibration changes.
+ */
+const QByteArray &Petrack::recognitionParameterHash()
+{
+    if(!mRecognitionParameterHash.isEmpty())
+    {
+        return mRecognitionParameterHash;
+    }
+
+    QDomDocument doc("PETRACK");
+    saveXml(doc);
+    mRecognitionParameterHash = reco::DetectionCache::parameterHashOf(doc, getFileList(mSeqFileName, mProFileName));
+    return mRecognitionParameterHash;
+}
+
+/**
+ * @brief Side file of the detection cache next to the project file (same name with ending .det)
+ * @return empty if no project is set
+ */
+QString Petrack::defaultDetectionCacheFileName() const
+{
+    if(mProFileName.isEmpty() || QFileInfo(mProFileName).isDir())
+    {
+        return {};
+    }
+    const QFileInfo projectInfo{mProFileName};
+    return projectInfo.dir().filePath(projectInfo.completeBaseName() + ".det");
+}
+
+/**
+ * @brief Sets the side file of the detection cache and loads it, if it exists
+ *
+ * @param fileName side file; empty to not store the detection cache
+ * @return false if the file exists, but could not be loaded
+ */
+bool Petrack::setDetectionCacheFileName(const QString &fileName)
+{
+    mDetectionCacheFileName = fileName;
+    if(fileName.isEmpty() || !QFileInfo::exists(fileName))
+    {
+        return true;
+    }
+    auto cache = reco::DetectionCache::load(fileName);
+    if(!cache)
+    {
+        return false;
+    }
+    mDetectionCache = std::move(*cache);
+    if(mDetectionCache.parameterHash() != recognitionParameterHash())
+    {
+        SPDLOG_WARN("Detection cache {} was created with other recognition parameters and is not used", fileName);
+    }
+    else
+    {
+        SPDLOG_INFO("Using {} cached frames of {}", mDetectionCache.nbDetectedFrames(), fileName);
+    }
+    return true;
 }
 
 // default: (QPointF *pos=NULL, int pers=-1, int frame=-1);
@@ -3784,45 +4059,54 @@ int Petrack::winSize(QPointF *pos, int pers, int frame, int level)
  * Calculates the filtered image based on the values of different filters.
  * They are passed as parameters, because once read, they return false when checking the changed()-method.
  *
+ * Swap, bright/contrast, border and calib filter are evaluated by mFilterGraph, which only reruns filters whose
+ * parameters or inputs changed and takes the results of recently shown frames from its cache.
+ *
+ * If a region is given, the filters only compute this region (and what they need from their inputs for it); the rest
+ * of mImgFiltered is black and the background filter only learns inside the region. The stereo rectification always
+ * uses the whole image.
+ *
  * @param imageChanged bool, if the image has changed since the last usage
+ * @param region part of the filtered image needed, e.g. processingRegion(); empty for the whole image
  */
 void Petrack::getFilteredImage(
-    bool imageChanged,
-    bool brightContrastFilterChanged,
-    bool swapFilterChanged,
-    bool borderFilterChanged,
-    bool calibFilterChanged)
+    bool            imageChanged,
+    bool            brightContrastFilterChanged,
+    bool            swapFilterChanged,
+    bool            borderFilterChanged,
+    bool            calibFilterChanged,
+    const cv::Rect &region)
 {
-    mImgFiltered = mImg;
-
-    // When applying the filter, the order is important!
-    // Computation heavy filter should be applied early.
-
-    if(imageChanged || swapFilterChanged)
-    {
-        mImgFiltered = mSwapFilter.apply(mImgFiltered);
-    }
-    else
+    if(brightContrastFilterChanged || swapFilterChanged || borderFilterChanged || calibFilterChanged)
     {
-        mImgFiltered = mSwapFilter.getLastResult();
+        // when loading a .pet file, a bg-file may be there.
+        // Only delete the bg-filter if no such file is present
+        if(mBackgroundFilter.getFilename().isEmpty())
+        {
+            // delete all background information and set bg.changed() to true.
+            mBackgroundFilter.reset();
+        }
+        else
+        {
+            SPDLOG_WARN("no background reset, because of explicit loaded background image!");
+        }
     }
 
-    if(imageChanged || swapFilterChanged || brightContrastFilterChanged)
-    {
-        mImgFiltered = mBrightContrastFilter.apply(mImgFiltered);
-    }
-    else
-    {
-        mImgFiltered = mBrightContrastFilter.getLastResult();
-    }
+    // the background model has to learn a whole image, before it can keep its background outside of a region
+    const cv::Rect filterRegion =
+        mBackgroundFilter.getEnabled() && !mBackgroundFilter.learnedWholeImage() ? cv::Rect() : region;
 
-    if(imageChanged || swapFilterChanged || brightContrastFilterChanged || borderFilterChanged)
+    if(imageChanged)
     {
-        mImgFiltered = mBorderFilter.apply(mImgFiltered);
+        // frames of a live stream or of the other camera of a stereo video cannot be identified by the frame number
+        const bool cacheable = !mAnimation.isCameraLiveStream() && !mStereoContext;
+        mFilterGraph.setSource(mImg, cacheable ? mAnimation.getCurrentFrameNum() : FilterCacheKey::NO_FRAME);
     }
-    else
+
+    // the whole image is needed for the stereo rectification and to adapt the controls to a new border
+    if(mStereoContext || borderFilterChanged)
     {
-        mImgFiltered = mBorderFilter.getLastResult();
+        mImgFiltered = mFilterGraph.result(mBorderNode);
     }
 
     if(borderFilterChanged)
@@ -3830,53 +4114,91 @@ void Petrack::getFilteredImage(
         updateControlImage(mImgFiltered);
     }
 
-    if(imageChanged || swapFilterChanged || brightContrastFilterChanged || borderFilterChanged || calibFilterChanged)
-    {
-        if(mStereoContext)
-            mStereoContext->init(mImgFiltered);
-    }
+    mImgFilteredPartial = !filterRegion.empty() && !mStereoContext;
 
-    if(imageChanged || swapFilterChanged || brightContrastFilterChanged || borderFilterChanged || calibFilterChanged)
+    if(mStereoContext)
     {
-        if(mStereoContext)
+        if(imageChanged || swapFilterChanged || brightContrastFilterChanged || borderFilterChanged ||
+           calibFilterChanged)
         {
+            mStereoContext->init(mImgFiltered);
+
+            diagnostics::ScopedTimer timer(diagnostics::Stage::CalibFilter);
             // getRecified rectifies filtered image set in mStereoContext->init()
             mImgFiltered = mStereoContext->getRectified(mAnimation.getCamera());
             mCalibFilter.setChanged(false);
         }
         else
         {
-            mImgFiltered = mCalibFilter.apply(mImgFiltered);
+            // TODO: need to handle this for the stereo case??
+            mImgFiltered = mCalibFilter.getLastResult();
         }
     }
     else
     {
-        // TODO: need to handle this for the stereo case??
-        mImgFiltered = mCalibFilter.getLastResult();
+        mImgFiltered = mFilterGraph.result(mCalibNode, filterRegion);
     }
 
-    if(brightContrastFilterChanged || swapFilterChanged || borderFilterChanged || calibFilterChanged)
+    // the background filter learns from the images, so its results are not cached; it only computes the foreground
+    // and returns the image unchanged, so a whole image replacing the filtered region of the same frame is not learned
+    // a second time
+    if(imageChanged || mBackgroundFilter.changed())
     {
-        // when loading a .pet file, a bg-file may be there.
-        // Only delete the bg-filter if no such file is present
-        if(mBackgroundFilter.getFilename().isEmpty())
-        {
-            // delete all background information and set bg.changed() to true.
-            mBackgroundFilter.reset();
-        }
-        else
-        {
-            SPDLOG_WARN("no background reset, because of explicit loaded background image!");
-        }
+        diagnostics::ScopedTimer timer(diagnostics::Stage::BackgroundFilter);
+        mBackgroundFilter.setRegion(mImgFilteredPartial ? filterRegion : cv::Rect());
+        mImgFiltered = mBackgroundFilter.apply(mImgFiltered);
     }
+}
 
-    if(imageChanged || mBackgroundFilter.changed())
+/**
+ * @brief Part of the filtered image needed for tracking and recognition of the current frame
+ *
+ * With "Restrict Filters to ROIs" checked, the filters only compute the union of the tracking ROI and the recognition
+ * ROI of the active steps while trackAll() or playAll() run, e.g. for -autoTrack. Frames shown during the interactive
+ * playback are always filtered as a whole (detectAll() restricts the filters itself). The tracking ROI is enlarged by
+ * the search window of the tracker on all pyramid levels, so that points near its edge are tracked as with the whole
+ * image; the margin needed by the undistortion is added by the CalibFilter itself.
+ *
+ * @return region in coordinates of the filtered image; empty, if the whole image is needed for the display
+ */
+cv::Rect Petrack::processingRegion()
+{
+    if(!mRestrictFiltersToRoiAct->isChecked() || mStereoContext || !mProcessingSequence)
     {
-        mImgFiltered = mBackgroundFilter.apply(mImgFiltered);
+        return {};
     }
-    else
+
+    cv::Rect region;
+    if(mControlWidget->isTrackActiveChecked())
     {
-        mImgFiltered = mBackgroundFilter.getLastResult();
+        const int margin = winSize(nullptr, -1, -1, 0) + (2 << mControlWidget->getTrackRegionLevels());
+        region           = cv::Rect(
+            myRound(mTrackingRoiItem->rect().x() + getImageBorderSize()) - margin,
+            myRound(mTrackingRoiItem->rect().y() + getImageBorderSize()) - margin,
+            myRound(mTrackingRoiItem->rect().width()) + 2 * margin,
+            myRound(mTrackingRoiItem->rect().height()) + 2 * margin);
+    }
+    if(mControlWidget->isRecoActiveChecked())
+    {
+        region |= cv::Rect(
+            myRound(mRecognitionRoiItem->rect().x() + getImageBorderSize()),
+            myRound(mRecognitionRoiItem->rect().y() + getImageBorderSize()),
+            myRound(mRecognitionRoiItem->rect().width()),
+            myRound(mRecognitionRoiItem->rect().height()));
+    }
+    return region;
+}
+
+/**
+ * @brief Filters and shows the whole image, if only the ROIs were filtered for the current frame
+ *
+ * Called when trackAll() or playAll() end, see processingRegion().
+ */
+void Petrack::showWholeImage()
+{
+    if(mImgFilteredPartial)
+    {
+        updateImage();
     }
 }
 
@@ -3962,13 +4284,7 @@ void Petrack::performRecognition()
            (recoMethod == reco::RecognitionMethod::MultiColor) || (recoMethod == reco::RecognitionMethod::Code) ||
            (recoMethod == reco::RecognitionMethod::MachineLearning))
         {
-            persList = mReco.getMarkerPos(
-                mImgFiltered,
-                rect,
-                mControlWidget,
-                getImageBorderSize(),
-                getBackgroundFilter(),
-                mControlWidget->getIntrinsicCameraParams());
+            persList   = recognizeMarkers(rect);
             markerLess = false;
         }
         if(isStereoContext && mStereoWidget->stereoUseForReco->isChecked())
@@ -3977,7 +4293,12 @@ void Petrack::performRecognition()
             pl.calcPersonPos(mImgFiltered, rect, persList, mStereoContext, getBackgroundFilter(), markerLess);
         }
 
-        mPersonStorage.addPoints(persList, frameNum, mReco.getRecoMethod());
+        diagnostics::FrameProfiler::global().count(
+            diagnostics::Counter::Detections, static_cast<int>(persList.size()));
+        {
+            diagnostics::ScopedTimer timer(diagnostics::Stage::InsertRecognized);
+            mPersonStorage.addPoints(persList, frameNum, mReco.getRecoMethod());
+        }
 
         if(isStereoContext && mStereoWidget->stereoUseForReco->isChecked())
         {
@@ -3993,6 +4314,30 @@ void Petrack::performRecognition()
     }
 }
 
+/**
+ * @brief Detects the markers in the current (filtered) image, or takes them from the detection cache
+ *
+ * The detection cache is only used if it contains the current frame and was filled with the current recognition
+ * parameters.
+ *
+ * @param roi recognition region of interest in the image with border
+ */
+QList<TrackPoint> Petrack::recognizeMarkers(QRect &roi)
+{
+    const int frameNum = mAnimation.getCurrentFrameNum();
+    if(mDetectionCache.contains(frameNum) && mDetectionCache.parameterHash() == recognitionParameterHash())
+    {
+        return *mDetectionCache.detections(frameNum);
+    }
+    return mReco.getMarkerPos(
+        mImgFiltered,
+        roi,
+        mControlWidget,
+        getImageBorderSize(),
+        getBackgroundFilter(),
+        mControlWidget->getIntrinsicCameraParams());
+}
+
 /**
  * Update the image that petrack shows.
  * This will not only change the shown image, but also run tracking and recognition if there are changes in the shown
@@ -4006,6 +4351,16 @@ void Petrack::performRecognition()
  */
 bool Petrack::updateImage(bool imageChanged)
 {
+    // changes of the filters, ROIs, calibration or frame lead to an update of the image
+    setProjectChanged();
+
+    if(mDeferImageUpdates)
+    {
+        mImageUpdatePending = true;
+        mPendingImageChanged |= imageChanged;
+        return false;
+    }
+
     mCodeMarkerItem->resetSavedMarkers();
 
     static int  lastRecoFrame            = -10000;
@@ -4023,7 +4378,8 @@ bool Petrack::updateImage(bool imageChanged)
             return false;
         }
 
-        int frameNum = mAnimation.getCurrentFrameNum();
+        const auto processingStart = diagnostics::Clock::now();
+        int        frameNum        = mAnimation.getCurrentFrameNum();
 
         setStatusTime();
 
@@ -4036,7 +4392,12 @@ bool Petrack::updateImage(bool imageChanged)
         bool borderChanged         = mBorderFilter.changed();
         bool calibChanged          = mCalibFilter.changed();
 
-        getFilteredImage(imageChanged, brightContrastChanged, swapChanged, borderChanged, calibChanged);
+        if(brightContrastChanged || swapChanged || borderChanged || calibChanged)
+        {
+            mRecognitionParameterHash.clear(); // detections depend on the filtered image
+        }
+        getFilteredImage(
+            imageChanged, brightContrastChanged, swapChanged, borderChanged, calibChanged, processingRegion());
 
         // delete track list, if intrinsic param have changed
         if(calibChanged && mPersonStorage.nbPersons() > 0) // mCalibFilter.getEnabled() &&
@@ -4100,22 +4461,26 @@ bool Petrack::updateImage(bool imageChanged)
         {
             mControlWidget->setRecoNumberNow(QString("0"));
         }
+        diagnostics::TrackingDiagnostics::global().logFrameSummary(frameNum);
 
         // sync ui with current state from reco/tracking (person count may change due to recognition/tracking updates)
         mControlWidget->setTrackShowOnlyNrMaximum(static_cast<int>(MAX(mPersonStorage.nbPersons(), 1)));
         updateStatusBarMsg();
-        copyToQImage(*mImage, mImgFiltered);
-
-        if(borderChanged)
-        {
-            mImageItem->setImage(mImage);
-        }
-        else
         {
-            getScene()->views().first()->viewport()->repaint();
-            qApp->processEvents();
-            // update pixel color (because image pixel moves)
-            setStatusColor();
+            diagnostics::ScopedTimer timer(diagnostics::Stage::Drawing);
+            shareToQImage(*mImage, mImgFiltered);
+
+            if(borderChanged)
+            {
+                mImageItem->setImage(mImage);
+            }
+            else
+            {
+                getScene()->views().first()->viewport()->repaint();
+                qApp->processEvents();
+                // update pixel color (because image pixel moves)
+                setStatusColor();
+            }
         }
 
 #ifdef QWT
@@ -4126,6 +4491,9 @@ bool Petrack::updateImage(bool imageChanged)
         }
 #endif
 
+        diagnostics::FrameProfiler::global().finishFrame(frameNum, processingStart);
+        setStatusFrameTiming();
+
         mutex.unlock();
         return true;
     }
@@ -4143,6 +4511,9 @@ void Petrack::updateSequence()
 {
     QImage *oldImage = mImage;
 
+    mRecognitionParameterHash.clear(); // the detection cache belongs to one sequence
+    mFilterGraph.clearCache();         // cached filter results are identified by the frame number
+
     QSize size = mAnimation.getSize();
     if(size != QSize{0, 0})
     {
@@ -4702,6 +5073,28 @@ void Petrack::openAutosaveSettings()
     }
 }
 
+/**
+ * @brief Asks for the memory used to cache filtered images of recently shown frames
+ * @see FilterGraph
+ */
+void Petrack::openFilterCacheSettings()
+{
+    bool ok;
+    int  sizeMiB = QInputDialog::getInt(
+        this,
+        tr("Filter Cache Size"),
+        tr("Memory for filtered images of recently shown frames in MiB (0 disables the cache):"),
+        static_cast<int>(mFilterGraph.memoryLimit() >> 20),
+        0,
+        1 << 20,
+        64,
+        &ok);
+    if(ok)
+    {
+        mFilterGraph.setMemoryLimit(static_cast<std::size_t>(sizeMiB) << 20);
+    }
+}
+
 void Petrack::setGitInformation(
     const std::string &gitCommitID,
     const std::string &gitCommitDate,
@@ -36,12 +36,15 @@
 #include "borderFilter.h"
 #include "brightContrastFilter.h"
 #include "calibFilter.h"
+#include "detectionCache.h"
 #include "extrCalibration.h"
+#include "filterGraph.h"
 #include "logwindow.h"
 #include "manualTrackpointMover.h"
 #include "moCapController.h"
 #include "moCapPerson.h"
 #include "personStorage.h"
+#include "projectFile.h"
 #include "swapFilter.h"
 #include "trackerReal.h"
 #include "walkAreaItem.h"
@@ -68,7 +71,6 @@ class QImage;
 class QString;
 class GraphicsView;
 class QGraphicsScene;
-class QXmlStreamWriter;
 class QSplitter;
 class QDoubleSpinBox;
 class QFrame;
@@ -170,9 +172,10 @@ public slots:
 public:
     void         openXml(QDomDocument &doc, bool openSequence = true);
     void         saveXml(QDomDocument &doc);
-    void         writeXmlElement(QXmlStreamWriter &xmlStream, QDomElement element);
+    QStringList  updateProjectFile();
     bool         saveProject(QString fileName = "");
     void         exportSequence(bool saveVideo, bool saveView = false, QString dest = "");
+    bool         exportOverlaySequence(const QString &dest);
     void         editTrackPersonComment(QPointF pos);
     void         setTrackPersonHeight(QPointF pos);
     void         resetTrackPersonHeight(QPointF pos);
@@ -187,6 +190,7 @@ public:
     void         setStatusStereo(float x, float y, float z);
     void         setStatusTime();
     void         setStatusFPS();
+    void         setStatusFrameTiming();
     void         setShowFPS(double fps);
     void         updateShowFPS(bool skipped = false);
     void         updateStatusBarMsg();
@@ -199,7 +203,8 @@ public:
     int          calculateRealTracker();
     void         exportTracker(QString dest = "");
     void         importTracker(QString dest = "");
-    void         trackAll();
+    void         trackAll(int firstFrame = 0, int lastFrame = -1);
+    bool         detectAll(int firstFrame = 0, int lastFrame = -1);
     void         playAll();
     int          winSize(QPointF *pos = nullptr, int pers = -1, int frame = -1, int level = -1);
     bool         updateImage(bool imageChanged = false);
@@ -249,6 +254,7 @@ public:
     inline cv::Mat                 getImageFiltered() { return mImgFiltered; }
     inline PersonStorage          &getPersonStorage() { return mPersonStorage; }
     inline const PersonStorage    &getPersonStorage() const { return mPersonStorage; }
+    inline ProjectFile            &getProjectFile() { return mProjectFile; }
     inline Tracker                *getTracker() { return mTracker; }
     inline TrackerReal            *getTrackerReal() { return mTrackerReal; }
     inline ImageItem              *getImageItem() { return mImageItem; }
@@ -268,11 +274,27 @@ public:
 
     inline QPointF getMousePosOnImage() { return mMousePosOnImage; }
 
-    inline void setRecognitionChanged(bool b) { mRecognitionChanged = b; }
+    inline void setRecognitionChanged(bool b)
+    {
+        mRecognitionChanged = b;
+        if(b)
+        {
+            mRecognitionParameterHash.clear();
+        }
+    }
     inline bool recognitionChanged() const { return mRecognitionChanged; }
 
+    const QByteArray            &recognitionParameterHash();
+    inline void                  invalidateRecognitionParameterHash() { mRecognitionParameterHash.clear(); }
+    inline reco::DetectionCache &getDetectionCache() { return mDetectionCache; }
+    inline const QString        &getDetectionCacheFileName() const { return mDetectionCacheFileName; }
+    bool                         setDetectionCacheFileName(const QString &fileName);
+    QString                      defaultDetectionCacheFileName() const;
+
     inline void     setTrackChanged(bool b) { mTrackChanged = b; }
     inline bool     trackChanged() const { return mTrackChanged; }
+    inline void     setProjectChanged() { mProjectChanged = true; }
+    inline bool     projectChanged() const { return mProjectChanged; }
     inline QAction *getHideControlActor() { return mHideControlsAct; }
 
     inline CalibFilter *getCalibFilter() { return &mCalibFilter; }
@@ -281,6 +303,7 @@ public:
     inline BorderFilter         *getBorderFilter() { return &mBorderFilter; }
     inline SwapFilter           *getSwapFilter() { return &mSwapFilter; }
     inline BackgroundFilter     *getBackgroundFilter() { return &mBackgroundFilter; }
+    inline FilterGraph          &getFilterGraph() { return mFilterGraph; }
 
     inline AnnotationGroupManager &getGroupManager() { return mGroupManager; }
 
@@ -335,27 +358,35 @@ public:
 
 
     void getFilteredImage(
-        bool imageChanged,
-        bool brightContrastFilterChanged,
-        bool swapFilterChanged,
-        bool borderFilterChanged,
-        bool calibFilterChanged);
+        bool            imageChanged,
+        bool            brightContrastFilterChanged,
+        bool            swapFilterChanged,
+        bool            borderFilterChanged,
+        bool            calibFilterChanged,
+        const cv::Rect &region = cv::Rect());
     void resetExistingPoints();
     void performTracking();
     void performRecognition();
 
+    cv::Rect processingRegion();
+    void     showWholeImage();
+
 private slots:
     void openAutosaveSettings();
+    void openFilterCacheSettings();
 
 private:
     void createActions();
     void createMenus();
     void createStatusBar();
+    void connectProjectChangeSignals();
     void readSettings();
     void writeSettings();
     void resetUI();
 
-    bool maybeSave();
+    bool              maybeSave();
+    void              flushImageUpdates(bool force);
+    QList<TrackPoint> recognizeMarkers(QRect &roi);
 
     void keyPressEvent(QKeyEvent *event);
     void mousePressEvent(QMouseEvent *event);
@@ -430,6 +461,8 @@ private:
     QAction      *mAboutAct;
     QAction      *mOnlineHelpAct;
     QAction      *mAutosaveSettings;
+    QAction      *mFilterCacheSettings;
+    QAction      *mRestrictFiltersToRoiAct;
     QActionGroup *mCameraGroupView;
     QMenu        *mPlaybackSpeedMenu;
 
@@ -481,6 +514,7 @@ private:
     QDoubleValidator *mFpsNumValidator;
     QLabel           *mStatusPersons;
     QLabel           *mStatusLabelFPS;
+    QLabel           *mStatusLabelTiming;
     QLabel           *mStatusLabelPosReal;
     QLabel           *mStatusLabelPos;
     QLabel           *mStatusLabelColor;
@@ -493,6 +527,12 @@ private:
     SwapFilter           mSwapFilter;
     BackgroundFilter     mBackgroundFilter;
 
+    FilterGraph         mFilterGraph; ///< all filters above except the background filter, see getFilteredImage()
+    FilterGraph::NodeId mBorderNode;
+    FilterGraph::NodeId mCalibNode;
+    bool                mImgFilteredPartial = false; ///< mImgFiltered was only computed inside the ROIs
+    bool                mProcessingSequence = false; ///< trackAll() or playAll() is running, see processingRegion()
+
     AutoCalib                       mAutoCalib;
     Autosave                        mAutosave{*this};
     PersonStorage                   mPersonStorage{*this, mAutosave};
@@ -500,6 +540,10 @@ private:
     const WorldImageCorrespondence *mWorldImageCorrespondence;
 
     bool mRecognitionChanged;
+
+    reco::DetectionCache mDetectionCache;           ///< detections of the whole video, see detectAll()
+    QString              mDetectionCacheFileName;   ///< side file of mDetectionCache; empty if not stored
+    QByteArray           mRecognitionParameterHash; ///< cached result of recognitionParameterHash()
     bool mTrackChanged;
 
     reco::Recognizer mReco;
@@ -519,6 +563,13 @@ private:
     bool mAutoTrackOptimizeColor = false;
     bool mLoading;
 
+    bool mDeferImageUpdates   = false; ///< updateImage() only records that an update is needed, see openXml()
+    bool mImageUpdatePending  = false;
+    bool mPendingImageChanged = false; ///< one of the deferred updates showed a new frame
+
+    ProjectFile mProjectFile; ///< serialized state of the project as last saved
+    bool        mProjectChanged = true; ///< settings may have changed since the last updateProjectFile()
+
     MoCapStorage    mMoCapStorage;
     MoCapController mMoCapController{mMoCapStorage, mExtrCalibration};
 
@@ -22,9 +22,15 @@
 
 #include <QApplication> // for qApp
 #include <QProgressDialog>
+#include <QtConcurrent/QtConcurrentMap>
+#include <numeric>
 
 namespace plausibility
 {
+namespace
+{
+constexpr size_t WALK_AREA_BATCH_SIZE = 1024; ///< persons checked in parallel between two progress updates
+}
 
 /**
  * Checks if the length for any trajectory is less than minLength frames.
@@ -230,4 +236,74 @@ std::vector<FailedCheck> checkEquality(
 
     return failedChecks;
 }
+
+/**
+ * Checks if trajectories leave the walkable area or enter an obstacle.
+ *
+ * Only the first frame of each violation is reported, i.e. a trajectory walking through an obstacle for several
+ * frames yields one entry. Positions outside of the rasterized field are not checked. The persons are checked in
+ * parallel.
+ *
+ * @param personStorage data container for trajectories
+ * @param progressDialog dialog for showing progress of all checks
+ * @param field rasterized walk area in pixel coordinates
+ * @param tolerance distance in px a trajectory may be outside of the walkable area without being reported
+ *
+ * @return vector of all trajectories and frames where the walkable area is left or an obstacle is entered
+ */
+std::vector<FailedCheck> checkWalkArea(
+    const PersonStorage           &personStorage,
+    QProgressDialog               *progressDialog,
+    const walkarea::WalkAreaField &field,
+    double                         tolerance)
+{
+    progressDialog->setValue(400);
+    progressDialog->setLabelText("Check if trajectories are inside the walk area...");
+    qApp->processEvents();
+
+    const size_t nbPersons = personStorage.nbPersons();
+    if(field.isEmpty() || nbPersons == 0)
+    {
+        return {};
+    }
+
+    std::vector<std::vector<FailedCheck>> failedPerPerson(nbPersons);
+    auto                                  checkPerson = [&](size_t i)
+    {
+        const auto &person = personStorage.at(i);
+        bool        failed = false;
+        for(int j = 0; j < person.size(); ++j)
+        {
+            const QPointF pos(person.at(j).x(), person.at(j).y());
+            const bool    violation = field.signedDistance(pos) < -tolerance;
+            if(violation && !failed)
+            {
+                const bool inObstacle = field.status(pos) == walkarea::FieldStatus::InsideObstacle;
+                failedPerPerson[i].push_back(
+                    {i + 1,
+                     person.firstFrame() + j,
+                     inObstacle ? "Trajectory enters an obstacle!" : "Trajectory leaves the walkable area!",
+                     CheckType::WalkArea});
+            }
+            failed = violation;
+        }
+    };
+
+    for(size_t begin = 0; begin < nbPersons; begin += WALK_AREA_BATCH_SIZE)
+    {
+        std::vector<size_t> indices(std::min(WALK_AREA_BATCH_SIZE, nbPersons - begin));
+        std::iota(indices.begin(), indices.end(), begin);
+        QtConcurrent::blockingMap(indices, checkPerson);
+
+        progressDialog->setValue(400 + (begin + indices.size()) * 100. / nbPersons);
+        qApp->processEvents();
+    }
+
+    std::vector<FailedCheck> failedChecks;
+    for(auto &failed : failedPerPerson)
+    {
+        failedChecks.insert(failedChecks.end(), failed.begin(), failed.end());
+    }
+    return failedChecks;
+}
 } // namespace plausibility
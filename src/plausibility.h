@@ -20,6 +20,7 @@
 #define PLAUSIBILITY_H
 
 #include "personStorage.h"
+#include "walkAreaField.h"
 
 #include <string>
 #include <vector>
@@ -41,7 +42,8 @@ enum class CheckType
     Velocity,
     Length,
     Inside,
-    Equality
+    Equality,
+    WalkArea
 };
 
 struct FailedCheck
@@ -85,6 +87,12 @@ std::vector<FailedCheck> checkEquality(
     Petrack             &petrack,
     double               headSizeFactor);
 
+std::vector<FailedCheck> checkWalkArea(
+    const PersonStorage           &personStorage,
+    QProgressDialog               *progressDialog,
+    const walkarea::WalkAreaField &field,
+    double                         tolerance);
+
 } // namespace plausibility
 
 Q_DECLARE_METATYPE(plausibility::FailedCheck)
@@ -0,0 +1,424 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "detectionCache.h"
+
+#include "logger.h"
+#include "projectFile.h"
+#include "trackPoint.h"
+
+#include <QColor>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QXmlStreamWriter>
+#include <algorithm>
+#include <utility>
+
+namespace reco
+{
+namespace
+{
+constexpr quint32 MAGIC   = 0x50444554; // "PDET"
+constexpr quint32 VERSION = 2;
+
+void setupStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+}
+
+QDataStream &operator<<(QDataStream &stream, const DetectionCache::Detection &detection)
+{
+    stream << detection.x << detection.y << detection.colorX << detection.colorY << detection.color
+           << detection.markerId << detection.orientation[0] << detection.orientation[1] << detection.orientation[2]
+           << detection.qual << detection.markers;
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, DetectionCache::Detection &detection)
+{
+    stream >> detection.x >> detection.y >> detection.colorX >> detection.colorY >> detection.color >>
+        detection.markerId >> detection.orientation[0] >> detection.orientation[1] >> detection.orientation[2] >>
+        detection.qual >> detection.markers;
+    return stream;
+}
+
+/// Setting of the project which changes the results of the recognition
+struct DetectionSetting
+{
+    QString     path;       ///< path of the element below the root element
+    QStringList attributes; ///< hashed attributes; if empty, all attributes and children except the ignored ones
+    QStringList ignored{};  ///< attributes of the element and its children which only change the display
+};
+
+/// allow-list of the settings hashed by DetectionCache::parameterHashOf()
+const std::vector<DetectionSetting> &detectionSettings()
+{
+    static const std::vector<DetectionSetting> settings{
+        {"CONTROL/CALIBRATION/BRIGHTNESS", {"ENABLED", "VALUE"}},
+        {"CONTROL/CALIBRATION/CONTRAST", {"ENABLED", "VALUE"}},
+        {"CONTROL/CALIBRATION/BORDER", {"ENABLED", "VALUE", "COLOR"}},
+        {"CONTROL/CALIBRATION/SWAP", {"ENABLED", "HORIZONTALLY", "VERTICALLY"}},
+        {"CONTROL/CALIBRATION/BG_SUB", {"ENABLED", "UPDATE", "FILE", "DELETE", "DELETE_NUMBER"}},
+        {"CONTROL/CALIBRATION/INTRINSIC_PARAMETERS", {}, {"CALIB_FILES", "CALIB_VIDEO", "IMMUTABLE"}},
+        {"CONTROL/CALIBRATION/EXTRINSIC_PARAMETERS",
+         {},
+         {"EXTERNAL_CALIB_FILE",
+          "IMMUTABLE_EXTRINSIC_BOX",
+          "SHOW_CALIB_POINTS",
+          "SHOW",
+          "FIX",
+          "COORD3D_AXIS_LEN",
+          "COORD_LINE_THICKNESS",
+          "IMMUTABLE_COORD_BOX"}},
+        {"CONTROL/RECOGNITION/PERFORM", {"METHOD", "MLMETHOD"}},
+        {"CONTROL/RECOGNITION/REGION_OF_INTEREST", {"X", "Y", "WIDTH", "HEIGHT"}},
+        {"CONTROL/RECOGNITION/MARKER", {"BRIGHTNESS", "IGNORE_WITHOUT"}},
+        {"CONTROL/RECOGNITION/SIZE_COLOR", {}, {"SHOW", "SYMBOL_SIZE"}},
+        {"STEREO", {}, {"SHOW", "COLOR", "OPACITY", "HIDE_INVALID", "EXPORT"}},
+        {"COLOR_MARKER", {}, {"SHOW", "OPACITY"}},
+        {"CODE_MARKER", {}, {"SHOW_DETECTED_CANDIDATES"}},
+        {"MULTI_COLOR_MARKER", {}, {"SHOW", "OPACITY", "ONLY_EXPORT", "SHOW_DETECTED_CANDIDATES"}},
+        {"YOLO_MARKER", {}},
+    };
+    return settings;
+}
+
+void removeAttributes(QDomElement element, const QStringList &names)
+{
+    for(const auto &name : names)
+    {
+        element.removeAttribute(name);
+    }
+    for(QDomElement child = element.firstChildElement(); !child.isNull(); child = child.nextSiblingElement())
+    {
+        removeAttributes(child, names);
+    }
+}
+} // namespace
+
+DetectionCache::Detection DetectionCache::Detection::fromTrackPoint(const TrackPoint &point)
+{
+    Detection detection;
+    detection.x    = static_cast<float>(point.x());
+    detection.y    = static_cast<float>(point.y());
+    detection.qual = static_cast<std::uint8_t>(point.qual());
+
+    auto setColorPoint = [&detection](const Vec2F &colorPoint)
+    {
+        detection.colorX = static_cast<float>(colorPoint.x());
+        detection.colorY = static_cast<float>(colorPoint.y());
+    };
+    if(const auto marker = point.getMultiColorMarker())
+    {
+        detection.markers |= MULTI_COLOR;
+        setColorPoint(marker->mColorPoint);
+        detection.color = marker->mColor.rgb();
+    }
+    if(const auto marker = point.getCasernMarker())
+    {
+        detection.markers |= CASERN;
+        setColorPoint(marker->mColorPoint);
+        detection.color = marker->mColor.rgb();
+    }
+    if(const auto marker = point.getJapanMarker())
+    {
+        detection.markers |= JAPAN;
+        setColorPoint(marker->mColorPoint);
+    }
+    if(const auto marker = point.getCodeMarker())
+    {
+        detection.markers |= CODE;
+        detection.markerId = marker->mMarkerId;
+        for(int i = 0; i < 3; ++i)
+        {
+            detection.orientation[i] = static_cast<float>(marker->mOrientation[i]);
+        }
+    }
+    if(point.getHermesMarker())
+    {
+        detection.markers |= HERMES;
+    }
+    return detection;
+}
+
+TrackPoint DetectionCache::Detection::toTrackPoint() const
+{
+    TrackPoint  point{Vec2F{x, y}, qual};
+    const Vec2F colorPoint{colorX, colorY};
+    if(markers & MULTI_COLOR)
+    {
+        point.setMultiColorMarker({colorPoint, QColor::fromRgb(color)});
+    }
+    if(markers & CASERN)
+    {
+        point.setCasernMarker({colorPoint, QColor::fromRgb(color)});
+    }
+    if(markers & JAPAN)
+    {
+        point.setJapanMarker({colorPoint});
+    }
+    if(markers & CODE)
+    {
+        point.setCodeMarker({markerId, {orientation[0], orientation[1], orientation[2]}});
+    }
+    if(markers & HERMES)
+    {
+        point.setHermesMarker({});
+    }
+    return point;
+}
+
+DetectionCache::DetectionCache(QByteArray parameterHash, int firstFrame, int lastFrame) :
+    mParameterHash(std::move(parameterHash)),
+    mFirstFrame(firstFrame),
+    mFrames(std::max(lastFrame - firstFrame + 1, 0)),
+    mDetected(mFrames.size(), false)
+{
+}
+
+bool DetectionCache::contains(int frame) const
+{
+    return frame >= mFirstFrame && frame <= lastFrame() && mDetected[frame - mFirstFrame];
+}
+
+/**
+ * @brief Returns the detections of the given frame as TrackPoints like returned by the recognition
+ * @return std::nullopt if the frame was not detected yet
+ */
+std::optional<QList<TrackPoint>> DetectionCache::detections(int frame) const
+{
+    if(!contains(frame))
+    {
+        return std::nullopt;
+    }
+    QList<TrackPoint> points;
+    points.reserve(static_cast<qsizetype>(mFrames[frame - mFirstFrame].size()));
+    for(const auto &detection : mFrames[frame - mFirstFrame])
+    {
+        points.append(detection.toTrackPoint());
+    }
+    return points;
+}
+
+/**
+ * @brief Stores the detections of a frame; frames outside of the range of the cache are ignored
+ */
+void DetectionCache::insert(int frame, const QList<TrackPoint> &points)
+{
+    if(frame < mFirstFrame || frame > lastFrame())
+    {
+        return;
+    }
+    auto &detections = mFrames[frame - mFirstFrame];
+    detections.clear();
+    detections.reserve(static_cast<size_t>(points.size()));
+    for(const auto &point : points)
+    {
+        detections.push_back(Detection::fromTrackPoint(point));
+    }
+    std::vector<bool>::reference detected = mDetected[frame - mFirstFrame];
+    if(!detected)
+    {
+        detected = true;
+        ++mNbDetectedFrames;
+    }
+}
+
+/**
+ * @brief Takes over all frames detected in other
+ * @return false if other was detected with different parameters
+ */
+bool DetectionCache::merge(const DetectionCache &other)
+{
+    if(other.mParameterHash != mParameterHash)
+    {
+        return false;
+    }
+    for(int frame = std::max(other.firstFrame(), firstFrame()); frame <= std::min(other.lastFrame(), lastFrame());
+        ++frame)
+    {
+        if(other.contains(frame))
+        {
+            mFrames[frame - mFirstFrame] = other.mFrames[frame - other.mFirstFrame];
+            std::vector<bool>::reference detected = mDetected[frame - mFirstFrame];
+            if(!detected)
+            {
+                detected = true;
+                ++mNbDetectedFrames;
+            }
+        }
+    }
+    return true;
+}
+
+bool DetectionCache::save(const QString &fileName) const
+{
+    // a crash while saving must not leave a broken cache behind
+    QSaveFile file{fileName};
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        SPDLOG_ERROR("Cannot write detection cache {}: {}", fileName, file.errorString());
+        return false;
+    }
+    QDataStream stream{&file};
+    setupStream(stream);
+
+    stream << MAGIC << VERSION << mParameterHash << qint32(mFirstFrame) << qint32(mFrames.size());
+
+    // index: number of detections per frame; -1 for frames not detected
+    for(size_t i = 0; i < mFrames.size(); ++i)
+    {
+        stream << (mDetected[i] ? static_cast<qint32>(mFrames[i].size()) : qint32(-1));
+    }
+    for(const auto &detections : mFrames)
+    {
+        for(const auto &detection : detections)
+        {
+            stream << detection;
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok || !file.commit())
+    {
+        SPDLOG_ERROR("Cannot write detection cache {}: {}", fileName, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Loads a cache written with save()
+ * @return std::nullopt if the file cannot be read or is no detection cache
+ */
+std::optional<DetectionCache> DetectionCache::load(const QString &fileName)
+{
+    QFile file{fileName};
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        SPDLOG_ERROR("Cannot read detection cache {}: {}", fileName, file.errorString());
+        return std::nullopt;
+    }
+    QDataStream stream{&file};
+    setupStream(stream);
+
+    quint32 magic   = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if(magic != MAGIC || version != VERSION)
+    {
+        SPDLOG_ERROR("{} is no detection cache of this PeTrack version", fileName);
+        return std::nullopt;
+    }
+
+    QByteArray parameterHash;
+    qint32     firstFrame = 0;
+    qint32     nbFrames   = 0;
+    stream >> parameterHash >> firstFrame >> nbFrames;
+    if(stream.status() != QDataStream::Ok || nbFrames < 0)
+    {
+        SPDLOG_ERROR("Corrupt detection cache {}", fileName);
+        return std::nullopt;
+    }
+
+    DetectionCache      cache{parameterHash, firstFrame, firstFrame + nbFrames - 1};
+    std::vector<qint32> counts(nbFrames);
+    for(auto &count : counts)
+    {
+        stream >> count;
+    }
+    for(qint32 i = 0; i < nbFrames && stream.status() == QDataStream::Ok; ++i)
+    {
+        if(counts[i] < 0)
+        {
+            continue;
+        }
+        if(counts[i] > file.size())
+        {
+            stream.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        auto &detections = cache.mFrames[i];
+        detections.resize(counts[i]);
+        for(auto &detection : detections)
+        {
+            stream >> detection;
+        }
+        cache.mDetected[i] = true;
+        ++cache.mNbDetectedFrames;
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        SPDLOG_ERROR("Corrupt detection cache {}", fileName);
+        return std::nullopt;
+    }
+    return cache;
+}
+/**
+ * @brief Hash of all settings of project which change the results of the recognition
+ *
+ * These are the settings of the filters, the calibration and the recognition including the settings of the marker
+ * dialogs. Settings only changing the display and names of files which were only read into other settings are not
+ * part of it.
+ *
+ * @param project project as written by Petrack::saveXml()
+ * @param files list of the files of the sequence
+ * @return SHA-256 hash
+ */
+QByteArray DetectionCache::parameterHashOf(const QDomDocument &project, const QString &files)
+{
+    // the settings are changed to remove the ignored attributes
+    const QDomDocument doc = project.cloneNode(true).toDocument();
+
+    QByteArray settings = files.toUtf8();
+    for(const auto &setting : detectionSettings())
+    {
+        QDomElement element = doc.documentElement();
+        for(const auto &name : setting.path.split('/'))
+        {
+            element = element.firstChildElement(name);
+        }
+        settings += '\n' + setting.path.toUtf8();
+        if(element.isNull())
+        {
+            continue;
+        }
+
+        if(setting.attributes.isEmpty())
+        {
+            removeAttributes(element, setting.ignored);
+            QByteArray       xml; // a writer on settings would overwrite it from the beginning
+            QXmlStreamWriter xmlStream(&xml);
+            ProjectFile::writeElement(xmlStream, element);
+            settings += xml;
+        }
+        else
+        {
+            for(const auto &name : setting.attributes)
+            {
+                settings += QString(" %1=%2").arg(name, element.attribute(name)).toUtf8();
+            }
+        }
+    }
+
+    return QCryptographicHash::hash(settings, QCryptographicHash::Sha256);
+}
+} // namespace reco
@@ -0,0 +1,103 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DETECTIONCACHE_H
+#define DETECTIONCACHE_H
+
+#include <QByteArray>
+#include <QDomDocument>
+#include <QList>
+#include <QString>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class TrackPoint;
+
+namespace reco
+{
+/**
+ * @brief Detections of the recognition for a range of frames, stored to a side file
+ *
+ * The results of Recognizer::getMarkerPos() only depend on the recognition parameters (and the filters applied to the
+ * image), not on the tracking. So the recognition can be run once for the whole video in advance (see
+ * Petrack::detectAll()) and tracking or stepping through the video takes the detections from here instead.
+ *
+ * The cache is keyed by a hash of the recognition parameters; a cache with another hash must not be used. Frames
+ * which were not detected yet are distinguished from frames without any detection.
+ *
+ * The file contains a header, an index with the number of the detections of each frame and all detections as fixed
+ * size records in the order of the frames. The whole file is read at once, so the records are not addressed by
+ * offsets.
+ */
+class DetectionCache
+{
+public:
+    /// Compact form of a detected TrackPoint with the markers set by the recognition
+    struct Detection
+    {
+        enum Markers : std::uint8_t
+        {
+            MULTI_COLOR = 1 << 0,
+            CASERN      = 1 << 1,
+            CODE        = 1 << 2,
+            JAPAN       = 1 << 3,
+            HERMES      = 1 << 4,
+        };
+
+        float         x        = 0;
+        float         y        = 0;
+        float         colorX   = 0;  ///< color point of multicolor, casern and japan marker
+        float         colorY   = 0;
+        std::uint32_t color    = 0;  ///< QRgb of multicolor and casern marker
+        std::int32_t  markerId = -1; ///< code marker
+        float         orientation[3]{-1.f, -1.f, -1.f}; ///< code marker
+        std::uint8_t  qual    = 0;
+        std::uint8_t  markers = 0;
+
+        static Detection fromTrackPoint(const TrackPoint &point);
+        TrackPoint       toTrackPoint() const;
+    };
+
+    DetectionCache() = default;
+    DetectionCache(QByteArray parameterHash, int firstFrame, int lastFrame);
+
+    const QByteArray &parameterHash() const { return mParameterHash; }
+    int               firstFrame() const { return mFirstFrame; }
+    int               lastFrame() const { return mFirstFrame + static_cast<int>(mFrames.size()) - 1; }
+    int               nbDetectedFrames() const { return mNbDetectedFrames; }
+
+    bool                             contains(int frame) const;
+    std::optional<QList<TrackPoint>> detections(int frame) const;
+    void                             insert(int frame, const QList<TrackPoint> &points);
+    bool                             merge(const DetectionCache &other);
+
+    bool                                 save(const QString &fileName) const;
+    static std::optional<DetectionCache> load(const QString &fileName);
+
+    static QByteArray parameterHashOf(const QDomDocument &project, const QString &files);
+
+private:
+    QByteArray                          mParameterHash;
+    int                                 mFirstFrame = 0;
+    std::vector<std::vector<Detection>> mFrames;
+    std::vector<bool>                   mDetected;
+    int                                 mNbDetectedFrames = 0;
+};
+} // namespace reco
+
+#endif // DETECTIONCACHE_H
@@ -24,6 +24,7 @@
 #include "colorMarkerItem.h"
 #include "colorMarkerWidget.h"
 #include "control.h"
+#include "frameProfiler.h"
 #include "helper.h"
 #include "logger.h"
 #include "markerCasern.h"
@@ -38,8 +39,10 @@
 
 #include <QPointF>
 #include <QRect>
+#include <QtConcurrent/QtConcurrentMap>
 #include <bitset>
 #include <iostream>
+#include <numeric>
 #include <opencv2/objdetect/aruco_detector.hpp>
 #include <opencv2/objdetect/aruco_dictionary.hpp>
 #include <opencv2/opencv.hpp>
@@ -313,25 +316,25 @@ Vec2F autoCorrectColorMarker(const Vec2F &boxImageCentre, Control *controlWidget
  * @brief Restricts the position in which the black dot should be according to position in image.
  *
  * @param[in] blob ColorBlob for which to restrict the position
- * @param[in] worldImageCorr reference to world to image correspondence
+ * @param[in] calibration calibration read before the parallel search
  * @param[in] bS bordersize
  * @param[in,out] cropRect cropRect to restrict/resize
  */
 void detail::restrictPositionBlackDot(
-    ColorBlob                      &blob,
-    const WorldImageCorrespondence *worldImageCorr,
-    int                             bS,
-    cv::Rect                       &cropRect)
+    ColorBlob                 &blob,
+    const CalibrationSnapshot &calibration,
+    int                        bS,
+    cv::Rect                  &cropRect)
 {
     double xy, x1, x2, y1, y2;
 
     Vec2F &boxImageCentre = blob.imageCenter;
 
-    xy = worldImageCorr->getAngleToGround(boxImageCentre.x() + bS, boxImageCentre.y() + bS, 175);
-    x1 = worldImageCorr->getAngleToGround(boxImageCentre.x() + bS + 10, boxImageCentre.y() + bS, 175);
-    x2 = worldImageCorr->getAngleToGround(boxImageCentre.x() + bS - 10, boxImageCentre.y() + bS, 175);
-    y1 = worldImageCorr->getAngleToGround(boxImageCentre.x() + bS, boxImageCentre.y() + bS + 10, 175);
-    y2 = worldImageCorr->getAngleToGround(boxImageCentre.x() + bS, boxImageCentre.y() + bS - 10, 175);
+    xy = calibration.getAngleToGround(boxImageCentre.x() + bS, boxImageCentre.y() + bS, 175);
+    x1 = calibration.getAngleToGround(boxImageCentre.x() + bS + 10, boxImageCentre.y() + bS, 175);
+    x2 = calibration.getAngleToGround(boxImageCentre.x() + bS - 10, boxImageCentre.y() + bS, 175);
+    y1 = calibration.getAngleToGround(boxImageCentre.x() + bS, boxImageCentre.y() + bS + 10, 175);
+    y2 = calibration.getAngleToGround(boxImageCentre.x() + bS, boxImageCentre.y() + bS - 10, 175);
 
     double           subFactorBig   = 1. - .75 * (90. - xy) / 90.; //  -.5 //in 1.0..0.25 // xy in 0..90
     constexpr double subFactorSmall = .85;                         // .9
@@ -432,6 +435,23 @@ cv::Mat detail::customBgr2Gray(const cv::Mat &subImg, const QColor &midHue)
     return subGray;
 }
 
+namespace
+{
+/**
+ * @brief Calls func with the index of each of the nbBlobs color blobs in parallel
+ *
+ * func must only write to the result slot of the given blob. The results are merged in blob order afterwards, so they
+ * do not depend on the scheduling of the threads.
+ */
+template <typename Func>
+void forEachBlobParallel(size_t nbBlobs, Func func)
+{
+    std::vector<size_t> indices(nbBlobs);
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, func);
+}
+} // namespace
+
 /**
  * @brief Refines the detection of multicolor-markers with a black dot
  *
@@ -444,6 +464,9 @@ cv::Mat detail::customBgr2Gray(const cv::Mat &subImg, const QColor &midHue)
  * is not found, the ColorBlob might still count as detection, if the ignoreWithoutMarker
  * option is disabled.
  *
+ * The search for the black dots runs in parallel, one blob per task. The TrackPoints are created afterwards in
+ * blob order, so crossList does not depend on the scheduling of the threads.
+ *
  * @param blobs detected color blobs
  * @param img img in which the color blobs were detected
  * @param crossList list of all detected people
@@ -455,19 +478,25 @@ void detail::refineWithBlackDot(
     QList<TrackPoint>      &crossList,
     const BlackDotOptions  &options)
 {
-    constexpr int                   border                = 4; // zusaetzlicher rand um subrects
-    const int                       bS                    = options.borderSize;
-    const bool                      restrictPosition      = options.restrictPosition;
-    const WorldImageCorrespondence *worldImageCorr        = options.worldImageCorr;
-    const QColor                    midHue                = options.midHue;
-    const double                    dotSize               = options.dotSize;
-    const bool                      ignoreWithoutMarker   = options.ignoreWithoutMarker;
-    const bool                      autoCorrect           = options.autoCorrect;
-    const bool                      autoCorrectOnlyExport = options.autoCorrectOnlyExport;
-    Control                        *controlWidget         = options.controlWidget;
+    constexpr int              border                = 4; // zusaetzlicher rand um subrects
+    const int                  bS                    = options.borderSize;
+    const bool                 restrictPosition      = options.restrictPosition;
+    const CalibrationSnapshot &calibration           = options.calibration;
+    const QColor               midHue                = options.midHue;
+    const double               dotSize               = options.dotSize;
+    const bool                 ignoreWithoutMarker   = options.ignoreWithoutMarker;
+    const bool                 autoCorrect           = options.autoCorrect;
+    const bool                 autoCorrectOnlyExport = options.autoCorrectOnlyExport;
+    Control                   *controlWidget         = options.controlWidget;
+    const double               defaultHeight         = controlWidget->getDefaultHeight();
+
+    // position of the black dot of each blob, if one was found
+    std::vector<std::optional<Vec2F>> dotCenters(blobs.size());
 
-    for(ColorBlob &blob : blobs)
+    auto findBlackDot = [&](size_t blobIdx)
     {
+        ColorBlob &blob = blobs[blobIdx];
+
         cv::Rect         cropRect;
         cv::RotatedRect &box = blob.box;
         cropRect.x           = std::max(1, myRound(box.center.x - box.size.width / 2 - border));
@@ -481,7 +510,7 @@ void detail::refineWithBlackDot(
 
         if(restrictPosition)
         {
-            restrictPositionBlackDot(blob, worldImageCorr, bS, cropRect);
+            restrictPositionBlackDot(blob, calibration, bS, cropRect);
         }
 
         // cvtColor results in really dark images, especially with red shades
@@ -525,8 +554,8 @@ void detail::refineWithBlackDot(
                         subMaxExpansion = subBox.size.width;
                     }
 
-                    QPointF cmPerPixel = worldImageCorr->getCmPerPixel(
-                        cropRect.x + subBox.center.x, cropRect.y + subBox.center.y, controlWidget->getDefaultHeight());
+                    QPointF cmPerPixel = calibration.getCmPerPixel(
+                        cropRect.x + subBox.center.x, cropRect.y + subBox.center.y, defaultHeight);
                     double cmPerPixelAvg = (cmPerPixel.x() + cmPerPixel.y()) / 2.;
                     double markerSize =
                         dotSize / cmPerPixelAvg; // war: 5cm// war WDG: = 16; war GymBay: = headSize / 4.5;
@@ -559,10 +588,24 @@ void detail::refineWithBlackDot(
         }
 
         if(minGrey < 260) // mit gefundenem schwarzem punkt
+        {
+            dotCenters[blobIdx] = subCenter;
+        }
+    };
+    forEachBlobParallel(blobs.size(), findBlackDot);
+
+    for(size_t blobIdx = 0; blobIdx < blobs.size(); ++blobIdx)
+    {
+        const ColorBlob       &blob = blobs[blobIdx];
+        const cv::RotatedRect &box  = blob.box;
+        if(dotCenters[blobIdx])
         {
             crossList.append(
                 TrackPoint::createMultiColorTrackPoint(
-                    subCenter, TrackPoint::BEST_DETECTION_QUAL, Vec2F(box.center.x, box.center.y), blob.color));
+                    *dotCenters[blobIdx],
+                    TrackPoint::BEST_DETECTION_QUAL,
+                    Vec2F(box.center.x, box.center.y),
+                    blob.color));
         }
         else if(!ignoreWithoutMarker)
         {
@@ -641,6 +684,9 @@ TrackPoint detail::resolveMoreThanOneCandidateCode(QList<TrackPoint> &codes, con
  * if the ignoreWithoutMarker option is disabled. Missing frames where code is not
  * recognized are interpolated in trackerReal.cpp and Marker ID is set to -1
  *
+ * The aruco detection runs in parallel, one blob per task. The found markers are handed to the CodeMarkerItem and
+ * the TrackPoints are created afterwards in blob order, so crossList does not depend on the scheduling of the threads.
+ *
  * @param blobs detected color blobs
  * @param img img in which the color blobs were detected
  * @param crossList list of all detected people
@@ -661,9 +707,24 @@ void detail::refineWithAruco(
     bool     autoCorrect           = options.autoCorrect;
     bool     autoCorrectOnlyExport = options.autoCorrectOnlyExport;
 
-    CodeMarkerOptions &codeOpt = options.codeOpt;
-    for(ColorBlob &blob : blobs)
+    const CodeMarkerOptions    &codeOpt    = options.codeOpt;
+    const MarkerPerimeterBounds bounds     = markerPerimeterBounds(options.method, codeOpt);
+    const cv::aruco::Dictionary dictionary = codeMarkerDictionary(codeOpt.getIndexOfMarkerDict());
+    const ArucoCodeParams       parameters = codeOpt.getDetectorParams();
+
+    struct BlobCodes
     {
+        cv::Rect            cropRect;
+        CodeMarkerDetection detection;
+        QList<TrackPoint>   codes; ///< codes inside the bounding rect of the blob, relative to cropRect
+    };
+    // aruco detection of each blob, empty if the blob is outside the image
+    std::vector<std::optional<BlobCodes>> blobCodes(blobs.size());
+
+    auto detectBlobCodes = [&](size_t blobIdx)
+    {
+        const ColorBlob &blob = blobs[blobIdx];
+
         // cropRect has coordinates of rechtangele around color blob with respect to lower left corner (as in the
         // beginning of useBlackDot)
         const cv::RotatedRect &box      = blob.box;
@@ -688,25 +749,38 @@ void detail::refineWithAruco(
         cropRect.height     = std::min(maxHeight, sideLength);
 
         cv::Mat subImg = img(cropRect); // --> shallow copy (points to original data)
-
-        Vec2F offsetCropRect2Roi; // needed for drawing detected ArucoCode-Candidates correctly -> passed on to
-                                  // findCodeMarker()-Function
-        offsetCropRect2Roi.setX(cropRect.x);
-        offsetCropRect2Roi.setY(cropRect.y);
-
         if(subImg.empty())
         {
-            continue;
+            return;
         }
-        // TODO: Use Reference to actual codeMarkerOptions in MulticolorMarkerOptions
-        // NOTE: For now, add as parameter of findMulticolorMarker
-        codeOpt.setOffsetCropRect2Roi(offsetCropRect2Roi);
 
-        QList<TrackPoint> addedCodes = findCodeMarker(subImg, options.method, codeOpt, intrinsicCameraParams, true);
-        codeOpt.setOffsetCropRect2Roi({0, 0});
+        CodeMarkerDetection detection = detectCodeMarker(subImg, dictionary, parameters, bounds);
+        QList<TrackPoint>   addedCodes = codeMarkerTrackPoints(detection, parameters, intrinsicCameraParams, true);
 
         // remove all detected codes in the image, that are not inside the bounding box of the color blob
-        addedCodes = filterCodesByBoundingRect(addedCodes, blob.box.boundingRect(), offsetCropRect2Roi);
+        addedCodes = filterCodesByBoundingRect(addedCodes, box.boundingRect(), Vec2F(cropRect.x, cropRect.y));
+
+        blobCodes[blobIdx] = BlobCodes{cropRect, std::move(detection), std::move(addedCodes)};
+    };
+    forEachBlobParallel(blobs.size(), detectBlobCodes);
+
+    CodeMarkerItem *codeMarkerItem = codeOpt.getCodeMarkerItem();
+    for(size_t blobIdx = 0; blobIdx < blobs.size(); ++blobIdx)
+    {
+        if(!blobCodes[blobIdx])
+        {
+            continue;
+        }
+        const ColorBlob       &blob       = blobs[blobIdx];
+        const cv::RotatedRect &box        = blob.box;
+        const cv::Rect        &cropRect   = blobCodes[blobIdx]->cropRect;
+        QList<TrackPoint>     &addedCodes = blobCodes[blobIdx]->codes;
+
+        // needed for drawing detected ArucoCode-Candidates correctly
+        Vec2F offsetCropRect2Roi(cropRect.x, cropRect.y);
+        codeMarkerItem->addDetectedMarkers(
+            blobCodes[blobIdx]->detection.corners, blobCodes[blobIdx]->detection.ids, offsetCropRect2Roi);
+        codeMarkerItem->addRejectedMarkers(blobCodes[blobIdx]->detection.rejected, offsetCropRect2Roi);
 
         // used for autocorrection (if enabled)
         Vec2F moveDir(0, 0);
@@ -868,7 +942,8 @@ void findMultiColorMarker(
             options.midHue                = midHue;
             options.dotSize               = dotSize;
             options.controlWidget         = controlWidget;
-            options.worldImageCorr        = &mainWindow->getWorldImageCorrespondence();
+            // the widgets holding the calibration must not be read from the worker threads
+            options.calibration = mainWindow->getExtrCalibration()->snapshot();
 
             // adds to crosslist
             refineWithBlackDot(blobs, img, crossList, options);
@@ -1108,23 +1183,54 @@ QList<TrackPoint> detail::findCodeMarker(
     bool                         appendRejectedCodes)
 {
     CodeMarkerItem *codeMarkerItem = opt.getCodeMarkerItem();
-    Control        *controlWidget  = opt.getControlWidget();
     const auto     &parameters     = opt.getDetectorParams();
 
-    auto dictionary =
-        (opt.getIndexOfMarkerDict() != 17) ?
-            cv::aruco::getPredefinedDictionary(cv::aruco::PredefinedDictionaryType(opt.getIndexOfMarkerDict())) :
-            detail::getDictMip36h12(); // for usage of DICT_mip_36h12 as it is not predifined in opencv
+    const CodeMarkerDetection detection = detectCodeMarker(
+        img,
+        codeMarkerDictionary(opt.getIndexOfMarkerDict()),
+        parameters,
+        markerPerimeterBounds(recoMethod, opt));
 
-    double minMarkerPerimeterRate = std::numeric_limits<double>::quiet_NaN();
-    double maxMarkerPerimeterRate = std::numeric_limits<double>::quiet_NaN();
-    double minCornerDistanceRate  = parameters.getMinCornerDistance();
-    double minMarkerDistanceRate  = parameters.getMinMarkerDistance();
+    codeMarkerItem->addDetectedMarkers(detection.corners, detection.ids, opt.getOffsetCropRect2Roi());
+    codeMarkerItem->addRejectedMarkers(detection.rejected, opt.getOffsetCropRect2Roi());
+
+    return codeMarkerTrackPoints(detection, parameters, intrinsicCameraParams, appendRejectedCodes);
+}
+
+/**
+ * @brief Returns the dictionary of code markers selected in the GUI
+ *
+ * @param indexOfMarkerDict index of the dictionary in the GUI, 17 is DICT_mip_36h12
+ */
+cv::aruco::Dictionary detail::codeMarkerDictionary(int indexOfMarkerDict)
+{
+    return (indexOfMarkerDict != 17) ?
+               cv::aruco::getPredefinedDictionary(cv::aruco::PredefinedDictionaryType(indexOfMarkerDict)) :
+               detail::getDictMip36h12(); // for usage of DICT_mip_36h12 as it is not predifined in opencv
+}
+
+/**
+ * @brief Computes the expected perimeter of code markers from the calibration
+ *
+ * Reads the calibration and the recognition ROI from the GUI, so it has to be called from the GUI thread. The
+ * result only depends on the size of the searched image via MarkerPerimeterBounds::referenceLength and can be
+ * reused for all sub images of one frame.
+ *
+ * @param recoMethod used recognition method; could be called from findMulticolorMarker
+ * @param opt arucomarker parameters used for detection
+ * @return perimeter bounds in pixel
+ */
+detail::MarkerPerimeterBounds detail::markerPerimeterBounds(RecognitionMethod recoMethod, const CodeMarkerOptions &opt)
+{
+    Control   *controlWidget = opt.getControlWidget();
+    const auto parameters    = opt.getDetectorParams();
 
     Petrack *mainWindow = controlWidget->getMainWindow();
 
     int borderSize = mainWindow->getImageBorderSize();
 
+    MarkerPerimeterBounds bounds;
+
     // 3D - Case
     if(controlWidget->getCalibCoordDimension() == 0)
     {
@@ -1148,29 +1254,46 @@ QList<TrackPoint> detail::findCodeMarker(
         if(recoMethod ==
            RecognitionMethod::Code) // for usage of codemarker with CodeMarker-function (-> without MulticolorMarker)
         {
-            minMarkerPerimeterRate =
-                (parameters.getMinMarkerPerimeter() * 4. / cmPerPixelMax) / std::max(rect.width(), rect.height());
-            maxMarkerPerimeterRate =
-                (parameters.getMaxMarkerPerimeter() * 4. / cmPerPixelMin) / std::max(rect.width(), rect.height());
+            bounds.minPerimeter    = parameters.getMinMarkerPerimeter() * 4. / cmPerPixelMax;
+            bounds.maxPerimeter    = parameters.getMaxMarkerPerimeter() * 4. / cmPerPixelMin;
+            bounds.referenceLength = std::max(rect.width(), rect.height());
         }
         else if(recoMethod == RecognitionMethod::MultiColor) // for usage of codemarker with MulticolorMarker
         {
-            minMarkerPerimeterRate =
-                (parameters.getMinMarkerPerimeter() * 4. / cmPerPixelMax) / std::max(img.cols, img.rows);
-            maxMarkerPerimeterRate =
-                (parameters.getMaxMarkerPerimeter() * 4. / cmPerPixelMin) / std::max(img.cols, img.rows);
+            // relative to the searched sub image
+            bounds.minPerimeter = parameters.getMinMarkerPerimeter() * 4. / cmPerPixelMax;
+            bounds.maxPerimeter = parameters.getMaxMarkerPerimeter() * 4. / cmPerPixelMin;
         }
     }
     else // 2D
     {
-        double cmPerPixel = mainWindow->getWorldImageCorrespondence().getCmPerPixel();
-        minMarkerPerimeterRate =
-            (parameters.getMinMarkerPerimeter() * 4 / cmPerPixel) /
-            std::max(mainWindow->getImage()->width() - borderSize, mainWindow->getImage()->height() - borderSize);
-        maxMarkerPerimeterRate =
-            (parameters.getMaxMarkerPerimeter() * 4 / cmPerPixel) /
+        double cmPerPixel   = mainWindow->getWorldImageCorrespondence().getCmPerPixel();
+        bounds.minPerimeter = parameters.getMinMarkerPerimeter() * 4 / cmPerPixel;
+        bounds.maxPerimeter = parameters.getMaxMarkerPerimeter() * 4 / cmPerPixel;
+        bounds.referenceLength =
             std::max(mainWindow->getImage()->width() - borderSize, mainWindow->getImage()->height() - borderSize);
     }
+    return bounds;
+}
+
+/**
+ * @brief Runs the OpenCV aruco detection on the given image
+ *
+ * Does not access the GUI, so it can be called from multiple threads at once.
+ *
+ * @param img image in which the codes should be detected
+ * @param dictionary dictionary of the code markers, see codeMarkerDictionary()
+ * @param parameters arucomarker parameters used for detection
+ * @param bounds expected perimeter of the markers, see markerPerimeterBounds()
+ * @return detected markers and rejected candidates
+ */
+detail::CodeMarkerDetection detail::detectCodeMarker(
+    const cv::Mat               &img,
+    const cv::aruco::Dictionary &dictionary,
+    const ArucoCodeParams       &parameters,
+    const MarkerPerimeterBounds &bounds)
+{
+    const double referenceLength = bounds.referenceLength > 0 ? bounds.referenceLength : std::max(img.cols, img.rows);
 
     cv::aruco::DetectorParameters detectorParams;
 
@@ -1178,12 +1301,12 @@ QList<TrackPoint> detail::findCodeMarker(
     detectorParams.adaptiveThreshWinSizeMax    = parameters.getAdaptiveThreshWinSizeMax();
     detectorParams.adaptiveThreshWinSizeStep   = parameters.getAdaptiveThreshWinSizeStep();
     detectorParams.adaptiveThreshConstant      = parameters.getAdaptiveThreshConstant();
-    detectorParams.minMarkerPerimeterRate      = minMarkerPerimeterRate;
-    detectorParams.maxMarkerPerimeterRate      = maxMarkerPerimeterRate;
+    detectorParams.minMarkerPerimeterRate      = bounds.minPerimeter / referenceLength;
+    detectorParams.maxMarkerPerimeterRate      = bounds.maxPerimeter / referenceLength;
     detectorParams.polygonalApproxAccuracyRate = parameters.getPolygonalApproxAccuracyRate();
-    detectorParams.minCornerDistanceRate       = minCornerDistanceRate;
+    detectorParams.minCornerDistanceRate       = parameters.getMinCornerDistance();
     detectorParams.minDistanceToBorder         = parameters.getMinDistanceToBorder();
-    detectorParams.minMarkerDistanceRate       = minMarkerDistanceRate;
+    detectorParams.minMarkerDistanceRate       = parameters.getMinMarkerDistance();
     // No refinement is default value
     // TODO Check if this is the best method for our usecase
     if(parameters.getDoCornerRefinement())
@@ -1200,19 +1323,34 @@ QList<TrackPoint> detail::findCodeMarker(
     detectorParams.minOtsuStdDev                         = parameters.getMinOtsuStdDev();
     detectorParams.errorCorrectionRate                   = parameters.getErrorCorrectionRate();
 
-    std::vector<int>                      ids;
-    std::vector<std::vector<cv::Point2f>> corners;
-    std::vector<std::vector<cv::Point2f>> rejected;
+    CodeMarkerDetection detection;
 
     const cv::aruco::ArucoDetector arucoDetector(dictionary, detectorParams);
-    arucoDetector.detectMarkers(img, corners, ids, rejected);
+    arucoDetector.detectMarkers(img, detection.corners, detection.ids, detection.rejected);
+    return detection;
+}
 
-    codeMarkerItem->addDetectedMarkers(corners, ids, opt.getOffsetCropRect2Roi());
-    codeMarkerItem->addRejectedMarkers(rejected, opt.getOffsetCropRect2Roi());
+/**
+ * @brief Converts the detected code markers to TrackPoints
+ *
+ * @param detection detected markers, see detectCodeMarker()
+ * @param parameters arucomarker parameters used for detection
+ * @param intrinsicCameraParams used for estimating arucomarker orientation
+ * @param appendRejectedCodes append trackpoints of rejected codes to the list of detected codes (see findCodeMarker())
+ * @return list of all detected codes, followed by the rejected candidates if requested
+ */
+QList<TrackPoint> detail::codeMarkerTrackPoints(
+    const CodeMarkerDetection   &detection,
+    const ArucoCodeParams       &parameters,
+    const IntrinsicCameraParams &intrinsicCameraParams,
+    bool                         appendRejectedCodes)
+{
+    const std::vector<int>               &ids     = detection.ids;
+    std::vector<std::vector<cv::Point2f>> corners = detection.corners;
 
-    if(appendRejectedCodes && !rejected.empty())
+    if(appendRejectedCodes && !detection.rejected.empty())
     {
-        corners.insert(corners.end(), rejected.begin(), rejected.end());
+        corners.insert(corners.end(), detection.rejected.begin(), detection.rejected.end());
     }
 
     if(corners.empty())
@@ -1223,7 +1361,7 @@ QList<TrackPoint> detail::findCodeMarker(
     }
 
     // value only relevant for axis length when drawing axes
-    float                  markerLength = (float) opt.getDetectorParams().getMinCornerDistance();
+    float                  markerLength = (float) parameters.getMinCornerDistance();
     std::vector<cv::Vec3d> rotationVectors;
     std::vector<cv::Vec3d> translationVectors;
     const cv::Mat         &cameraMatrix = intrinsicCameraParams.cameraMatrix;
@@ -1591,6 +1729,8 @@ QList<TrackPoint> Recognizer::getMarkerPos(
     BackgroundFilter            *bgFilter,
     const IntrinsicCameraParams &intrinsicCameraParams)
 {
+    diagnostics::ScopedTimer timer(diagnostics::Stage::Recognition);
+
     int  markerBrightness    = controlWidget->getMarkerBrightness();
     bool ignoreWithoutMarker = controlWidget->isMarkerIgnoreWithoutChecked();
     bool autoWB              = controlWidget->isRecoAutoWBChecked();
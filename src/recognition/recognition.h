@@ -19,11 +19,13 @@
 #ifndef RECOGNITION_H
 #define RECOGNITION_H
 
+#include "extrCalibration.h"
 #include "vector.h"
 
 #include <QColor>
 #include <QList>
 #include <QObject>
+#include <limits>
 #include <opencv2/dnn.hpp>
 #include <opencv2/objdetect/aruco_detector.hpp>
 
@@ -34,7 +36,6 @@ class Control;
 class ImageItem;
 class CodeMarkerItem;
 struct IntrinsicCameraParams;
-class WorldImageCorrespondence;
 
 namespace reco
 {
@@ -269,10 +270,10 @@ namespace detail
         bool autoCorrect         = false; ///< should perspective correction be performed
         bool autoCorrectOnlyExport =
             false; ///< should perspective correction only be performed when exporting trajectories
-        const WorldImageCorrespondence *worldImageCorr = nullptr; ///< used for getAngleToGround and such
-        QColor                          midHue;                   ///< middle hue of the color map
-        double                          dotSize       = 5;        ///< size of the black dot
-        Control                        *controlWidget = nullptr;  ///< pointer to Control used for autoCorrect
+        CalibrationSnapshot calibration;           ///< used for getAngleToGround and such from the worker threads
+        QColor              midHue;                ///< middle hue of the color map
+        double              dotSize       = 5;     ///< size of the black dot
+        Control            *controlWidget = nullptr; ///< pointer to Control used for autoCorrect
     };
 
     struct ArucoOptions
@@ -287,9 +288,24 @@ namespace detail
         CodeMarkerOptions &codeOpt;
     };
 
+    struct CodeMarkerDetection
+    {
+        std::vector<int>                      ids;      ///< ids of the detected markers
+        std::vector<std::vector<cv::Point2f>> corners;  ///< corners of the detected markers
+        std::vector<std::vector<cv::Point2f>> rejected; ///< corners of the rejected candidates
+    };
+
+    /// expected perimeter of code markers; divided by referenceLength to get the rates used by OpenCV
+    struct MarkerPerimeterBounds
+    {
+        double minPerimeter    = std::numeric_limits<double>::quiet_NaN(); ///< min marker perimeter in pixel
+        double maxPerimeter    = std::numeric_limits<double>::quiet_NaN(); ///< max marker perimeter in pixel
+        int    referenceLength = 0;                                        ///< 0 uses the larger side of the image
+    };
+
     std::vector<ColorBlob> findColorBlob(const ColorBlobDetectionParams &options);
     void
-    restrictPositionBlackDot(ColorBlob &blob, const WorldImageCorrespondence *imageItem, int bS, cv::Rect &cropRect);
+    restrictPositionBlackDot(ColorBlob &blob, const CalibrationSnapshot &calibration, int bS, cv::Rect &cropRect);
     cv::Mat customBgr2Gray(const cv::Mat &subImg, const QColor &midHue);
     void    refineWithBlackDot(
            std::vector<ColorBlob> &blobs,
@@ -315,6 +331,18 @@ namespace detail
         const CodeMarkerOptions     &opt,
         const IntrinsicCameraParams &intrinsicCameraParams,
         bool                         appendRejectedCodes = false);
+    cv::aruco::Dictionary codeMarkerDictionary(int indexOfMarkerDict);
+    MarkerPerimeterBounds markerPerimeterBounds(RecognitionMethod recoMethod, const CodeMarkerOptions &opt);
+    CodeMarkerDetection   detectCodeMarker(
+          const cv::Mat               &img,
+          const cv::aruco::Dictionary &dictionary,
+          const ArucoCodeParams       &parameters,
+          const MarkerPerimeterBounds &bounds);
+    QList<TrackPoint> codeMarkerTrackPoints(
+        const CodeMarkerDetection   &detection,
+        const ArucoCodeParams       &parameters,
+        const IntrinsicCameraParams &intrinsicCameraParams,
+        bool                         appendRejectedCodes);
     cv::aruco::Dictionary getDictMip36h12();
 
     void estimatePoseSingleMarkers(
@@ -0,0 +1,142 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pointKalmanFilter.h"
+
+#include <cfloat>
+
+namespace
+{
+using Matx24f = cv::Matx<float, 2, 4>;
+using Matx42f = cv::Matx<float, 4, 2>;
+
+constexpr float DT = 1.F; // frame difference
+
+// clang-format off
+// Transition matrix for dt (x(t + 1) = x(t) + vx*dt, y(t + 1) = y(t) + vy*dt)
+const cv::Matx44f TRANSITION{
+    1.F, 0.F, DT,  0.F,
+    0.F, 1.F, 0.F, DT,
+    0.F, 0.F, 1.F, 0.F,
+    0.F, 0.F, 0.F, 1.F};
+
+const Matx24f MEASUREMENT{
+    1.F, 0.F, 0.F, 0.F,
+    0.F, 1.F, 0.F, 0.F};
+
+// Q, built from the 1D block for dt
+constexpr float SIGMA_A2 = KalmanFilterParams::SIGMA_A * KalmanFilterParams::SIGMA_A;
+constexpr float Q11      = SIGMA_A2 * (DT * DT * DT * DT) / 4.F; // dt^4/4 * sigma^2
+constexpr float Q12      = SIGMA_A2 * (DT * DT * DT) / 2.F;      // dt^3/2 * sigma^2
+constexpr float Q22      = SIGMA_A2 * (DT * DT);                 // dt^2 * sigma^2
+
+const cv::Matx44f PROCESS_NOISE{
+    Q11, 0.F, Q12, 0.F,
+    0.F, Q11, 0.F, Q12,
+    Q12, 0.F, Q22, 0.F,
+    0.F, Q12, 0.F, Q22};
+// clang-format on
+
+/**
+ * @brief Pseudo inverse of a symmetric positive semidefinite 2x2 matrix
+ *
+ * cv::KalmanFilter solves with DECOMP_SVD, so a singular innovation covariance (e.g. no measurement noise and no
+ * prior uncertainty) has to yield the pseudo inverse instead of failing.
+ */
+cv::Matx22f pseudoInverse(const cv::Matx22f &mat)
+{
+    const float trace = mat(0, 0) + mat(1, 1);
+    const float det   = mat(0, 0) * mat(1, 1) - mat(0, 1) * mat(1, 0);
+    if(trace <= 0.F)
+    {
+        return cv::Matx22f::zeros();
+    }
+    if(det <= FLT_EPSILON * trace * trace)
+    {
+        // rank one: mat = lambda * v * v^T with lambda = trace
+        return mat * (1.F / (trace * trace));
+    }
+    return cv::Matx22f{mat(1, 1), -mat(0, 1), -mat(1, 0), mat(0, 0)} * (1.F / det);
+}
+} // namespace
+
+/**
+ * @brief Resets the filter to the position pos without velocity
+ *
+ * The a priori state and covariance are cleared, the a posteriori covariance is set to the initial variances of
+ * KalmanFilterParams and the measurement noise to zero.
+ */
+void PointKalmanFilter::init(const cv::Point2f &pos)
+{
+    const float pPos = KalmanFilterParams::INIT_POS_VAR;
+    const float pVel = KalmanFilterParams::INIT_VEL_VAR;
+
+    mStatePre            = State::zeros();
+    mStatePost           = State{pos.x, pos.y, 0.F, 0.F};
+    mErrorCovPre         = Covariance::zeros();
+    mErrorCovPost        = Covariance::diag(State{pPos, pPos, pVel, pVel});
+    mMeasurementNoiseCov = cv::Matx22f::zeros();
+}
+
+/// Resets the filter to the position pos moving with velocity vel; the prediction starts from this state, too
+void PointKalmanFilter::init(const cv::Point2f &pos, const cv::Point2f &vel)
+{
+    init(pos);
+    mStatePost = State{pos.x, pos.y, vel.x, vel.y};
+    mStatePre  = mStatePost;
+}
+
+/**
+ * @brief Predicts the position in the next frame
+ *
+ * Like cv::KalmanFilter::predict(), the prediction is also taken as a posteriori state, in case no correction
+ * follows.
+ *
+ * @return predicted position
+ */
+cv::Point2f PointKalmanFilter::predict()
+{
+    mStatePre     = TRANSITION * mStatePost;
+    mErrorCovPre  = TRANSITION * mErrorCovPost * TRANSITION.t() + PROCESS_NOISE;
+    mStatePost    = mStatePre;
+    mErrorCovPost = mErrorCovPre;
+    return {mStatePre[0], mStatePre[1]};
+}
+
+/**
+ * @brief Corrects the last prediction with a measured position
+ * @param measurement measured position
+ * @return corrected position
+ */
+cv::Point2f PointKalmanFilter::correct(const cv::Point2f &measurement)
+{
+    const Matx24f     hp   = MEASUREMENT * mErrorCovPre;
+    const cv::Matx22f s    = hp * MEASUREMENT.t() + mMeasurementNoiseCov;
+    const Matx42f     gain = (pseudoInverse(s) * hp).t();
+
+    const cv::Vec2f innovation = cv::Vec2f{measurement.x, measurement.y} - MEASUREMENT * mStatePre;
+    mStatePost                 = mStatePre + gain * innovation;
+    mErrorCovPost              = mErrorCovPre - gain * hp;
+    return {mStatePost[0], mStatePost[1]};
+}
+
+/// Sets the diagonal measurement noise covariance R
+void PointKalmanFilter::setMeasurementNoise(float varX, float varY)
+{
+    mMeasurementNoiseCov = cv::Matx22f{varX, 0.F, 0.F, varY};
+}
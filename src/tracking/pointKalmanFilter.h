@@ -0,0 +1,69 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef POINTKALMANFILTER_H
+#define POINTKALMANFILTER_H
+
+#include <opencv2/core/matx.hpp>
+#include <opencv2/core/types.hpp>
+
+namespace KalmanFilterParams
+{
+constexpr static float SIGMA_A = 0.2F;
+
+// Initial posterior covariance
+constexpr static float INIT_POS_VAR = 1.0F;
+constexpr static float INIT_VEL_VAR = 1.0F;
+} // namespace KalmanFilterParams
+
+/**
+ * @brief Constant velocity Kalman filter for a single image point
+ *
+ * State is [x, y, vx, vy]^T, the measurement is the position [x, y]^T and the time step is one frame. The filter
+ * computes exactly what cv::KalmanFilter computes for the same model (including the separate a priori and a
+ * posteriori state), but all matrices are fixed size cv::Matx. Hence the filter needs no heap allocation, is cheap
+ * to copy and can be stored by value in every TrackPerson.
+ */
+class PointKalmanFilter
+{
+public:
+    using State      = cv::Vec4f;
+    using Covariance = cv::Matx44f;
+
+    void init(const cv::Point2f &pos);
+    void init(const cv::Point2f &pos, const cv::Point2f &vel);
+
+    cv::Point2f predict();
+    cv::Point2f correct(const cv::Point2f &measurement);
+
+    void setMeasurementNoise(float varX, float varY);
+
+    const State      &statePre() const { return mStatePre; }
+    const State      &statePost() const { return mStatePost; }
+    const Covariance &errorCovPre() const { return mErrorCovPre; }
+    const Covariance &errorCovPost() const { return mErrorCovPost; }
+
+private:
+    State       mStatePre{};            ///< predicted state x'(k) = A*x(k-1)
+    State       mStatePost{};           ///< corrected state x(k) = x'(k) + K(k)*(z(k) - H*x'(k))
+    Covariance  mErrorCovPre{};         ///< a priori error covariance P'(k) = A*P(k-1)*A^T + Q
+    Covariance  mErrorCovPost{};        ///< a posteriori error covariance P(k) = (I - K(k)*H)*P'(k)
+    cv::Matx22f mMeasurementNoiseCov{}; ///< R
+};
+
+#endif // POINTKALMANFILTER_H
@@ -19,9 +19,7 @@
 #include "trackPerson.h"
 
 #include "petrack.h"
-
-#include <opencv2/video/tracking.hpp>
-
+#include "trackingDiagnostics.h"
 
 TrackPerson::TrackPerson(int nr, int frame, const TrackPoint &p) :
     mNr(nr),
@@ -30,8 +28,7 @@ TrackPerson::TrackPerson(int nr, int frame, const TrackPoint &p) :
     mHeightCount(0),
     mFirstFrame(frame),
     mComment(),
-    mColorCount(1),
-    mKalmanFilter(4, 2, 0)
+    mColorCount(1)
 {
     if(auto color = p.getColorForHeightMap())
     {
@@ -48,8 +45,7 @@ TrackPerson::TrackPerson(int nr, int frame, const TrackPoint &p, int markerID) :
     mHeightCount(0),
     mFirstFrame(frame),
     mComment(),
-    mColorCount(1),
-    mKalmanFilter(4, 2, 0)
+    mColorCount(1)
 {
     if(auto color = p.getColorForHeightMap())
     {
@@ -62,78 +58,17 @@ TrackPerson::TrackPerson(int nr, int frame, const TrackPoint &p, int markerID) :
 
 void TrackPerson::initKalmanFilter(const TrackPoint &firstPoint)
 {
-    constexpr float dt      = 1.F; // frame difference
-    constexpr float sigmaA  = KalmanFilterParams::SIGMA_A;
-    constexpr float sigmaA2 = sigmaA * sigmaA;
-
-    mKalmanFilter.init(4, 2);
-    // Constant velocity model
-    // State: [x, y, vx, vy]^T
-    // Transition matrix for dt (x(t + 1) = x(t) + vx*dt, y(t + 1) = y(t) + vy*dt)
-
-    // clang-format off
-    mKalmanFilter.transitionMatrix =
-        (cv::Mat_<float>(4, 4) <<
-        1.F, 0.F, dt, 0.F,
-        0.F, 1.F, 0.F, dt,
-        0.F, 0.F, 1.F, 0.F,
-        0.F, 0.F, 0.F, 1.F
-    );
-
-    mKalmanFilter.measurementMatrix = (cv::Mat_<float>(2, 4) <<
-        1.F, 0.F, 0.F, 0.F,
-        0.F, 1.F, 0.F, 0.F
-    );
-    // clang-format on
-
-    // Q
-    // 1D block for dt:
-    float q11 = sigmaA2 * (dt * dt * dt * dt) / 4.F; // dt^4/4 * sigma^2
-    float q12 = sigmaA2 * (dt * dt * dt) / 2.F;      // dt^3/2 * sigma^2
-    float q22 = sigmaA2 * (dt * dt);                 // dt^2 * sigma^2
-
-    // clang-format off
-    mKalmanFilter.processNoiseCov =
-        (cv::Mat_<float>(4, 4) <<
-        q11, 0.F, q12, 0.F,
-        0.F, q11, 0.F, q12,
-        q12, 0.F, q22, 0.F,
-        0.F, q12, 0.F, q22
-    );
-    // clang-format on
-
-    // Measurement noise covariance R (initial)
-    mKalmanFilter.measurementNoiseCov = cv::Mat::zeros(2, 2, CV_32F);
-
-    // Posteriori covariance P_post
-    float pPos = KalmanFilterParams::INIT_POS_VAR;
-    float pVel = KalmanFilterParams::INIT_VEL_VAR;
-
-    // clang-format off
-    mKalmanFilter.errorCovPost =
-        (cv::Mat_<float>(4, 4) <<
-        pPos, 0.F, 0.F, 0.F,
-        0.F, pPos, 0.F, 0.F,
-        0.F, 0.F, pVel, 0.F,
-        0.F, 0.F, 0.F, pVel
-    );
-    // clang-format on
-
-    // Initialize state with measurement (px, py) and velocity
-    cv::Point2f pos         = firstPoint.pixelPoint().toPoint2f();
-    mKalmanFilter.statePost = (cv::Mat_<float>(4, 1) << pos.x, pos.y, 0.F, 0.F);
-
+    mKalmanFilter.init(firstPoint.pixelPoint().toPoint2f());
     mKalmanInitialized = true;
 }
 
 void TrackPerson::initKalmanFilter(const TrackPoint &firstPoint, const TrackPoint &secondPoint)
 {
-    initKalmanFilter(firstPoint);
     // Initialize state with measurement (px, py) and velocity
-    cv::Point2f pos         = secondPoint.pixelPoint().toPoint2f();
-    cv::Point2f vel         = secondPoint.pixelPoint().toPoint2f() - firstPoint.pixelPoint().toPoint2f();
-    mKalmanFilter.statePost = (cv::Mat_<float>(4, 1) << pos.x, pos.y, vel.x, vel.y);
-    mKalmanFilter.statePre  = mKalmanFilter.statePost;
+    cv::Point2f pos = secondPoint.pixelPoint().toPoint2f();
+    cv::Point2f vel = secondPoint.pixelPoint().toPoint2f() - firstPoint.pixelPoint().toPoint2f();
+    mKalmanFilter.init(pos, vel);
+    mKalmanInitialized = true;
 }
 
 /**
@@ -169,6 +104,10 @@ void TrackPerson::optimizeColor()
             break;
         }
     }
+    if(i == mData.size()) // kein farbpunkt vorhanden
+    {
+        return;
+    }
     if(mData.at(i).getCasernMarker())
     {
         ++anz1;
@@ -204,7 +143,7 @@ void TrackPerson::optimizeColor()
     // farben mit geringerer anzahl loeschen
     if(anz2 > anz1)
     {
-        mData[i].deleteColorMarkers();
+        deleteColorMarkers(i);
     }
     for(j = i + 1; j < mData.size(); ++j)
     {
@@ -221,14 +160,14 @@ void TrackPerson::optimizeColor()
             {
                 if(anz1 > anz2)
                 {
-                    mData[j].deleteColorMarkers();
+                    deleteColorMarkers(j);
                 }
             }
             else
             {
                 if(anz2 > anz1)
                 {
-                    mData[j].deleteColorMarkers();
+                    deleteColorMarkers(j);
                 }
             }
             vBefore = v;
@@ -304,7 +243,11 @@ double TrackPerson::getNearestZ(int i, int *extrapolated) const
         {
             ++nrFor;
         }
-        std::optional<StereoMarker> nrForStereoMarker = mData.at(i + nrFor).getStereoMarker();
+        std::optional<StereoMarker> nrForStereoMarker;
+        if(i + nrFor < mData.size())
+        {
+            nrForStereoMarker = mData.at(i + nrFor).getStereoMarker();
+        }
 
         while((i - nrRew >= 0) &&
               (!mData.at(i - nrRew)
@@ -313,7 +256,11 @@ double TrackPerson::getNearestZ(int i, int *extrapolated) const
             ++nrRew;
         }
 
-        std::optional<StereoMarker> nrRewStereoMarker = mData.at(i - nrRew).getStereoMarker();
+        std::optional<StereoMarker> nrRewStereoMarker;
+        if(i - nrRew >= 0)
+        {
+            nrRewStereoMarker = mData.at(i - nrRew).getStereoMarker();
+        }
 
         if((i + nrFor == mData.size()) && (i - nrRew < 0)) // gar keine Hoeheninfo in trj gefunden
         {
@@ -399,12 +346,8 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
                       0))) // das vorherige einfuegen ist 2x nicht auch schon schlecht gewesen
                 {
                     tp = point;
-                    SPDLOG_WARN(
-                        "Extrapolation instead of tracking because of big difference from tracked point in speed and "
-                        "direction of person {} between frame {} and {}!",
-                        persNr + 1,
-                        lastFrame(),
-                        lastFrame() + 1);
+                    diagnostics::TrackingDiagnostics::global().record(
+                        diagnostics::TrackingEventKind::Extrapolated, frame, persNr + 1, distance);
                     tp = mData.last() + tmp; // nur vektor wird hier durch + geaendert
                     tp.setQual(0);
                     // im anschluss koennte noch dunkelster pkt in umgebung gesucht werden!!!
@@ -414,11 +357,8 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
 
                 else
                 {
-                    SPDLOG_WARN(
-                        "Because of three big differences from tracked point in speed and direction between last three "
-                        "frames the track point of person {} at {} was NOT inserted!",
-                        persNr + 1,
-                        lastFrame() + 1);
+                    diagnostics::TrackingDiagnostics::global().record(
+                        diagnostics::TrackingEventKind::NotInserted, frame, persNr + 1, distance);
                     return false;
                 }
             }
@@ -462,23 +402,16 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
                      (mData.at(1).qual() == 0))) // das vorherige einfuegen ist 2x nicht auch schon schlecht gewesen
                 {
                     tp = point;
-                    SPDLOG_WARN(
-                        "Extrapolation instead of tracking because of big difference from tracked point in speed and "
-                        "direction of person {} between frame {} and {}!",
-                        persNr + 1,
-                        lastFrame(),
-                        lastFrame() - 1);
+                    diagnostics::TrackingDiagnostics::global().record(
+                        diagnostics::TrackingEventKind::Extrapolated, frame, persNr + 1, distance);
                     tp = mData.at(0) + tmp; // nur vektor wird hier durch + geaendert
                     tp.setQual(0);
                     mData.prepend(tp);
                 }
                 else
                 {
-                    SPDLOG_WARN(
-                        "Because of three big differences from tracked point in speed and direction between last three "
-                        "frames the track point of person {} at {} was NOT inserted!",
-                        persNr + 1,
-                        lastFrame() - 1);
+                    diagnostics::TrackingDiagnostics::global().record(
+                        diagnostics::TrackingEventKind::NotInserted, frame, persNr + 1, distance);
                     return false;
                 }
             }
@@ -513,10 +446,8 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
                     tmp = point.pixelPoint() + (trackPointAt(frame - 1).pixelPoint() - *orientationPoint);
                     tp.setX(tmp.x());
                     tp.setY(tmp.y());
-                    SPDLOG_WARN(
-                        "move TrackPoint according to last distance of structure marker and color marker of person {}:",
-                        persNr + 1);
-                    SPDLOG_WARN("         {} -> {}", point, tp);
+                    diagnostics::TrackingDiagnostics::global().record(
+                        diagnostics::TrackingEventKind::MovedByColorMarker, frame, persNr + 1, tp.x(), tp.y());
                 }
             }
             else if(trackPointExist(frame + 1) && trackPointAt(frame + 1).qual() > 90)
@@ -528,10 +459,8 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
                     tmp = point.pixelPoint() + (trackPointAt(frame + 1).pixelPoint() - *orientationPoint);
                     tp.setX(tmp.x());
                     tp.setY(tmp.y());
-                    SPDLOG_WARN(
-                        "move TrackPoint according to last distance of structure marker and color marker of person {}:",
-                        persNr + 1);
-                    SPDLOG_WARN("         {} -> {}", point, tp);
+                    diagnostics::TrackingDiagnostics::global().record(
+                        diagnostics::TrackingEventKind::MovedByColorMarker, frame, persNr + 1, tp.x(), tp.y());
                 }
             }
         }
@@ -553,10 +482,8 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
                (distance > 3))
             {
                 int anz;
-                SPDLOG_WARN(
-                    "Big difference in location between existing and replacing track point of person {} in frame {}!",
-                    persNr + 1,
-                    frame);
+                diagnostics::TrackingDiagnostics::global().record(
+                    diagnostics::TrackingEventKind::ReplacementJump, frame, persNr + 1, distance);
                 // qualitaet anpassen, da der weg zum pkt nicht der richtige gewesen sein kann
                 // zurueck
                 anz = 1;
@@ -567,7 +494,7 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
                 for(int i = 1; i < (anz - 1);
                     ++i) // anz ist einer zu viel; zudem nur boie anz-1 , da sonst eh nur mit 1 multipliziert wuerde
                 {
-                    mData[frame - mFirstFrame - i].setQual((i * trackPointAt(frame - i).qual()) / anz);
+                    mData.setQual(frame - mFirstFrame - i, (i * trackPointAt(frame - i).qual()) / anz);
                 }
                 // vor
                 anz = 1;
@@ -578,24 +505,22 @@ bool TrackPerson::insertAtFrame(int frame, const TrackPoint &point, int persNr,
                 for(int i = 1; i < (anz - 1);
                     ++i) // anz ist einer zu viel; zudem nur boie anz-1 , da sonst eh nur mit 1 multipliziert wuerde
                 {
-                    mData[frame - mFirstFrame + i].setQual((i * trackPointAt(frame + i).qual()) / anz);
+                    mData.setQual(frame - mFirstFrame + i, (i * trackPointAt(frame + i).qual()) / anz);
                 }
             }
 
             if(useKalmanFilter && mKalmanInitialized)
             {
-                mKalmanFilter.measurementNoiseCov = cv::Mat::zeros(2, 2, CV_32F);
-
-                cv::Mat measurement = (cv::Mat_<float>(2, 1) << tp.x(), tp.y());
-                mKalmanFilter.correct(measurement);
+                mKalmanFilter.setMeasurementNoise(0.F, 0.F);
+                mKalmanFilter.correct(tp.pixelPoint().toPoint2f());
             }
 
-            mData.replace(frame - mFirstFrame, tp);
-
-            if(tp.qual() > TrackPoint::BEST_DETECTION_QUAL) // manual add // after inserting, because point ist const
+            if(tp.qual() > TrackPoint::BEST_DETECTION_QUAL) // manual add
             {
-                mData[frame - mFirstFrame].setQual(TrackPoint::BEST_DETECTION_QUAL); // so moving of a point is possible
+                tp.setQual(TrackPoint::BEST_DETECTION_QUAL); // so moving of a point is possible
             }
+
+            mData.set(frame - mFirstFrame, tp);
         }
         else
         {
@@ -621,7 +546,7 @@ bool TrackPerson::trackPointExist(int frame) const
  * @param frame frame to get TrackPoint
  * @return TrackPoint at frame
  */
-const TrackPoint &TrackPerson::trackPointAt(int frame) const
+TrackPoint TrackPerson::trackPointAt(int frame) const
 {
     return mData.at(frame - mFirstFrame);
 }
@@ -653,7 +578,7 @@ double TrackPerson::distanceToNextFrame(int frame) const
  * @param i index of TrackPoint
  * @return i-th TrackPoint of the TrackPerson
  */
-const TrackPoint &TrackPerson::at(int i) const
+TrackPoint TrackPerson::at(int i) const
 {
     return mData.at(i);
 }
@@ -668,34 +593,42 @@ bool TrackPerson::isEmpty() const
     return mData.isEmpty();
 }
 
-const TrackPoint &TrackPerson::first() const
+TrackPoint TrackPerson::first() const
 {
     return mData.first();
 }
 
-const TrackPoint &TrackPerson::last() const
+TrackPoint TrackPerson::last() const
 {
     return mData.last();
 }
 
-QList<TrackPoint>::const_iterator TrackPerson::cbegin() const
+TrajectoryColumns::const_iterator TrackPerson::cbegin() const
 {
-    return mData.cbegin();
+    return mData.begin();
 }
 
-QList<TrackPoint>::const_iterator TrackPerson::cend() const
+TrajectoryColumns::const_iterator TrackPerson::cend() const
 {
-    return mData.cend();
+    return mData.end();
 }
 
-QList<TrackPoint>::const_iterator TrackPerson::begin() const
+TrajectoryColumns::const_iterator TrackPerson::begin() const
 {
-    return mData.cbegin();
+    return mData.begin();
 }
 
-QList<TrackPoint>::const_iterator TrackPerson::end() const
+TrajectoryColumns::const_iterator TrackPerson::end() const
 {
-    return mData.cend();
+    return mData.end();
+}
+
+/**
+ * @brief Approximate number of bytes allocated for the TrackPoints of this person
+ */
+size_t TrackPerson::memoryUsage() const
+{
+    return mData.memoryUsage();
 }
 
 void TrackPerson::append(const TrackPoint &trackPoint)
@@ -710,28 +643,39 @@ void TrackPerson::clear()
 
 void TrackPerson::replaceTrackPoint(int frame, TrackPoint trackPoint)
 {
-    mData[frame - mFirstFrame] = trackPoint;
+    mData.set(frame - mFirstFrame, trackPoint);
 }
 
 void TrackPerson::updateStereoPoint(int frame, Vec3F stereoPoint)
 {
     StereoMarker newStereo{stereoPoint};
-    mData[frame - mFirstFrame].setStereoMarker(newStereo);
+    TrackPoint   point = trackPointAt(frame);
+    point.setStereoMarker(newStereo);
+    replaceTrackPoint(frame, point);
 }
 
 void TrackPerson::updateMarkerID(int frame, int markerID)
 {
-    auto marker = mData[frame - mFirstFrame].getCodeMarker();
+    TrackPoint point  = trackPointAt(frame);
+    auto       marker = point.getCodeMarker();
     if(marker)
     {
         marker->mMarkerId = markerID;
-        mData[frame - mFirstFrame].setCodeMarker(*marker);
+        point.setCodeMarker(*marker);
     }
     else
     {
         CodeMarker newCode{markerID};
-        mData[frame - mFirstFrame].setCodeMarker(newCode);
+        point.setCodeMarker(newCode);
     }
+    replaceTrackPoint(frame, point);
+}
+
+void TrackPerson::deleteColorMarkers(int i)
+{
+    TrackPoint point = mData.at(i);
+    point.deleteColorMarkers();
+    mData.set(i, point);
 }
 
 /**
@@ -765,9 +709,7 @@ void TrackPerson::removeFramesBetween(int startFrame, int endFrame)
     auto startIndex = startFrame - mFirstFrame;
     auto endIndex   = endFrame - mFirstFrame + 1; // +1 to also remove endFrame
 
-    auto startIt = mData.begin() + startIndex;
-    auto endIt   = mData.begin() + endIndex;
-    mData.erase(startIt, endIt);
+    mData.erase(startIndex, endIndex);
 
     if(startFrame == mFirstFrame)
     {
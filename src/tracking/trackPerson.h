@@ -21,9 +21,11 @@
 
 #include "annotationGrouping.h"
 #include "intervalList.h"
+#include "pointKalmanFilter.h"
 #include "recognition.h"
 #include "trackPoint.h"
 #include "trackerConstants.h"
+#include "trajectoryColumns.h"
 #include "trcparser.h"
 #include "vector.h"
 
@@ -32,28 +34,17 @@
 #include <QRegularExpression>
 #include <QSet>
 #include <QTextStream>
-#include <opencv2/video/tracking.hpp>
 #include <spdlog/fmt/bundled/format.h>
 
 class PersonStorage;
 class Petrack;
 
-namespace KalmanFilterParams
-{
-constexpr static float SIGMA_A = 0.2F;
-
-// Initial posterior covariance
-constexpr static float INIT_POS_VAR = 1.0F;
-constexpr static float INIT_VEL_VAR = 1.0F;
-} // namespace KalmanFilterParams
-
-
 /**
  * @brief Stores all tracking information for a whole trajectory, as markerID, color, comment and also the
  * corresponding TrackPoints.
  *
- * A TrackPerson contains all TrackPoints from mFirstFrame to mLastFrame. The index in mData is the frame number plus
- * mFirstFrame.
+ * A TrackPerson contains all TrackPoints from mFirstFrame to mLastFrame. The index in mData is the frame number minus
+ * mFirstFrame. The TrackPoints are stored in columns (see TrajectoryColumns) and returned by value.
  *
  * Important: It is always a continuous range of frames for each person! No gaps in the middle!
  */
@@ -69,9 +60,9 @@ private:
     QString           mComment;       //< comment for person
     int               mNrInBg;        //< number of successive frames in the background
     int               mColorCount;    //< number of colors where mColor is average from
-    QList<TrackPoint> mData{};        //< TrackPoints from mFirstFrame to mLastFrame;;
+    TrajectoryColumns mData{};        //< TrackPoints from mFirstFrame to mLastFrame;;
     IntervalList<int> mGroups{annotationGroups::NO_GROUP.id};
-    cv::KalmanFilter  mKalmanFilter;
+    PointKalmanFilter mKalmanFilter;
     bool              mKalmanInitialized = false;
 
 public:
@@ -134,22 +125,24 @@ public:
     void              addColor(const QColor &col);
     void              optimizeColor();
     bool              trackPointExist(int frame) const;
-    const TrackPoint &trackPointAt(int frame) const;
+    TrackPoint        trackPointAt(int frame) const;
     // gibt -1 zurueck, wenn frame oder naechster frame nicht existiert
     // entfernung ist absolut
     double distanceToNextFrame(int frame) const;
     void   syncTrackPersonMarkerID(int markerID);
 
-    const TrackPoint &at(int i) const;
+    TrackPoint at(int i) const;
 
     int                               size() const;
     bool                              isEmpty() const;
-    const TrackPoint                 &first() const;
-    const TrackPoint                 &last() const;
-    QList<TrackPoint>::const_iterator begin() const;
-    QList<TrackPoint>::const_iterator end() const;
-    QList<TrackPoint>::const_iterator cbegin() const;
-    QList<TrackPoint>::const_iterator cend() const;
+    TrackPoint                        first() const;
+    TrackPoint                        last() const;
+    TrajectoryColumns::const_iterator begin() const;
+    TrajectoryColumns::const_iterator end() const;
+    TrajectoryColumns::const_iterator cbegin() const;
+    TrajectoryColumns::const_iterator cend() const;
+    const TrajectoryColumns          &columns() const { return mData; }
+    size_t                            memoryUsage() const;
 
     void append(const TrackPoint &trackPoint);
     void clear();
@@ -160,7 +153,10 @@ public:
     void                            removeFramesBetween(int startFrame, int endFrame);
     inline IntervalList<int>       &getGroups() { return mGroups; }
     inline const IntervalList<int> &getGroups() const { return mGroups; }
-    cv::KalmanFilter               &getKalmanFilter() { return mKalmanFilter; }
+    PointKalmanFilter              &getKalmanFilter() { return mKalmanFilter; }
+
+private:
+    void deleteColorMarkers(int i);
 };
 
 // mHeightCount wird nicht e3xportiert und auch nicht wieder eingelesen -> nach import auf 0 obwohl auf height ein
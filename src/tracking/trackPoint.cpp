@@ -22,21 +22,21 @@
 
 #include <utility>
 
-TrackPoint::TrackPoint() : mId(nextId++), mQuality(0) {}
-TrackPoint::TrackPoint(const Vec2F &pixelPoint) : mId(nextId++), mPixelPoint(pixelPoint), mQuality(0) {}
-TrackPoint::TrackPoint(const Vec2F &pixelPoint, int qual) : mId(nextId++), mPixelPoint(pixelPoint), mQuality(qual) {}
-
-TrackPoint::TrackPoint(const TrackPoint &other)
-{
-    *this = other;
-}
-
-TrackPoint::TrackPoint(TrackPoint &&other) noexcept
+/**
+ * @brief Markers of this TrackPoint for changing them
+ *
+ * The markers are copied first, if they are shared with other TrackPoints.
+ */
+TrackPoint::Markers &TrackPoint::editMarkers()
 {
-    *this = std::move(other);
+    if(!mMarkers || mMarkers.use_count() > 1)
+    {
+        mMarkers = mMarkers ? std::make_shared<Markers>(*mMarkers) : std::make_shared<Markers>();
+    }
+    // mMarkers is only shared as const, this TrackPoint is its only owner
+    return const_cast<Markers &>(*mMarkers);
 }
 
-
 /**
  * @brief Shifts the pixelPoint and colorPoints of the trackPoint with a given vector
  * @param vec vector to add for the shift
@@ -102,52 +102,63 @@ TrackPoint TrackPoint::createStereoTrackPoint(const Vec2F &pixelPoint, int qual,
 }
 
 
-void TrackPoint::setMultiColorMarker(const MultiColorMarker &marker) // NOLINT: modifies static maps
+void TrackPoint::setMultiColorMarker(const MultiColorMarker &marker)
 {
     if(marker.mColor.isValid())
     {
-        multiColorMap[mId] = marker;
+        editMarkers().multiColor = marker;
     }
-    else
+    else if(getMultiColorMarker())
     {
-        multiColorMap.erase(mId);
+        editMarkers().multiColor.reset();
     }
 }
 
-void TrackPoint::setCasernMarker(const CasernMarker &marker) // NOLINT: modifies static maps
+void TrackPoint::setCasernMarker(const CasernMarker &marker)
 {
     if(marker.mColor.isValid())
     {
-        casernMap[mId] = marker;
+        editMarkers().casern = marker;
     }
-    else
+    else if(getCasernMarker())
     {
-        casernMap.erase(mId);
+        editMarkers().casern.reset();
     }
 }
 
-void TrackPoint::setCodeMarker(const CodeMarker &marker) // NOLINT: modifies static maps
+void TrackPoint::setCodeMarker(const CodeMarker &marker)
 {
-    codeMap[mId] = marker;
+    editMarkers().code = marker;
 }
 
-void TrackPoint::setJapanMarker(const JapanMarker &marker) // NOLINT: modifies static maps
+void TrackPoint::setJapanMarker(const JapanMarker &marker)
 {
-    japanMap[mId] = marker;
+    editMarkers().japan = marker;
 }
-void TrackPoint::setHermesMarker(const HermesMarker &marker) // NOLINT: modifies static maps
+void TrackPoint::setHermesMarker(const HermesMarker &marker)
 {
-    hermesMap[mId] = marker;
+    editMarkers().hermes = marker;
 }
-void TrackPoint::setStereoMarker(const StereoMarker &marker) // NOLINT: modifies static maps
+void TrackPoint::setStereoMarker(const StereoMarker &marker)
 {
     if(marker.mStereoPoint.z() >= 0)
     {
-        stereoMap[mId] = marker;
+        editMarkers().stereo = marker;
+    }
+    else if(getStereoMarker())
+    {
+        editMarkers().stereo.reset();
     }
-    else
+}
+
+void TrackPoint::deleteColorMarkers()
+{
+    if(getMultiColorMarker() || getCasernMarker() || getJapanMarker())
     {
-        stereoMap.erase(mId);
+        auto &markers = editMarkers();
+        markers.multiColor.reset();
+        markers.casern.reset();
+        markers.japan.reset();
     }
 }
 
@@ -213,6 +224,11 @@ std::optional<Vec2F> TrackPoint::getColorPointForOrientation() const
 
 void TrackPoint::copyAllMarkersFromTrackPoint(const TrackPoint &trackPoint)
 {
+    if(!mMarkers)
+    {
+        mMarkers = trackPoint.mMarkers;
+        return;
+    }
     if(const auto multiColorMarker = trackPoint.getMultiColorMarker())
     {
         setMultiColorMarker(MultiColorMarker(*multiColorMarker));
@@ -246,35 +262,6 @@ TrackPoint &TrackPoint::operator=(const Vec2F &vec)
     return *this;
 }
 
-TrackPoint &TrackPoint::operator=(const TrackPoint &other)
-{
-    if(this == &other)
-    {
-        return *this;
-    }
-    mId         = nextId++;
-    mPixelPoint = other.mPixelPoint;
-    mQuality    = other.mQuality;
-    clearMarkers(); // clear all old markers (we only want the new ones)
-    copyAllMarkersFromTrackPoint(other);
-    return *this;
-}
-
-
-TrackPoint &TrackPoint::operator=(TrackPoint &&other) noexcept
-{
-    if(this == &other)
-    {
-        return *this;
-    }
-    mPixelPoint = other.mPixelPoint;
-    mQuality    = other.mQuality;
-    clearMarkers();
-    mId = std::exchange(other.mId, TrackPoint::SENTINEL);
-
-    return *this;
-}
-
 TrackPoint &TrackPoint::operator+=(const Vec2F &vec)
 {
     mPixelPoint += vec;
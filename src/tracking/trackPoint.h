@@ -26,6 +26,7 @@
 #include <QTextStream>
 #include <cstddef>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <spdlog/fmt/bundled/format.h>
 #include <spdlog/spdlog.h>
@@ -70,13 +71,22 @@ struct StereoMarker
 class TrackPoint
 {
 public:
-    TrackPoint();
-    explicit TrackPoint(const Vec2F &pixelPoint);
-    TrackPoint(const Vec2F &pixelPoint, int qual);
-    TrackPoint(const TrackPoint &other);
-    TrackPoint(TrackPoint &&other) noexcept;
+    /// All markers of a TrackPoint; most TrackPoints have none
+    struct Markers
+    {
+        std::optional<MultiColorMarker> multiColor;
+        std::optional<CasernMarker>     casern;
+        std::optional<CodeMarker>       code;
+        std::optional<JapanMarker>      japan;
+        std::optional<HermesMarker>     hermes;
+        std::optional<StereoMarker>     stereo;
+
+        bool empty() const { return !multiColor && !casern && !code && !japan && !hermes && !stereo; }
+    };
 
-    ~TrackPoint() { clearMarkers(); }
+    TrackPoint() = default;
+    explicit TrackPoint(const Vec2F &pixelPoint) : mPixelPoint(pixelPoint) {}
+    TrackPoint(const Vec2F &pixelPoint, int qual) : mPixelPoint(pixelPoint), mQuality(qual) {}
 
     const Vec2F &pixelPoint() const { return mPixelPoint; }
     double       x() const { return mPixelPoint.x(); }
@@ -89,15 +99,11 @@ public:
     void setX(double x) { mPixelPoint.setX(x); }
     void setY(double y) { mPixelPoint.setY(y); }
 
-    void clearMarkers() // NOLINT: modifies static maps
-    {
-        multiColorMap.erase(mId);
-        casernMap.erase(mId);
-        codeMap.erase(mId);
-        japanMap.erase(mId);
-        hermesMap.erase(mId);
-        stereoMap.erase(mId);
-    }
+    void clearMarkers() { mMarkers.reset(); }
+
+    /// markers of this point, shared with its copies; nullptr if it has none
+    const std::shared_ptr<const Markers> &markers() const { return mMarkers; }
+    void setMarkers(std::shared_ptr<const Markers> markers) { mMarkers = std::move(markers); }
 
     void shift(const Vec2F &vec);
 
@@ -118,12 +124,7 @@ public:
     void setHermesMarker(const HermesMarker &marker);
     void setStereoMarker(const StereoMarker &marker);
 
-    void deleteColorMarkers() // NOLINT: modifies static maps
-    {
-        multiColorMap.erase(mId);
-        casernMap.erase(mId);
-        japanMap.erase(mId);
-    }
+    void deleteColorMarkers();
 
     // getters for similar marker properties
     std::optional<QColor> getColorForHeightMap() const;
@@ -133,16 +134,14 @@ public:
     void copyAllMarkersFromTrackPoint(const TrackPoint &trackPoint);
 
 
-    std::optional<MultiColorMarker> getMultiColorMarker() const { return getMapEntry(multiColorMap); }
-    std::optional<CasernMarker>     getCasernMarker() const { return getMapEntry(casernMap); }
-    std::optional<CodeMarker>       getCodeMarker() const { return getMapEntry(codeMap); }
-    std::optional<JapanMarker>      getJapanMarker() const { return getMapEntry(japanMap); }
-    std::optional<HermesMarker>     getHermesMarker() const { return getMapEntry(hermesMap); }
-    std::optional<StereoMarker>     getStereoMarker() const { return getMapEntry(stereoMap); }
+    std::optional<MultiColorMarker> getMultiColorMarker() const { return getMarker(&Markers::multiColor); }
+    std::optional<CasernMarker>     getCasernMarker() const { return getMarker(&Markers::casern); }
+    std::optional<CodeMarker>       getCodeMarker() const { return getMarker(&Markers::code); }
+    std::optional<JapanMarker>      getJapanMarker() const { return getMarker(&Markers::japan); }
+    std::optional<HermesMarker>     getHermesMarker() const { return getMarker(&Markers::hermes); }
+    std::optional<StereoMarker>     getStereoMarker() const { return getMarker(&Markers::stereo); }
 
 
-    TrackPoint &operator=(const TrackPoint &other);
-    TrackPoint &operator=(TrackPoint &&other) noexcept;
     TrackPoint &operator=(const Vec2F &vec);
     TrackPoint &operator+=(const Vec2F &vec);
     TrackPoint &operator-=(const Vec2F &vec);
@@ -151,33 +150,27 @@ public:
     TrackPoint  operator-(const Vec2F &vec) const;
     TrackPoint  operator-(const TrackPoint &other) const;
 
-    static constexpr int         MAX_TRACKING_QUAL    = 80;
-    static constexpr int         BEST_DETECTION_QUAL  = 100;
-    static constexpr int         COLOR_DETECTION_QUAL = 90;
-    static constexpr std::size_t SENTINEL             = std::numeric_limits<std::size_t>::max();
-    [[nodiscard]] bool           isDetection() const;
+    static constexpr int MAX_TRACKING_QUAL    = 80;
+    static constexpr int BEST_DETECTION_QUAL  = 100;
+    static constexpr int COLOR_DETECTION_QUAL = 90;
+    [[nodiscard]] bool   isDetection() const;
 
 
 private:
-    inline static std::unordered_map<std::size_t, MultiColorMarker> multiColorMap;
-    inline static std::unordered_map<std::size_t, CasernMarker>     casernMap;
-    inline static std::unordered_map<std::size_t, CodeMarker>       codeMap;
-    inline static std::unordered_map<std::size_t, JapanMarker>      japanMap;
-    inline static std::unordered_map<std::size_t, HermesMarker>     hermesMap;
-    inline static std::unordered_map<std::size_t, StereoMarker>     stereoMap;
-    inline static std::size_t                                       nextId = 0;
-
-    std::size_t mId = SENTINEL; // make sure id is always initialized! ub otherwise
-    Vec2F       mPixelPoint;
-    int         mQuality;
+    // The markers are shared between copies and only copied when one of them is changed. So copying a TrackPoint
+    // does not allocate and TrackPoints of different persons can be used from different threads without locking.
+    std::shared_ptr<const Markers> mMarkers;
+    Vec2F                          mPixelPoint;
+    int                            mQuality = 0;
 
+    Markers &editMarkers();
 
     template <typename T>
-    std::optional<T> getMapEntry(const std::unordered_map<std::size_t, T> &map) const
+    std::optional<T> getMarker(std::optional<T> Markers::*marker) const
     {
-        if(auto iter = map.find(mId); iter != map.end())
+        if(mMarkers)
         {
-            return iter->second;
+            return (*mMarkers).*marker;
         }
         return std::nullopt;
     }
@@ -20,12 +20,14 @@
 
 #include "animation.h"
 #include "control.h"
+#include "frameProfiler.h"
 #include "helper.h"
 #include "multiColorMarkerWidget.h"
 #include "personStorage.h"
 #include "petrack.h"
 #include "roiItem.h"
 #include "stereoWidget.h"
+#include "trackingDiagnostics.h"
 
 #include <algorithm>
 #include <ctime>
@@ -126,33 +128,43 @@ void Tracker::resize(cv::Size size)
  * @param reTrack boolean saying if people should be retracked, when tracking was of low quality
  * @param reQual threshold for low quality in case of reTrack = true
  * @param borderSize
- * @param onlyVisible
+ * @param onlyVisible persons to track; empty for all persons
  * @return number of feature points
  */
 size_t Tracker::calcPrevFeaturePoints(
-    int          prevFrame,
-    cv::Rect    &rect,
-    int          frame,
-    bool         reTrack,
-    int          reQual,
-    int          borderSize,
-    QSet<size_t> onlyVisible)
+    int                 prevFrame,
+    cv::Rect           &rect,
+    int                 frame,
+    bool                reTrack,
+    int                 reQual,
+    int                 borderSize,
+    const QSet<size_t> &onlyVisible)
 {
-    int j = -1;
-
     mPrevFeaturePoints.clear();
     mPrevFeaturePointsIdx.clear();
 
     if(prevFrame != -1)
     {
+        // only look at persons which exist in the previous frame, in ascending order like the persons themselves
+        std::vector<size_t> candidates;
+        if(onlyVisible.empty())
+        {
+            candidates = mPersonStorage.personsInFrameRange(prevFrame, prevFrame);
+        }
+        else
+        {
+            candidates.assign(onlyVisible.begin(), onlyVisible.end());
+            std::erase_if(candidates, [&](size_t i) { return i >= mPersonStorage.nbPersons(); });
+            std::sort(candidates.begin(), candidates.end());
+        }
+        mPrevFeaturePoints.reserve(candidates.size());
+        mPrevFeaturePointsIdx.reserve(candidates.size());
+
         const auto &persons = mPersonStorage.getPersons();
-        for(int i = 0; i < static_cast<int>(mPersonStorage.nbPersons()); ++i)
+        for(size_t candidate : candidates)
         {
+            const int   i      = static_cast<int>(candidate);
             const auto &person = persons[i];
-            if(!((onlyVisible.empty()) || (onlyVisible.contains(i))))
-            {
-                continue;
-            }
             if(!person.trackPointExist(prevFrame))
             {
                 continue;
@@ -194,14 +206,7 @@ size_t Tracker::calcPrevFeaturePoints(
             if(rect.contains(p2f))
             {
                 mPrevFeaturePoints.push_back(p2f);
-                ++j;
-
                 mPrevFeaturePointsIdx.push_back(i);
-                if(j > MAX_COUNT - 2)
-                {
-                    SPDLOG_WARN("reached maximal number of tracking point: {}", MAX_COUNT);
-                    break; // for loop
-                }
             }
         }
     }
@@ -351,8 +356,12 @@ int Tracker::insertFeaturePoints(int frame, size_t count, cv::Mat &img, int bord
             if(mStatus[i] == TrackStatus::NotTracked && v.x() >= dist && v.y() >= dist &&
                v.x() <= img.cols - 1 - dist && v.y() <= img.rows - 1 - dist)
             {
-                SPDLOG_WARN(
-                    "lost trajectory inside picture of person {} a frame {}!", mPrevFeaturePointsIdx[i] + 1, frame);
+                diagnostics::TrackingDiagnostics::global().record(
+                    diagnostics::TrackingEventKind::LostInsidePicture,
+                    frame,
+                    mPrevFeaturePointsIdx[i] + 1,
+                    mPrevFeaturePoints[i].x,
+                    mPrevFeaturePoints[i].y);
             }
         }
     }
@@ -374,8 +383,14 @@ bool Tracker::tryMergeTrajectories(const TrackPoint &v, size_t i, int frame)
     const auto &persons = mPersonStorage.getPersons();
     const auto &person  = persons[mPrevFeaturePointsIdx[i]];
     // nach trajektorie suchen, mit der eine verschmelzung erfolgen koennte
-    for(int j = 0; !found && j < static_cast<int>(mPersonStorage.nbPersons()); ++j) // ueber TrackPerson
+    // only persons existing in frame can be merged with; after a merge the loop ends, so the indices stay valid
+    for(size_t candidate : mPersonStorage.personsInFrameRange(frame, frame)) // ueber TrackPerson
     {
+        if(found)
+        {
+            break;
+        }
+        const int   j     = static_cast<int>(candidate);
         const auto &other = persons[j];
         if(j != mPrevFeaturePointsIdx[i] && other.trackPointExist(frame) &&
            (other.trackPointAt(frame).distanceToPoint(v) < mMainWindow->getHeadSize(nullptr, j, frame) / 2.))
@@ -390,6 +405,7 @@ bool Tracker::tryMergeTrajectories(const TrackPoint &v, size_t i, int frame)
                    mMainWindow->getHeadSize(nullptr, mPrevFeaturePointsIdx[i], frame + 1) / 2.))))
             {
                 int deleteIndex = mPersonStorage.merge(mPrevFeaturePointsIdx[i], j);
+                diagnostics::FrameProfiler::global().count(diagnostics::Counter::Merges);
 
                 int idxOtherMerged = -1;
                 // shift index of feature points
@@ -444,7 +460,7 @@ void Tracker::track(
     int                     borderSize,
     reco::RecognitionMethod recoMethod,
     int                     level,
-    QSet<size_t>            onlyVisible,
+    const QSet<size_t>     &onlyVisible,
     int                     errorScaleExponent)
 {
     QList<int> trjToDel;
@@ -493,10 +509,14 @@ void Tracker::track(
     size_t numOfPeopleToTrack =
         calcPrevFeaturePoints(mPrevFrame, rect, frame, reTrack, reQual, borderSize, onlyVisible);
     mCurrentlyTracked = static_cast<int>(numOfPeopleToTrack);
+    diagnostics::FrameProfiler::global().count(diagnostics::Counter::PointsTracked, mCurrentlyTracked);
 
     if(numOfPeopleToTrack > 0)
     {
-        preCalculateImagePyramids(level);
+        {
+            diagnostics::ScopedTimer timer(diagnostics::Stage::Pyramids);
+            preCalculateImagePyramids(level);
+        }
 
         if(mPrevFrame != -1)
         {
@@ -513,31 +533,36 @@ void Tracker::track(
             }
         }
 
-        trackFeaturePointsLK(level, mMainWindow->getControlWidget()->getAdaptiveLevel());
+        {
+            diagnostics::ScopedTimer timer(diagnostics::Stage::OpticalFlow);
+            trackFeaturePointsLK(frame, level, mMainWindow->getControlWidget()->getAdaptiveLevel());
 
-        // TODO Split up refineViaColorPointLK as well...
-        refineViaColorPointLK(level, errorScale);
+            // TODO Split up refineViaColorPointLK as well...
+            refineViaColorPointLK(frame, level, errorScale);
 
-        BackgroundFilter *bgFilter = mMainWindow->getBackgroundFilter();
-        // testen, ob Punkt im Vordergrund liegt, ansonsten, wenn nicht gerade zuvor detektiert, ganze
-        // trajektorie loeschen (maximnale laenge ausserhalb ist somit 2 frames)
-        if(bgFilter && bgFilter->getEnabled() && (mPrevFrame != -1)) // nur fuer den fall von bgSubtraction durchfuehren
-        {
-            useBackgroundFilter(trjToDel, bgFilter);
-        }
+            BackgroundFilter *bgFilter = mMainWindow->getBackgroundFilter();
+            // testen, ob Punkt im Vordergrund liegt, ansonsten, wenn nicht gerade zuvor detektiert, ganze
+            // trajektorie loeschen (maximnale laenge ausserhalb ist somit 2 frames)
+            if(bgFilter && bgFilter->getEnabled() &&
+               (mPrevFrame != -1)) // nur fuer den fall von bgSubtraction durchfuehren
+            {
+                useBackgroundFilter(trjToDel, bgFilter);
+            }
 
-        // (bei schlechten, aber noch ertraeglichem fehler in der naehe dunkelsten punkt suchen)
-        // dieser ansatz kann dazu fuehren, dass bei starken helligkeitsunterschieden auf pappe zum schatten
-        // gewandert wird!!!
-        if(!mMainWindow->getStereoWidget()->stereoUseForReco->isChecked() &&
-           ((recoMethod == reco::RecognitionMethod::Casern) ||
-            (recoMethod == reco::RecognitionMethod::Hermes))) // nicht benutzen, wenn ueber disparity der kopf
-                                                              // gesucht wird und somit kein marker vorhanden
-                                                              // oder zumindest nicht am punkt lewigen muss
-        {
-            refineViaNearDarkPoint();
+            // (bei schlechten, aber noch ertraeglichem fehler in der naehe dunkelsten punkt suchen)
+            // dieser ansatz kann dazu fuehren, dass bei starken helligkeitsunterschieden auf pappe zum schatten
+            // gewandert wird!!!
+            if(!mMainWindow->getStereoWidget()->stereoUseForReco->isChecked() &&
+               ((recoMethod == reco::RecognitionMethod::Casern) ||
+                (recoMethod == reco::RecognitionMethod::Hermes))) // nicht benutzen, wenn ueber disparity der kopf
+                                                                  // gesucht wird und somit kein marker vorhanden
+                                                                  // oder zumindest nicht am punkt lewigen muss
+            {
+                refineViaNearDarkPoint(frame);
+            }
         }
 
+        diagnostics::ScopedTimer timer(diagnostics::Stage::InsertTracked);
         insertFeaturePoints(frame, numOfPeopleToTrack, img, borderSize, map1, errorScale);
     }
 
@@ -594,10 +619,11 @@ void Tracker::preCalculateImagePyramids(int level)
  * where it should work. A suspicion: Happens when there is no unique point in the following
  * frame, because of every pixel having the exact same grey level in the smalles pyramid scale.
  *
+ * @param frame frame which is tracked
  * @param level Maximum pyramid level to track with
  * @param adaptive indicates if pyramid level should be lowered after unsuccessful tracking attempt
  */
-void Tracker::trackFeaturePointsLK(int level, bool adaptive)
+void Tracker::trackFeaturePointsLK(int frame, int level, bool adaptive)
 {
     const size_t numOfPeople = mPrevFeaturePointsIdx.size();
     mFeaturePoints.resize(numOfPeople);
@@ -612,13 +638,19 @@ void Tracker::trackFeaturePointsLK(int level, bool adaptive)
     const int  bS              = mMainWindow->getImageBorderSize();
     const bool useKalmanFilter = mMainWindow->getControlWidget()->isTrackUseKalmanChecked();
 
+    // predict all persons in one pass; the filters are small and stored by value in the persons
+    std::vector<cv::Point2f> predictedPts(numOfPeople);
+    for(size_t i = 0; i < numOfPeople; ++i)
+    {
+        predictedPts[i] = mPersonStorage.getKalmanFilterOf(mPrevFeaturePointsIdx[i]).predict() + cv::Point2f(bS, bS);
+    }
+
+    std::vector<cv::Point2f> measurementVar(numOfPeople);
     for(size_t i = 0; i < numOfPeople; ++i)
     {
-        cv::KalmanFilter &kf     = mPersonStorage.getKalmanFilterOf(mPrevFeaturePointsIdx[i]);
         bool isKalmanInitialized = mPersonStorage.isKalmanFilterOfPersonInitialized(mPrevFeaturePointsIdx[i]);
 
-        cv::Mat     prediction = kf.predict();
-        cv::Point2f predictedPt(prediction.at<float>(0) + bS, prediction.at<float>(1) + bS);
+        const cv::Point2f &predictedPt = predictedPts[i];
 
         int   l       = level;
         int   winSize = 0;
@@ -629,7 +661,10 @@ void Tracker::trackFeaturePointsLK(int level, bool adaptive)
         do
         {
             if(l < level)
-                SPDLOG_WARN("try tracking person {} with pyramid level {}", mPrevFeaturePointsIdx[i], l);
+            {
+                diagnostics::TrackingDiagnostics::global().record(
+                    diagnostics::TrackingEventKind::AdaptiveLevelRetry, frame, mPrevFeaturePointsIdx[i] + 1, l);
+            }
 
             winSize = std::max(
                 static_cast<double>(mMainWindow->winSize(nullptr, mPrevFeaturePointsIdx[i], mPrevFrame, l)),
@@ -763,25 +798,34 @@ void Tracker::trackFeaturePointsLK(int level, bool adaptive)
 
         } while(adaptive && !tracked && (l--) > 0);
 
-        mStatus[i] = tracked ? TrackStatus::Tracked : TrackStatus::NotTracked;
+        mStatus[i]        = tracked ? TrackStatus::Tracked : TrackStatus::NotTracked;
+        measurementVar[i] = {dx * dx, dy * dy};
+    }
 
-        if(useKalmanFilter && tracked && isKalmanInitialized)
+    if(!useKalmanFilter)
+    {
+        return;
+    }
+    // correct all tracked persons in one pass
+    for(size_t i = 0; i < numOfPeople; ++i)
+    {
+        if(mStatus[i] != TrackStatus::Tracked)
         {
-            kf.measurementNoiseCov.at<float>(0, 0) = dx * dx;
-            kf.measurementNoiseCov.at<float>(1, 1) = dy * dy;
-
-            cv::Mat meas      = (cv::Mat_<float>(2, 1) << mFeaturePoints[i].x - bS, mFeaturePoints[i].y - bS);
-            cv::Mat corr      = kf.correct(meas);
-            mFeaturePoints[i] = {corr.at<float>(0) + bS, corr.at<float>(1) + bS};
+            continue;
         }
-        else if(useKalmanFilter && tracked && !isKalmanInitialized)
+        PointKalmanFilter &kf = mPersonStorage.getKalmanFilterOf(mPrevFeaturePointsIdx[i]);
+        if(mPersonStorage.isKalmanFilterOfPersonInitialized(mPrevFeaturePointsIdx[i]))
+        {
+            kf.setMeasurementNoise(measurementVar[i].x, measurementVar[i].y);
+            mFeaturePoints[i] = kf.correct(mFeaturePoints[i] - cv::Point2f(bS, bS)) + cv::Point2f(bS, bS);
+        }
+        else
         {
             // Initialize with velocity
             TrackPoint first{{mPrevFeaturePoints[i].x - bS, mPrevFeaturePoints[i].y - bS}};
             TrackPoint second{{mFeaturePoints[i].x - bS, mFeaturePoints[i].y - bS}};
             mPersonStorage.initKalmanFilterOfPerson(mPrevFeaturePointsIdx[i], first, second);
-            kf.measurementNoiseCov.at<float>(0, 0) = dx * dx;
-            kf.measurementNoiseCov.at<float>(1, 1) = dy * dy;
+            kf.setMeasurementNoise(measurementVar[i].x, measurementVar[i].y);
         }
     }
 }
@@ -789,11 +833,12 @@ void Tracker::trackFeaturePointsLK(int level, bool adaptive)
 /**
  * @brief Tries to track colorPoint when featurePoint has high error
  *
+ * @param frame frame which is tracked
  * @param level Pyramidlevel to track with
  * @param numOfPeopleToTrack
  * @param errorScale Factor for highest tolerable tracking error
  */
-void Tracker::refineViaColorPointLK(int level, float errorScale)
+void Tracker::refineViaColorPointLK(int frame, int level, float errorScale)
 {
     int                      winSize;
     bool                     useColor = mMainWindow->getMultiColorMarkerWidget()->useColor->isChecked();
@@ -833,12 +878,10 @@ void Tracker::refineViaColorPointLK(int level, float errorScale)
 
             if((colorStatus[i] == 1) && (colorTrackError[i] < errorScale * 50.F))
             {
-                SPDLOG_WARN(
-                    "tracking color marker instead of structural marker of person {} at {} x {} / error: {} / color "
-                    "error: {}",
+                diagnostics::TrackingDiagnostics::global().record(
+                    diagnostics::TrackingEventKind::ColorMarkerTracked,
+                    frame,
                     mPrevFeaturePointsIdx[i] + 1,
-                    mFeaturePoints[i].x,
-                    mFeaturePoints[i].y,
                     mTrackError[i],
                     colorTrackError[i]);
 
@@ -846,7 +889,6 @@ void Tracker::refineViaColorPointLK(int level, float errorScale)
                 mFeaturePoints[i] = cv::Point2f(
                     mPrevFeaturePoints[i].x + (colorFeaturePoint[i].x - prevColorFeaturePoint[i].x),
                     mPrevFeaturePoints[i].x + (colorFeaturePoint[i].x - prevColorFeaturePoint[i].x));
-                SPDLOG_INFO("\tresulting point: {} x {}", mFeaturePoints[i].x, mFeaturePoints[i].y);
                 mTrackError[i] = colorTrackError[i];
             }
         }
@@ -915,9 +957,10 @@ void Tracker::useBackgroundFilter(QList<int> &trjToDel, BackgroundFilter *bgFilt
  * an black middle. The target of this method is to find this dark point in the
  * middle of the marker and track that instead of the feature point.
  *
+ * @param frame frame which is tracked
  * @param numOfPeopleTracked Number of people who have been tracked
  */
-void Tracker::refineViaNearDarkPoint()
+void Tracker::refineViaNearDarkPoint(int frame)
 {
     int x, y;
     for(size_t i = 0; i < mPrevFeaturePointsIdx.size(); ++i)
@@ -994,7 +1037,12 @@ void Tracker::refineViaNearDarkPoint()
             {
                 mFeaturePoints[i].x = xDark;
                 mFeaturePoints[i].y = yDark;
-                SPDLOG_INFO("move TrackPoint to darker pixel for {}!", i + 1);
+                diagnostics::TrackingDiagnostics::global().record(
+                    diagnostics::TrackingEventKind::MovedToDarkerPixel,
+                    frame,
+                    mPrevFeaturePointsIdx[i] + 1,
+                    mFeaturePoints[i].x,
+                    mFeaturePoints[i].y);
             }
 
             // interpolation wg nachbargrauwerten:
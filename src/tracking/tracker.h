@@ -83,13 +83,13 @@ public:
     void resize(cv::Size size);
 
     size_t calcPrevFeaturePoints(
-        int          prevFrame,
-        cv::Rect    &rect,
-        int          frame,
-        bool         reTrack,
-        int          reQual,
-        int          borderSize,
-        QSet<size_t> onlyVisible);
+        int                 prevFrame,
+        cv::Rect           &rect,
+        int                 frame,
+        bool                reTrack,
+        int                 reQual,
+        int                 borderSize,
+        const QSet<size_t> &onlyVisible);
 
     int insertFeaturePoints(int frame, size_t count, cv::Mat &img, int borderSize, cv::Mat map1, float errorScale);
 
@@ -104,7 +104,7 @@ public:
         int                     borderSize,
         reco::RecognitionMethod recoMethod,
         int                     level              = 3,
-        QSet<size_t>            onlyVisible        = QSet<size_t>(),
+        const QSet<size_t>     &onlyVisible        = QSet<size_t>(),
         int                     errorScaleExponent = 0);
 
     void checkPlausibility(
@@ -119,10 +119,10 @@ private:
     bool tryMergeTrajectories(const TrackPoint &v, size_t i, int frame);
 
     void trackFeaturePointsLK(int level);
-    void trackFeaturePointsLK(int level, bool adaptive);
-    void refineViaColorPointLK(int level, float errorScale);
+    void trackFeaturePointsLK(int frame, int level, bool adaptive);
+    void refineViaColorPointLK(int frame, int level, float errorScale);
     void useBackgroundFilter(QList<int> &trjToDel, BackgroundFilter *bgFilter);
-    void refineViaNearDarkPoint();
+    void refineViaNearDarkPoint(int frame);
     void preCalculateImagePyramids(int level);
 };
 
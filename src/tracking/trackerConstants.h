@@ -23,9 +23,6 @@
 // ein problem)
 inline constexpr double EXTRAPOLATE_FACTOR = 3.;
 
-// maximale anzahl an gleichzeitig getrackten personen
-inline constexpr int MAX_COUNT = 1500;
-
 // maximale zahl an frames zwischen denen noch getrackt wird
 inline constexpr int MAX_STEP_TRACK = 5;
 
@@ -21,10 +21,12 @@
 #include "animation.h"
 #include "control.h"
 #include "helper.h"
+#include "pProgressDialog.h"
 #include "personStorage.h"
 #include "petrack.h"
 #include "player.h"
 #include "recognition.h"
+#include "walkAreaField.h"
 #include "worldImageCorrespondence.h"
 
 #include <H5Cpp.h>
@@ -32,6 +34,8 @@
 #include <QJsonObject>
 #include <QProgressDialog>
 #include <QVariantMap>
+#include <cmath>
+#include <limits>
 #include <opencv2/highgui.hpp>
 
 TrackPointReal::TrackPointReal(const Vec3F &p, int frameNum) : Vec3F(p), mFrameNum(frameNum)
@@ -153,6 +157,7 @@ int TrackerReal::calculate(
         {
             clear();
         }
+        mVelocitiesValid = false;
 
         int        j, f;
         QList<int> missingList;    // frame nr wo ausgelassen; passend dazu:
@@ -195,6 +200,19 @@ int TrackerReal::calculate(
         float           angle;
         QString         comment;
 
+        // ausreisser ausfindig machen (dies geschieht, bevor -1 elemente herausgenommen werden, um die
+        // glaettung beim eliminieren der -1 elemente hier nicht einfluss nehmen zu lassen):
+        // wenn direkt pointgrey hoehe oder eigene hoehenberechnung aber variierend ueber trj genommen werden soll
+        if(exportSmooth && (useTrackpoints || alternateHeight))
+        {
+            // changes Trajectories!
+            PProgressDialog progress(Petrack::tr("Smoothing the heights of all persons..."), petrack);
+            if(!mPersonStorage.smoothHeights(progress.callback()))
+            {
+                SPDLOG_WARN("smoothing of the heights cancelled, only some persons are smoothed");
+            }
+        }
+
         const auto &persons = mPersonStorage.getPersons();
         for(size_t i = 0; i < persons.size(); ++i) // ueber trajektorien
         {
@@ -229,15 +247,6 @@ int TrackerReal::calculate(
             for(j = 0; (j < tsize); ++j) // ueber trackpoints
             {
                 Vec2F moveDir(0, 0); // used for head direction
-                // ausreisser ausfindig machen (dies geschieht, bevor -1 elemente herausgenommen werden, um die
-                // glaettung beim eliminieren der -1 elemente hier nicht einfluss nehmen zu lassen):
-                if(exportSmooth && (useTrackpoints || alternateHeight) &&
-                   (tsize > 1)) // wenn direkt pointgrey hoehe oder eigene hoehenberechnung aber variierend ueber
-                                // trj genommen werden soll
-                {
-                    // changes Trajectories!
-                    mPersonStorage.smoothHeight(i, j + person.firstFrame());
-                }
                 if(useTrackpoints)
                 {
                     if(auto stereoMarker = person.at(j).getStereoMarker())
@@ -520,6 +529,8 @@ int TrackerReal::calculate(
                 SPDLOG_WARN("person {} is not inserted, because of no TrackPoints!", i + 1);
             }
         }
+        // precompute the velocities, so the analysis plot only has to draw them
+        velocities(VelocityOptions::fromProject(*petrack));
         return size();
     }
     else
@@ -531,6 +542,154 @@ int TrackerReal::calculate(
     }
 }
 
+VelocityOptions VelocityOptions::fromProject(Petrack &petrack)
+{
+    const Control  *control = petrack.getControlWidget();
+    VelocityOptions options;
+    options.step        = control->getAnaStep();
+    options.considerX   = control->isAnaConsiderXChecked();
+    options.considerY   = control->isAnaConsiderYChecked();
+    options.considerAbs = control->isAnaConsiderAbsChecked();
+    options.considerRev = control->isAnaConsiderRevChecked();
+    options.fps         = petrack.getAnimation()->getSequenceFPS();
+    return options;
+}
+
+/**
+ * @brief Computes the velocities of all persons with finite differences over options.step frames
+ *
+ * The coordinates of each person are copied into contiguous arrays first, so the differences are simple loops over
+ * plain arrays which the compiler can vectorize.
+ *
+ * @param persons trajectories in cm
+ * @param options selects the considered components and the step width
+ * @return velocities in m/s and their mean per frame
+ */
+VelocitySeries computeVelocities(const QList<TrackPersonReal> &persons, const VelocityOptions &options)
+{
+    VelocitySeries series;
+    const int      step   = std::max(1, options.step);
+    const double   fps    = options.fps > 0 ? options.fps : DEFAULT_FPS;
+    const double   factor = fps / (100. * step); // cm per step frames -> m/s
+
+    size_t nbSamples  = 0;
+    int    firstFrame = std::numeric_limits<int>::max();
+    int    lastFrame  = std::numeric_limits<int>::min();
+    for(const auto &person : persons)
+    {
+        if(person.size() > step)
+        {
+            nbSamples += person.size() - step;
+            firstFrame = std::min(firstFrame, person.firstFrame());
+            lastFrame  = std::max(lastFrame, person.firstFrame() + static_cast<int>(person.size()) - step - 1);
+        }
+    }
+    series.frames.reserve(nbSamples);
+    series.animFrames.reserve(nbSamples);
+    series.velocities.resize(nbSamples);
+    series.personStart.reserve(persons.size() + 1);
+
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<double> zs;
+    size_t              offset = 0;
+    for(const auto &person : persons)
+    {
+        const int nb = static_cast<int>(person.size()) - step;
+        if(nb > 0)
+        {
+            xs.resize(person.size());
+            ys.resize(person.size());
+            zs.resize(person.size());
+            for(int j = 0; j < person.size(); ++j)
+            {
+                xs[j] = person.at(j).x();
+                ys[j] = person.at(j).y();
+                zs[j] = person.at(j).z();
+            }
+
+            double *vel = series.velocities.data() + offset;
+            if(options.considerX && options.considerY)
+            {
+                for(int j = 0; j < nb; ++j)
+                {
+                    const double dx = xs[j + step] - xs[j];
+                    const double dy = ys[j + step] - ys[j];
+                    const double dz = zs[j + step] - zs[j];
+                    vel[j]          = std::sqrt(dx * dx + dy * dy + dz * dz) * factor;
+                }
+            }
+            else
+            {
+                const double *c = options.considerX ? xs.data() : ys.data();
+                if(options.considerAbs)
+                {
+                    for(int j = 0; j < nb; ++j)
+                    {
+                        vel[j] = std::abs(c[j + step] - c[j]) * factor;
+                    }
+                }
+                else if(options.considerRev)
+                {
+                    for(int j = 0; j < nb; ++j)
+                    {
+                        vel[j] = (c[j] - c[j + step]) * factor;
+                    }
+                }
+                else
+                {
+                    for(int j = 0; j < nb; ++j)
+                    {
+                        vel[j] = (c[j + step] - c[j]) * factor;
+                    }
+                }
+            }
+
+            for(int j = 0; j < nb; ++j)
+            {
+                series.frames.push_back(person.firstFrame() + j);
+                series.animFrames.push_back(person.at(j).frameNum()); // without inserted missing frames
+            }
+            offset += nb;
+        }
+        series.personStart.push_back(offset);
+    }
+
+    if(nbSamples > 0)
+    {
+        std::vector<double> sums(lastFrame - firstFrame + 1, 0.);
+        std::vector<int>    counts(sums.size(), 0);
+        for(size_t i = 0; i < nbSamples; ++i)
+        {
+            sums[series.frames[i] - firstFrame] += series.velocities[i];
+            ++counts[series.frames[i] - firstFrame];
+        }
+        series.firstFrame = firstFrame;
+        series.meanVelocities.resize(sums.size());
+        for(size_t i = 0; i < sums.size(); ++i)
+        {
+            series.meanVelocities[i] = counts[i] > 0 ? sums[i] / counts[i] : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    return series;
+}
+
+/**
+ * @brief Returns the velocities of all persons for the given options
+ *
+ * The velocities are computed once after calculate() and only recomputed if the options change.
+ */
+const VelocitySeries &TrackerReal::velocities(const VelocityOptions &options)
+{
+    if(!mVelocitiesValid || options != mVelocityOptions)
+    {
+        mVelocities      = computeVelocities(*this, options);
+        mVelocityOptions = options;
+        mVelocitiesValid = true;
+    }
+    return mVelocities;
+}
+
 void TrackerReal::calcMinMax()
 {
     Vec3F pos;
@@ -609,13 +768,14 @@ int TrackerReal::smallestLastFrame()
 }
 
 void TrackerReal::exportTxt(
-    QTextStream &out,
-    bool         alternateHeight,
-    bool         useTrackpoints,
-    bool         exportViewingDirection,
-    bool         exportAngleOfView,
-    bool         exportUseM,
-    bool         exportMarkerID)
+    QTextStream                   &out,
+    bool                           alternateHeight,
+    bool                           useTrackpoints,
+    bool                           exportViewingDirection,
+    bool                           exportAngleOfView,
+    bool                           exportUseM,
+    bool                           exportMarkerID,
+    const walkarea::WalkAreaField *wallDistance)
 {
     float scale;
 
@@ -628,6 +788,11 @@ void TrackerReal::exportTxt(
     {
         out << "# viewAngle: angle of view of camera to person from perpendicular [0..Pi/2]" << Qt::endl;
     }
+    if(wallDistance)
+    {
+        out << "# wallDistance: distance to the nearest wall or obstacle, negative outside of the walkable area"
+            << Qt::endl;
+    }
     if(exportUseM)
     {
         out << "# id frame x/m y/m z/m";
@@ -648,6 +813,10 @@ void TrackerReal::exportTxt(
     {
         out << " markerID";
     }
+    if(wallDistance)
+    {
+        out << (exportUseM ? " wallDistance/m" : " wallDistance/cm");
+    }
 
     out << Qt::endl;
 
@@ -705,6 +874,11 @@ void TrackerReal::exportTxt(
                 out << " " << at(i).getMarkerID();
             }
 
+            if(wallDistance)
+            {
+                out << " " << wallDistance->signedDistance(QPointF(at(i).at(j).x(), at(i).at(j).y())) * scale;
+            }
+
             out << Qt::endl;
         }
     }
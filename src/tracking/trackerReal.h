@@ -19,6 +19,7 @@
 #ifndef TRACKERREAL_H
 #define TRACKERREAL_H
 
+#include "animation.h"
 #include "colorPlot.h"
 #include "imageItem.h"
 #include "tracker.h"
@@ -26,6 +27,7 @@
 
 #include <QList>
 #include <utility>
+#include <vector>
 
 class PersonStorage;
 class WorldImageCorrespondence;
@@ -35,6 +37,11 @@ namespace H5
 class H5Object;
 }
 
+namespace walkarea
+{
+class WalkAreaField;
+}
+
 struct TrackPointInfoHdf5
 {
     int   id;
@@ -179,6 +186,42 @@ inline QTextStream &operator<<(QTextStream &s, const TrackPersonReal &tp)
 
 //----------------------------------------------------------------------------
 
+/// options of the velocity analysis shown in the AnalysePlot
+struct VelocityOptions
+{
+    int    step        = 1;     ///< distance in frames used for the finite differences
+    bool   considerX   = false; ///< both considerX and considerY: absolute velocity
+    bool   considerY   = true;
+    bool   considerAbs = false; ///< absolute value of the single considered component
+    bool   considerRev = false; ///< reversed sign of the single considered component
+    double fps         = DEFAULT_FPS;
+
+    bool operator==(const VelocityOptions &other) const = default;
+
+    static VelocityOptions fromProject(Petrack &petrack);
+};
+
+/**
+ * @brief Velocities of all persons of a TrackerReal in contiguous arrays
+ *
+ * The samples of the i-th person are stored at the indices [personStart[i], personStart[i+1]). meanVelocities holds
+ * the mean velocity over all persons for each frame from firstFrame on; frames without any sample are NaN.
+ */
+struct VelocitySeries
+{
+    std::vector<int>    frames;     ///< frame of the sample including inserted missing frames
+    std::vector<int>    animFrames; ///< frame of the sample in the animation
+    std::vector<double> velocities; ///< velocity in m/s
+    std::vector<size_t> personStart{0};
+
+    int                 firstFrame = 0;
+    std::vector<double> meanVelocities;
+
+    size_t size() const { return velocities.size(); }
+};
+
+VelocitySeries computeVelocities(const QList<TrackPersonReal> &persons, const VelocityOptions &options);
+
 // using tracker:
 // 1. initial recognition
 // 2. next frame track existing track points
@@ -195,6 +238,10 @@ private:
     Petrack       *mMainWindow;
     PersonStorage &mPersonStorage;
 
+    VelocitySeries  mVelocities;
+    VelocityOptions mVelocityOptions;
+    bool            mVelocitiesValid = false;
+
 public:
     inline double xMin() const { return mXMin; }
     inline double xMax() const { return mXMax; }
@@ -232,6 +279,8 @@ public:
         bool                            exportMarkerID         = false,
         bool                            exportAutoCorrect      = false);
 
+    const VelocitySeries &velocities(const VelocityOptions &options);
+
     void calcMinMax();
     int  largestFirstFrame();
     int  largestLastFrame();
@@ -240,13 +289,14 @@ public:
 
     // alternateHeight true, wenn keine eindeutige personengroesse ausgegeben wird, sondern fuer jeden pounkt andere
     void exportTxt(
-        QTextStream &out,
-        bool         alternateHeight,
-        bool         useTrackpoints,
-        bool         exportViewingDirection,
-        bool         exportAngleOfView,
-        bool         exportUseM,
-        bool         exportMarkerID);
+        QTextStream                   &out,
+        bool                           alternateHeight,
+        bool                           useTrackpoints,
+        bool                           exportViewingDirection,
+        bool                           exportAngleOfView,
+        bool                           exportUseM,
+        bool                           exportMarkerID,
+        const walkarea::WalkAreaField *wallDistance = nullptr);
     void exportDat(QTextStream &out, bool alternateHeight, bool useTrackpoints); // fuer gnuplot
     void exportXml(QTextStream &outXml, bool alternateHeight, bool useTrackpoints);
     void exportHdf5(
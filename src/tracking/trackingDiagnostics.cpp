@@ -0,0 +1,355 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trackingDiagnostics.h"
+
+#include "logger.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+namespace diagnostics
+{
+namespace
+{
+constexpr std::array<const char *, NB_TRACKING_EVENT_KINDS> EVENT_NAMES = {
+    "lost_inside_picture",
+    "adaptive_level_retry",
+    "color_marker_tracked",
+    "moved_to_darker_pixel",
+    "extrapolated",
+    "not_inserted",
+    "moved_by_color_marker",
+    "replacement_jump",
+    "ambiguous_assignment"};
+
+constexpr std::array<const char *, NB_TRACKING_EVENT_KINDS> SUMMARY_TEXTS = {
+    "lost inside picture",
+    "retried with smaller pyramid level",
+    "tracked via color marker",
+    "moved to darker pixel",
+    "extrapolated",
+    "not inserted",
+    "moved by color marker",
+    "replaced by distant point",
+    "ambiguous assignment"};
+} // namespace
+
+const char *toString(TrackingEventKind kind)
+{
+    return EVENT_NAMES.at(static_cast<std::size_t>(kind));
+}
+
+std::optional<TrackingEventKind> trackingEventKindFromString(const QString &name)
+{
+    for(std::size_t i = 0; i < EVENT_NAMES.size(); ++i)
+    {
+        if(name == QLatin1String(EVENT_NAMES[i]))
+        {
+            return static_cast<TrackingEventKind>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+TrackingDiagnostics::TrackingDiagnostics(std::size_t capacity) :
+    mCapacity(std::bit_ceil(std::max<std::size_t>(capacity, 1))), mSlots(std::make_unique<Slot[]>(mCapacity))
+{
+}
+
+/**
+ * @brief Diagnostics used by the tracking of the application
+ */
+TrackingDiagnostics &TrackingDiagnostics::global()
+{
+    static TrackingDiagnostics diagnostics;
+    return diagnostics;
+}
+
+/// the fields are only ordered by the sequence of the slot, see record() and events()
+void TrackingDiagnostics::Slot::store(const TrackingEvent &event)
+{
+    kind.store(event.kind, std::memory_order_relaxed);
+    frame.store(event.frame, std::memory_order_relaxed);
+    personNr.store(event.personNr, std::memory_order_relaxed);
+    otherPersonNr.store(event.otherPersonNr, std::memory_order_relaxed);
+    value1.store(event.value1, std::memory_order_relaxed);
+    value2.store(event.value2, std::memory_order_relaxed);
+}
+
+TrackingEvent TrackingDiagnostics::Slot::load() const
+{
+    return {
+        kind.load(std::memory_order_relaxed),
+        frame.load(std::memory_order_relaxed),
+        personNr.load(std::memory_order_relaxed),
+        otherPersonNr.load(std::memory_order_relaxed),
+        value1.load(std::memory_order_relaxed),
+        value2.load(std::memory_order_relaxed)};
+}
+
+/**
+ * @brief Handles an event which is not (or no longer) stored in the ring buffer
+ *
+ * It is moved into the growable buffer if all events are kept, and counted as overwritten otherwise.
+ */
+void TrackingDiagnostics::lose(std::size_t position, const TrackingEvent &event)
+{
+    if(keepAllEvents())
+    {
+        std::lock_guard lock(mSpilledMutex);
+        mSpilled.emplace_back(position, event);
+    }
+    else
+    {
+        mOverwrittenCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Stores an event in the ring buffer; safe to call from several threads and lock-free
+ *
+ * Writers which lapped each other may reach the same slot in any order. A writer only replaces an older event and
+ * does not wait if another writer is just writing the slot; the event which is not stored in the slot is handled by
+ * lose().
+ */
+void TrackingDiagnostics::record(
+    TrackingEventKind kind,
+    int               frame,
+    int               personNr,
+    float             value1,
+    float             value2,
+    int               otherPersonNr)
+{
+    const std::size_t   position = mHead.fetch_add(1, std::memory_order_relaxed);
+    Slot               &slot     = mSlots[position & (mCapacity - 1)];
+    const TrackingEvent event{kind, frame, personNr, otherPersonNr, value1, value2};
+
+    std::size_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    while(true)
+    {
+        if(sequence % 2 == 1 || sequence > sequenceOf(position))
+        {
+            // another writer is just writing the slot or it already holds a newer event
+            lose(position, event);
+            break;
+        }
+        if(slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire))
+        {
+            // readers seeing the odd sequence retry, so the fields may be written now
+            std::atomic_thread_fence(std::memory_order_release);
+            if(sequence != 0)
+            {
+                lose(sequence / 2 - 1, slot.load());
+            }
+            slot.store(event);
+            slot.sequence.store(sequenceOf(position), std::memory_order_release);
+            break;
+        }
+    }
+
+    mUnreported[static_cast<std::size_t>(kind)].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Logs one line with the number of events per kind recorded since the last summary
+ *
+ * Nothing is logged if no event was recorded.
+ */
+void TrackingDiagnostics::logFrameSummary(int frame)
+{
+    std::string summary;
+    int         total = 0;
+    for(std::size_t i = 0; i < NB_TRACKING_EVENT_KINDS; ++i)
+    {
+        const int count = mUnreported[i].exchange(0, std::memory_order_relaxed);
+        if(count > 0)
+        {
+            summary += fmt::format("{}{} {}", total > 0 ? ", " : "", count, SUMMARY_TEXTS[i]);
+            total += count;
+        }
+    }
+    if(total > 0)
+    {
+        SPDLOG_WARN("frame {}: {} (details in tracking diagnostics)", frame, summary);
+    }
+}
+
+/**
+ * @brief Removes all events; must not be called while events are recorded
+ */
+void TrackingDiagnostics::clear()
+{
+    for(std::size_t i = 0; i < mCapacity; ++i)
+    {
+        mSlots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    for(auto &count : mUnreported)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard lock(mSpilledMutex);
+        mSpilled.clear();
+        mSpilled.shrink_to_fit();
+    }
+    mOverwrittenCount.store(0, std::memory_order_relaxed);
+    mHead.store(0, std::memory_order_release);
+}
+
+/**
+ * @brief Number of events which were lost because the ring buffer was full and not all events were kept
+ */
+std::size_t TrackingDiagnostics::overwrittenCount() const
+{
+    return mOverwrittenCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief All events still in the ring buffer or kept after being overwritten, from oldest to newest
+ *
+ * A slot is read again if a writer replaced it while its event was copied.
+ */
+std::vector<TrackingEvent> TrackingDiagnostics::events() const
+{
+    const std::size_t head  = mHead.load(std::memory_order_acquire);
+    const std::size_t first = head > mCapacity ? head - mCapacity : 0;
+
+    std::vector<std::pair<std::size_t, TrackingEvent>> collected;
+    {
+        std::lock_guard lock(mSpilledMutex);
+        collected = mSpilled;
+    }
+    collected.reserve(collected.size() + (head - first));
+    for(std::size_t position = first; position < head; ++position)
+    {
+        const Slot &slot = mSlots[position & (mCapacity - 1)];
+        while(true)
+        {
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if(sequence % 2 == 1)
+            {
+                continue; // just written, maybe with the event at position
+            }
+            if(sequence != sequenceOf(position))
+            {
+                break; // empty or overwritten
+            }
+            const TrackingEvent event = slot.load();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot.sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                collected.emplace_back(position, event);
+                break;
+            }
+        }
+    }
+    std::sort(
+        collected.begin(), collected.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+    std::vector<TrackingEvent> result;
+    result.reserve(collected.size());
+    std::transform(
+        collected.begin(),
+        collected.end(),
+        std::back_inserter(result),
+        [](const auto &positionAndEvent) { return positionAndEvent.second; });
+    return result;
+}
+
+std::vector<TrackingEvent> TrackingDiagnostics::events(TrackingEventKind kind) const
+{
+    auto result = events();
+    std::erase_if(result, [kind](const TrackingEvent &event) { return event.kind != kind; });
+    return result;
+}
+
+std::vector<TrackingEvent> TrackingDiagnostics::eventsInFrame(int frame) const
+{
+    auto result = events();
+    std::erase_if(result, [frame](const TrackingEvent &event) { return event.frame != frame; });
+    return result;
+}
+
+bool TrackingDiagnostics::exportCsv(const QString &filename) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        SPDLOG_ERROR("Cannot open {} to write tracking diagnostics: {}", filename, file.errorString());
+        return false;
+    }
+    if(const std::size_t overwritten = overwrittenCount(); overwritten > 0)
+    {
+        SPDLOG_WARN("{} tracking diagnostics events were overwritten and are missing in {}", overwritten, filename);
+    }
+    QTextStream out(&file);
+    out << "kind,frame,person,other_person,value1,value2\n";
+    for(const auto &event : events())
+    {
+        out << toString(event.kind) << ',' << event.frame << ',' << event.personNr << ',' << event.otherPersonNr
+            << ',' << event.value1 << ',' << event.value2 << '\n';
+    }
+    return out.status() == QTextStream::Ok;
+}
+
+bool TrackingDiagnostics::exportJson(const QString &filename) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        SPDLOG_ERROR("Cannot open {} to write tracking diagnostics: {}", filename, file.errorString());
+        return false;
+    }
+    QJsonArray array;
+    for(const auto &event : events())
+    {
+        array.append(QJsonObject{
+            {"kind", toString(event.kind)},
+            {"frame", event.frame},
+            {"person", event.personNr},
+            {"otherPerson", event.otherPersonNr},
+            {"value1", event.value1},
+            {"value2", event.value2}});
+    }
+    QJsonObject root{
+        {"overwritten", static_cast<qint64>(overwrittenCount())},
+        {"events", array},
+    };
+    return file.write(QJsonDocument(root).toJson()) != -1;
+}
+
+/**
+ * @brief Exports the events as JSON if filename ends with .json, as CSV otherwise
+ */
+bool TrackingDiagnostics::exportFile(const QString &filename) const
+{
+    if(QFileInfo(filename).suffix().compare("json", Qt::CaseInsensitive) == 0)
+    {
+        return exportJson(filename);
+    }
+    return exportCsv(filename);
+}
+} // namespace diagnostics
@@ -0,0 +1,146 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACKINGDIAGNOSTICS_H
+#define TRACKINGDIAGNOSTICS_H
+
+#include <QString>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace diagnostics
+{
+/// Kind of a noteworthy event during tracking; the meaning of the values of a TrackingEvent depends on it
+enum class TrackingEventKind : std::uint8_t
+{
+    LostInsidePicture,   ///< trajectory could not be tracked although inside the image; values: last x, y
+    AdaptiveLevelRetry,  ///< tracking retried with smaller pyramid level; value1: level
+    ColorMarkerTracked,  ///< color marker tracked instead of structure marker; values: error, color error
+    MovedToDarkerPixel,  ///< tracked point moved to a darker pixel nearby; values: new x, y
+    Extrapolated,        ///< point extrapolated instead of tracked; value1: distance to tracked point
+    NotInserted,         ///< point rejected after repeated extrapolation; value1: distance to tracked point
+    MovedByColorMarker,  ///< detection moved by the offset to the color marker; values: new x, y
+    ReplacementJump,     ///< replacing point far away from the existing one; value1: distance
+    AmbiguousAssignment, ///< several persons near a recognized point; values: distance to person, to otherPerson
+};
+
+inline constexpr std::size_t NB_TRACKING_EVENT_KINDS = 9;
+
+const char                      *toString(TrackingEventKind kind);
+std::optional<TrackingEventKind> trackingEventKindFromString(const QString &name);
+
+struct TrackingEvent
+{
+    TrackingEventKind kind;
+    int               frame;
+    int               personNr;      ///< person number as shown in the GUI (index + 1)
+    int               otherPersonNr; ///< second person involved or -1
+    float             value1;
+    float             value2;
+};
+
+/**
+ * @brief Collects events of the tracking as typed records instead of formatting a log line for each of them
+ *
+ * Events are written into a fixed size lock-free ring buffer, so recording is cheap and may happen from several
+ * threads. Each slot is a seqlock: its sequence is odd while a writer replaces the event and readers retry until they
+ * copied the event without a writer in between. A writer never waits for another one; if the slot is just written or
+ * already holds a newer event, its event is not stored in the slot.
+ *
+ * When the buffer is full, the oldest events are overwritten, unless keeping all events is enabled (e.g. for
+ * exporting the diagnostics of a whole run); then overwritten events and events not stored in their slot are moved
+ * into a growable buffer instead. Instead of one warning per person and frame, logFrameSummary() prints one aggregated
+ * line per frame. The recorded events can be queried and exported as CSV or JSON afterwards.
+ *
+ * Queries and exports should be done while no events are recorded (e.g. after trackAll); events which are still
+ * written while copying may be missing.
+ */
+class TrackingDiagnostics
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t{1} << 16;
+
+    explicit TrackingDiagnostics(std::size_t capacity = DEFAULT_CAPACITY);
+
+    static TrackingDiagnostics &global();
+
+    void record(
+        TrackingEventKind kind,
+        int               frame,
+        int               personNr,
+        float             value1        = 0.F,
+        float             value2        = 0.F,
+        int               otherPersonNr = -1);
+
+    void logFrameSummary(int frame);
+    void clear();
+
+    void setKeepAllEvents(bool keepAll) { mKeepAll.store(keepAll, std::memory_order_relaxed); }
+    bool keepAllEvents() const { return mKeepAll.load(std::memory_order_relaxed); }
+
+    std::vector<TrackingEvent> events() const;
+    std::vector<TrackingEvent> events(TrackingEventKind kind) const;
+    std::vector<TrackingEvent> eventsInFrame(int frame) const;
+
+    std::size_t capacity() const { return mCapacity; }
+    std::size_t recordedCount() const { return mHead.load(std::memory_order_relaxed); }
+    std::size_t overwrittenCount() const;
+
+    bool exportCsv(const QString &filename) const;
+    bool exportJson(const QString &filename) const;
+    bool exportFile(const QString &filename) const;
+
+private:
+    /// the fields of the event are atomic, so a reader may copy them while a writer replaces them
+    struct Slot
+    {
+        std::atomic<std::size_t>       sequence{0}; ///< 2 * (position in the stream + 1), odd while written, 0 if empty
+        std::atomic<TrackingEventKind> kind{};
+        std::atomic<int>               frame{0};
+        std::atomic<int>               personNr{0};
+        std::atomic<int>               otherPersonNr{0};
+        std::atomic<float>             value1{0.F};
+        std::atomic<float>             value2{0.F};
+
+        void          store(const TrackingEvent &event);
+        TrackingEvent load() const;
+    };
+
+    static std::size_t sequenceOf(std::size_t position) { return 2 * (position + 1); }
+
+    void lose(std::size_t position, const TrackingEvent &event);
+
+    std::size_t                                           mCapacity;
+    std::unique_ptr<Slot[]>                               mSlots;
+    std::atomic<std::size_t>                              mHead{0};
+    std::array<std::atomic<int>, NB_TRACKING_EVENT_KINDS> mUnreported{}; ///< events per kind since last summary
+    std::atomic<bool>                                     mKeepAll{false};
+    std::atomic<std::size_t>                              mOverwrittenCount{0}; ///< events lost while not all kept
+    mutable std::mutex                                    mSpilledMutex;
+    std::vector<std::pair<std::size_t, TrackingEvent>>    mSpilled; ///< overwritten events with their position
+};
+} // namespace diagnostics
+
+#endif // TRACKINGDIAGNOSTICS_H
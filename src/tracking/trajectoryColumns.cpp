@@ -0,0 +1,166 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trajectoryColumns.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+constexpr size_t MIN_FRONT_SLOTS = 8;
+
+/// qualities are in [0, TrackPoint::BEST_DETECTION_QUAL], so they fit into 8 bit
+std::uint8_t toQual(int qual)
+{
+    return static_cast<std::uint8_t>(std::clamp(qual, 0, 255));
+}
+} // namespace
+
+TrackPoint TrajectoryColumns::at(int i) const
+{
+    if(i < 0 || i >= size())
+    {
+        throw std::out_of_range(fmt::format("TrackPoint index {} out of range [0, {})", i, size()));
+    }
+    TrackPoint point{Vec2F(x(i), y(i)), qual(i)};
+    if(auto markers = mMarkers.find(position(i)); markers != mMarkers.end())
+    {
+        point.setMarkers(markers->second);
+    }
+    return point;
+}
+
+void TrajectoryColumns::append(const TrackPoint &point)
+{
+    mX.push_back(point.x());
+    mY.push_back(point.y());
+    mQual.push_back(toQual(point.qual()));
+    setMarkers(size() - 1, point.markers());
+}
+
+void TrajectoryColumns::prepend(const TrackPoint &point)
+{
+    if(mHead == 0)
+    {
+        growFront();
+    }
+    --mHead;
+    --mOrigin;
+    mX[mHead]    = point.x();
+    mY[mHead]    = point.y();
+    mQual[mHead] = toQual(point.qual());
+    setMarkers(0, point.markers());
+}
+
+void TrajectoryColumns::set(int i, const TrackPoint &point)
+{
+    mX[mHead + i]    = point.x();
+    mY[mHead + i]    = point.y();
+    mQual[mHead + i] = toQual(point.qual());
+    setMarkers(i, point.markers());
+}
+
+void TrajectoryColumns::setQual(int i, int qual)
+{
+    mQual[mHead + i] = toQual(qual);
+}
+
+/// the markers are shared with the TrackPoint, not copied
+void TrajectoryColumns::setMarkers(int i, const MarkersPtr &markers)
+{
+    if(markers && !markers->empty())
+    {
+        mMarkers[position(i)] = markers;
+    }
+    else
+    {
+        mMarkers.erase(position(i));
+    }
+}
+
+/**
+ * @brief Removes the points with index in [from, to)
+ *
+ * Removing from the front only moves the first point, so cutting a trajectory at its start is O(1) for the columns.
+ */
+void TrajectoryColumns::erase(int from, int to)
+{
+    if(from >= to)
+    {
+        return;
+    }
+    const std::int64_t count = to - from;
+    mMarkers.erase(mMarkers.lower_bound(position(from)), mMarkers.lower_bound(position(to)));
+
+    if(from == 0)
+    {
+        mHead += to;
+        mOrigin += count;
+        return;
+    }
+
+    const auto first = static_cast<std::ptrdiff_t>(mHead) + from;
+    const auto last  = static_cast<std::ptrdiff_t>(mHead) + to;
+    mX.erase(mX.begin() + first, mX.begin() + last);
+    mY.erase(mY.begin() + first, mY.begin() + last);
+    mQual.erase(mQual.begin() + first, mQual.begin() + last);
+
+    // points behind the removed range move to the front
+    std::map<std::int64_t, MarkersPtr> moved;
+    for(auto iter = mMarkers.lower_bound(position(from)); iter != mMarkers.end();)
+    {
+        moved.emplace(iter->first - count, std::move(iter->second));
+        iter = mMarkers.erase(iter);
+    }
+    mMarkers.merge(moved);
+}
+
+void TrajectoryColumns::clear()
+{
+    mX.clear();
+    mY.clear();
+    mQual.clear();
+    mHead   = 0;
+    mOrigin = 0;
+    mMarkers.clear();
+}
+
+/**
+ * @brief Approximate number of bytes allocated for the trajectory
+ *
+ * For every point with markers the tree node (three pointers and a color flag) and the shared markers are counted.
+ * Markers shared between several points are counted for each of them.
+ */
+size_t TrajectoryColumns::memoryUsage() const
+{
+    constexpr size_t markerSize =
+        sizeof(decltype(mMarkers)::value_type) + 4 * sizeof(void *) + sizeof(TrackPoint::Markers);
+    return mX.capacity() * sizeof(double) + mY.capacity() * sizeof(double) + mQual.capacity() * sizeof(std::uint8_t) +
+           mMarkers.size() * markerSize;
+}
+
+/// doubles the free slots in front of the first point, so prepending is amortized O(1)
+void TrajectoryColumns::growFront()
+{
+    const size_t slots = std::max(MIN_FRONT_SLOTS, static_cast<size_t>(size()));
+    mX.insert(mX.begin(), slots, 0.);
+    mY.insert(mY.begin(), slots, 0.);
+    mQual.insert(mQual.begin(), slots, 0);
+    mHead += slots;
+}
@@ -0,0 +1,156 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRAJECTORYCOLUMNS_H
+#define TRAJECTORYCOLUMNS_H
+
+#include "trackPoint.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Storage of the TrackPoints of a trajectory in columns
+ *
+ * The coordinates and qualities are stored in separate contiguous arrays, so loops over many points only touch the
+ * data they need. Markers are rare and stored sparse. A TrackPoint is assembled from the columns on access, so at()
+ * and the iterators return TrackPoints by value.
+ *
+ * Points can be appended and prepended in amortized O(1): free slots are kept in front of the first point and
+ * doubled when they are used up. The markers are keyed by a position which does not change when prepending.
+ */
+class TrajectoryColumns
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = TrackPoint;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = TrackPoint;
+
+        const_iterator() = default;
+        const_iterator(const TrajectoryColumns *columns, int index) : mColumns(columns), mIndex(index) {}
+
+        TrackPoint operator*() const { return mColumns->at(mIndex); }
+        TrackPoint operator[](difference_type n) const { return mColumns->at(mIndex + static_cast<int>(n)); }
+
+        const_iterator &operator++()
+        {
+            ++mIndex;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            auto old = *this;
+            ++mIndex;
+            return old;
+        }
+        const_iterator &operator--()
+        {
+            --mIndex;
+            return *this;
+        }
+        const_iterator operator--(int)
+        {
+            auto old = *this;
+            --mIndex;
+            return old;
+        }
+        const_iterator &operator+=(difference_type n)
+        {
+            mIndex += static_cast<int>(n);
+            return *this;
+        }
+        const_iterator &operator-=(difference_type n)
+        {
+            mIndex -= static_cast<int>(n);
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator iter, difference_type n) { return iter += n; }
+        friend const_iterator operator+(difference_type n, const_iterator iter) { return iter += n; }
+        friend const_iterator operator-(const_iterator iter, difference_type n) { return iter -= n; }
+        friend difference_type operator-(const const_iterator &lhs, const const_iterator &rhs)
+        {
+            return lhs.mIndex - rhs.mIndex;
+        }
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs)
+        {
+            return lhs.mIndex == rhs.mIndex;
+        }
+        friend auto operator<=>(const const_iterator &lhs, const const_iterator &rhs)
+        {
+            return lhs.mIndex <=> rhs.mIndex;
+        }
+
+    private:
+        const TrajectoryColumns *mColumns = nullptr;
+        int                      mIndex   = 0;
+    };
+
+    int  size() const { return static_cast<int>(mX.size() - mHead); }
+    bool isEmpty() const { return size() == 0; }
+
+    TrackPoint at(int i) const;
+    TrackPoint first() const { return at(0); }
+    TrackPoint last() const { return at(size() - 1); }
+
+    double x(int i) const { return mX[mHead + i]; }
+    double y(int i) const { return mY[mHead + i]; }
+    int    qual(int i) const { return mQual[mHead + i]; }
+
+    std::span<const double>       xs() const { return {mX.data() + mHead, static_cast<size_t>(size())}; }
+    std::span<const double>       ys() const { return {mY.data() + mHead, static_cast<size_t>(size())}; }
+    std::span<const std::uint8_t> quals() const { return {mQual.data() + mHead, static_cast<size_t>(size())}; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size()}; }
+
+    void append(const TrackPoint &point);
+    void prepend(const TrackPoint &point);
+    void set(int i, const TrackPoint &point);
+    void setQual(int i, int qual);
+    void erase(int from, int to);
+    void clear();
+
+    size_t memoryUsage() const;
+
+private:
+    using MarkersPtr = std::shared_ptr<const TrackPoint::Markers>;
+
+    std::int64_t position(int i) const { return mOrigin + i; }
+    void         setMarkers(int i, const MarkersPtr &markers);
+    void         growFront();
+
+    std::vector<double>                mX;
+    std::vector<double>                mY;
+    std::vector<std::uint8_t>          mQual;
+    size_t                             mHead   = 0; ///< number of free slots in front of the first point
+    std::int64_t                       mOrigin = 0; ///< position of the first point
+    std::map<std::int64_t, MarkersPtr> mMarkers;    ///< markers per position, only for points having some
+};
+
+#endif // TRAJECTORYCOLUMNS_H
@@ -0,0 +1,301 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trajectoryStitching.h"
+
+#include "logger.h"
+
+#include <QJsonArray>
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace stitching
+{
+namespace
+{
+struct Candidate
+{
+    size_t left;  ///< index in the result
+    size_t right; ///< index in the later shard
+    double distance;
+};
+
+/**
+ * @brief Mean distance of two trajectories in the frames [fromFrame, toFrame] both contain
+ * @return std::nullopt if the trajectories cannot be the same person
+ */
+std::optional<double> stitchDistance(
+    const TrackPerson   &left,
+    const TrackPerson   &right,
+    int                  fromFrame,
+    int                  toFrame,
+    const StitchOptions &options)
+{
+    const bool bothHaveMarker = left.getMarkerID() >= 0 && right.getMarkerID() >= 0;
+    if(options.useMarkerIDs && bothHaveMarker && left.getMarkerID() != right.getMarkerID())
+    {
+        return std::nullopt;
+    }
+
+    const int first = std::max({fromFrame, left.firstFrame(), right.firstFrame()});
+    const int last  = std::min({toFrame, left.lastFrame(), right.lastFrame()});
+    if(last - first + 1 < options.minCommonFrames)
+    {
+        return std::nullopt;
+    }
+    if(options.useMarkerIDs && bothHaveMarker)
+    {
+        return 0.;
+    }
+
+    double sum = 0;
+    for(int frame = first; frame <= last; ++frame)
+    {
+        sum += left.trackPointAt(frame).distanceToPoint(right.trackPointAt(frame));
+    }
+    const double distance = sum / (last - first + 1);
+    if(distance > options.maxDistance)
+    {
+        return std::nullopt;
+    }
+    return distance;
+}
+
+/// Appends right to left, switching from left to right at frame cut (or the closest possible frame)
+void join(TrackPerson &left, const TrackPerson &right, int cut)
+{
+    const int switchFrame = std::clamp(cut, right.firstFrame(), left.lastFrame() + 1);
+    if(switchFrame <= left.firstFrame())
+    {
+        // left is completely covered by right
+        const int markerID = left.getMarkerID();
+        left               = right;
+        if(left.getMarkerID() < 0 && markerID >= 0)
+        {
+            left.setMarkerID(markerID);
+        }
+        return;
+    }
+
+    if(switchFrame <= left.lastFrame())
+    {
+        left.removeFramesBetween(switchFrame, left.lastFrame());
+    }
+    for(int frame = switchFrame; frame <= right.lastFrame(); ++frame)
+    {
+        left.append(right.trackPointAt(frame));
+    }
+    if(left.getMarkerID() < 0 && right.getMarkerID() >= 0)
+    {
+        left.setMarkerID(right.getMarkerID());
+    }
+}
+} // namespace
+
+QJsonObject StitchReport::toJson() const
+{
+    QJsonArray ambiguousStitches;
+    for(const auto &stitch : ambiguous)
+    {
+        ambiguousStitches.append(QJsonObject{
+            {"shard", stitch.shard},
+            {"frame", stitch.frame},
+            {"personNr", stitch.personNr},
+            {"distance", stitch.distance},
+            {"alternativeDistance", stitch.alternativeDistance}});
+    }
+    return QJsonObject{
+        {"shards", nbShards},
+        {"stitches", nbStitches},
+        {"ambiguousStitches", nbAmbiguous},
+        {"unmatched", nbUnmatched},
+        {"ambiguous", ambiguousStitches}};
+}
+
+/**
+ * @brief Splits [firstFrame, lastFrame] into nbShards ranges of similar length, where neighbors share overlap frames
+ *
+ * The overlap is reduced, if the ranges would get shorter than it; the number of shards is reduced, if there are
+ * fewer frames than shards.
+ */
+std::vector<FrameShard> splitFrameRange(int firstFrame, int lastFrame, int nbShards, int overlap)
+{
+    const int nbFrames = lastFrame - firstFrame + 1;
+    if(nbFrames <= 0)
+    {
+        return {};
+    }
+    nbShards = std::clamp(nbShards, 1, nbFrames);
+    overlap  = std::clamp(overlap, 0, nbFrames / nbShards);
+
+    auto boundary = [&](int shard)
+    { return firstFrame + static_cast<int>(static_cast<long long>(shard) * nbFrames / nbShards); };
+
+    std::vector<FrameShard> shards;
+    for(int i = 0; i < nbShards; ++i)
+    {
+        shards.push_back(
+            {std::max(firstFrame, boundary(i) - overlap / 2),
+             std::min(lastFrame, boundary(i + 1) - 1 + overlap - overlap / 2)});
+    }
+    return shards;
+}
+
+/// Removes all TrackPoints outside of range and all persons without TrackPoints in range
+void cropToFrameRange(std::vector<TrackPerson> &persons, const FrameShard &range)
+{
+    std::erase_if(
+        persons,
+        [&range](const TrackPerson &person)
+        { return person.isEmpty() || person.lastFrame() < range.firstFrame || person.firstFrame() > range.lastFrame; });
+    for(auto &person : persons)
+    {
+        if(person.firstFrame() < range.firstFrame)
+        {
+            person.removeFramesBetween(person.firstFrame(), range.firstFrame - 1);
+        }
+        if(person.lastFrame() > range.lastFrame)
+        {
+            person.removeFramesBetween(range.lastFrame + 1, person.lastFrame());
+        }
+    }
+}
+
+/**
+ * @brief Joins the trajectories of neighboring shards
+ *
+ * For each overlap, all pairs of a trajectory reaching into the overlap from the earlier shard and one from the later
+ * shard are compared by their mean distance in the overlap. The closest pairs are joined greedily; the joined
+ * trajectory follows the earlier shard until the middle of the overlap and the later shard afterwards. A stitch is
+ * reported as ambiguous, if one of both trajectories has another partner which is at most options.ambiguityRatio
+ * times farther away. Trajectories of the later shard without partner are added as new persons.
+ *
+ * @param shards trajectories of each shard, cropped to its frame range
+ * @param frameShards frame ranges of the shards, see splitFrameRange()
+ * @param options criteria for joining
+ * @param report statistics of the stitching
+ * @return joined trajectories
+ */
+std::vector<TrackPerson> stitchShards(
+    std::vector<std::vector<TrackPerson>> shards,
+    const std::vector<FrameShard>        &frameShards,
+    const StitchOptions                  &options,
+    StitchReport                         &report)
+{
+    report = StitchReport{};
+    if(shards.empty())
+    {
+        return {};
+    }
+    report.nbShards = static_cast<int>(shards.size());
+
+    std::vector<TrackPerson> result = std::move(shards.front());
+    for(size_t shard = 1; shard < shards.size(); ++shard)
+    {
+        const int overlapFirst = frameShards[shard].firstFrame;
+        const int overlapLast  = frameShards[shard - 1].lastFrame;
+        const int cut          = (overlapFirst + overlapLast + 1) / 2;
+        auto     &later        = shards[shard];
+
+        std::vector<size_t> leftOpen;
+        for(size_t i = 0; i < result.size(); ++i)
+        {
+            if(result[i].lastFrame() >= overlapFirst)
+            {
+                leftOpen.push_back(i);
+            }
+        }
+
+        std::vector<Candidate> candidates;
+        for(size_t left : leftOpen)
+        {
+            for(size_t right = 0; right < later.size(); ++right)
+            {
+                if(later[right].firstFrame() > overlapLast)
+                {
+                    continue;
+                }
+                if(auto distance = stitchDistance(result[left], later[right], overlapFirst, overlapLast, options))
+                {
+                    candidates.push_back({left, right, *distance});
+                }
+            }
+        }
+        std::stable_sort(
+            candidates.begin(),
+            candidates.end(),
+            [](const Candidate &a, const Candidate &b) { return a.distance < b.distance; });
+
+        std::vector<bool> leftUsed(result.size(), false);
+        std::vector<bool> rightUsed(later.size(), false);
+        for(const auto &candidate : candidates)
+        {
+            if(leftUsed[candidate.left] || rightUsed[candidate.right])
+            {
+                continue;
+            }
+            leftUsed[candidate.left]   = true;
+            rightUsed[candidate.right] = true;
+
+            double alternative = std::numeric_limits<double>::infinity();
+            for(const auto &other : candidates)
+            {
+                const bool sharesOne = (other.left == candidate.left) != (other.right == candidate.right);
+                if(sharesOne)
+                {
+                    alternative = std::min(alternative, other.distance);
+                }
+            }
+            if(alternative <= options.ambiguityRatio * candidate.distance)
+            {
+                ++report.nbAmbiguous;
+                report.ambiguous.push_back(
+                    {static_cast<int>(shard),
+                     cut,
+                     static_cast<int>(candidate.left) + 1,
+                     candidate.distance,
+                     alternative});
+                SPDLOG_WARN(
+                    "Ambiguous stitch of person {} at frame {}: distance {:.2f}, alternative {:.2f}",
+                    candidate.left + 1,
+                    cut,
+                    candidate.distance,
+                    alternative);
+            }
+
+            join(result[candidate.left], later[candidate.right], cut);
+            ++report.nbStitches;
+        }
+
+        for(size_t left : leftOpen)
+        {
+            report.nbUnmatched += leftUsed[left] ? 0 : 1;
+        }
+        for(size_t right = 0; right < later.size(); ++right)
+        {
+            if(!rightUsed[right])
+            {
+                report.nbUnmatched += later[right].firstFrame() <= overlapLast ? 1 : 0;
+                result.push_back(std::move(later[right]));
+            }
+        }
+    }
+    return result;
+}
+} // namespace stitching
@@ -0,0 +1,81 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRAJECTORYSTITCHING_H
+#define TRAJECTORYSTITCHING_H
+
+#include "trackPerson.h"
+
+#include <QJsonObject>
+#include <vector>
+
+/**
+ * @brief Joining trajectories which were tracked independently in overlapping frame ranges
+ *
+ * A long video can be tracked in shards, i.e. overlapping frame ranges tracked in parallel. Afterwards the
+ * trajectories of neighboring shards are matched by their positions (and marker IDs) in the overlap and joined in the
+ * middle of the overlap.
+ */
+namespace stitching
+{
+struct FrameShard
+{
+    int firstFrame = 0;
+    int lastFrame  = 0;
+};
+
+struct StitchOptions
+{
+    double maxDistance     = 10.;  ///< maximal mean distance in pixel of two trajectories in the overlap
+    double ambiguityRatio  = 1.5;  ///< a stitch is ambiguous, if an alternative is at most this factor worse
+    int    minCommonFrames = 3;    ///< minimal number of frames both trajectories need in the overlap
+    bool   useMarkerIDs    = true; ///< trajectories with different marker IDs are never joined
+};
+
+struct AmbiguousStitch
+{
+    int    shard               = 0; ///< index of the later of both shards
+    int    frame               = 0; ///< frame where the trajectories were joined
+    int    personNr            = 0; ///< number of the joined trajectory in the result, starting with 1
+    double distance            = 0; ///< mean distance of the joined trajectories
+    double alternativeDistance = 0; ///< mean distance of the best alternative
+};
+
+struct StitchReport
+{
+    int                          nbShards    = 0;
+    int                          nbStitches  = 0;
+    int                          nbAmbiguous = 0;
+    int                          nbUnmatched = 0; ///< trajectories reaching into an overlap without any partner
+    std::vector<AmbiguousStitch> ambiguous;
+
+    QJsonObject toJson() const;
+};
+
+std::vector<FrameShard> splitFrameRange(int firstFrame, int lastFrame, int nbShards, int overlap);
+
+void cropToFrameRange(std::vector<TrackPerson> &persons, const FrameShard &range);
+
+std::vector<TrackPerson> stitchShards(
+    std::vector<std::vector<TrackPerson>> shards,
+    const std::vector<FrameShard>        &frameShards,
+    const StitchOptions                  &options,
+    StitchReport                         &report);
+} // namespace stitching
+
+#endif // TRAJECTORYSTITCHING_H
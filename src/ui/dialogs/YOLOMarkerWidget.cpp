@@ -22,7 +22,38 @@
 #include "recognition.h"
 #include "ui_YOLOMarkerWidget.h"
 
+#include <QDateTime>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <map>
+#include <mutex>
+
+namespace
+{
+/**
+ * @brief Reads the network from modelFile or returns the already loaded one
+ *
+ * Reading a network is expensive and projects processed one after another (e.g. in batch mode) mostly use the same
+ * model. The cache is keyed by the absolute path; a model file changed on disk is read again.
+ */
+cv::dnn::Net readCachedNet(const QString &modelFile)
+{
+    static std::mutex                                            cacheMutex;
+    static std::map<QString, std::pair<QDateTime, cv::dnn::Net>> cache;
+
+    const QFileInfo  info{modelFile};
+    const QString    path         = info.absoluteFilePath();
+    const QDateTime  lastModified = info.lastModified();
+    std::scoped_lock lock{cacheMutex};
+    if(auto iter = cache.find(path); iter != cache.end() && iter->second.first == lastModified)
+    {
+        return iter->second.second;
+    }
+    auto network = cv::dnn::readNet(modelFile.toStdString());
+    cache[path]  = {lastModified, network};
+    return network;
+}
+} // namespace
 
 YOLOMarkerWidget::YOLOMarkerWidget(QWidget *parent, Ui::YOLOMarkerWidget *ui) : QWidget(parent)
 {
@@ -164,7 +195,7 @@ void YOLOMarkerWidget::initialize()
     }
     try
     {
-        mYOLOMarkerOptions.network = cv::dnn::readNet(mYOLOMarkerOptions.modelFile.toStdString());
+        mYOLOMarkerOptions.network = readCachedNet(mYOLOMarkerOptions.modelFile);
     }
     catch(cv::Exception &e)
     {
@@ -0,0 +1,43 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pProgressDialog.h"
+
+#include <QApplication>
+
+PProgressDialog::PProgressDialog(const QString &labelText, QWidget *parent) :
+    QProgressDialog(labelText, tr("Abort"), 0, 0, parent)
+{
+    setWindowModality(Qt::WindowModal); // blocks main window
+}
+
+/**
+ * @brief Progress hook updating this dialog
+ *
+ * @return hook returning false, if the user aborted; has to be called from the thread of the dialog
+ */
+std::function<bool(std::size_t, std::size_t)> PProgressDialog::callback()
+{
+    return [this](std::size_t processed, std::size_t total)
+    {
+        setMaximum(static_cast<int>(total));
+        setValue(static_cast<int>(processed));
+        qApp->processEvents();
+        return !wasCanceled();
+    };
+}
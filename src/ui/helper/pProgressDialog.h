@@ -0,0 +1,42 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PPROGRESSDIALOG_H
+#define PPROGRESSDIALOG_H
+
+#include <QProgressDialog>
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Modal progress dialog which serves as progress hook of long operations, e.g. PersonStorage::recalcHeight()
+ *
+ * The dialog only shows up, if the operation takes longer than the minimum duration of QProgressDialog. Pressing
+ * "Abort" makes the hook request the cancellation of the operation.
+ */
+class PProgressDialog : public QProgressDialog
+{
+    Q_OBJECT
+
+public:
+    PProgressDialog(const QString &labelText, QWidget *parent);
+
+    std::function<bool(std::size_t processed, std::size_t total)> callback();
+};
+
+#endif // PPROGRESSDIALOG_H
@@ -32,6 +32,10 @@
 #include <qwt_symbol.h>
 #include <qwt_text.h>
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 //-----------------------------------------------------------------
 class AnalyseZoomer : public QwtPlotZoomer
 {
@@ -117,57 +121,146 @@ public:
 
 //-----------------------------------------------------------------------------------------
 
-// die kreise liegen mgl nicht genau auf kreuz - noch zu testen
+namespace
+{
+/// marks pixels already painted, so samples mapped to the same pixel are only drawn once
+class PixelMask
+{
+public:
+    explicit PixelMask(const QRect &rect) : mRect(rect), mMask(static_cast<size_t>(rect.width()) * rect.height()) {}
+
+    /// returns false if point is outside of the rect or its pixel was already set
+    bool set(const QPointF &point)
+    {
+        const int x = static_cast<int>(point.x()) - mRect.left();
+        const int y = static_cast<int>(point.y()) - mRect.top();
+        if(x < 0 || y < 0 || x >= mRect.width() || y >= mRect.height())
+        {
+            return false;
+        }
+        std::vector<bool>::reference pixel = mMask[static_cast<size_t>(y) * mRect.width() + x];
+        if(pixel)
+        {
+            return false;
+        }
+        pixel = true;
+        return true;
+    }
+
+private:
+    QRect             mRect;
+    std::vector<bool> mMask;
+};
+
+/**
+ * @brief Draws the mean velocity as lines with level-of-detail decimation
+ *
+ * For every pixel column only the first, minimal, maximal and last value are kept, which results in the same image as
+ * drawing every frame, but needs at most four points per column. Frames without a value interrupt the line.
+ */
+void drawMeanVelocity(
+    QPainter                  &painter,
+    const VelocitySeries      &series,
+    const QwtScaleMap         &mapX,
+    const QwtScaleMap         &mapY,
+    const std::pair<int, int> &visibleFrames)
+{
+    const auto &mean = series.meanVelocities;
+    const int   from = std::max(0, visibleFrames.first - series.firstFrame);
+    const int   to   = std::min(static_cast<int>(mean.size()) - 1, visibleFrames.second - series.firstFrame);
+
+    QPolygonF line;
+    int       column = std::numeric_limits<int>::min();
+    double    x      = 0;
+    double    first = 0, last = 0, min = 0, max = 0;
+
+    auto flushColumn = [&]()
+    {
+        if(column == std::numeric_limits<int>::min())
+        {
+            return;
+        }
+        line.append(QPointF(x, mapY.transform(first)));
+        if(min != max)
+        {
+            line.append(QPointF(x, mapY.transform(min)));
+            line.append(QPointF(x, mapY.transform(max)));
+        }
+        if(last != first && last != min && last != max)
+        {
+            line.append(QPointF(x, mapY.transform(last)));
+        }
+        column = std::numeric_limits<int>::min();
+    };
+    auto flushLine = [&]()
+    {
+        flushColumn();
+        if(line.size() > 1)
+        {
+            painter.drawPolyline(line);
+        }
+        line.clear();
+    };
+
+    for(int i = from; i <= to; ++i)
+    {
+        const double value = mean[i];
+        if(std::isnan(value))
+        {
+            flushLine();
+            continue;
+        }
+        const double frameX = mapX.transform(series.firstFrame + i);
+        if(static_cast<int>(frameX) != column)
+        {
+            flushColumn();
+            column = static_cast<int>(frameX);
+            x      = frameX;
+            first  = min = max = value;
+        }
+        min  = std::min(min, value);
+        max  = std::max(max, value);
+        last = value;
+    }
+    flushLine();
+}
+} // namespace
+
 TrackerRealPlotItem::TrackerRealPlotItem()
 {
     mTrackerReal = nullptr;
 }
 
-void TrackerRealPlotItem::draw(QPainter *p, const QwtScaleMap &mapX, const QwtScaleMap &mapY, const QRectF & /*re*/)
-    const
+/**
+ * @brief Draws the velocities of all persons and their mean per frame
+ *
+ * The velocities are precomputed by TrackerReal, here they are only mapped to the canvas. Samples mapped to an
+ * already painted pixel are skipped and the mean is decimated per pixel column, so long sequences with many persons
+ * do not slow down the replot done on every frame.
+ */
+void TrackerRealPlotItem::draw(QPainter *p, const QwtScaleMap &mapX, const QwtScaleMap &mapY, const QRectF &re) const
 {
-    Control *controlWidget = ((AnalysePlot *) plot())->getControlWidget();
+    auto    *analysePlot   = static_cast<AnalysePlot *>(plot());
+    Control *controlWidget = analysePlot->getControlWidget();
     if(mTrackerReal && (mTrackerReal->size() > 0) && controlWidget != nullptr)
     {
-        QRectF  rect;
-        double  sx         = (mapX.p2() - mapX.p1()) / (mapX.s2() - mapX.s1());
-        double  sy         = (mapY.p2() - mapY.p1()) / (mapY.s2() - mapY.s1());
-        double  circleSize = ((AnalysePlot *) plot())->symbolSize();
-        int     i, j;
-        QPointF point, lastPoint;
-
-        p->save();
-        p->translate(mapX.p1(), mapY.p2()); // in pixelkoordinaten vor skalierung
-        p->scale(sx, sy);
-        p->translate(-mapX.s1(), -mapY.s2());
-
-        p->setPen(Qt::red);
-
-        rect.setWidth(circleSize / sx);
-        rect.setHeight(circleSize / sy);
-        sx = circleSize / (2. * sx);
-        sy = circleSize / (2. * sy);
-
-        bool anaConsiderX   = controlWidget->isAnaConsiderXChecked();
-        bool anaConsiderY   = controlWidget->isAnaConsiderYChecked();
-        bool anaConsiderAbs = controlWidget->isAnaConsiderAbsChecked();
-        bool anaConsiderRev = controlWidget->isAnaConsiderRevChecked();
+        const VelocityOptions options = VelocityOptions::fromProject(*controlWidget->getMainWindow());
 
         // Beschriftung
         static QFont f("Courier", 10, QFont::Normal);        // Times Helvetica, Normal Bold
         QwtText      titleX("t [frame]", QwtText::RichText); //"x" TeXText
         QwtText      titleY;
-        if(anaConsiderX && anaConsiderY)
+        if(options.considerX && options.considerY)
         {
             titleY.setText("v [m/s]", QwtText::RichText);
         }
-        else if(anaConsiderX)
+        else if(options.considerX)
         {
-            if(anaConsiderAbs)
+            if(options.considerAbs)
             {
                 titleY.setText("v<sub>|x|</sub> [m/s]", QwtText::RichText);
             }
-            else if(anaConsiderRev)
+            else if(options.considerRev)
             {
                 titleY.setText("v<sub>-x</sub> [m/s]", QwtText::RichText);
             }
@@ -176,13 +269,13 @@ void TrackerRealPlotItem::draw(QPainter *p, const QwtScaleMap &mapX, const QwtSc
                 titleY.setText("v<sub>x</sub> [m/s]", QwtText::RichText);
             }
         }
-        else // == if (anaConsiderY)
+        else // == if (options.considerY)
         {
-            if(anaConsiderAbs)
+            if(options.considerAbs)
             {
                 titleY.setText("v<sub>|y|</sub> [m/s]", QwtText::RichText);
             }
-            else if(anaConsiderRev)
+            else if(options.considerRev)
             {
                 titleY.setText("v<sub>-y</sub> [m/s]", QwtText::RichText);
             }
@@ -193,120 +286,62 @@ void TrackerRealPlotItem::draw(QPainter *p, const QwtScaleMap &mapX, const QwtSc
         }
         titleX.setFont(f);
         titleY.setFont(f);
-        ((AnalysePlot *) plot())->setAxisTitle(QwtPlot::xBottom, titleX); //"x"
-        ((AnalysePlot *) plot())->setAxisTitle(QwtPlot::yLeft, titleY);   //"y"
-
-        int             step = controlWidget->getAnaStep(); // 1
-        int             frame, animFrame, velVecActIdx = -1;
-        double          vel; // geschwindigkeit
-        int             largestLastFrame = mTrackerReal->largestLastFrame();
-        QVector<int>    velAnzVec(largestLastFrame, 0);
-        QVector<double> velVec(largestLastFrame, 0.);
-        int             actFrame = ((AnalysePlot *) plot())->getActFrame();
-        bool            markAct  = controlWidget->isAnaMarkActChecked();
-        double          fps      = controlWidget->getMainWindow()->getAnimation()->getSequenceFPS();
-        if(fps < 0)
-        {
-            fps = DEFAULT_FPS;
-        }
+        analysePlot->setAxisTitle(QwtPlot::xBottom, titleX); //"x"
+        analysePlot->setAxisTitle(QwtPlot::yLeft, titleY);   //"y"
+
+        const VelocitySeries &series     = mTrackerReal->velocities(options);
+        const double          circleSize = analysePlot->symbolSize();
+        const int             actFrame   = analysePlot->getActFrame();
+        const bool            markAct    = controlWidget->isAnaMarkActChecked();
+        const QRectF          visible    = re.adjusted(-circleSize, -circleSize, circleSize, circleSize);
+        PixelMask             mask(visible.toAlignedRect());
+        QRectF                rect(0, 0, circleSize, circleSize);
+        int                   velVecActIdx = -1;
 
-        if(!markAct)
+        p->save();
+        p->setPen(Qt::green);
+        p->setBrush(Qt::green);
+        for(size_t i = 0; i < series.size(); ++i)
         {
-            p->setPen(Qt::green);
-            p->setBrush(Qt::green);
+            if(markAct && series.animFrames[i] == actFrame)
+            {
+                velVecActIdx = series.frames[i]; // drawn on top afterwards
+                continue;
+            }
+            const QPointF point(mapX.transform(series.frames[i]), mapY.transform(series.velocities[i]));
+            if(mask.set(point))
+            {
+                rect.moveCenter(point);
+                p->drawEllipse(rect);
+            }
         }
-        for(i = 0; i < mTrackerReal->size(); ++i)
+        if(velVecActIdx >= 0)
         {
-            for(j = 0; j < mTrackerReal->at(i).size() - step; ++j) // -step, damit geschwindigkeit ermittelt werden kann
+            p->setPen(Qt::red);
+            p->setBrush(Qt::red);
+            for(size_t i = 0; i < series.size(); ++i)
             {
-                frame     = mTrackerReal->at(i).firstFrame() + j;
-                animFrame = mTrackerReal->at(i).at(j).frameNum(); // ohne eingefuegte frames bei auslassungen
-                if(markAct)
+                if(series.animFrames[i] == actFrame)
                 {
-                    if(animFrame == actFrame)
-                    {
-                        p->setPen(Qt::red);
-                        p->setBrush(Qt::red);
-                        velVecActIdx = frame;
-                    }
-                    else // if (frame == actFrame+1)
-                    {
-                        p->setPen(Qt::green);
-                        p->setBrush(Qt::green);
-                    }
-                }
-
-                if(anaConsiderX && anaConsiderY)
-                {
-                    vel = (mTrackerReal->at(i).at(j + step).distanceToPoint(mTrackerReal->at(i).at(j)));
-                }
-                else if(anaConsiderX)
-                {
-                    if(anaConsiderAbs)
-                    {
-                        vel = fabs((mTrackerReal->at(i).at(j + step).x() - mTrackerReal->at(i).at(j).x()));
-                    }
-                    else if(anaConsiderRev)
-                    {
-                        vel = (mTrackerReal->at(i).at(j).x() - mTrackerReal->at(i).at(j + step).x());
-                    }
-                    else
-                    {
-                        vel = (mTrackerReal->at(i).at(j + step).x() - mTrackerReal->at(i).at(j).x());
-                    }
-                }
-                else // == if (anaConsiderY)
-                {
-                    if(anaConsiderAbs)
-                    {
-                        vel = fabs((mTrackerReal->at(i).at(j + step).y() - mTrackerReal->at(i).at(j).y()));
-                    }
-                    else if(anaConsiderRev)
-                    {
-                        vel = (mTrackerReal->at(i).at(j).y() - mTrackerReal->at(i).at(j + step).y());
-                    }
-                    else
-                    {
-                        vel = (mTrackerReal->at(i).at(j + step).y() - mTrackerReal->at(i).at(j).y());
-                    }
+                    rect.moveCenter(QPointF(mapX.transform(series.frames[i]), mapY.transform(series.velocities[i])));
+                    p->drawEllipse(rect);
                 }
-                vel /= ((100. / fps) * step); // m/s, war: 100cm/25frames =4 => vel /=(4.*step);
-
-                point.setX(frame);
-                point.setY(vel);
-                rect.moveLeft(point.x() - sx);
-                rect.moveTop(point.y() - sy);
-                p->drawEllipse(rect);
-
-                // j - j+step, da gegen die x-achse gelaufen wird
-
-                ++velAnzVec[frame];
-                velVec[frame] += vel;
             }
         }
 
-        rect.setWidth(2 * rect.width());
-        rect.setHeight(2 * rect.height());
         p->setPen(Qt::blue);
         p->setBrush(Qt::blue);
-        for(i = 0; i < velAnzVec.size(); ++i)
+        const std::pair<int, int> visibleFrames{
+            static_cast<int>(std::floor(mapX.invTransform(visible.left()))),
+            static_cast<int>(std::ceil(mapX.invTransform(visible.right())))};
+        drawMeanVelocity(*p, series, mapX, mapY, visibleFrames);
+
+        const int actIdx = velVecActIdx - series.firstFrame;
+        if(velVecActIdx >= 0 && actIdx < static_cast<int>(series.meanVelocities.size()))
         {
-            if(velAnzVec[i] != 0)
-            {
-                point.setX(i);
-                point.setY(velVec[i] / velAnzVec[i]);
-                if((i != 0) && (velAnzVec[i - 1] != 0)) // nicht ganz hundertprozentig
-                {
-                    p->drawLine(lastPoint, point);
-                }
-                lastPoint = point;
-                if(markAct && (i == velVecActIdx))
-                {
-                    rect.moveLeft(point.x() - 2 * sx);
-                    rect.moveTop(point.y() - 2 * sy);
-                    p->drawEllipse(rect);
-                }
-            }
+            rect.setSize(QSizeF(2 * circleSize, 2 * circleSize));
+            rect.moveCenter(QPointF(mapX.transform(velVecActIdx), mapY.transform(series.meanVelocities[actIdx])));
+            p->drawEllipse(rect);
         }
 
         p->restore();
@@ -230,26 +230,18 @@ void AnnotationGroupWidget::addTrajectories()
 
     auto group = mGroupManager.getGroup(grpId);
 
-    std::vector<int> fails;
-
+    std::vector<size_t> indices;
+    indices.reserve(trajectories.size());
     for(const int id : trajectories)
     {
-        if(grpId == -1)
-        {
-            SPDLOG_DEBUG("adding to NO GROUP");
-            if(!mGroupManager.removeTrajectoryAssignment(id - 1))
-            {
-                fails.push_back(id);
-            }
-        }
-        else if(!mGroupManager.addTrajectoryToGroup(id - 1, group.id))
-        {
-            fails.push_back(id);
-        }
+        indices.push_back(id - 1);
     }
+    // a single update of the tree view and the image for all trajectories
+    const auto failedIndices = mGroupManager.addTrajectoriesToGroup(indices, group.id);
 
-    for(int fail : fails)
+    for(const size_t failedIndex : failedIndices)
     {
+        const int fail = static_cast<int>(failedIndex) + 1;
         SPDLOG_WARN("Failed adding trajectory:  {}. Maybe it does not exist?", fail);
         PWarning(
             this->parentWidget(),
@@ -311,7 +303,7 @@ void AnnotationGroupWidget::populateTreeView()
         {
             auto grpElem = std::make_unique<GroupTreeItem>(grp.id, grp.name, grp.type, tlgElem.get());
             grpElem->setColor(grp.color);
-            grpElem->setChildCount((int) mGroupManager.getTrajectoriesOfGroup(grp.id).size());
+            grpElem->setChildCount((int) mGroupManager.getTrajectoryCountOfGroup(grp.id));
             tlgElem->appendChild(std::move(grpElem));
         }
         root->appendChild(std::move(tlgElem));
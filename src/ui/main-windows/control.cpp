@@ -38,6 +38,7 @@
 #include "pGroupBox.h"
 #include "pIO.h"
 #include "pMessageBox.h"
+#include "pProgressDialog.h"
 #include "penUtils.h"
 #include "petrack.h"
 #include "player.h"
@@ -47,6 +48,7 @@
 #include "trackerItem.h"
 #include "ui_control.h"
 #include "view.h"
+#include "walkAreaManager.h"
 #include "walkAreaWidget.h"
 #include "wheelIgnoreFilter.h"
 #include "worldImageCorrespondence.h"
@@ -179,7 +181,29 @@ Control::Control(
     QWidget::setTabOrder(mGrid, mWalkArea);
 
     connect(mExtr, &ExtrinsicBox::extrinsicChanged, mCoordSys, &CoordinateSystemBox::updateCoordItem);
+    // coordDataChanged is emitted whenever ExtrCalib has different results
+    connect(
+        mCoordSys,
+        &CoordinateSystemBox::coordDataChanged,
+        &mMainWindow->getMoCapController(),
+        &MoCapController::invalidateProjections);
     connect(mIntr, &IntrinsicBox::paramsChanged, this, &Control::onIntrinsicParamsChanged);
+    // the recognition uses the calibration, e.g. for the size of the markers and the angle to the ground
+    const auto invalidateRecognitionHash = [this]() { mMainWindow->invalidateRecognitionParameterHash(); };
+    connect(mExtr, &ExtrinsicBox::extrinsicChanged, this, invalidateRecognitionHash);
+    connect(mCoordSys, &CoordinateSystemBox::coordDataChanged, this, invalidateRecognitionHash);
+    connect(mIntr, &IntrinsicBox::paramsChanged, this, invalidateRecognitionHash);
+    // the rasterized walk area in world coordinates depends on the whole calibration
+    connect(
+        mCoordSys,
+        &CoordinateSystemBox::coordDataChanged,
+        mMainWindow->getWalkAreaManager(),
+        &WalkAreaManager::invalidateWorldField);
+    connect(
+        mIntr,
+        &IntrinsicBox::paramsChanged,
+        mMainWindow->getWalkAreaManager(),
+        &WalkAreaManager::invalidateWorldField);
     connect(
         mExtr,
         &ExtrinsicBox::enabledChanged,
@@ -1495,7 +1519,8 @@ void Control::onRecoShowColorStateChanged(int i)
 
 void Control::onRecoOptimizeColorClicked()
 {
-    mMainWindow->getPersonStorage().optimizeColor();
+    PProgressDialog progress(Petrack::tr("Optimizing the colors of all persons..."), mMainWindow);
+    mMainWindow->getPersonStorage().optimizeColor(progress.callback());
     replotColorplot();
     mScene->update(); // damit mgl angezeige farbpunkte geaendert/weggenommen werden
 }
@@ -1801,12 +1826,14 @@ void Control::onMapDistributionClicked()
 }
 void Control::onMapResetHeightClicked()
 {
-    mMainWindow->getPersonStorage().resetHeight();
+    PProgressDialog progress(Petrack::tr("Resetting the heights of all persons..."), mMainWindow);
+    mMainWindow->getPersonStorage().resetHeight(progress.callback());
     mScene->update();
 }
 void Control::onMapResetPosClicked()
 {
-    mMainWindow->getPersonStorage().resetPos();
+    PProgressDialog progress(Petrack::tr("Resetting the positions of all persons..."), mMainWindow);
+    mMainWindow->getPersonStorage().resetPos(progress.callback());
     mScene->update();
 }
 void Control::onMapDefaultHeightValueChanged(double d)
@@ -1827,9 +1854,13 @@ void Control::onMapReadHeightsClicked()
 
     if(std::holds_alternative<std::unordered_map<int, float>>(heights)) // heights contains the height map
     {
-        mMainWindow->getPersonStorage().resetHeight();
-        mMainWindow->getPersonStorage().setMarkerHeights(std::get<std::unordered_map<int, float>>(heights));
-        mMainWindow->setHeightFileName(heightFile);
+        PProgressDialog progress(Petrack::tr("Setting the heights of all persons..."), mMainWindow);
+        auto           &personStorage = mMainWindow->getPersonStorage();
+        if(personStorage.resetHeight(progress.callback()) &&
+           personStorage.setMarkerHeights(std::get<std::unordered_map<int, float>>(heights), progress.callback()))
+        {
+            mMainWindow->setHeightFileName(heightFile);
+        }
     }
     else // heights contains an error string
     {
@@ -2200,6 +2231,10 @@ void Control::setXml(QDomElement &elem)
     subSubElem.setAttribute("ENABLED", mUi->exportMarkerID->isChecked());
     subElem.appendChild(subSubElem);
 
+    subSubElem = (elem.ownerDocument()).createElement("EXPORT_WALL_DISTANCE");
+    subSubElem.setAttribute("ENABLED", mUi->exportWallDistance->isChecked());
+    subElem.appendChild(subSubElem);
+
     subSubElem = (elem.ownerDocument()).createElement("TRACK_FILE");
     fn         = mMainWindow->getTrackFileName();
     if(fn != "")
@@ -2614,6 +2649,10 @@ void Control::getXml(const QDomElement &elem, const QString &version)
                 {
                     loadBoolValue(subSubElem, "ENABLED", mUi->exportMarkerID);
                 }
+                else if(subSubElem.tagName() == "EXPORT_WALL_DISTANCE")
+                {
+                    loadBoolValue(subSubElem, "ENABLED", mUi->exportWallDistance);
+                }
                 else if((subSubElem.tagName() == "TEST_EQUAL") && (!newerThanVersion(version, QString("0.10.0"))))
                 {
                     mCorrectionWidget->setTestEqualChecked(readBool(subSubElem, "ENABLED"));
@@ -2999,6 +3038,11 @@ bool Control::isExportMarkerIDChecked() const
     return mUi->exportMarkerID->isChecked();
 }
 
+bool Control::isExportWallDistanceChecked() const
+{
+    return mUi->exportWallDistance->isChecked();
+}
+
 bool Control::isTrackRecalcHeightChecked() const
 {
     return mUi->trackRecalcHeight->isChecked();
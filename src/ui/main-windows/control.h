@@ -244,6 +244,7 @@ public:
     bool           isExportViewDirChecked() const;
     bool           isExportAngleOfViewChecked() const;
     bool           isExportMarkerIDChecked() const;
+    bool           isExportWallDistanceChecked() const;
     bool           isTrackRecalcHeightChecked() const;
     bool           isTrackMissingFramesChecked() const;
     bool           isExportUseMeterChecked() const;
@@ -255,25 +255,7 @@ double CoordinateSystemBox::getCmPerPixel() const
 // Liefert zum Pixelpunkt (px,py) die Anzahl der Zentimeter in x- und y-Richtung
 QPointF CoordinateSystemBox::getCmPerPixel(float px, float py, float h) const
 {
-    // ToDo:
-    // 3D Punkte an (px-0.5, py) und (px+0.5, py) berechnen und Auswirkung in x-Richtung
-    // und          (px, py-0.5) und (px, py+0.5) berechnen und Auswirkung in y-Richtung untersuchen
-    //
-    // Unterscheiden nach x- und y-Richtung?
-    // Wie fliesst die Hoehe mit ein?
-
-    cv::Point3f p3x1 = mExtrCalib.get3DPoint(cv::Point2f(px - 0.5, py), h);
-    cv::Point3f p3x2 = mExtrCalib.get3DPoint(cv::Point2f(px + 0.5, py), h);
-
-    cv::Point3f p3y1 = mExtrCalib.get3DPoint(cv::Point2f(px, py - 0.5), h);
-    cv::Point3f p3y2 = mExtrCalib.get3DPoint(cv::Point2f(px, py + 0.5), h);
-
-    double x_dir = norm(p3x1 - p3x2);
-    double y_dir = norm(p3y1 - p3y2);
-
-    QPointF res(x_dir, y_dir);
-
-    return res;
+    return mExtrCalib.snapshot().getCmPerPixel(px, py, h);
 }
 
 ///*
@@ -284,22 +266,7 @@ QPointF CoordinateSystemBox::getCmPerPixel(float px, float py, float h) const
 ///*
 double CoordinateSystemBox::getAngleToGround(float px, float py, float height) const
 {
-    const auto &extrParams = mExtrBox.getExtrinsicParameters();
-    cv::Point3f cam(
-        -mUi->coord3DTransX->value() - extrParams.trans1,
-        -mUi->coord3DTransY->value() - extrParams.trans2,
-        -mUi->coord3DTransZ->value() - extrParams.trans3);
-
-    cv::Point3f posInImage = mExtrCalib.get3DPoint(cv::Point2f(px - mGetBorderSize(), py - mGetBorderSize()), height);
-
-    cv::Point3f a(cam.x - posInImage.x, cam.y - posInImage.y, cam.z - posInImage.z), b(0, 0, 1);
-
-    // NOTE: in C++20 can be replaced with numbers import
-    const double pi = std::atan(1.0) * 4;
-    return asin(
-               (a.x * b.x + a.y * b.y + a.z * b.z) / (abs(sqrt(pow(a.x, 2) + pow(a.y, 2) + pow(a.z, 2))) *
-                                                      abs(sqrt(pow(b.x, 2) + pow(b.y, 2) + pow(b.z, 2))))) *
-           180 / pi;
+    return mExtrCalib.snapshot().getAngleToGround(px, py, height);
 }
 
 QPointF CoordinateSystemBox::getPosImage(QPointF pos, float height) const
@@ -25,6 +25,7 @@
 #include "personStorage.h"
 #include "player.h"
 #include "roiItem.h"
+#include "walkAreaManager.h"
 #include "ui_correction.h"
 
 #include <QByteArray>
@@ -338,7 +339,7 @@ void Correction::checkButtonClicked()
 {
     std::vector<plausibility::FailedCheck> failedChecks;
 
-    QProgressDialog progress("Check Plausibility", nullptr, 0, 400, mPetrack);
+    QProgressDialog progress("Check Plausibility", nullptr, 0, 500, mPetrack);
     progress.setWindowTitle("Check plausibility");
     progress.setWindowModality(Qt::WindowModal);
     progress.setVisible(true);
@@ -377,6 +378,12 @@ void Correction::checkButtonClicked()
         failedChecks.insert(failedChecks.end(), failedEqualityChecks.begin(), failedEqualityChecks.end());
     }
 
+    if(mUi->chbWalkArea->isChecked())
+    {
+        auto failedWalkAreaChecks{runWalkAreaCheck(progress)};
+        failedChecks.insert(failedChecks.end(), failedWalkAreaChecks.begin(), failedWalkAreaChecks.end());
+    }
+
     // Restore the status if the same check for a person in a frame was already in the table
     const auto &previousChecks = mTableModel->getFailedChecks();
     for(auto &failedCheck : failedChecks)
@@ -561,6 +568,11 @@ void Correction::setXml(QDomElement &elem) const
     insideElement.setAttribute("ENABLED", mUi->chbInside->isChecked());
     insideElement.setAttribute("MARGIN", mUi->spbxInsideMargin->value());
     elem.appendChild(insideElement);
+
+    auto walkAreaElement = (elem.ownerDocument()).createElement("WALK_AREA");
+    walkAreaElement.setAttribute("ENABLED", mUi->chbWalkArea->isChecked());
+    walkAreaElement.setAttribute("TOLERANCE", mUi->spbxWalkAreaTolerance->value());
+    elem.appendChild(walkAreaElement);
 }
 
 bool Correction::getXml(const QDomElement &correctionElem)
@@ -586,6 +598,11 @@ bool Correction::getXml(const QDomElement &correctionElem)
             loadBoolValue(subElem, "ENABLED", mUi->chbInside);
             loadIntValue(subElem, "MARGIN", mUi->spbxInsideMargin);
         }
+        else if(subElem.tagName() == "WALK_AREA")
+        {
+            loadBoolValue(subElem, "ENABLED", mUi->chbWalkArea);
+            loadDoubleValue(subElem, "TOLERANCE", mUi->spbxWalkAreaTolerance);
+        }
         else
         {
             SPDLOG_WARN("Unknown CORRECTION tag: {}", subElem.tagName().toStdString());
@@ -597,7 +614,7 @@ bool Correction::getXml(const QDomElement &correctionElem)
 std::vector<plausibility::FailedCheck> Correction::rerunChecks()
 {
     // Rerun tests (except equality)
-    QProgressDialog progress("Check Plausibility", nullptr, 0, 400, mPetrack);
+    QProgressDialog progress("Check Plausibility", nullptr, 0, 500, mPetrack);
     progress.setWindowTitle("Check plausibility");
     progress.setWindowModality(Qt::WindowModal);
     progress.setVisible(false);
@@ -631,9 +648,25 @@ std::vector<plausibility::FailedCheck> Correction::rerunChecks()
         auto failedVelocityChecks{plausibility::checkVelocityVariation(mPersonStorage, &progress)};
         failedChecks.insert(failedChecks.end(), failedVelocityChecks.begin(), failedVelocityChecks.end());
     }
+
+    if(mUi->chbWalkArea->isChecked())
+    {
+        auto failedWalkAreaChecks{runWalkAreaCheck(progress)};
+        failedChecks.insert(failedChecks.end(), failedWalkAreaChecks.begin(), failedWalkAreaChecks.end());
+    }
     return failedChecks;
 }
 
+/// checks the trajectories against the walk area rasterized in pixel coordinates (cached by the WalkAreaManager)
+std::vector<plausibility::FailedCheck> Correction::runWalkAreaCheck(QProgressDialog &progress) const
+{
+    const auto   imageSize  = mPetrack->getImageFiltered().size();
+    const int    borderSize = mPetrack->getImageBorderSize();
+    const QRectF imageRect(0, 0, imageSize.width - 2 * borderSize, imageSize.height - 2 * borderSize);
+    const auto   field = mPetrack->getWalkAreaManager()->getPixelField(imageRect);
+    return plausibility::checkWalkArea(mPersonStorage, &progress, *field, mUi->spbxWalkAreaTolerance->value());
+}
+
 Correction::~Correction()
 {
     delete mUi;
@@ -95,6 +95,7 @@ private:
     bool                    mChecksExecuted = false;
 
     std::vector<plausibility::FailedCheck> rerunChecks();
+    std::vector<plausibility::FailedCheck> runWalkAreaCheck(QProgressDialog &progress) const;
     plausibility::CheckStatus              getStatus(QList<QModelIndex> pos) const;
 private slots:
     void selectedRowChanged();
@@ -23,10 +23,19 @@
 #include "logger.h"
 #include "moCapPerson.h"
 #include "pIO.h"
+#include "pMessageBox.h"
 
 #include <QDomElement>
+#include <QEventLoop>
+#include <QFutureWatcher>
 #include <QMessageBox>
+#include <QProgressDialog>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentMap>
+#include <atomic>
+#include <numeric>
 #include <opencv2/opencv.hpp>
+#include <utility>
 
 
 /**
@@ -37,7 +46,10 @@
  * into a list of lines (and one arrow for the head direction) to be drawn.
  *
  * If there is no sample for the given timepoint, it is inerpolated. Never
- * extrapolated.
+ * extrapolated. The joints of the samples are projected only once (see
+ * MoCapPerson::getProjectedJoints) and the bones are interpolated in the image;
+ * at the samplerates of MoCap systems, this differs from projecting the
+ * interpolated joints by far less than a pixel.
  *
  * @param [in]person Person whose skeleton to transform into SegmentRenderDAta
  * @param [in]framerate Framerate of the video (NOT the mocap-recording)
@@ -71,48 +83,51 @@ void MoCapController::transformPersonSkeleton(
         return;
     }
 
-    const SkeletonTree &preSample  = person.getSample(std::floor(sampleIndex));
-    const SkeletonTree &postSample = person.getSample(std::ceil(sampleIndex));
-    double              intpart    = 0.0;
-    double              weight     = modf(sampleIndex, &intpart);
+    const size_t preSample  = std::floor(sampleIndex);
+    const size_t postSample = std::ceil(sampleIndex);
+    double       intpart    = 0.0;
+    double       weight     = modf(sampleIndex, &intpart);
 
-    const auto prePairs  = preSample.getLines();
-    const auto postPairs = postSample.getLines();
+    const auto project     = [this](cv::Point3f point) { return mExtrCalib.getImagePoint(point); };
+    const auto preJoints   = person.getProjectedJoints(preSample, project);
+    const auto postJoints  = person.getProjectedJoints(postSample, project);
+    const auto interpolate = [&](size_t joint) { return preJoints[joint] * (1 - weight) + postJoints[joint] * weight; };
 
-    const std::vector<SkeletonLine> interpolatedPairs = interpolate(prePairs, postPairs, weight);
-
-    std::vector<std::pair<cv::Point2f, cv::Point2f>> projectedPairs;
-    projectedPairs.reserve(prePairs.size());
-
-    SkeletonLine neckToHead;
-    Vec3F        neckToHead3D;
-
-    for(const auto &pair : interpolatedPairs)
-    {
-        projectedPairs.emplace_back(mExtrCalib.getImagePoint(pair.start), mExtrCalib.getImagePoint(pair.end));
-        if(pair.start_id == 19 && pair.end_id == 2)
-        {
-            neckToHead   = pair;
-            neckToHead3D = Vec3F(pair.end - pair.start);
-        }
-    }
-
-    for(const auto &pair : projectedPairs)
+    // every joint except the root is the end of the bone starting at its parent
+    const SkeletonTopology &topology = person.getTopology();
+    for(size_t joint = 1; joint < topology.getJointCount(); ++joint)
     {
-        renderData.push_back({/*.mLine =*/QLine(pair.first.x, pair.first.y, pair.second.x, pair.second.y),
+        const cv::Point2f start = interpolate(topology.mParents[joint]);
+        const cv::Point2f end   = interpolate(joint);
+        renderData.push_back({/*.mLine =*/QLine(start.x, start.y, end.x, end.y),
                               /*.mColor =*/mColor,
                               /*.mThickness =*/mThickness,
                               /*.mDirected =*/false});
     }
 
     // Head Direction Arrow
-    cv::Vec3f headDir_v = preSample.getHeadDir() * (1 - weight) + postSample.getHeadDir() * weight;
+    const int head = topology.findJoint(19, 2);
+    if(head < 0)
+    {
+        return;
+    }
+    const auto interpolate3D = [&](size_t joint)
+    {
+        return person.getTransformedJoint(preSample, joint) * (1 - weight) +
+               person.getTransformedJoint(postSample, joint) * weight;
+    };
+    const cv::Point3f neckPos = interpolate3D(topology.mParents[head]);
+    const cv::Point3f headPos = interpolate3D(head);
+    Vec3F             neckToHead3D(headPos - neckPos);
+
+    cv::Vec3f headDir_v =
+        person.getTransformedHeadDir(preSample) * (1 - weight) + person.getTransformedHeadDir(postSample) * weight;
     headDir_v           = cv::normalize(headDir_v);
     cv::Point3f headDir = cv::Point3f(headDir_v);
     headDir *= neckToHead3D.length();
 
     // Start arrow at 75% the way from C7 to top of head
-    auto        arrowBase   = neckToHead.start + (neckToHead.end - neckToHead.start) * 0.75;
+    auto        arrowBase   = neckPos + (headPos - neckPos) * 0.75;
     cv::Point2f arrowHead   = mExtrCalib.getImagePoint(arrowBase + headDir);
     auto        arrowBase2D = mExtrCalib.getImagePoint(arrowBase);
 
@@ -122,37 +137,52 @@ void MoCapController::transformPersonSkeleton(
                           /*.mDirected =*/true});
 }
 
-std::vector<SegmentRenderData> MoCapController::getRenderData(int currentFrame, double framerate) const
+/**
+ * @brief Returns the render data of all visible persons for the given frame
+ *
+ * The render data is cached and only computed again, when the frame, the framerate,
+ * the loaded persons, the calibration (see invalidateProjections) or the color or
+ * thickness changed.
+ *
+ * @param currentFrame current frame of the video
+ * @param framerate Framerate of the video
+ * @return render data; valid until the next call
+ */
+const std::vector<SegmentRenderData> &MoCapController::getRenderData(int currentFrame, double framerate) const
 {
-    std::vector<SegmentRenderData> renderData;
-    for(const auto &person : mStorage.getPersons())
+    if(mRenderCache.mValid && mRenderCache.mFrame == currentFrame && mRenderCache.mFramerate == framerate &&
+       mRenderCache.mStorageRevision == mStorage.getRevision())
+    {
+        return mRenderCache.mRenderData;
+    }
+
+    mRenderCache.mRenderData.clear();
+    for(const auto &person : std::as_const(mStorage).getPersons())
     {
         if(person.isVisible())
         {
-            transformPersonSkeleton(person, framerate, currentFrame, renderData);
+            transformPersonSkeleton(person, framerate, currentFrame, mRenderCache.mRenderData);
         }
     }
-    return renderData;
+    mRenderCache.mValid           = true;
+    mRenderCache.mFrame           = currentFrame;
+    mRenderCache.mFramerate       = framerate;
+    mRenderCache.mStorageRevision = mStorage.getRevision();
+    return mRenderCache.mRenderData;
 }
 
-std::vector<SkeletonLine> MoCapController::interpolate(
-    const std::vector<SkeletonLine> &prePairs,
-    const std::vector<SkeletonLine> &postPairs,
-    double                           weight)
+/**
+ * @brief Discards the cached projections and render data
+ *
+ * Has to be called whenever ExtrCalibration::getImagePoint would give different results.
+ */
+void MoCapController::invalidateProjections()
 {
-    // Needs: prePairs.size() == postPairs.size()
-    // Needs: prePair and postPair be EXACTLY one sample away from each other
-    std::vector<SkeletonLine> interpolatedPairs;
-    interpolatedPairs.reserve(prePairs.size());
-
-    for(size_t i = 0; i < prePairs.size(); ++i)
+    for(auto &person : mStorage.getPersons())
     {
-        interpolatedPairs.push_back({/*.start =*/prePairs[i].start * (1 - weight) + postPairs[i].start * weight,
-                                     /*.start_id =*/prePairs[i].start_id,
-                                     /*.end =*/prePairs[i].end * (1 - weight) + postPairs[i].end * weight,
-                                     /*.end_id =*/prePairs[i].end_id});
+        person.invalidateProjections();
     }
-    return interpolatedPairs;
+    mRenderCache.mValid = false;
 }
 
 /**
@@ -185,7 +215,8 @@ void MoCapController::setColor(const QColor &color)
     }
     if(mColor != color)
     {
-        mColor = color;
+        mColor              = color;
+        mRenderCache.mValid = false;
         emit colorChanged(color);
     }
 }
@@ -205,7 +236,8 @@ void MoCapController::setThickness(int thickness)
     }
     if(mThickness != thickness)
     {
-        mThickness = thickness;
+        mThickness          = thickness;
+        mRenderCache.mValid = false;
         emit thicknessChanged(thickness);
     }
 }
@@ -242,6 +274,9 @@ std::vector<MoCapPersonMetadata> MoCapController::getAllMoCapPersonMetadata() co
  *
  * This method deletes every person from the storage whose metadata does not occur in the newMetadata and calls
  * the IO::readMoCapC3D-method for every new Metadata.
+ *
+ * The files are read in parallel. The GUI stays responsive meanwhile and shows the progress; the reading can be
+ * aborted. Errors of all files are shown together once all files are read.
  */
 void MoCapController::readMoCapFiles(const std::vector<MoCapPersonMetadata> &newMetadata)
 {
@@ -255,7 +290,9 @@ void MoCapController::readMoCapFiles(const std::vector<MoCapPersonMetadata> &new
                    { return readsTheSame(other, person.getMetadata()); }) == newMetadata.cend();
     };
     persons.erase(std::remove_if(persons.begin(), persons.end(), unselected), persons.end());
+    mRenderCache.mValid = false;
     std::vector<MoCapPersonMetadata> currentMetadata = getAllMoCapPersonMetadata();
+    std::vector<MoCapPersonMetadata> metadataToRead;
     for(const MoCapPersonMetadata &md : newMetadata)
     {
         const auto isCurrentMD = [&md](const MoCapPersonMetadata &lhs) { return readsTheSame(lhs, md); };
@@ -263,9 +300,85 @@ void MoCapController::readMoCapFiles(const std::vector<MoCapPersonMetadata> &new
             std::find_if(currentMetadata.cbegin(), currentMetadata.cend(), isCurrentMD) == currentMetadata.cend();
         if(isNewMd)
         {
-            IO::readMoCapC3D(mStorage, md);
+            metadataToRead.push_back(md);
         }
     }
+    if(metadataToRead.empty())
+    {
+        return;
+    }
+
+    // read fraction of every file in per mille
+    constexpr int                 progressPerFile = 1000;
+    std::vector<std::atomic<int>> fileProgress(metadataToRead.size());
+    std::atomic<bool>             canceled = false;
+    const auto                    readFile = [&](size_t index)
+    {
+        return IO::readMoCapC3D(
+            metadataToRead[index],
+            [&, index](double fraction)
+            {
+                fileProgress[index] = static_cast<int>(fraction * progressPerFile);
+                return !canceled;
+            });
+    };
+    std::vector<size_t> indices(metadataToRead.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QProgressDialog progress(
+        tr("Reading %1 MoCap file(s)...").arg(metadataToRead.size()),
+        tr("Abort reading"),
+        0,
+        static_cast<int>(metadataToRead.size()) * progressPerFile);
+    progress.setWindowModality(Qt::ApplicationModal);
+    progress.setMinimumDuration(500);
+    connect(&progress, &QProgressDialog::canceled, this, [&canceled] { canceled = true; });
+
+    QTimer progressTimer;
+    connect(
+        &progressTimer,
+        &QTimer::timeout,
+        this,
+        [&]
+        {
+            int value = 0;
+            for(const auto &fileValue : fileProgress)
+            {
+                value += fileValue;
+            }
+            progress.setValue(value);
+        });
+    progressTimer.start(100);
+
+    QFutureWatcher<std::variant<MoCapPerson, std::string>> watcher;
+    QEventLoop                                             loop;
+    connect(&watcher, &QFutureWatcherBase::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(QtConcurrent::mapped(indices, readFile));
+    loop.exec();
+    progressTimer.stop();
+    progress.reset();
+
+    if(canceled)
+    {
+        SPDLOG_INFO("Reading of MoCap files aborted.");
+        return;
+    }
+    QStringList errors;
+    for(auto &result : watcher.future().results())
+    {
+        if(auto *person = std::get_if<MoCapPerson>(&result))
+        {
+            mStorage.addPerson(std::move(*person));
+        }
+        else
+        {
+            errors.append(QString::fromStdString(std::get<std::string>(result)));
+        }
+    }
+    if(!errors.isEmpty())
+    {
+        PCritical(nullptr, tr("Error: Cannot load C3D File"), errors.join("\n"));
+    }
 }
 
 
@@ -26,7 +26,6 @@
 #include <QObject>
 #include <vector>
 
-struct SkeletonLine;
 class QDomElement;
 
 struct SegmentRenderData
@@ -59,14 +58,15 @@ public:
         double                          framerate,
         int                             currentFrame,
         std::vector<SegmentRenderData> &renderData) const;
-    std::vector<SegmentRenderData>   getRenderData(int currentFrame, double framerate) const;
-    bool                             getShowMoCap() const { return mShowMoCap; };
-    void                             setShowMoCap(bool visibility);
-    void                             setColor(const QColor &color);
-    void                             setThickness(int thickness);
-    void                             notifyAllObserver();
-    std::vector<MoCapPersonMetadata> getAllMoCapPersonMetadata() const;
-    void                             readMoCapFiles(const std::vector<MoCapPersonMetadata> &newMetadata);
+    const std::vector<SegmentRenderData> &getRenderData(int currentFrame, double framerate) const;
+    bool                                  getShowMoCap() const { return mShowMoCap; };
+    void                                  setShowMoCap(bool visibility);
+    void                                  setColor(const QColor &color);
+    void                                  setThickness(int thickness);
+    void                                  notifyAllObserver();
+    std::vector<MoCapPersonMetadata>      getAllMoCapPersonMetadata() const;
+    void                                  readMoCapFiles(const std::vector<MoCapPersonMetadata> &newMetadata);
+    void                                  invalidateProjections();
 
     void setXml(QDomElement &elem);
     void getXml(const QDomElement &elem);
@@ -77,15 +77,22 @@ signals:
     void thicknessChanged(int thickness);
 
 private:
-    static std::vector<SkeletonLine>
-    interpolate(const std::vector<SkeletonLine> &prePairs, const std::vector<SkeletonLine> &postPairs, double weight);
+    /// render data of the last call of getRenderData and the state it was computed for
+    struct RenderCache
+    {
+        bool                           mValid           = false;
+        int                            mFrame           = 0;
+        double                         mFramerate       = 0;
+        size_t                         mStorageRevision = 0;
+        std::vector<SegmentRenderData> mRenderData;
+    };
 
-
-    MoCapStorage    &mStorage;
-    bool             mShowMoCap = false;
-    QColor           mColor     = QColor(255, 255, 55);
-    int              mThickness = 2;
-    ExtrCalibration &mExtrCalib;
+    MoCapStorage       &mStorage;
+    bool                mShowMoCap = false;
+    QColor              mColor     = QColor(255, 255, 55);
+    int                 mThickness = 2;
+    ExtrCalibration    &mExtrCalib;
+    mutable RenderCache mRenderCache;
 };
 
 #endif // MOCAPCONTROLLER_H
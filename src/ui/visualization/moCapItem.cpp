@@ -55,9 +55,9 @@ void MoCapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem * /* opt
 {
     if(mController.getShowMoCap())
     {
-        std::vector<SegmentRenderData> allRenderData =
+        const std::vector<SegmentRenderData> &allRenderData =
             mController.getRenderData(mAnimation.getCurrentFrameNum(), mAnimation.getSequenceFPS());
-        for(SegmentRenderData &renderData : allRenderData)
+        for(const SegmentRenderData &renderData : allRenderData)
         {
             drawLine(painter, renderData);
             if(renderData.mDirected)
@@ -73,7 +73,7 @@ void MoCapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem * /* opt
  * @param painter
  * @param renderData
  */
-void MoCapItem::drawLine(QPainter *painter, SegmentRenderData &renderData)
+void MoCapItem::drawLine(QPainter *painter, const SegmentRenderData &renderData)
 {
     QPen pen{renderData.mColor};
     pen.setWidth(renderData.mThickness);
@@ -88,7 +88,7 @@ void MoCapItem::drawLine(QPainter *painter, SegmentRenderData &renderData)
  * @param painter
  * @param renderData
  */
-void MoCapItem::drawArrowHead(QPainter *painter, SegmentRenderData &renderData)
+void MoCapItem::drawArrowHead(QPainter *painter, const SegmentRenderData &renderData)
 {
     QPolygonF arrowHead;
     auto      lineItem = QGraphicsLineItem(renderData.mLine);
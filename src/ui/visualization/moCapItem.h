@@ -48,8 +48,8 @@ private:
     Petrack         &mMainWindow;
     Animation       &mAnimation;
     MoCapController &mController;
-    static void      drawLine(QPainter *painter, SegmentRenderData &renderData);
-    static void      drawArrowHead(QPainter *painter, SegmentRenderData &renderData);
+    static void      drawLine(QPainter *painter, const SegmentRenderData &renderData);
+    static void      drawArrowHead(QPainter *painter, const SegmentRenderData &renderData);
 };
 
 #endif // MOCAPITEM_H
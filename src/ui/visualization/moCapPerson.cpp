@@ -22,6 +22,7 @@
 
 #include <QDomElement>
 #include <exception>
+#include <string>
 
 /**
  * @brief Gets index of sample at given time
@@ -34,11 +35,6 @@ double MoCapPerson::getSampleIndex(double time) const
     return mMetadata.getSamplerate() * (time + mMetadata.getOffset());
 }
 
-SkeletonTree MoCapPerson::getSample(size_t sample) const
-{
-    return mSkeletons.at(sample).transformed(mMetadata.getRotation(), mMetadata.getTranslation());
-}
-
 void MoCapPerson::setSamplerate(double samplerate)
 {
     mMetadata.setSamplerate(samplerate);
@@ -58,21 +54,172 @@ void MoCapPerson::setTranslation(const cv::Vec3f &trans)
 {
     cv::Affine3f newTrans{cv::Mat::eye({3, 3}, CV_32F), trans};
     mMetadata.setTranslation(newTrans);
+    invalidateProjections();
 }
 
 void MoCapPerson::setRotation(double angle)
 {
     mMetadata.setAngle(angle);
+    invalidateProjections();
 }
 
+/**
+ * @brief Sets the bone topology of all samples
+ *
+ * Removes all samples added before.
+ *
+ * @param topology topology of the samples which will be added
+ */
+void MoCapPerson::setTopology(const SkeletonTopology &topology)
+{
+    mTopology = topology;
+    mJoints.clear();
+    mHeadDirs.clear();
+    mRotationCenters.clear();
+    invalidateProjections();
+}
+
+void MoCapPerson::reserveSamples(size_t samples)
+{
+    mJoints.reserve(samples * mTopology.getJointCount());
+    mHeadDirs.reserve(samples);
+    mRotationCenters.reserve(samples);
+}
+
+/**
+ * @brief Appends a sample to the recording
+ *
+ * @param joints position of every joint, in the order of getTopology()
+ * @param headDir direction the head is facing; will be normalized
+ * @param rotationCenter center of rotation (top of head)
+ * @throw std::invalid_argument if the number of joints does not match the topology
+ */
+void MoCapPerson::addSample(
+    std::span<const cv::Point3f> joints,
+    const cv::Vec3f             &headDir,
+    const cv::Point3f           &rotationCenter)
+{
+    if(joints.size() != mTopology.getJointCount())
+    {
+        throw std::invalid_argument("Number of joints does not match the skeleton topology of the person");
+    }
+    mJoints.insert(mJoints.end(), joints.begin(), joints.end());
+    mHeadDirs.push_back(cv::normalize(headDir));
+    mRotationCenters.push_back(rotationCenter);
+}
+
+/**
+ * @brief Appends the skeleton as sample to the recording
+ *
+ * The first skeleton defines the topology of all samples.
+ *
+ * @param skeleton skeleton with the same topology as all other samples
+ * @throw std::invalid_argument if the topology differs from the one of the other samples
+ */
 void MoCapPerson::addSkeleton(const SkeletonTree &skeleton)
 {
-    mSkeletons.push_back(skeleton);
+    if(getSampleCount() == 0)
+    {
+        setTopology(skeleton.getTopology());
+    }
+    else if(skeleton.getTopology() != mTopology)
+    {
+        throw std::invalid_argument("Skeleton topology differs from the other samples of the person");
+    }
+    addSample(skeleton.getJoints(), skeleton.getHeadDir(), skeleton.getRotationCenter());
 }
 
-const SkeletonTree &MoCapPerson::getSkeleton(size_t sample) const
+/**
+ * @brief Builds the (untransformed) skeleton of a sample
+ *
+ * @param sample index of the sample
+ * @return skeleton of the sample
+ */
+SkeletonTree MoCapPerson::getSkeleton(size_t sample) const
 {
-    return mSkeletons.at(sample);
+    return SkeletonTree::fromJoints(mTopology, getJoints(sample), mHeadDirs.at(sample), mRotationCenters.at(sample));
+}
+
+/**
+ * @brief Returns the untransformed joints of a sample
+ *
+ * @param sample index of the sample
+ * @return joints in the order of getTopology()
+ */
+std::span<const cv::Point3f> MoCapPerson::getJoints(size_t sample) const
+{
+    if(!hasSample(sample))
+    {
+        throw std::out_of_range("Sample " + std::to_string(sample) + " does not exist");
+    }
+    const size_t jointCount = mTopology.getJointCount();
+    return {mJoints.data() + sample * jointCount, jointCount};
+}
+
+/**
+ * @brief Returns the transformation of a sample by the user chosen rotation and translation
+ *
+ * The rotation is around the rotation center of the sample.
+ */
+cv::Affine3f MoCapPerson::getTransform(size_t sample) const
+{
+    const cv::Point3f &rotationCenter  = mRotationCenters.at(sample);
+    auto               transFrom       = cv::Affine3f().translate(rotationCenter);
+    auto               transTo         = cv::Affine3f().translate(-rotationCenter);
+    auto               rotAroundCenter = transTo.concatenate(mMetadata.getRotation().concatenate(transFrom));
+    return rotAroundCenter.concatenate(mMetadata.getTranslation());
+}
+
+cv::Point3f MoCapPerson::getTransformedJoint(size_t sample, size_t joint) const
+{
+    return getTransform(sample) * getJoints(sample)[joint];
+}
+
+cv::Vec3f MoCapPerson::getTransformedHeadDir(size_t sample) const
+{
+    cv::Matx33f rot = getTransform(sample).rotation();
+    return rot * mHeadDirs.at(sample);
+}
+
+/**
+ * @brief Discards all cached projections, e.g. after the calibration changed
+ */
+void MoCapPerson::invalidateProjections()
+{
+    mProjectedJoints.clear();
+    mIsProjected.clear();
+}
+
+/**
+ * @brief Returns the image points of the transformed joints of a sample
+ *
+ * The joints of each sample are only projected the first time they are needed. The result is cached until
+ * invalidateProjections() is called, so project has to stay the same until then.
+ *
+ * @param sample index of the sample
+ * @param project function projecting a 3D point onto the image
+ * @return image points of the joints in the order of getTopology()
+ */
+std::span<const cv::Point2f>
+MoCapPerson::getProjectedJoints(size_t sample, const std::function<cv::Point2f(cv::Point3f)> &project) const
+{
+    const auto   joints     = getJoints(sample);
+    const size_t jointCount = joints.size();
+    if(mIsProjected.empty())
+    {
+        mProjectedJoints.resize(mJoints.size());
+        mIsProjected.resize(getSampleCount(), false);
+    }
+    if(!mIsProjected[sample])
+    {
+        const cv::Affine3f transform = getTransform(sample);
+        for(size_t joint = 0; joint < jointCount; ++joint)
+        {
+            mProjectedJoints[sample * jointCount + joint] = project(transform * joints[joint]);
+        }
+        mIsProjected[sample] = true;
+    }
+    return {mProjectedJoints.data() + sample * jointCount, jointCount};
 }
 
 const std::string &MoCapPerson::getFilename() const
@@ -98,6 +245,7 @@ void MoCapPerson::setVisible(bool visible)
 void MoCapPerson::setMetadata(const MoCapPersonMetadata &metadata)
 {
     mMetadata = metadata;
+    invalidateProjections();
 }
 
 
@@ -122,9 +270,11 @@ void MoCapPerson::setXml(QDomElement &elem) const
 void MoCapStorage::addPerson(const MoCapPerson &person)
 {
     mPersons.push_back(person);
+    ++mRevision;
 }
 
 void MoCapStorage::addPerson(MoCapPerson &&person)
 {
-    mPersons.push_back(person);
+    mPersons.push_back(std::move(person));
+    ++mRevision;
 }
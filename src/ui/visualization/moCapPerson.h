@@ -21,6 +21,8 @@
 #include "moCapPersonMetadata.h"
 #include "skeletonTree.h"
 
+#include <functional>
+#include <span>
 #include <vector>
 
 
@@ -33,13 +35,18 @@ class QDomElement;
  * is not done at the resolution of the system, but at the resolution of the
  * internal data structure, i.e. only points which are important for drawing
  * are saved.
+ *
+ * All samples share one SkeletonTopology, so the joints are kept in one flat
+ * array with getTopology().getJointCount() joints per sample. The projections of
+ * the joints into the image are cached per sample until invalidateProjections()
+ * is called or the rotation/translation of the person changes.
  */
 class MoCapPerson
 {
 public:
-    double       getSampleIndex(double time) const;
-    inline bool  hasSample(size_t index) const { return index < mSkeletons.size(); }
-    SkeletonTree getSample(size_t sample) const;
+    double      getSampleIndex(double time) const;
+    inline bool hasSample(size_t index) const { return index < getSampleCount(); }
+    size_t      getSampleCount() const { return mHeadDirs.size(); }
 
     void                       setSamplerate(double samplerate);
     void                       setUserTimeOffset(double timeOffset);
@@ -47,31 +54,54 @@ public:
     void                       setTranslation(const cv::Vec3f &trans);
     void                       setRotation(double angle);
     void                       setMetadata(const MoCapPersonMetadata &metadata);
-    void                       addSkeleton(const SkeletonTree &skeleton);
-    const SkeletonTree        &getSkeleton(size_t samples) const;
     const std::string         &getFilename() const;
     const MoCapPersonMetadata &getMetadata() const;
     bool                       isVisible() const;
     void                       setVisible(bool visible);
 
+    void setTopology(const SkeletonTopology &topology);
+    void reserveSamples(size_t samples);
+    void addSample(
+        std::span<const cv::Point3f> joints,
+        const cv::Vec3f             &headDir,
+        const cv::Point3f           &rotationCenter);
+    void                         addSkeleton(const SkeletonTree &skeleton);
+    SkeletonTree                 getSkeleton(size_t sample) const;
+    const SkeletonTopology      &getTopology() const { return mTopology; }
+    std::span<const cv::Point3f> getJoints(size_t sample) const;
+    cv::Point3f                  getTransformedJoint(size_t sample, size_t joint) const;
+    cv::Vec3f                    getTransformedHeadDir(size_t sample) const;
+    void                         invalidateProjections();
+    std::span<const cv::Point2f>
+    getProjectedJoints(size_t sample, const std::function<cv::Point2f(cv::Point3f)> &project) const;
 
     void setXml(QDomElement &elem) const;
 
 private:
-    std::vector<SkeletonTree> mSkeletons;
-    MoCapPersonMetadata       mMetadata;
+    cv::Affine3f getTransform(size_t sample) const;
+
+    SkeletonTopology         mTopology;
+    std::vector<cv::Point3f> mJoints;          ///< joints of all samples, untransformed
+    std::vector<cv::Vec3f>   mHeadDirs;        ///< normalized head direction of each sample, untransformed
+    std::vector<cv::Point3f> mRotationCenters; ///< rotation center of each sample
+    MoCapPersonMetadata      mMetadata;
+
+    mutable std::vector<cv::Point2f> mProjectedJoints; ///< cached image points of mJoints after the transformation
+    mutable std::vector<bool>        mIsProjected;     ///< whether the joints of a sample are in mProjectedJoints
 };
 
 class MoCapStorage
 {
 private:
     std::vector<MoCapPerson> mPersons;
+    size_t                   mRevision = 0; ///< incremented whenever a person is added
 
 public:
     void                            addPerson(const MoCapPerson &person);
     void                            addPerson(MoCapPerson &&person);
     std::vector<MoCapPerson>       &getPersons() { return mPersons; }
     const std::vector<MoCapPerson> &getPersons() const { return mPersons; }
+    size_t                          getRevision() const { return mRevision; }
 };
 
 #endif // MOCAPPERSON_H
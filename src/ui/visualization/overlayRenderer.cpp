@@ -0,0 +1,363 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "overlayRenderer.h"
+
+#include "calibration/walkAreaManager.h"
+#include "control.h"
+#include "penUtils.h"
+#include "personStorage.h"
+#include "petrack.h"
+
+#include <QImage>
+#include <QPainter>
+#include <algorithm>
+#include <numeric>
+#include <opencv2/imgproc.hpp>
+#include <optional>
+
+/**
+ * @brief Reads the current visualization options of the tracking tab and the walk area
+ *
+ * Has to be called in the GUI thread.
+ */
+OverlaySettings OverlaySettings::fromProject(Petrack &petrack)
+{
+    const Control  *control = petrack.getControlWidget();
+    OverlaySettings settings;
+
+    settings.borderSize       = petrack.getImageBorderSize();
+    settings.showTrajectories = control->getTrackShow();
+    settings.selection        = petrack.getPedestrianUserSelection();
+
+    settings.showBefore      = control->getTrackShowBefore();
+    settings.showAfter       = control->getTrackShowAfter();
+    settings.showComplPath   = control->isTrackShowComplPathChecked();
+    settings.showOnlyVisible = control->isTrackShowOnlyVisibleChecked();
+
+    settings.showCurrentPoint      = control->isTrackShowCurrentPointChecked();
+    settings.showColorMarker       = control->isTrackShowColorMarkerChecked();
+    settings.showColColor          = control->isTrackShowColColorChecked();
+    settings.showNumber            = control->isTrackShowNumberChecked();
+    settings.showPoints            = control->isTrackShowPointsChecked();
+    settings.showPointsColored     = control->isTrackShowPointsColoredChecked();
+    settings.showPath              = control->isTrackShowPathChecked();
+    settings.numberBold            = control->isTrackNumberBoldChecked();
+    settings.currentPointSize      = control->getTrackCurrentPointSize();
+    settings.pointSize             = control->getTrackPointSize();
+    settings.colColorSize          = control->getTrackColColorSize();
+    settings.colorMarkerSize       = control->getTrackColorMarkerSize();
+    settings.numberSize            = control->getTrackNumberSize();
+    settings.currentPointLineWidth = control->getTrackCurrentPointLineWidth();
+    settings.colorMarkerLineWidth  = control->getTrackColorMarkerLineWidth();
+    settings.pointsLineWidth       = control->getTrackShowPointsLineWidth();
+    settings.pathWidth             = control->getTrackPathWidth();
+    settings.pathColor             = control->getTrackPathColor();
+
+    if(const WalkAreaManager *walkArea = petrack.getWalkAreaManager(); walkArea && walkArea->isVisible())
+    {
+        auto addPolygon = [&settings, walkArea](const walkarea::Polygon &polygon)
+        {
+            const bool visible = polygon.type() == walkarea::PolygonType::Obstacle ? walkArea->isObstacleVisible() :
+                                                                                      walkArea->isWalkableVisible();
+            if(visible && !polygon.disabled())
+            {
+                settings.walkAreaPolygons.push_back(polygon);
+            }
+        };
+        if(const auto walkable = walkArea->getWalkableArea())
+        {
+            addPolygon(*walkable);
+        }
+        for(const auto &[id, obstacle] : walkArea->getObstacles())
+        {
+            addPolygon(obstacle);
+        }
+    }
+    return settings;
+}
+
+OverlayRenderer::OverlayRenderer(const PersonStorage &storage, OverlaySettings settings) :
+    mPersonStorage(storage), mSettings(std::move(settings))
+{
+}
+
+/**
+ * @brief Draws the overlays of frame
+ *
+ * The painter has to paint onto an image of the size of the filtered image (including the border).
+ */
+void OverlayRenderer::paint(QPainter &painter, int frame) const
+{
+    painter.save();
+    // TrackPoints are relative to the image without border, see TrackerItem::boundingRect
+    painter.translate(mSettings.borderSize, mSettings.borderSize);
+
+    paintWalkArea(painter);
+
+    if(mSettings.showTrajectories)
+    {
+        const auto &persons   = mPersonStorage.getPersons();
+        const bool  allFrames = mSettings.showBefore == -1 || mSettings.showAfter == -1 ||
+                               (mSettings.showComplPath && !mSettings.selection.empty());
+
+        std::vector<size_t> personsToPaint;
+        if(allFrames)
+        {
+            personsToPaint.resize(persons.size());
+            std::iota(personsToPaint.begin(), personsToPaint.end(), 0);
+        }
+        else
+        {
+            personsToPaint =
+                mPersonStorage.personsInFrameRange(frame - mSettings.showBefore, frame + mSettings.showAfter);
+        }
+
+        for(size_t i : personsToPaint)
+        {
+            if(!mSettings.selection.empty() && !mSettings.selection.contains(i))
+            {
+                continue;
+            }
+            const auto &person = persons[i];
+            if(person.trackPointExist(frame))
+            {
+                paintCurrentPoint(painter, person, i, frame);
+            }
+            if(!mSettings.showOnlyVisible || person.trackPointExist(frame))
+            {
+                paintPath(painter, person, frame);
+            }
+        }
+    }
+    painter.restore();
+}
+
+/**
+ * @brief Returns a color copy of img (filtered image including border) with the overlays of frame drawn onto it
+ */
+cv::Mat OverlayRenderer::render(const cv::Mat &img, int frame) const
+{
+    cv::Mat result;
+    if(img.channels() == 1)
+    {
+        cv::cvtColor(img, result, cv::COLOR_GRAY2BGR);
+    }
+    else
+    {
+        result = img.clone();
+    }
+
+    // draw directly into the pixels of result
+    QImage   image(result.data, result.cols, result.rows, static_cast<int>(result.step), QImage::Format_BGR888);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    paint(painter, frame);
+    painter.end();
+
+    return result;
+}
+
+void OverlayRenderer::paintWalkArea(QPainter &painter) const
+{
+    for(const auto &polygon : mSettings.walkAreaPolygons)
+    {
+        const bool isObs = (polygon.type() == walkarea::PolygonType::Obstacle);
+        QPen       pen(isObs ? QColor(220, 80, 80, 220) : QColor(60, 160, 240, 220));
+        pen.setWidth(2);
+        painter.setPen(scaledPen(pen));
+        painter.setBrush(QBrush(isObs ? QColor(220, 80, 80, 90) : QColor(60, 160, 240, 90)));
+        painter.drawPolygon(polygon, Qt::WindingFill);
+    }
+}
+
+void OverlayRenderer::paintCurrentPoint(QPainter &painter, const TrackPerson &person, size_t index, int frame) const
+{
+    const TrackPoint &tp  = person.trackPointAt(frame);
+    const double      pSP = mSettings.currentPointSize;
+    const double      pSC = mSettings.colColorSize;
+    const double      pSM = mSettings.colorMarkerSize;
+    const double      pSN = mSettings.numberSize;
+    QRectF            rect;
+
+    if(mSettings.showCurrentPoint)
+    {
+        QPen pen(tp.isDetection() ? Qt::green : Qt::blue);
+        pen.setWidth(mSettings.currentPointLineWidth);
+        painter.setPen(pen);
+        painter.setBrush(Qt::NoBrush);
+        rect.setRect(tp.x() - pSP / 2., tp.y() - pSP / 2., pSP, pSP);
+        painter.drawEllipse(rect);
+    }
+
+    if(mSettings.showColorMarker)
+    {
+        auto color      = tp.getColorForHeightMap();
+        auto colorPoint = tp.getColorPointForOrientation();
+        if(!colorPoint && color) // its a multicolor point instead
+        {
+            colorPoint = tp.getMultiColorMarker()->mColorPoint;
+        }
+        if(colorPoint)
+        {
+            QPen pen(color ? *color : JapanMarker::COLOR);
+            pen.setWidth(mSettings.colorMarkerLineWidth);
+            painter.setPen(pen);
+            painter.setBrush(Qt::NoBrush);
+            rect.setRect(colorPoint->x() - pSM / 2., colorPoint->y() - pSM / 2., pSM, pSM);
+            painter.drawEllipse(rect);
+        }
+    }
+
+    if(!mSettings.showColColor && !mSettings.showNumber)
+    {
+        return;
+    }
+
+    // direction to place number and color of the person, orthogonal to the orientation of the marker
+    Vec2F normalVector(1., 0.);
+    auto  orientation = [](const TrackPoint &point) -> std::optional<Vec2F>
+    {
+        if(auto colorPoint = point.getColorPointForOrientation())
+        {
+            Vec2F normal = (point.pixelPoint() - *colorPoint).normal();
+            normal.normalize();
+            return normal;
+        }
+        return std::nullopt;
+    };
+    if(auto normal = orientation(tp))
+    {
+        normalVector = normal->length() < .001 ? Vec2F(1., 0.) : *normal;
+    }
+    else
+    {
+        // search backwards and then forwards for a TrackPoint with orientation (see TrackerItem::paint)
+        std::optional<Vec2F> found;
+        for(int j = frame - person.firstFrame(); j > -1 && !found; --j)
+        {
+            found = orientation(person.at(j));
+        }
+        for(int j = frame - person.firstFrame() + 1; j < person.size() && !found; ++j)
+        {
+            found = orientation(person.at(j));
+        }
+        normalVector = found.value_or(normalVector);
+    }
+
+    QPen numberPen(Qt::red);
+    if(mSettings.showColColor)
+    {
+        painter.setPen(numberPen);
+        painter.setBrush(Qt::NoBrush);
+        rect.setRect(tp.x() + 10, tp.y() + 10, 15 * pSC, 10 * pSC);
+        painter.drawText(rect, person.comment());
+
+        if(person.getMarkerID() >= 0)
+        {
+            auto codeMarker = tp.getCodeMarker();
+            painter.setPen(QPen(codeMarker && codeMarker->mMarkerId >= 0 ? Qt::green : Qt::blue));
+            painter.drawText(QPointF{tp.x(), tp.y()}, QString("id=%1").arg(person.getMarkerID()));
+        }
+
+        if(person.color().isValid())
+        {
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(QBrush(person.color()));
+            rect.setRect(
+                tp.x() + (pSP + pSC) * 0.6 * normalVector.x() - pSC / 2.,
+                tp.y() + (pSP + pSC) * 0.6 * normalVector.y() - pSC / 2.,
+                pSC,
+                pSC);
+            painter.drawEllipse(rect);
+        }
+    }
+
+    if(mSettings.showNumber)
+    {
+        QFont font;
+        font.setBold(mSettings.numberBold);
+        font.setPixelSize(static_cast<int>(pSN));
+        painter.setFont(font);
+        painter.setPen(numberPen);
+        painter.setBrush(Qt::NoBrush);
+        rect.setRect(
+            tp.x() - (pSP + pSN) * 0.6 * normalVector.x() - pSN,
+            tp.y() - (pSP + pSN) * 0.6 * normalVector.y() - pSN / 2.,
+            2. * pSN,
+            pSN);
+        painter.drawText(rect, Qt::AlignHCenter, QString("%1").arg(index + 1));
+    }
+}
+
+void OverlayRenderer::paintPath(QPainter &painter, const TrackPerson &person, int frame) const
+{
+    if(!mSettings.showPath && !mSettings.showPoints)
+    {
+        return;
+    }
+
+    const bool complete = mSettings.showComplPath && !mSettings.selection.empty();
+    const int  from =
+        (mSettings.showBefore == -1 || complete) ? 0 : std::max(0, frame - person.firstFrame() - mSettings.showBefore);
+    const int to = (mSettings.showAfter == -1 || complete) ?
+                       person.size() :
+                       std::min(person.size(), frame - person.firstFrame() + mSettings.showAfter + 1);
+
+    QPen linePen(mSettings.pathColor);
+    linePen.setWidth(mSettings.pathWidth);
+    QPen pointPen(mSettings.pathColor);
+    pointPen.setWidth(mSettings.pointsLineWidth);
+    const double pS = mSettings.pointSize;
+
+    for(int j = from; j < to; ++j)
+    {
+        if(mSettings.showPath && j != from)
+        {
+            painter.setPen(linePen);
+            painter.setBrush(Qt::NoBrush);
+            const QPointF previous = person.at(j - 1).pixelPoint().toQPointF();
+            const QPointF current  = person.at(j).pixelPoint().toQPointF();
+            if(previous != current)
+            {
+                painter.drawLine(previous, current);
+            }
+            else
+            {
+                painter.drawPoint(previous);
+            }
+        }
+
+        if(mSettings.showPoints && person.firstFrame() + j != frame)
+        {
+            const TrackPoint &point = person.at(j);
+            auto              color = point.getColorForHeightMap();
+            if(mSettings.showPointsColored && color)
+            {
+                painter.setPen(Qt::NoPen);
+                painter.setBrush(QBrush(*color));
+            }
+            else
+            {
+                painter.setPen(pointPen);
+                painter.setBrush(Qt::NoBrush);
+            }
+            painter.drawEllipse(QRectF(point.x() - pS / 2., point.y() - pS / 2., pS, pS));
+        }
+    }
+}
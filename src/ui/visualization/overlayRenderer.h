@@ -0,0 +1,109 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OVERLAYRENDERER_H
+#define OVERLAYRENDERER_H
+
+#include "polygon.h"
+
+#include <QColor>
+#include <QSet>
+#include <opencv2/core.hpp>
+#include <vector>
+
+class PersonStorage;
+class Petrack;
+class QPainter;
+class TrackPerson;
+
+/**
+ * @brief Snapshot of all options needed to draw the overlays of a frame
+ *
+ * Reading the options once from the GUI allows to draw the overlays without touching any widget, i.e. from several
+ * threads at once.
+ */
+struct OverlaySettings
+{
+    int          borderSize       = 0;
+    bool         showTrajectories = true;
+    QSet<size_t> selection; ///< persons to draw; all if empty
+
+    int  showBefore      = 15; ///< frames of the path before the current frame; -1 for all
+    int  showAfter       = 15; ///< frames of the path after the current frame; -1 for all
+    bool showComplPath   = false;
+    bool showOnlyVisible = false;
+
+    bool   showCurrentPoint      = true;
+    bool   showColorMarker       = true;
+    bool   showColColor          = true;
+    bool   showNumber            = true;
+    bool   showPoints            = false;
+    bool   showPointsColored     = true;
+    bool   showPath              = true;
+    bool   numberBold            = true;
+    double currentPointSize      = 60;
+    double pointSize             = 7;
+    double colColorSize          = 11;
+    double colorMarkerSize       = 14;
+    double numberSize            = 14;
+    int    currentPointLineWidth = 1;
+    int    colorMarkerLineWidth  = 1;
+    int    pointsLineWidth       = 1;
+    int    pathWidth             = 2;
+    QColor pathColor             = Qt::red;
+
+    std::vector<walkarea::Polygon> walkAreaPolygons; ///< visible walkable areas and obstacles
+
+    static OverlaySettings fromProject(Petrack &petrack);
+};
+
+/**
+ * @brief Draws trajectories and walk area of a frame without a QGraphicsScene
+ *
+ * The drawing follows TrackerItem and WalkAreaItem, but works on plain images: the trajectories are read from the
+ * PersonStorage and the options from an OverlaySettings snapshot. Since no widget is used, several frames can be
+ * rendered in parallel as long as the PersonStorage is not changed meanwhile.
+ *
+ * Only the trajectories and the walk area are drawn. In particular, the following parts of the view are not drawn:
+ * - the grid and the coordinate system (incl. the calibration and vanishing points)
+ * - the MoCap skeletons
+ * - the trajectory options depending on the calibration: head sized points, search region, heights, ground positions
+ *   and paths, Voronoi cells
+ * - the regions of interest, the detected color, code and multicolor markers, the stereo disparity, the background,
+ *   the annotation groups and the logo
+ */
+class OverlayRenderer
+{
+public:
+    OverlayRenderer(const PersonStorage &storage, OverlaySettings settings);
+
+    void    paint(QPainter &painter, int frame) const;
+    cv::Mat render(const cv::Mat &img, int frame) const;
+
+    const OverlaySettings &settings() const { return mSettings; }
+
+private:
+    void paintWalkArea(QPainter &painter) const;
+    void paintCurrentPoint(QPainter &painter, const TrackPerson &person, size_t index, int frame) const;
+    void paintPath(QPainter &painter, const TrackPerson &person, int frame) const;
+
+    const PersonStorage &mPersonStorage;
+    OverlaySettings      mSettings;
+};
+
+#endif // OVERLAYRENDERER_H
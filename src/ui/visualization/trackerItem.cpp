@@ -31,6 +31,7 @@
 #include <QInputDialog>
 #include <QMenu>
 #include <QMessageBox>
+#include <numeric>
 
 // in x und y gleichermassen skaliertes koordinatensystem,
 // da von einer vorherigen intrinsischen kamerakalibrierung ausgegenagen wird,
@@ -421,7 +422,23 @@ void TrackerItem::paint(QPainter *painter, const QStyleOptionGraphicsItem * /*op
 
     auto        pedestrianToPaint = mMainWindow->getPedestrianUserSelection();
     const auto &persons           = mPersonStorage.getPersons();
-    for(size_t i = 0; i < persons.size(); ++i) // ueber TrackPerson
+
+    // only persons with a TrackPoint in the shown part of the paths can be drawn (the current frame is part of it)
+    std::vector<size_t> personsToPaint;
+    const int           showBefore = mControlWidget->getTrackShowBefore();
+    const int           showAfter  = mControlWidget->getTrackShowAfter();
+    if(showBefore == -1 || showAfter == -1 ||
+       (mControlWidget->isTrackShowComplPathChecked() && !pedestrianToPaint.empty()))
+    {
+        personsToPaint.resize(persons.size());
+        std::iota(personsToPaint.begin(), personsToPaint.end(), 0);
+    }
+    else
+    {
+        personsToPaint = mPersonStorage.personsInFrameRange(curFrame - showBefore, curFrame + showAfter);
+    }
+
+    for(size_t i : personsToPaint) // ueber TrackPerson
     {
         const auto &person = persons[i];
         // show current frame
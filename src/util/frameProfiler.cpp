@@ -0,0 +1,430 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "frameProfiler.h"
+
+#include "logger.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <algorithm>
+
+namespace diagnostics
+{
+namespace
+{
+constexpr std::array<const char *, NB_STAGES> STAGE_NAMES = {
+    "decode",
+    "swap_filter",
+    "bright_contrast_filter",
+    "border_filter",
+    "calib_filter",
+    "background_filter",
+    "pyramids",
+    "optical_flow",
+    "insert_tracked",
+    "recognition",
+    "insert_recognized",
+    "drawing"};
+
+constexpr std::array<const char *, NB_COUNTERS> COUNTER_NAMES = {"points_tracked", "detections", "merges", "seeks"};
+
+constexpr const char *FRAME_EVENT_NAME = "frame";
+
+/// small number per thread for the trace, in order of the first measurement in the thread
+int threadIndex()
+{
+    static std::atomic<int> nextIndex{0};
+    thread_local const int  index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+std::int64_t toNs(Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+double toMs(std::int64_t ns)
+{
+    return static_cast<double>(ns) * 1e-6;
+}
+
+FrameTiming meanOf(const std::vector<FrameTiming> &frames)
+{
+    FrameTiming result;
+    if(frames.empty())
+    {
+        return result;
+    }
+    std::array<std::int64_t, NB_COUNTERS> countSums{};
+    for(const auto &frame : frames)
+    {
+        result.processingNs += frame.processingNs;
+        for(std::size_t i = 0; i < NB_STAGES; ++i)
+        {
+            result.stageNs[i] += frame.stageNs[i];
+        }
+        for(std::size_t i = 0; i < NB_COUNTERS; ++i)
+        {
+            countSums[i] += frame.counts[i];
+        }
+    }
+    const auto nbFrames = static_cast<std::int64_t>(frames.size());
+    result.frame        = frames.back().frame;
+    result.processingNs /= nbFrames;
+    for(auto &ns : result.stageNs)
+    {
+        ns /= nbFrames;
+    }
+    for(std::size_t i = 0; i < NB_COUNTERS; ++i)
+    {
+        result.counts[i] = static_cast<int>(countSums[i] / nbFrames);
+    }
+    return result;
+}
+} // namespace
+
+const char *toString(Stage stage)
+{
+    return STAGE_NAMES.at(static_cast<std::size_t>(stage));
+}
+
+const char *toString(Counter counter)
+{
+    return COUNTER_NAMES.at(static_cast<std::size_t>(counter));
+}
+
+std::int64_t FrameTiming::otherNs() const
+{
+    std::int64_t measured = 0;
+    for(std::size_t i = 0; i < NB_STAGES; ++i)
+    {
+        if(i != static_cast<std::size_t>(Stage::Decode))
+        {
+            measured += stageNs[i];
+        }
+    }
+    return std::max<std::int64_t>(processingNs - measured, 0);
+}
+
+FrameProfiler::FrameProfiler(std::size_t capacity) : mCapacity(std::max<std::size_t>(capacity, 1))
+{
+    mLastFrames.reserve(mCapacity);
+}
+
+/**
+ * @brief Profiler used by the frame pipeline of the application
+ */
+FrameProfiler &FrameProfiler::global()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+/**
+ * @brief Adds the interval from start to end to the given stage of the current frame; safe to call from several threads
+ */
+void FrameProfiler::addTime(Stage stage, Clock::time_point start, Clock::time_point end)
+{
+    mStageNs[static_cast<std::size_t>(stage)].fetch_add(toNs(end - start), std::memory_order_relaxed);
+    if(isRecording())
+    {
+        std::lock_guard lock(mMutex);
+        addTraceEvent(toString(stage), start, end);
+    }
+}
+
+void FrameProfiler::count(Counter counter, int n)
+{
+    mCounts[static_cast<std::size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Stores everything measured since the last finished frame as timing of frame
+ *
+ * Decoding is usually done before the processing of the frame starts, so it is measured as its own stage and not
+ * included in the processing time.
+ *
+ * @param frame number of the frame
+ * @param processingStart time when the processing of the decoded frame started
+ */
+void FrameProfiler::finishFrame(int frame, Clock::time_point processingStart)
+{
+    const auto end = Clock::now();
+
+    FrameTiming timing;
+    timing.frame        = frame;
+    timing.processingNs = toNs(end - processingStart);
+    for(std::size_t i = 0; i < NB_STAGES; ++i)
+    {
+        timing.stageNs[i] = mStageNs[i].exchange(0, std::memory_order_relaxed);
+    }
+    for(std::size_t i = 0; i < NB_COUNTERS; ++i)
+    {
+        timing.counts[i] = mCounts[i].exchange(0, std::memory_order_relaxed);
+    }
+
+    std::lock_guard lock(mMutex);
+    if(mLastFrames.size() < mCapacity)
+    {
+        mLastFrames.push_back(timing);
+    }
+    else
+    {
+        mLastFrames[mNbFinished % mCapacity] = timing;
+    }
+    ++mNbFinished;
+
+    if(isRecording())
+    {
+        mRecordedFrames.push_back(timing);
+        addTraceEvent(FRAME_EVENT_NAME, processingStart, end);
+        for(std::size_t i = mFirstUnfinishedEvent; i < mTrace.size(); ++i)
+        {
+            mTrace[i].frame = frame;
+        }
+        mFirstUnfinishedEvent = mTrace.size();
+    }
+}
+
+/**
+ * @brief Drops everything measured since the last finished frame, e.g. for frames which are not processed
+ */
+void FrameProfiler::discardFrame()
+{
+    for(auto &ns : mStageNs)
+    {
+        ns.store(0, std::memory_order_relaxed);
+    }
+    for(auto &count : mCounts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+    std::lock_guard lock(mMutex);
+    mTrace.resize(mFirstUnfinishedEvent);
+}
+
+/**
+ * @brief Timings of the last (at most nbFrames) finished frames, from oldest to newest
+ */
+std::vector<FrameTiming> FrameProfiler::lastFrames(std::size_t nbFrames) const
+{
+    std::lock_guard lock(mMutex);
+    nbFrames = std::min(nbFrames, mLastFrames.size());
+
+    std::vector<FrameTiming> result;
+    result.reserve(nbFrames);
+    for(std::size_t i = mNbFinished - nbFrames; i < mNbFinished; ++i)
+    {
+        result.push_back(mLastFrames[i % mCapacity]);
+    }
+    return result;
+}
+
+/**
+ * @brief Mean timing of the last nbFrames finished frames; frame is the number of the newest one
+ */
+FrameTiming FrameProfiler::mean(std::size_t nbFrames) const
+{
+    return meanOf(lastFrames(nbFrames));
+}
+
+/**
+ * @brief Starts to keep all following frames and intervals; the previous recording is removed
+ */
+void FrameProfiler::startRecording()
+{
+    std::lock_guard lock(mMutex);
+    mRecordedFrames.clear();
+    mTrace.clear();
+    mFirstUnfinishedEvent = 0;
+    mRecordingStart       = Clock::now();
+    mRecording.store(true, std::memory_order_relaxed);
+}
+
+void FrameProfiler::stopRecording()
+{
+    mRecording.store(false, std::memory_order_relaxed);
+}
+
+std::vector<FrameTiming> FrameProfiler::recordedFrames() const
+{
+    std::lock_guard lock(mMutex);
+    return mRecordedFrames;
+}
+
+std::vector<TraceEvent> FrameProfiler::recordedTrace() const
+{
+    std::lock_guard lock(mMutex);
+    return std::vector<TraceEvent>(mTrace.begin(), mTrace.begin() + static_cast<std::ptrdiff_t>(mFirstUnfinishedEvent));
+}
+
+/**
+ * @brief Logs the mean time per frame of each stage of the recorded frames
+ */
+void FrameProfiler::logRecordingSummary() const
+{
+    const auto frames = recordedFrames();
+    if(frames.empty())
+    {
+        return;
+    }
+    const FrameTiming mean = meanOf(frames);
+
+    std::string stages;
+    for(std::size_t i = 0; i < NB_STAGES; ++i)
+    {
+        if(mean.stageNs[i] > 0)
+        {
+            stages += fmt::format("{} {:.2f}, ", STAGE_NAMES[i], toMs(mean.stageNs[i]));
+        }
+    }
+    SPDLOG_INFO(
+        "Mean time of {} frames: {:.2f} ms per frame ({}other {:.2f}); {} points tracked, {} detections per frame",
+        frames.size(),
+        toMs(mean.totalNs()),
+        stages,
+        toMs(mean.otherNs()),
+        mean.count(Counter::PointsTracked),
+        mean.count(Counter::Detections));
+}
+
+/**
+ * @brief Writes one line per recorded frame with the times in ms and the counters
+ */
+bool FrameProfiler::exportCsv(const QString &filename) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        SPDLOG_ERROR("Cannot open {} to write frame timings: {}", filename, file.errorString());
+        return false;
+    }
+    QTextStream out(&file);
+    out << "frame,total_ms,processing_ms";
+    for(const auto *name : STAGE_NAMES)
+    {
+        out << ',' << name << "_ms";
+    }
+    out << ",other_ms";
+    for(const auto *name : COUNTER_NAMES)
+    {
+        out << ',' << name;
+    }
+    out << '\n';
+
+    for(const auto &frame : recordedFrames())
+    {
+        out << frame.frame << ',' << toMs(frame.totalNs()) << ',' << toMs(frame.processingNs);
+        for(const auto ns : frame.stageNs)
+        {
+            out << ',' << toMs(ns);
+        }
+        out << ',' << toMs(frame.otherNs());
+        for(const auto count : frame.counts)
+        {
+            out << ',' << count;
+        }
+        out << '\n';
+    }
+    return out.status() == QTextStream::Ok;
+}
+
+/**
+ * @brief Writes the recorded intervals in the Trace Event Format of Chrome, which can be opened with Perfetto
+ *
+ * Each stage and each frame is a complete event ("X") on the thread it was measured on; the counters of each frame
+ * are counter events ("C") at the end of the frame.
+ */
+bool FrameProfiler::exportChromeTrace(const QString &filename) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        SPDLOG_ERROR("Cannot open {} to write frame trace: {}", filename, file.errorString());
+        return false;
+    }
+    const auto frames = recordedFrames();
+    const auto trace  = recordedTrace();
+
+    // the events are written directly, as a whole run has millions of them
+    QTextStream out(&file);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool        first      = true;
+    std::size_t frameIndex = 0;
+    for(const auto &event : trace)
+    {
+        const double start = static_cast<double>(event.startNs) * 1e-3;
+        out << (first ? "" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\"petrack\",\"ph\":\"X\",\"pid\":1,"
+            << "\"tid\":" << event.thread << ",\"ts\":" << start
+            << ",\"dur\":" << static_cast<double>(event.durationNs) * 1e-3 << ",\"args\":{\"frame\":" << event.frame
+            << "}}";
+        first = false;
+
+        // frame events and recorded frames are stored together in finishFrame
+        if(event.name == FRAME_EVENT_NAME && frameIndex < frames.size())
+        {
+            const auto &frame = frames[frameIndex++];
+            out << ",\n{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"ts\":"
+                << start + static_cast<double>(event.durationNs) * 1e-3 << ",\"args\":{";
+            for(std::size_t i = 0; i < NB_COUNTERS; ++i)
+            {
+                out << (i > 0 ? "," : "") << '"' << COUNTER_NAMES[i] << "\":" << frame.counts[i];
+            }
+            out << "}}";
+        }
+    }
+    out << "\n]}\n";
+    return out.status() == QTextStream::Ok;
+}
+
+/**
+ * @brief Exports the recording as Chrome trace if filename ends with .json, as CSV otherwise
+ */
+bool FrameProfiler::exportFile(const QString &filename) const
+{
+    if(QFileInfo(filename).suffix().compare("json", Qt::CaseInsensitive) == 0)
+    {
+        return exportChromeTrace(filename);
+    }
+    return exportCsv(filename);
+}
+
+/**
+ * @brief Removes all measurements, including the recording
+ */
+void FrameProfiler::clear()
+{
+    discardFrame();
+    std::lock_guard lock(mMutex);
+    mLastFrames.clear();
+    mNbFinished = 0;
+    mRecordedFrames.clear();
+    mTrace.clear();
+    mFirstUnfinishedEvent = 0;
+}
+
+/// has to be called with locked mMutex
+void FrameProfiler::addTraceEvent(const char *name, Clock::time_point start, Clock::time_point end)
+{
+    mTrace.push_back(TraceEvent{name, -1, threadIndex(), toNs(start - mRecordingStart), toNs(end - start)});
+}
+} // namespace diagnostics
@@ -0,0 +1,179 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QString>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace diagnostics
+{
+/// Stage of the frame pipeline whose time is measured by a ScopedTimer
+enum class Stage : std::uint8_t
+{
+    Decode,               ///< reading and decoding the frame from the video or image sequence
+    SwapFilter,           ///< SwapFilter::apply
+    BrightContrastFilter, ///< BrightContrastFilter::apply
+    BorderFilter,         ///< BorderFilter::apply
+    CalibFilter,          ///< undistortion with CalibFilter or rectification of the stereo context
+    BackgroundFilter,     ///< BackgroundFilter::apply
+    Pyramids,             ///< image pyramids for Lucas-Kanade
+    OpticalFlow,          ///< Lucas-Kanade of the feature points including the refinement of the positions
+    InsertTracked,        ///< insertion of the tracked points into the trajectories, including merges
+    Recognition,          ///< detection of the markers
+    InsertRecognized,     ///< insertion of the recognized points into the trajectories
+    Drawing,              ///< conversion into the shown image and repaint of the view
+};
+
+inline constexpr std::size_t NB_STAGES = 12;
+
+/// Numbers counted per frame
+enum class Counter : std::uint8_t
+{
+    PointsTracked, ///< points tracked with Lucas-Kanade
+    Detections,    ///< points found by the recognition
+    Merges,        ///< trajectories merged with another one
+    Seeks,         ///< seeks in the video (instead of reading the next frame)
+};
+
+inline constexpr std::size_t NB_COUNTERS = 4;
+
+const char *toString(Stage stage);
+const char *toString(Counter counter);
+
+using Clock = std::chrono::steady_clock;
+
+/// Times and counts of one processed frame
+struct FrameTiming
+{
+    int                                 frame        = -1;
+    std::int64_t                        processingNs = 0; ///< from start of processing the decoded frame to its end
+    std::array<std::int64_t, NB_STAGES> stageNs{};
+    std::array<int, NB_COUNTERS>        counts{};
+
+    /// processing time plus the time to decode the frame before
+    std::int64_t totalNs() const { return processingNs + stageNs[static_cast<std::size_t>(Stage::Decode)]; }
+    /// processing time not covered by one of the measured stages
+    std::int64_t otherNs() const;
+    std::int64_t ns(Stage stage) const { return stageNs[static_cast<std::size_t>(stage)]; }
+    int          count(Counter counter) const { return counts[static_cast<std::size_t>(counter)]; }
+};
+
+/// Measured interval for the trace; name is the name of a stage or "frame"
+struct TraceEvent
+{
+    const char  *name;
+    int          frame;
+    int          thread;
+    std::int64_t startNs; ///< since the start of the recording
+    std::int64_t durationNs;
+};
+
+/**
+ * @brief Collects the time spent in each stage of the frame pipeline and some counters per frame
+ *
+ * ScopedTimers and count() accumulate into the current frame from any thread without locks. finishFrame() moves the
+ * accumulated values into a ring buffer of the last frames, which is used for the live breakdown in the status bar.
+ *
+ * While recording (e.g. during trackAll), all frames and every single measured interval are kept additionally, so a
+ * whole run can be exported as CSV (one line per frame) or as Chrome trace (chrome://tracing, Perfetto).
+ */
+class FrameProfiler
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+    explicit FrameProfiler(std::size_t capacity = DEFAULT_CAPACITY);
+
+    static FrameProfiler &global();
+
+    void addTime(Stage stage, Clock::time_point start, Clock::time_point end);
+    void count(Counter counter, int n = 1);
+    void finishFrame(int frame, Clock::time_point processingStart);
+    void discardFrame();
+
+    std::vector<FrameTiming> lastFrames(std::size_t nbFrames) const;
+    FrameTiming              mean(std::size_t nbFrames) const;
+
+    void                     startRecording();
+    void                     stopRecording();
+    bool                     isRecording() const { return mRecording.load(std::memory_order_relaxed); }
+    std::vector<FrameTiming> recordedFrames() const;
+    std::vector<TraceEvent>  recordedTrace() const;
+    void                     logRecordingSummary() const;
+
+    bool exportCsv(const QString &filename) const;
+    bool exportChromeTrace(const QString &filename) const;
+    bool exportFile(const QString &filename) const;
+
+    void clear();
+
+private:
+    void addTraceEvent(const char *name, Clock::time_point start, Clock::time_point end);
+
+    std::array<std::atomic<std::int64_t>, NB_STAGES> mStageNs{};
+    std::array<std::atomic<int>, NB_COUNTERS>        mCounts{};
+
+    std::size_t              mCapacity;
+    std::vector<FrameTiming> mLastFrames; ///< ring buffer of the last mCapacity frames
+    std::size_t              mNbFinished = 0;
+
+    std::atomic<bool>        mRecording{false};
+    Clock::time_point        mRecordingStart;
+    std::vector<FrameTiming> mRecordedFrames;
+    std::vector<TraceEvent>  mTrace;
+    std::size_t              mFirstUnfinishedEvent = 0; ///< first event in mTrace without frame number
+
+    mutable std::mutex mMutex; ///< guards everything except the atomics
+};
+
+/**
+ * @brief Adds the time from construction to destruction to a stage of the current frame
+ *
+ * Cheap enough to be used for every frame: two clock reads and an atomic addition; the interval is only stored
+ * additionally while the profiler is recording.
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Stage stage, FrameProfiler &profiler = FrameProfiler::global()) :
+        mProfiler(profiler), mStage(stage), mStart(Clock::now())
+    {
+    }
+    ~ScopedTimer() { mProfiler.addTime(mStage, mStart, Clock::now()); }
+
+    ScopedTimer(const ScopedTimer &)            = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+    ScopedTimer(ScopedTimer &&)                 = delete;
+    ScopedTimer &operator=(ScopedTimer &&)      = delete;
+
+private:
+    FrameProfiler    &mProfiler;
+    Stage             mStage;
+    Clock::time_point mStart;
+};
+} // namespace diagnostics
+
+#endif // FRAMEPROFILER_H
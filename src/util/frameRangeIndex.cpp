@@ -0,0 +1,251 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "frameRangeIndex.h"
+
+#include <algorithm>
+
+void FrameRangeIndex::clear()
+{
+    mRanges.clear();
+    mBlocks.clear();
+    mFirstFrames.clear();
+    mLastFrames.clear();
+}
+
+/**
+ * @brief Replaces the whole index, element i gets the range ranges[i]
+ */
+void FrameRangeIndex::rebuild(const std::vector<Range> &ranges)
+{
+    clear();
+    mRanges.reserve(ranges.size());
+    for(const auto &range : ranges)
+    {
+        pushBack(range.firstFrame, range.lastFrame);
+    }
+}
+
+/**
+ * @brief Adds a new element with index size()
+ */
+void FrameRangeIndex::pushBack(int firstFrame, int lastFrame)
+{
+    const size_t index = mRanges.size();
+    mRanges.push_back({firstFrame, lastFrame});
+    mFirstFrames.insert(firstFrame);
+    mLastFrames.insert(lastFrame);
+    if(firstFrame <= lastFrame)
+    {
+        addToBlocks(index, blockOf(firstFrame), blockOf(lastFrame));
+    }
+}
+
+/**
+ * @brief Sets the range of an existing element
+ *
+ * Only the blocks entered or left by the range are touched, so extending a range by a single frame is cheap.
+ */
+void FrameRangeIndex::update(size_t index, int firstFrame, int lastFrame)
+{
+    auto &range = mRanges.at(index);
+    if(range.firstFrame == firstFrame && range.lastFrame == lastFrame)
+    {
+        return;
+    }
+
+    if(range.firstFrame != firstFrame)
+    {
+        mFirstFrames.erase(mFirstFrames.find(range.firstFrame));
+        mFirstFrames.insert(firstFrame);
+    }
+    if(range.lastFrame != lastFrame)
+    {
+        mLastFrames.erase(mLastFrames.find(range.lastFrame));
+        mLastFrames.insert(lastFrame);
+    }
+
+    const bool wasEmpty = range.lastFrame < range.firstFrame;
+    const bool isEmpty  = lastFrame < firstFrame;
+    if(!wasEmpty && !isEmpty)
+    {
+        const int oldFrom = blockOf(range.firstFrame);
+        const int oldTo   = blockOf(range.lastFrame);
+        const int newFrom = blockOf(firstFrame);
+        const int newTo   = blockOf(lastFrame);
+        if(oldTo < newFrom || newTo < oldFrom)
+        {
+            removeFromBlocks(index, oldFrom, oldTo);
+            addToBlocks(index, newFrom, newTo);
+        }
+        else
+        {
+            removeFromBlocks(index, oldFrom, newFrom - 1);
+            removeFromBlocks(index, newTo + 1, oldTo);
+            addToBlocks(index, newFrom, oldFrom - 1);
+            addToBlocks(index, oldTo + 1, newTo);
+        }
+    }
+    else if(!wasEmpty)
+    {
+        removeFromBlocks(index, blockOf(range.firstFrame), blockOf(range.lastFrame));
+    }
+    else if(!isEmpty)
+    {
+        addToBlocks(index, blockOf(firstFrame), blockOf(lastFrame));
+    }
+
+    range = {firstFrame, lastFrame};
+}
+
+/**
+ * @brief Removes an element; the following elements move one index down, like in the indexed container
+ */
+void FrameRangeIndex::erase(size_t index)
+{
+    const auto range = mRanges.at(index);
+    mFirstFrames.erase(mFirstFrames.find(range.firstFrame));
+    mLastFrames.erase(mLastFrames.find(range.lastFrame));
+    if(range.firstFrame <= range.lastFrame)
+    {
+        removeFromBlocks(index, blockOf(range.firstFrame), blockOf(range.lastFrame));
+    }
+    mRanges.erase(mRanges.begin() + static_cast<std::ptrdiff_t>(index));
+
+    for(auto &[block, indices] : mBlocks)
+    {
+        for(auto &element : indices)
+        {
+            if(element > index)
+            {
+                --element;
+            }
+        }
+    }
+}
+
+/// Number of elements existing in frame
+size_t FrameRangeIndex::count(int frame) const
+{
+    auto block = mBlocks.find(blockOf(frame));
+    if(block == mBlocks.end())
+    {
+        return 0;
+    }
+    return std::count_if(
+        block->second.begin(),
+        block->second.end(),
+        [this, frame](size_t index)
+        { return mRanges[index].firstFrame <= frame && frame <= mRanges[index].lastFrame; });
+}
+
+/// Indices of all elements existing in frame in ascending order
+std::vector<size_t> FrameRangeIndex::find(int frame) const
+{
+    return find(frame, frame);
+}
+
+/// Indices of all elements existing in at least one frame of [fromFrame, toFrame] in ascending order
+std::vector<size_t> FrameRangeIndex::find(int fromFrame, int toFrame) const
+{
+    std::vector<size_t> result;
+    if(mRanges.empty())
+    {
+        return result;
+    }
+    // do not walk over blocks no element can be in
+    fromFrame = std::max(fromFrame, smallestFirstFrame());
+    toFrame   = std::min(toFrame, largestLastFrame());
+
+    const int toBlock = blockOf(toFrame);
+    for(int block = blockOf(fromFrame); fromFrame <= toFrame && block <= toBlock; ++block)
+    {
+        auto elements = mBlocks.find(block);
+        if(elements == mBlocks.end())
+        {
+            continue;
+        }
+        for(size_t index : elements->second)
+        {
+            const auto &range = mRanges[index];
+            // elements spanning multiple blocks are only taken from the first block of the queried range they are in
+            if(range.lastFrame >= fromFrame && range.firstFrame <= toFrame &&
+               blockOf(std::max(range.firstFrame, fromFrame)) == block)
+            {
+                result.push_back(index);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/// Smallest first frame of all elements, -1 if there are none
+int FrameRangeIndex::smallestFirstFrame() const
+{
+    return mFirstFrames.empty() ? -1 : *mFirstFrames.begin();
+}
+
+/// Largest first frame of all elements, -1 if there are none
+int FrameRangeIndex::largestFirstFrame() const
+{
+    return mFirstFrames.empty() ? -1 : *mFirstFrames.rbegin();
+}
+
+/// Largest last frame of all elements, -1 if there are none
+int FrameRangeIndex::largestLastFrame() const
+{
+    return mLastFrames.empty() ? -1 : *mLastFrames.rbegin();
+}
+
+/// Block containing frame; rounds towards negative infinity
+int FrameRangeIndex::blockOf(int frame)
+{
+    return frame >= 0 ? frame / BLOCK_SIZE : -((-frame - 1) / BLOCK_SIZE) - 1;
+}
+
+void FrameRangeIndex::addToBlocks(size_t index, int fromBlock, int toBlock)
+{
+    for(int block = fromBlock; block <= toBlock; ++block)
+    {
+        mBlocks[block].push_back(index);
+    }
+}
+
+void FrameRangeIndex::removeFromBlocks(size_t index, int fromBlock, int toBlock)
+{
+    for(int block = fromBlock; block <= toBlock; ++block)
+    {
+        auto elements = mBlocks.find(block);
+        if(elements == mBlocks.end())
+        {
+            continue;
+        }
+        auto &indices = elements->second;
+        if(auto it = std::find(indices.begin(), indices.end(), index); it != indices.end())
+        {
+            // order inside a block does not matter
+            *it = indices.back();
+            indices.pop_back();
+        }
+        if(indices.empty())
+        {
+            mBlocks.erase(elements);
+        }
+    }
+}
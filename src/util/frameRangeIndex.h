@@ -0,0 +1,79 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMERANGEINDEX_H
+#define FRAMERANGEINDEX_H
+
+#include <cstddef>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Index over the frame ranges of many elements (e.g. trajectories)
+ *
+ * Each element has a continuous range [firstFrame, lastFrame], the element index is its position in the indexed
+ * container. The frames are bucketed into blocks of BLOCK_SIZE frames and every block knows all elements whose range
+ * intersects it. Questions like "which elements exist in frame f" therefore only look at the elements living near f
+ * instead of all elements.
+ *
+ * Growing or shrinking a range by a few frames (as done while tracking) is amortized constant time. Removing an
+ * element only touches the blocks of its range and shifts the stored indices of the following elements.
+ *
+ * Elements with lastFrame < firstFrame are considered empty; they exist in no frame but still count for the
+ * first/last frame queries.
+ */
+class FrameRangeIndex
+{
+public:
+    static constexpr int BLOCK_SIZE = 64;
+
+    struct Range
+    {
+        int firstFrame;
+        int lastFrame;
+    };
+
+    void clear();
+    void rebuild(const std::vector<Range> &ranges);
+
+    void   pushBack(int firstFrame, int lastFrame);
+    void   update(size_t index, int firstFrame, int lastFrame);
+    void   erase(size_t index);
+    size_t size() const { return mRanges.size(); }
+
+    size_t              count(int frame) const;
+    std::vector<size_t> find(int frame) const;
+    std::vector<size_t> find(int fromFrame, int toFrame) const;
+
+    int smallestFirstFrame() const;
+    int largestFirstFrame() const;
+    int largestLastFrame() const;
+
+private:
+    std::vector<Range>                           mRanges;
+    std::unordered_map<int, std::vector<size_t>> mBlocks; ///< block number -> elements intersecting the block
+    std::multiset<int>                           mFirstFrames;
+    std::multiset<int>                           mLastFrames;
+
+    static int blockOf(int frame);
+    void       addToBlocks(size_t index, int fromBlock, int toBlock);
+    void       removeFromBlocks(size_t index, int fromBlock, int toBlock);
+};
+
+#endif // FRAMERANGEINDEX_H
@@ -45,6 +45,38 @@ const QString commandLineOptionsString = []() -> QString
         {"-autoTrack|-autotrack trackerFile",
          "calculates automatically the trajectories of marked pedestrians and stores the result to "
          "<kbd>trackerFile</kbd>"},
+        {"-autoTrackDiagnostics diagnosticsFile",
+         "writes the events noticed during <kbd>-autoTrack</kbd> or <kbd>-autoPlay</kbd> (lost trajectories, "
+         "extrapolations, ambiguous assignments, ...) to <kbd>diagnosticsFile</kbd>; JSON if the suffix is "
+         "<kbd>json</kbd>, CSV otherwise"},
+        {"-autoTrackProfile profileFile",
+         "writes the time spent in each stage of the frame pipeline (decoding, filters, tracking, recognition, "
+         "drawing) and counters like the number of tracked points for every frame of <kbd>-autoTrack</kbd> or "
+         "<kbd>-autoPlay</kbd> to <kbd>profileFile</kbd>; a Chrome trace (e.g. for Perfetto) if the suffix is "
+         "<kbd>json</kbd>, CSV with one line per frame otherwise"},
+        {"-trackFrames first-last",
+         "restricts <kbd>-autoTrack</kbd> to the frames <kbd>first</kbd> to <kbd>last</kbd>: tracks forward from "
+         "<kbd>first</kbd> to <kbd>last</kbd> and backward to <kbd>first</kbd>"},
+        {"-trackShards number",
+         "splits the sequence for <kbd>-autoTrack</kbd> into <kbd>number</kbd> overlapping parts, which are tracked "
+         "by parallel worker processes; the trajectories of neighboring parts are joined in the overlap by their "
+         "positions and marker IDs; the project has to be saved"},
+        {"-trackShardOverlap frames",
+         "number of frames tracked by both neighboring parts of <kbd>-trackShards</kbd> (default 50)"},
+        {"-trackShardReport report.json",
+         "writes the number of joined, ambiguously joined and unmatched trajectories of <kbd>-trackShards</kbd> "
+         "to <kbd>report.json</kbd>"},
+        {"-detectAll",
+         "runs the recognition on all frames (or the frames of <kbd>-trackFrames</kbd>) in advance and stores the "
+         "detections in the detection cache; <kbd>-autoTrack</kbd> and <kbd>-autoPlay</kbd> use the cached detections "
+         "afterwards"},
+        {"-detectWorkers number",
+         "runs the recognition of <kbd>-detectAll</kbd> in <kbd>number</kbd> worker processes in parallel; the "
+         "project has to be saved"},
+        {"-detectionCache detections.det",
+         "file of the detection cache, which is loaded if it exists; cached detections are only used with the "
+         "recognition settings they were created with; defaults to the project name with the ending "
+         "<kbd>.det</kbd> for <kbd>-detectAll</kbd>"},
         {"-autoReadMarkerID|-autoreadmarkerid markerIdFile",
          "automatically reads the <kbd>txt-file</kbd> including personID and markerID and applies the markerIDs to the "
          "corresponding person. If -autoTrack is not used, saving trackerFiles using -autoSaveTracker is recommended."},
@@ -57,9 +89,29 @@ const QString commandLineOptionsString = []() -> QString
         {"-autoExportView|-autoexportview outputFile",
          "exports the view, e.g., the undistorted video "
          "or the video with trajectories, to <kbd>outputFile</kbd>"},
+        {"-autoExportOverlay outputFile",
+         "exports the sequence with the trajectories and walk area drawn onto it to <kbd>outputFile</kbd> (video "
+         "file or folder for png images); unlike <kbd>-autoExportView</kbd> no view is rendered, so it also runs "
+         "without a display, e.g. with <kbd>QT_QPA_PLATFORM=offscreen</kbd>"},
         {"-autoIntrinsic | -autointrinsic calibDir",
          "performs intrinsic calibration with the files in <kbd>calibDir</kbd>. Saving the pet-file with "
-         "<kbd>-autoSave</kbd> is recommended, since else the calculated parameters will be lost."}};
+         "<kbd>-autoSave</kbd> is recommended, since else the calculated parameters will be lost."},
+        {"-batch projects",
+         "tracks all <kbd>projects</kbd> and exports the trajectories to a trc-file with the name of the project; "
+         "<kbd>projects</kbd> is a pet-file, a wildcard pattern like <kbd>\"data/*.pet\"</kbd> or a text file with "
+         "one project per line; the option can be given several times"},
+        {"-batchJobs number",
+         "number of worker processes used by <kbd>-batch</kbd> (default 1); projects with the same intrinsic "
+         "calibration and YOLO model are processed by the same worker to reuse undistortion maps and networks"},
+        {"-batchExportOverlay",
+         "additionally exports a video <kbd>name_overlay.mp4</kbd> with the trajectories drawn onto it for every "
+         "project of <kbd>-batch</kbd>"},
+        {"-batchOutputDir dir",
+         "folder for the trajectories written by <kbd>-batch</kbd>; by default they are stored next to the "
+         "projects"},
+        {"-batchSummary summary.json",
+         "file for the JSON summary of <kbd>-batch</kbd> with timings, number of frames and tracked persons per "
+         "project; by default <kbd>petrack_batch_summary.json</kbd> in the output folder"}};
 
     // help and project are supposed to be on the same line as petrack
     // therefore they are handled separately
@@ -89,39 +141,63 @@ const QString commandLineOptionsString = []() -> QString
 }();
 
 
-void copyToQImage(QImage &qImg, cv::Mat &img) // war static functin in animatioln class
+/**
+ * @brief Lets qImg show img without copying the pixel data.
+ *
+ * The QImage holds a reference to the buffer of img, which is released together with the last copy of the QImage.
+ * The data is passed as read-only, so writing to the QImage detaches it. The buffer of img must not be written in
+ * place afterwards; producers reusing a buffer have to call detachSharedMat() first. Mats which do not own their data
+ * (e.g. wrapping memory of a capture library) are copied, as their content may change at any time.
+ *
+ * @param qImg[out] image shown by the ImageItem
+ * @param img 8 bit image with 1 or 3 channels (BGR)
+ */
+void shareToQImage(QImage &qImg, const cv::Mat &img)
 {
-    if(qImg.height() != img.rows || qImg.width() != img.cols) //! qImg || ( or qImg has no object behind pointer
-    {
-        qImg = QImage(QSize(img.cols, img.rows), QImage::Format_RGB888);
-    }
-
-    int channels = img.channels();
-
+    QImage::Format format;
+    const int      channels = img.channels();
     if(channels == 3)
     {
-        // Needs Qt 5.14 for QImage::Format_BGR888 (saves the color transformation into RGB888)
-        qImg = QImage(
-                   (const unsigned char *) (img.data),
-                   img.cols,
-                   img.rows,
-                   static_cast<int>(img.step),
-                   QImage::Format_BGR888)
-                   .copy();
+        format = QImage::Format_BGR888;
     }
     else if(channels == 1)
     {
-        qImg = QImage(
-                   static_cast<const uchar *>(img.data),
-                   img.cols,
-                   img.rows,
-                   static_cast<int>(img.step),
-                   QImage::Format_Grayscale8)
-                   .copy();
+        format = QImage::Format_Grayscale8;
     }
     else
     {
         SPDLOG_ERROR("{} channels are not supported!", channels);
+        return;
+    }
+
+    if(!img.u)
+    {
+        qImg = QImage(img.data, img.cols, img.rows, static_cast<qsizetype>(img.step), format).copy();
+        return;
+    }
+
+    auto *ref = new cv::Mat(img);
+    qImg      = QImage(
+        static_cast<const uchar *>(ref->data),
+        ref->cols,
+        ref->rows,
+        static_cast<qsizetype>(ref->step),
+        format,
+        [](void *mat) { delete static_cast<cv::Mat *>(mat); },
+        ref);
+}
+
+/**
+ * @brief Releases mat if its buffer is referenced elsewhere.
+ *
+ * Call this before writing into a reused buffer (e.g. cv::VideoCapture::read), so that a frame still shown or
+ * processed somewhere else is not overwritten. The next write then allocates a fresh buffer.
+ */
+void detachSharedMat(cv::Mat &mat)
+{
+    if(mat.u && CV_XADD(&mat.u->refcount, 0) > 1)
+    {
+        mat.release();
     }
 }
 
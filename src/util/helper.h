@@ -59,14 +59,10 @@ constexpr const char *file_name(const char *path)
 
 inline constexpr double PI = 3.141592654;
 
-// SHARING MAY ALSO WORK:
-//    > IplImage* frame = cvQueryFrame(mCamera);
-//    > QImage qtImage = QImage(QSize(frame->width, frame->height), QImage::Format_RGB888);
-//    > cvImage = cvCreateImageHeader(cvSize(frame->width, frame->height), 8, 3);
-//    > cvImage->imageData = (char *)qtImage.bits();
-// Static function that converts an iplImg in a qImg.
-// If the images are not the same size, a new qImg will be created with the same size as the iplImg.
-void copyToQImage(QImage &qImg, cv::Mat &img);
+// Shows img in qImg without a deep copy; the QImage keeps a reference to the cv::Mat buffer.
+void shareToQImage(QImage &qImg, const cv::Mat &img);
+// Releases mat if its buffer is referenced elsewhere, so the next write does not change a shared frame.
+void detachSharedMat(cv::Mat &mat);
 
 cv::Rect qRectToCvRect(const QRect &roi, const cv::Mat &img, bool evenPixelNumber = true);
 cv::Mat  getRoi(cv::Mat &img, const QRect &roi, cv::Rect &rect, bool evenPixelNumber = true);
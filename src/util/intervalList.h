@@ -21,6 +21,7 @@
 
 #include "util/logger.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <list>
 #include <string>
@@ -91,27 +92,17 @@ public:
             mEntries.push_back({pos, value});
             return;
         }
-        for(auto it = mEntries.begin(); it != mEntries.end(); it++)
+        auto it = std::lower_bound(
+            mEntries.begin(), mEntries.end(), pos, [](const Entry &entry, int start) { return entry.start < start; });
+        if(it != mEntries.end() && it->start == pos)
         {
-            if(pos == it->start)
-            {
-                it->data = value;
-                break;
-            }
-
-            if(pos < it->start)
-            {
-                mEntries.insert(it, {pos, value});
-                break;
-            }
-            // append if position is behind start of last entry
-            if(it == mEntries.end() - 1)
-            {
-                mEntries.push_back({pos, value});
-                break;
-            }
+            it->data = value;
+        }
+        else
+        {
+            it = mEntries.insert(it, {pos, value});
         }
-        compact();
+        compactAround(static_cast<size_t>(it - mEntries.begin()));
     }
 
     /**
@@ -149,24 +140,15 @@ public:
     }
 
     /**
-     * Go through the entries and return the index that corresponds to the given position.
+     * Binary search for the index of the entry that corresponds to the given position.
      * @param position the position to find
      * @return the index of the entry. -1 if it is before the first entry
      */
     int indexOf(int position) const
     {
-        if(position < mEntries.front().start)
-        {
-            return -1;
-        }
-        for(int i = 1; i < (int) mEntries.size(); ++i)
-        {
-            if(position < mEntries.at(i).start)
-            {
-                return i - 1;
-            }
-        }
-        return mEntries.size() - 1;
+        auto it = std::upper_bound(
+            mEntries.begin(), mEntries.end(), position, [](int pos, const Entry &entry) { return pos < entry.start; });
+        return static_cast<int>(it - mEntries.begin()) - 1;
     }
 
     /**
@@ -195,6 +177,22 @@ public:
         }
     }
 
+    /**
+     * Compact the neighbourhood of the entry at index, assuming the rest of the list is compact already.
+     * Used after changing a single entry, so that not the whole list has to be checked.
+     */
+    void compactAround(size_t index)
+    {
+        if(index + 1 < mEntries.size() && mEntries[index + 1].data == mEntries[index].data)
+        {
+            mEntries.erase(mEntries.begin() + index + 1);
+        }
+        if(index > 0 && mEntries[index - 1].data == mEntries[index].data)
+        {
+            mEntries.erase(mEntries.begin() + index);
+        }
+    }
+
     /**
      * Get the Data at a specific position.
      *
@@ -0,0 +1,57 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "brightContrastFilter.h"
+#include "fixtures.h"
+#include "petrack.h"
+
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Filtering of the frame", "[benchmark][filter]")
+{
+    Petrack petrack{"Benchmark"};
+    // intrinsic calibration (undistortion) and border of the demo project
+    bench::openDemoProject(petrack, "04_correction/07_corrected.pet");
+    QTemporaryDir dir;
+    bench::openFrame(petrack, bench::texture(bench::DEMO_FRAME_SIZE, CV_8UC3), dir);
+
+    petrack.getBrightContrastFilter()->enable();
+    petrack.getBrightContrastFilter()->getBrightness().setValue(10);
+    petrack.getBrightContrastFilter()->getContrast().setValue(10);
+
+    BENCHMARK("getFilteredImage, new frame")
+    {
+        petrack.getFilterGraph().clearCache();
+        petrack.getFilteredImage(true, false, false, false, false);
+        return petrack.getImageFiltered();
+    };
+
+    BENCHMARK("getFilteredImage, recently shown frame")
+    {
+        petrack.getFilteredImage(true, false, false, false, false);
+        return petrack.getImageFiltered();
+    };
+
+    BENCHMARK("getFilteredImage, unchanged frame")
+    {
+        petrack.getFilteredImage(false, false, false, false, false);
+        return petrack.getImageFiltered();
+    };
+}
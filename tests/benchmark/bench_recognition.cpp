@@ -0,0 +1,119 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "control.h"
+#include "fixtures.h"
+#include "petrack.h"
+#include "recognition.h"
+#include "worldImageCorrespondence.h"
+
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+constexpr int NB_MARKERS = 200;
+
+/// positions of the markers inside of the recognition ROI of the demo projects
+std::vector<cv::Point> markerPositions(Petrack &petrack, int spacing)
+{
+    const QRect roi = bench::recognitionRoi(petrack);
+    return bench::gridPositions({roi.x(), roi.y(), roi.width(), roi.height()}, spacing, NB_MARKERS);
+}
+
+QList<TrackPoint> recognize(Petrack &petrack, cv::Mat &img, QRect &roi)
+{
+    return petrack.getRecognizer().getMarkerPos(
+        img,
+        roi,
+        petrack.getControlWidget(),
+        petrack.getImageBorderSize(),
+        petrack.getBackgroundFilter(),
+        petrack.getControlWidget()->getIntrinsicCameraParams());
+}
+} // namespace
+
+TEST_CASE("Recognition of multicolor markers", "[benchmark][recognition]")
+{
+    Petrack petrack{"Benchmark"};
+    bench::openDemoProject(petrack, "02_recognition/04_recognition_multicolor.pet");
+    petrack.getRecognizer().userChangedRecoMethod(reco::RecognitionMethod::MultiColor);
+
+    const int dict = petrack.getRecognizer().getCodeMarkerOptions().getIndexOfMarkerDict();
+    // the head size depends on the opened sequence, so open an empty frame first
+    QTemporaryDir dir;
+    bench::openFrame(petrack, bench::multiColorFrame(bench::DEMO_FRAME_SIZE, {}, 1, dict), dir);
+    const int  radius    = static_cast<int>(0.4 * petrack.getHeadSize());
+    const auto positions = markerPositions(petrack, 3 * radius);
+    bench::openFrame(petrack, bench::multiColorFrame(bench::DEMO_FRAME_SIZE, positions, radius, dict), dir);
+
+    cv::Mat img = petrack.getImageFiltered();
+    QRect   roi = bench::recognitionRoi(petrack);
+    BENCHMARK("findMultiColorMarker, 200 hats with code") { return recognize(petrack, img, roi); };
+}
+
+TEST_CASE("Recognition of contour markers", "[benchmark][recognition]")
+{
+    Petrack petrack{"Benchmark"};
+    bench::openDemoProject(petrack, "02_recognition/04_recognition_multicolor.pet");
+    petrack.getRecognizer().userChangedRecoMethod(reco::RecognitionMethod::Casern);
+
+    QTemporaryDir dir;
+    bench::openFrame(petrack, bench::contourFrame(bench::DEMO_FRAME_SIZE, {}, 1), dir);
+    const int  radius    = static_cast<int>(0.5 * petrack.getHeadSize());
+    const auto positions = markerPositions(petrack, 3 * radius);
+    bench::openFrame(petrack, bench::contourFrame(bench::DEMO_FRAME_SIZE, positions, radius), dir);
+
+    cv::Mat img = petrack.getImageFiltered();
+    QRect   roi = bench::recognitionRoi(petrack);
+    BENCHMARK("findContourMarker, 200 heads") { return recognize(petrack, img, roi); };
+}
+
+TEST_CASE("Recognition of code markers", "[benchmark][recognition]")
+{
+    Petrack petrack{"Benchmark"};
+    bench::openDemoProject(petrack, "02_recognition/04_recognition_codemarker.pet");
+    petrack.getRecognizer().userChangedRecoMethod(reco::RecognitionMethod::Code);
+
+    auto         &options = petrack.getRecognizer().getCodeMarkerOptions();
+    QTemporaryDir dir;
+    bench::openFrame(petrack, bench::codeMarkerFrame(bench::DEMO_FRAME_SIZE, {}, 1, 0), dir);
+
+    // codes with the mean of the allowed side lengths (in cm) at the default height
+    const auto   *control   = petrack.getControlWidget();
+    const QPointF cmPerPx   = petrack.getWorldImageCorrespondence().getCmPerPixel(
+        bench::DEMO_FRAME_SIZE.width / 2.F,
+        bench::DEMO_FRAME_SIZE.height / 2.F,
+        static_cast<float>(control->getDefaultHeight()));
+    const auto    params    = options.getDetectorParams();
+    const double  sideCm    = (params.getMinMarkerPerimeter() + params.getMaxMarkerPerimeter()) / 2.;
+    const int     side      = std::max(8, static_cast<int>(sideCm / std::max(cmPerPx.x(), cmPerPx.y())));
+    const auto    positions = markerPositions(petrack, 3 * side);
+    bench::openFrame(
+        petrack,
+        bench::codeMarkerFrame(bench::DEMO_FRAME_SIZE, positions, side, options.getIndexOfMarkerDict()),
+        dir);
+
+    cv::Mat    img       = petrack.getImageFiltered();
+    const auto intrinsic = control->getIntrinsicCameraParams();
+    BENCHMARK("findCodeMarker, 200 codes")
+    {
+        return reco::detail::findCodeMarker(img, reco::RecognitionMethod::Code, options, intrinsic);
+    };
+}
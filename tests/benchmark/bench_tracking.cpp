@@ -0,0 +1,131 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "control.h"
+#include "fixtures.h"
+#include "personStorage.h"
+#include "petrack.h"
+#include "tracker.h"
+#include "trackerReal.h"
+
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace
+{
+constexpr int NB_PERSONS = 1000;
+constexpr int SPACING    = 40;
+
+std::vector<cv::Point> personPositions()
+{
+    constexpr int margin = 100;
+    return bench::gridPositions(
+        {margin, margin, bench::DEMO_FRAME_SIZE.width - 2 * margin, bench::DEMO_FRAME_SIZE.height - 2 * margin},
+        SPACING,
+        NB_PERSONS);
+}
+
+void addPersons(PersonStorage &storage, const std::vector<cv::Point> &positions, int frame)
+{
+    for(size_t i = 0; i < positions.size(); ++i)
+    {
+        const Vec2F pos(positions[i].x, positions[i].y);
+        storage.addPerson(TrackPerson(static_cast<int>(i), frame, TrackPoint(pos, TrackPoint::BEST_DETECTION_QUAL)));
+    }
+}
+} // namespace
+
+TEST_CASE("Tracking of persons", "[benchmark][tracking]")
+{
+    Petrack petrack{"Benchmark"};
+
+    const cv::Mat texture = bench::texture(bench::DEMO_FRAME_SIZE);
+    cv::Mat       shifted;
+    const cv::Mat shift = (cv::Mat_<double>(2, 3) << 1, 0, 1, 0, 1, 1);
+    cv::warpAffine(texture, shifted, shift, bench::DEMO_FRAME_SIZE, cv::INTER_LINEAR, cv::BORDER_REFLECT);
+    const cv::Mat map1 = bench::identityMap(bench::DEMO_FRAME_SIZE);
+    cv::Rect      roi{{0, 0}, bench::DEMO_FRAME_SIZE};
+
+    Tracker &tracker = *petrack.getTracker();
+    tracker.init(bench::DEMO_FRAME_SIZE);
+    addPersons(petrack.getPersonStorage(), personPositions(), 0);
+    cv::Mat first = texture.clone();
+    tracker.track(first, roi, map1, 0, false, 0, 0, reco::RecognitionMethod::MultiColor);
+
+    // the persons move back and forth by one pixel, each call tracks into the next frame
+    int frame = 0;
+    BENCHMARK("Tracker::track, 1000 persons")
+    {
+        ++frame;
+        cv::Mat img = (frame % 2 == 1 ? shifted : texture).clone();
+        tracker.track(img, roi, map1, frame, false, 0, 0, reco::RecognitionMethod::MultiColor);
+    };
+    CHECK(tracker.getCurrentlyTracked() == NB_PERSONS);
+}
+
+TEST_CASE("Adding recognized points to the persons", "[benchmark][tracking]")
+{
+    Petrack petrack{"Benchmark"};
+    auto      &storage   = petrack.getPersonStorage();
+    const auto positions = personPositions();
+    addPersons(storage, positions, 0);
+
+    // recognition slightly off the tracked points, as after tracking a frame
+    QList<TrackPoint> recognized;
+    for(const auto &pos : positions)
+    {
+        recognized.append(TrackPoint(Vec2F(pos.x + 1., pos.y + 1.), TrackPoint::BEST_DETECTION_QUAL));
+    }
+
+    BENCHMARK_ADVANCED("PersonStorage::addPoints, 1000 points")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<QList<TrackPoint>> points(meter.runs(), recognized);
+        meter.measure([&](int i) { storage.addPoints(points[i], 0, reco::RecognitionMethod::MultiColor); });
+    };
+    CHECK(storage.nbPersons() == NB_PERSONS);
+}
+
+TEST_CASE("Calculation of the real trajectories", "[benchmark][tracking]")
+{
+    Petrack petrack{"Benchmark"};
+    bench::openDemoProject(petrack, "04_correction/07_corrected.pet");
+    QTemporaryDir dir;
+    bench::openFrame(petrack, bench::texture(bench::DEMO_FRAME_SIZE, CV_8UC3), dir);
+    petrack.getPersonStorage().clear();
+    petrack.importTracker(bench::demoFile("04_correction/07_corrected_trajectories.trc"));
+    REQUIRE(petrack.getPersonStorage().nbPersons() > 0);
+
+    auto         *control = petrack.getControlWidget();
+    MissingFrames missingFrames{false, {}};
+    BENCHMARK("TrackerReal::calculate, demo trajectories")
+    {
+        return petrack.getTrackerReal()->calculate(
+            &petrack,
+            petrack.getTracker(),
+            &petrack.getWorldImageCorrespondence(),
+            control->getColorPlot(),
+            missingFrames,
+            petrack.getImageBorderSize(),
+            false,
+            false,
+            control->getTrackAlternateHeight(),
+            control->getCameraAltitude());
+    };
+}
@@ -0,0 +1,53 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fixtures.h"
+#include "personStorage.h"
+#include "petrack.h"
+
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Import and export of trajectories", "[benchmark][io]")
+{
+    Petrack petrack{"Benchmark"};
+    bench::openDemoProject(petrack, "04_correction/07_corrected.pet");
+    QTemporaryDir dir;
+    // the export to txt needs an image for the world coordinates
+    bench::openFrame(petrack, bench::texture(bench::DEMO_FRAME_SIZE, CV_8UC3), dir);
+
+    const QString trcFile = bench::demoFile("04_correction/07_corrected_trajectories.trc");
+    BENCHMARK("importTracker, trc")
+    {
+        petrack.getPersonStorage().clear();
+        petrack.importTracker(trcFile);
+        return petrack.getPersonStorage().nbPersons();
+    };
+    REQUIRE(petrack.getPersonStorage().nbPersons() > 0);
+
+    BENCHMARK("exportTracker, trc")
+    {
+        petrack.exportTracker(dir.filePath("exported.trc"));
+    };
+
+    BENCHMARK("exportTracker, txt")
+    {
+        petrack.exportTracker(dir.filePath("exported.txt"));
+    };
+}
@@ -0,0 +1,87 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkJsonListener.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <spdlog/spdlog.h>
+
+CATCH_REGISTER_LISTENER(BenchmarkJsonListener)
+
+std::string &BenchmarkJsonListener::outputFile()
+{
+    static std::string file;
+    return file;
+}
+
+void BenchmarkJsonListener::testCaseStarting(const Catch::TestCaseInfo &testInfo)
+{
+    mCurrentTestCase = testInfo.name;
+}
+
+void BenchmarkJsonListener::benchmarkEnded(const Catch::BenchmarkStats<> &benchmarkStats)
+{
+    mResults.push_back(
+        {benchmarkStats.info.name,
+         mCurrentTestCase,
+         benchmarkStats.mean.point.count(),
+         benchmarkStats.mean.lower_bound.count(),
+         benchmarkStats.mean.upper_bound.count(),
+         benchmarkStats.standardDeviation.point.count(),
+         benchmarkStats.info.samples,
+         benchmarkStats.info.iterations});
+}
+
+void BenchmarkJsonListener::testRunEnded(const Catch::TestRunStats & /*testRunStats*/)
+{
+    if(outputFile().empty())
+    {
+        return;
+    }
+
+    QJsonArray benchmarks;
+    for(const auto &result : mResults)
+    {
+        benchmarks.append(QJsonObject{
+            {"name", QString::fromStdString(result.name)},
+            {"testCase", QString::fromStdString(result.testCase)},
+            {"meanNs", result.meanNs},
+            {"meanLowerNs", result.meanLowerNs},
+            {"meanUpperNs", result.meanUpperNs},
+            {"stdDevNs", result.stdDevNs},
+            {"samples", static_cast<int>(result.samples)},
+            {"iterations", result.iterations}});
+    }
+    const QJsonObject root{
+        {"version", PETRACK_VERSION},
+        {"commit", GIT_COMMIT_HASH},
+        {"buildType", PETRACK_BUILD_TYPE},
+        {"benchmarks", benchmarks}};
+
+    QFile file(QString::fromStdString(outputFile()));
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        SPDLOG_ERROR("Could not write benchmark results to {}", outputFile());
+        return;
+    }
+    file.write(QJsonDocument(root).toJson());
+}
@@ -0,0 +1,66 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARKJSONLISTENER_H
+#define BENCHMARKJSONLISTENER_H
+
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Collects the results of all BENCHMARKs and writes them as JSON at the end of the run
+ *
+ * The file is only written if an output file was set (--json-out). Its format is read by
+ * scripts/compare-benchmarks.py:
+ *
+ *     {"version": ..., "commit": ..., "buildType": ...,
+ *      "benchmarks": [{"name": ..., "testCase": ..., "meanNs": ..., "meanLowerNs": ..., "meanUpperNs": ...,
+ *                      "stdDevNs": ..., "samples": ..., "iterations": ...}, ...]}
+ */
+class BenchmarkJsonListener : public Catch::EventListenerBase
+{
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    static void setOutputFile(std::string file) { outputFile() = std::move(file); }
+
+    void testCaseStarting(const Catch::TestCaseInfo &testInfo) override;
+    void benchmarkEnded(const Catch::BenchmarkStats<> &benchmarkStats) override;
+    void testRunEnded(const Catch::TestRunStats &testRunStats) override;
+
+private:
+    struct Result
+    {
+        std::string name;
+        std::string testCase;
+        double      meanNs;
+        double      meanLowerNs;
+        double      meanUpperNs;
+        double      stdDevNs;
+        unsigned    samples;
+        int         iterations;
+    };
+
+    static std::string &outputFile();
+
+    std::string         mCurrentTestCase;
+    std::vector<Result> mResults;
+};
+
+#endif // BENCHMARKJSONLISTENER_H
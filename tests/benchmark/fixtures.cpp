@@ -0,0 +1,158 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fixtures.h"
+
+#include "helper.h"
+#include "petrack.h"
+#include "recognition.h"
+#include "roiItem.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/objdetect/aruco_dictionary.hpp>
+
+namespace bench
+{
+namespace
+{
+cv::aruco::Dictionary arucoDictionary(int index)
+{
+    // 17 is DICT_mip_36h12, which is not predefined in OpenCV (see detail::findCodeMarker)
+    return index != 17 ? cv::aruco::getPredefinedDictionary(cv::aruco::PredefinedDictionaryType(index)) :
+                         reco::detail::getDictMip36h12();
+}
+
+/// draws aruco code id (modulo the dictionary size) centered at pos
+void drawCode(cv::Mat &frame, const cv::aruco::Dictionary &dictionary, int id, const cv::Point &pos, int side)
+{
+    cv::Mat code;
+    cv::aruco::generateImageMarker(dictionary, id % dictionary.bytesList.rows, side, code);
+    cv::cvtColor(code, code, cv::COLOR_GRAY2BGR);
+    const cv::Rect rect(pos.x - side / 2, pos.y - side / 2, side, side);
+    code.copyTo(frame(rect & cv::Rect({0, 0}, frame.size())));
+}
+} // namespace
+
+QString demoFile(const QString &relativePath)
+{
+    return QDir(PETRACK_DEMO_DIR).filePath(relativePath);
+}
+
+void openDemoProject(Petrack &petrack, const QString &relativePath)
+{
+    const QString file = demoFile(relativePath);
+    REQUIRE(QFile::exists(file));
+    petrack.openProject(file, false);
+}
+
+void openFrame(Petrack &petrack, const cv::Mat &frame, const QTemporaryDir &dir)
+{
+    REQUIRE(dir.isValid());
+    const QString file = dir.filePath("frame.png");
+    REQUIRE(cv::imwrite(file.toStdString(), frame));
+    petrack.openSequence(file);
+    REQUIRE_FALSE(petrack.getImageFiltered().empty());
+}
+
+QRect recognitionRoi(Petrack &petrack)
+{
+    const QRectF rect       = petrack.getRecoRoiItem()->rect();
+    const int    borderSize = petrack.getImageBorderSize();
+    return {
+        myRound(rect.x() + borderSize),
+        myRound(rect.y() + borderSize),
+        myRound(rect.width()),
+        myRound(rect.height())};
+}
+
+cv::Mat texture(const cv::Size &size, int type)
+{
+    cv::Mat texture(size, type);
+    cv::randu(texture, 0, 255);
+    cv::GaussianBlur(texture, texture, {0, 0}, 2);
+    return texture;
+}
+
+cv::Mat identityMap(const cv::Size &size)
+{
+    cv::Mat map(size, CV_16SC2);
+    for(int y = 0; y < size.height; ++y)
+    {
+        for(int x = 0; x < size.width; ++x)
+        {
+            map.at<cv::Vec2s>(y, x) = cv::Vec2s(static_cast<short>(x), static_cast<short>(y));
+        }
+    }
+    return map;
+}
+
+std::vector<cv::Point> gridPositions(const cv::Rect &rect, int spacing, int count)
+{
+    std::vector<cv::Point> positions;
+    for(int y = rect.y + spacing / 2; y < rect.y + rect.height && static_cast<int>(positions.size()) < count;
+        y += spacing)
+    {
+        for(int x = rect.x + spacing / 2; x < rect.x + rect.width && static_cast<int>(positions.size()) < count;
+            x += spacing)
+        {
+            positions.emplace_back(x, y);
+        }
+    }
+    return positions;
+}
+
+cv::Mat multiColorFrame(const cv::Size &size, const std::vector<cv::Point> &positions, int radius, int dictionary)
+{
+    cv::Mat    frame(size, CV_8UC3, cv::Scalar(120, 120, 120));
+    const auto codes = arucoDictionary(dictionary);
+    for(size_t i = 0; i < positions.size(); ++i)
+    {
+        // hue 0, saturation 210, value 230, inside of the color map of the multicolor demo project
+        cv::circle(frame, positions[i], radius, cv::Scalar(40, 40, 230), cv::FILLED, cv::LINE_AA);
+        drawCode(frame, codes, static_cast<int>(i), positions[i], radius);
+    }
+    return frame;
+}
+
+cv::Mat codeMarkerFrame(const cv::Size &size, const std::vector<cv::Point> &positions, int side, int dictionary)
+{
+    cv::Mat    frame(size, CV_8UC3, cv::Scalar(255, 255, 255));
+    const auto codes = arucoDictionary(dictionary);
+    for(size_t i = 0; i < positions.size(); ++i)
+    {
+        drawCode(frame, codes, static_cast<int>(i), positions[i], side);
+    }
+    return frame;
+}
+
+cv::Mat contourFrame(const cv::Size &size, const std::vector<cv::Point> &positions, int radius)
+{
+    cv::Mat frame(size, CV_8UC3, cv::Scalar(200, 200, 200));
+    for(const auto &pos : positions)
+    {
+        cv::ellipse(frame, pos, {radius, radius * 4 / 5}, 0, 0, 360, cv::Scalar(30, 30, 30), cv::FILLED, cv::LINE_AA);
+        cv::circle(frame, pos, radius / 4, cv::Scalar(250, 250, 250), cv::FILLED, cv::LINE_AA);
+    }
+    return frame;
+}
+} // namespace bench
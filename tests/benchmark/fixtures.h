@@ -0,0 +1,72 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_FIXTURES_H
+#define BENCHMARK_FIXTURES_H
+
+#include <QRect>
+#include <QString>
+#include <opencv2/core.hpp>
+#include <vector>
+
+class Petrack;
+class QTemporaryDir;
+
+/**
+ * @brief Synthetic frames and demo data for the benchmarks
+ *
+ * The demo projects are used for their calibration and recognition settings. Their video is stored with git lfs and
+ * is not needed: the frames are drawn synthetically in the size of the demo video.
+ */
+namespace bench
+{
+/// size of the video of the demo projects
+inline const cv::Size DEMO_FRAME_SIZE{4000, 3000};
+
+/// absolute path of a file relative to the demo directory of the source tree
+QString demoFile(const QString &relativePath);
+
+/// opens the demo project without its video
+void openDemoProject(Petrack &petrack, const QString &relativePath);
+
+/// writes frame as image into dir and opens it as the sequence of petrack
+void openFrame(Petrack &petrack, const cv::Mat &frame, const QTemporaryDir &dir);
+
+/// recognition ROI in the image with border, as used by Petrack
+QRect recognitionRoi(Petrack &petrack);
+
+/// blurred noise, which gives the KLT tracker features everywhere
+cv::Mat texture(const cv::Size &size, int type = CV_8UC1);
+
+/// identity undistortion map as created by CalibFilter for a camera without distortion
+cv::Mat identityMap(const cv::Size &size);
+
+/// first count positions on a grid with the given spacing inside rect
+std::vector<cv::Point> gridPositions(const cv::Rect &rect, int spacing, int count);
+
+/// gray frame with red hats with an aruco code of the given dictionary at each position
+cv::Mat multiColorFrame(const cv::Size &size, const std::vector<cv::Point> &positions, int radius, int dictionary);
+
+/// white frame with aruco codes of the given dictionary at each position
+cv::Mat codeMarkerFrame(const cv::Size &size, const std::vector<cv::Point> &positions, int side, int dictionary);
+
+/// light frame with dark heads with a bright center at each position
+cv::Mat contourFrame(const cv::Size &size, const std::vector<cv::Point> &positions, int radius);
+} // namespace bench
+
+#endif // BENCHMARK_FIXTURES_H
@@ -0,0 +1,60 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkJsonListener.h"
+#include "logger.h"
+
+#include <QApplication>
+#include <algorithm>
+#include <catch2/catch_session.hpp>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+    // always run the benchmarks offscreen, so PMessageBox-es only log
+    auto args = std::vector<char *>(argv, argv + argc);
+    if(std::none_of(args.begin(), args.end(), [](const char *arg) { return qstrcmp("-platform", arg) == 0; }))
+    {
+        args.push_back(const_cast<char *>("-platform"));
+        args.push_back(const_cast<char *>("offscreen"));
+    }
+    int argc2 = static_cast<int>(args.size());
+
+    logger::setupLogger();
+    // the hot paths log per call, which would be part of the measurement
+    spdlog::set_level(spdlog::level::warn);
+
+    QApplication a(argc2, args.data());
+
+    Catch::Session session;
+    std::string    jsonFile;
+    using Catch::Clara::Opt;
+    session.cli(
+        session.cli() |
+        Opt(jsonFile, "file")["--json-out"]("write the benchmark results as JSON to this file"));
+
+    if(const int result = session.applyCommandLine(argc2, args.data()); result != 0)
+    {
+        return result;
+    }
+    BenchmarkJsonListener::setOutputFile(jsonFile);
+
+    const int result = session.run();
+    return (result < 0xff ? result : 0xff);
+}
@@ -19,6 +19,7 @@
 #include "skeletonTree.h"
 #include "skeletonTreeFactory.h"
 
+#include <array>
 #include <catch2/catch_test_macros.hpp>
 
 const XSenseStruct XSENSE_DUMMY_DATA = {
@@ -202,3 +203,46 @@ TEST_CASE("SkeletonTree for XSenseData is built")
         }
     }
 }
+
+TEST_CASE("SkeletonTree can be stored as flat joints")
+{
+    SkeletonTree skel = SkeletonTreeFactory::generateTree(XSENSE_DUMMY_DATA);
+
+    SECTION("Topology and joints are in the order of the lines")
+    {
+        const auto topology = skel.getTopology();
+        const auto joints   = skel.getJoints();
+        const auto lines    = skel.getLines();
+        REQUIRE(topology == SkeletonTreeFactory::xsenseTopology());
+        REQUIRE(joints.size() == topology.getJointCount());
+        REQUIRE(topology.mParents[0] == -1);
+        REQUIRE(lines.size() + 1 == topology.getJointCount());
+        for(size_t i = 0; i < lines.size(); ++i)
+        {
+            const size_t joint = i + 1;
+            REQUIRE(lines[i].start_id == topology.mIds[topology.mParents[joint]]);
+            REQUIRE(lines[i].end_id == topology.mIds[joint]);
+            REQUIRE(lines[i].start == joints[topology.mParents[joint]]);
+            REQUIRE(lines[i].end == joints[joint]);
+        }
+        REQUIRE(topology.findJoint(19, 2) == 3);
+        REQUIRE(topology.findJoint(2, 19) == -1);
+    }
+
+    SECTION("A skeleton is rebuilt from its joints")
+    {
+        std::array<cv::Point3f, SkeletonTreeFactory::XSENSE_JOINT_COUNT> joints;
+        SkeletonTreeFactory::generateJoints(XSENSE_DUMMY_DATA, joints);
+        REQUIRE(std::vector<cv::Point3f>(joints.begin(), joints.end()) == skel.getJoints());
+
+        SkeletonTree rebuilt =
+            SkeletonTree::fromJoints(skel.getTopology(), joints, skel.getHeadDir(), skel.getRotationCenter());
+        REQUIRE(rebuilt.getTopology() == skel.getTopology());
+        REQUIRE(rebuilt.getJoints() == skel.getJoints());
+        REQUIRE(rebuilt.getHeadDir() == skel.getHeadDir());
+        REQUIRE(rebuilt.getRotationCenter() == skel.getRotationCenter());
+
+        REQUIRE_THROWS(
+            SkeletonTree::fromJoints(skel.getTopology(), std::span(joints).first(3), skel.getHeadDir(), {0, 0, 0}));
+    }
+}
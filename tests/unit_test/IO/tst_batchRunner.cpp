@@ -0,0 +1,142 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "batchRunner.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+void writeFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file{fileName};
+    REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    file.write(content);
+}
+
+QByteArray project(const QString &fx, const QString &modelFile)
+{
+    return QString(R"(<PETRACK><CONTROL><CALIBRATION><INTRINSIC_PARAMETERS FX="%1" FY="881">)"
+                   R"(<OLD_MODEL K1="0"/></INTRINSIC_PARAMETERS></CALIBRATION></CONTROL>)"
+                   R"(<YOLO_MARKER><PARAMS MODEL_FILE="%2"/></YOLO_MARKER></PETRACK>)")
+        .arg(fx, modelFile)
+        .toUtf8();
+}
+} // namespace
+
+TEST_CASE("batch runner", "[io][batch]")
+{
+    QTemporaryDir tmpDir;
+    REQUIRE(tmpDir.isValid());
+    const QDir dir{tmpDir.path()};
+
+    SECTION("expandProjectPatterns")
+    {
+        writeFile(dir.filePath("b.pet"), project("1", "m.onnx"));
+        writeFile(dir.filePath("a.pet"), project("1", "m.onnx"));
+        writeFile(dir.filePath("c.txt"), "");
+        writeFile(dir.filePath("list.txt"), "# comment\n\nz.pet\n*.pet\n");
+
+        CHECK(
+            batch::expandProjectPatterns({dir.filePath("*.pet")}) ==
+            QStringList{dir.filePath("a.pet"), dir.filePath("b.pet")});
+        // order of the arguments is kept, duplicates are removed
+        CHECK(
+            batch::expandProjectPatterns({dir.filePath("list.txt"), dir.filePath("a.pet")}) ==
+            QStringList{dir.filePath("z.pet"), dir.filePath("a.pet"), dir.filePath("b.pet")});
+        CHECK(batch::expandProjectPatterns({dir.filePath("*.unknown")}).isEmpty());
+    }
+
+    SECTION("settingsKey")
+    {
+        writeFile(dir.filePath("a.pet"), project("1", "m.onnx"));
+        writeFile(dir.filePath("b.pet"), project("1", "m.onnx"));
+        writeFile(dir.filePath("c.pet"), project("2", "m.onnx"));
+        writeFile(dir.filePath("d.pet"), project("1", "other.onnx"));
+
+        const auto key = batch::settingsKey(dir.filePath("a.pet"));
+        CHECK_FALSE(key.isEmpty());
+        CHECK(batch::settingsKey(dir.filePath("b.pet")) == key);
+        CHECK(batch::settingsKey(dir.filePath("c.pet")) != key);
+        CHECK(batch::settingsKey(dir.filePath("d.pet")) != key);
+        CHECK(batch::settingsKey(dir.filePath("missing.pet")).isEmpty());
+    }
+
+    SECTION("scheduleProjects")
+    {
+        const QStringList projects{"a1", "b1", "a2", "a3", "b2", "c1"};
+        const QStringList keys{"a", "b", "a", "a", "b", "c"};
+
+        SECTION("single worker keeps groups together")
+        {
+            const auto workers = batch::scheduleProjects(projects, keys, 1);
+            REQUIRE(workers.size() == 1);
+            CHECK(workers[0] == QStringList{"a1", "a2", "a3", "b1", "b2", "c1"});
+        }
+
+        SECTION("groups are not spread over workers")
+        {
+            const auto workers = batch::scheduleProjects(projects, keys, 2);
+            REQUIRE(workers.size() == 2);
+            CHECK(workers[0] == QStringList{"a1", "a2", "a3"});
+            CHECK(workers[1] == QStringList{"b1", "b2", "c1"});
+        }
+
+        SECTION("large groups are split")
+        {
+            const auto workers = batch::scheduleProjects(projects, QStringList(projects.size(), "same"), 3);
+            REQUIRE(workers.size() == 3);
+            for(const auto &worker : workers)
+            {
+                CHECK(worker.size() == 2);
+            }
+        }
+
+        SECTION("no idle workers")
+        {
+            CHECK(batch::scheduleProjects({"a1", "b1"}, {"a", "b"}, 8).size() == 2);
+        }
+    }
+
+    SECTION("ProjectResult json roundtrip")
+    {
+        batch::ProjectResult result;
+        result.project        = "a.pet";
+        result.trackerFile    = "a.trc";
+        result.success        = true;
+        result.worker         = 2;
+        result.frames         = 100;
+        result.trackedPersons = 7;
+        result.trackSeconds   = 2.5;
+
+        const auto json = result.toJson();
+        CHECK(json.value("framesPerSecond").toDouble() == 40.);
+
+        const auto read = batch::ProjectResult::fromJson(json);
+        CHECK(read.project == result.project);
+        CHECK(read.trackerFile == result.trackerFile);
+        CHECK(read.success);
+        CHECK(read.worker == 2);
+        CHECK(read.frames == 100);
+        CHECK(read.trackedPersons == 7);
+        CHECK(read.trackSeconds == 2.5);
+    }
+}
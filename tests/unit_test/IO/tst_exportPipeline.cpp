@@ -0,0 +1,122 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "exportPipeline.h"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ExportPipeline executes all jobs", "[io]")
+{
+    std::atomic<int> executed = 0;
+    ExportPipeline   pipeline(4, 2);
+    for(int i = 0; i < 100; ++i)
+    {
+        REQUIRE(pipeline.enqueue(
+            [&executed]
+            {
+                ++executed;
+                return true;
+            },
+            QString::number(i)));
+    }
+    CHECK(pipeline.finish());
+    CHECK(executed == 100);
+    CHECK(pipeline.completedJobs() == 100);
+    CHECK(pipeline.jobsPerSecond() > 0);
+    CHECK_FALSE(pipeline.enqueue([] { return true; }, "after finish"));
+}
+
+TEST_CASE("ExportPipeline with one worker keeps the order", "[io]")
+{
+    std::vector<int> order;
+    ExportPipeline   pipeline(1, 3);
+    for(int i = 0; i < 50; ++i)
+    {
+        pipeline.enqueue(
+            [&order, i]
+            {
+                order.push_back(i);
+                return true;
+            },
+            QString::number(i));
+    }
+    REQUIRE(pipeline.finish());
+    REQUIRE(order.size() == 50);
+    for(int i = 0; i < 50; ++i)
+    {
+        CHECK(order[i] == i);
+    }
+}
+
+TEST_CASE("ExportPipeline bounds the number of waiting jobs", "[io]")
+{
+    constexpr std::size_t maxQueued = 3;
+    std::mutex            gate;
+    std::atomic<int>      enqueued = 0;
+    std::atomic<int>      started  = 0;
+
+    std::unique_lock closed(gate);
+    ExportPipeline   pipeline(1, maxQueued);
+    std::thread      producer(
+        [&]
+        {
+            for(int i = 0; i < 10; ++i)
+            {
+                pipeline.enqueue(
+                    [&]
+                    {
+                        ++started;
+                        std::lock_guard wait(gate);
+                        return true;
+                    },
+                    QString::number(i));
+                ++enqueued;
+            }
+        });
+
+    // the worker blocks in the first job, so only maxQueued further jobs fit into the queue
+    while(started == 0 || enqueued < static_cast<int>(maxQueued) + 1)
+    {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(enqueued == static_cast<int>(maxQueued) + 1);
+
+    closed.unlock();
+    producer.join();
+    CHECK(pipeline.finish());
+    CHECK(pipeline.completedJobs() == 10);
+}
+
+TEST_CASE("ExportPipeline reports the first failed job", "[io]")
+{
+    ExportPipeline pipeline(1, 4);
+    pipeline.enqueue([] { return true; }, "frame0.png");
+    pipeline.enqueue([] { return false; }, "frame1.png");
+    pipeline.enqueue([] { return false; }, "frame2.png");
+
+    CHECK_FALSE(pipeline.finish());
+    CHECK(pipeline.failed());
+    CHECK(pipeline.failedJob() == "frame1.png");
+    CHECK(pipeline.completedJobs() == 1);
+}
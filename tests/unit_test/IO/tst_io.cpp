@@ -16,9 +16,13 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "c3dPointReader.h"
 #include "moCapPerson.h"
 #include "pIO.h"
+#include "trackPerson.h"
 
+#include <QTemporaryDir>
+#include <array>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
@@ -618,5 +622,131 @@ SCENARIO("I want to read a XSens c3d file", "[io]")
                 REQUIRE(root.getChildById(1).getPos() == cv::Point3f(15, 15, 15)); // pC7SpinalProcess point[15]
             }
         }
+
+        AND_GIVEN("I write that c3d-file to disk")
+        {
+            QTemporaryDir dir;
+            REQUIRE(dir.isValid());
+            const QString fileName = dir.filePath("xsens.c3d");
+            c3d.write(fileName.toStdString());
+
+            THEN("the points are streamed from the file")
+            {
+                auto reader = C3dPointReader::open(fileName);
+                REQUIRE(std::holds_alternative<C3dPointReader>(reader));
+                const auto &pointReader = std::get<C3dPointReader>(reader);
+                REQUIRE(pointReader.getPointCount() == numPoints);
+                REQUIRE(pointReader.getFrameCount() == 10);
+                REQUIRE(pointReader.getUnit() == "cm");
+
+                const std::array<size_t, 3> points{86, 0, 15};
+                size_t                      frames      = 0;
+                const auto                  checkPoints = [&](size_t frame, std::span<const cv::Point3f> framePoints)
+                {
+                    REQUIRE(frame == frames++);
+                    REQUIRE(framePoints.size() == points.size());
+                    REQUIRE(framePoints[0] == cv::Point3f(86, 86, 86));
+                    REQUIRE(framePoints[1] == cv::Point3f(0, 0, 0));
+                    REQUIRE(framePoints[2] == cv::Point3f(15, 15, 15));
+                    return true;
+                };
+                REQUIRE_FALSE(pointReader.readFrames(points, checkPoints));
+                REQUIRE(frames == 10);
+
+                // points behind the last point of the file
+                const std::array<size_t, 1> missingPoint{numPoints};
+                REQUIRE(pointReader.readFrames(missingPoint, checkPoints));
+                REQUIRE(frames == 10);
+            }
+
+            THEN("the person read from the file has the same skeletons as the one read with ezc3d")
+            {
+                MoCapPersonMetadata metadata;
+                metadata.setFilepath(fileName.toStdString(), XSensC3D);
+                metadata.setSamplerate(60);
+                auto result = IO::readMoCapC3D(metadata);
+                REQUIRE(std::holds_alternative<MoCapPerson>(result));
+                const auto &person = std::get<MoCapPerson>(result);
+
+                MoCapPerson ezc3dPerson;
+                IO::readSkeletonC3D_XSENS(
+                    c3d,
+                    ezc3dPerson,
+                    [](const ezc3d::DataNS::Points3dNS::Point &point)
+                    {
+                        return cv::Point3f{
+                            static_cast<float>(point.x()),
+                            static_cast<float>(point.y()),
+                            static_cast<float>(point.z())};
+                    });
+
+                REQUIRE(person.getSampleCount() == 10);
+                REQUIRE(person.getTopology() == ezc3dPerson.getTopology());
+                for(size_t sample = 0; sample < person.getSampleCount(); ++sample)
+                {
+                    const auto joints      = person.getJoints(sample);
+                    const auto ezc3dJoints = ezc3dPerson.getJoints(sample);
+                    REQUIRE(std::equal(joints.begin(), joints.end(), ezc3dJoints.begin(), ezc3dJoints.end()));
+                }
+            }
+        }
+
+        AND_GIVEN("a file which is no c3d-file")
+        {
+            QTemporaryDir dir;
+            REQUIRE(dir.isValid());
+            const QString fileName = dir.filePath("broken.c3d");
+            std::ofstream(fileName.toStdString()) << "no c3d";
+
+            THEN("it cannot be streamed")
+            {
+                REQUIRE(std::holds_alternative<std::string>(C3dPointReader::open(fileName)));
+            }
+        }
+    }
+}
+
+TEST_CASE("IO::readTrcFile", "[tracking][io]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("tracks.trc");
+    const auto    method   = reco::RecognitionMethod::MultiColor;
+
+    SECTION("could not open file")
+    {
+        REQUIRE(std::holds_alternative<std::string>(IO::readTrcFile(dir.filePath("missing.trc"), method)));
+    }
+
+    SECTION("empty file")
+    {
+        std::ofstream(fileName.toStdString()).close();
+        auto result = IO::readTrcFile(fileName, method);
+        REQUIRE(std::holds_alternative<std::string>(result));
+        REQUIRE_THAT(std::get<std::string>(result), Catch::Matchers::EndsWith("is empty"));
+    }
+
+    SECTION("unsupported version")
+    {
+        std::ofstream(fileName.toStdString()) << "version 9\n0\n";
+        auto result = IO::readTrcFile(fileName, method);
+        REQUIRE(std::holds_alternative<std::string>(result));
+        REQUIRE_THAT(std::get<std::string>(result), Catch::Matchers::StartsWith("Not supported trc version"));
+    }
+
+    SECTION("missing person")
+    {
+        std::ofstream(fileName.toStdString()) << "version 4\n1\n";
+        auto result = IO::readTrcFile(fileName, method);
+        REQUIRE(std::holds_alternative<std::string>(result));
+        REQUIRE_THAT(std::get<std::string>(result), Catch::Matchers::StartsWith("Error parsing person 1 of 1"));
+    }
+
+    SECTION("no persons")
+    {
+        std::ofstream(fileName.toStdString()) << "version 4\n0\n";
+        auto result = IO::readTrcFile(fileName, method);
+        REQUIRE(std::holds_alternative<std::vector<TrackPerson>>(result));
+        REQUIRE(std::get<std::vector<TrackPerson>>(result).empty());
     }
 }
@@ -0,0 +1,280 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "projectFile.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QXmlStreamWriter>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+QDomDocument project(int frame, const QString &version = "1.3")
+{
+    QDomDocument doc("PETRACK");
+    QDomElement  root = doc.createElement("PETRACK");
+    root.setAttribute("VERSION", version);
+    doc.appendChild(root);
+
+    QDomElement main = doc.createElement("MAIN");
+    main.setAttribute("SRC", "video.mp4");
+    main.setAttribute("STATUS_HEIGHT", 180);
+    root.appendChild(main);
+
+    QDomElement control = doc.createElement("CONTROL");
+    QDomElement calib   = doc.createElement("CALIBRATION");
+    calib.setAttribute("ENABLED", 1);
+    calib.setAttribute("COMMENT", "line\nbreak");
+    control.appendChild(calib);
+    root.appendChild(control);
+
+    QDomElement player = doc.createElement("PLAYER");
+    player.setAttribute("FRAME", frame);
+    root.appendChild(player);
+    return doc;
+}
+
+/// project with the structure of a saved .pet file, including values which have to be escaped
+QDomDocument realisticProject()
+{
+    QDomDocument doc("PETRACK");
+    QDomElement  root = doc.createElement("PETRACK");
+    root.setAttribute("VERSION", "1.3.0");
+    doc.appendChild(root);
+
+    QDomElement main = doc.createElement("MAIN");
+    main.setAttribute("SRC", "C:/videos/<run 1> & \"crowd\".mp4");
+    main.setAttribute("STATUS_HEIGHT", 180.5);
+    main.setAttribute("HEIGHT_SOURCE", QString::fromUtf8("H\xc3\xb6he"));
+    root.appendChild(main);
+
+    QDomElement control = doc.createElement("CONTROL");
+    control.setAttribute("TAB", 1);
+    for(const char *name : {"CALIBRATION", "RECOGNITION", "TRACKING"})
+    {
+        QDomElement section = doc.createElement(name);
+        // attributes are added unsorted and sorted when written
+        section.setAttribute("Z_VALUE", -1.25);
+        section.setAttribute("ENABLED", 1);
+        section.setAttribute("COMMENT", "tab\tand\nnewline");
+        for(int i = 0; i < 3; ++i)
+        {
+            QDomElement child = doc.createElement(QString("PARAM_%1").arg(i));
+            child.setAttribute("VALUE", i * 0.1);
+            QDomElement grandChild = doc.createElement("RANGE");
+            grandChild.setAttribute("FROM", -i);
+            grandChild.setAttribute("TO", i);
+            child.appendChild(grandChild);
+            section.appendChild(child);
+        }
+        control.appendChild(section);
+    }
+    root.appendChild(control);
+
+    root.appendChild(doc.createElement("STEREO"));
+
+    QDomElement player = doc.createElement("PLAYER");
+    player.setAttribute("FRAME", 1234);
+    player.setAttribute("FPS", 25.);
+    root.appendChild(player);
+
+    QDomElement missing = doc.createElement("MISSING_FRAMES");
+    for(int frame : {10, 20})
+    {
+        QDomElement elem = doc.createElement("FRAME");
+        elem.setAttribute("NUM_FRAME", frame);
+        elem.setAttribute("NUM_MISSING", 1);
+        missing.appendChild(elem);
+    }
+    root.appendChild(missing);
+    return doc;
+}
+
+/// Petrack::writeXmlElement as used to write .pet files before ProjectFile
+void writeXmlElementBaseline(QXmlStreamWriter &xmlStream, QDomElement element)
+{
+    xmlStream.writeStartElement(element.tagName());
+
+    QVector<QString>       attribute_names;
+    const QDomNamedNodeMap attributes = element.attributes();
+    for(int i = 0; i < attributes.size(); ++i)
+    {
+        attribute_names.push_back(attributes.item(i).toAttr().name());
+    }
+
+    std::stable_sort(attribute_names.begin(), attribute_names.end()); // for a canonical XML
+
+    for(const QString &name : attribute_names)
+    {
+        QDomAttr attr = element.attributeNode(name);
+        xmlStream.writeAttribute(attr.name(), attr.value());
+    }
+
+    // order of child nodes is defined at creation
+    if(element.hasChildNodes())
+    {
+        const QDomNodeList children = element.childNodes();
+        for(int i = 0; i < children.size(); ++i)
+        {
+            writeXmlElementBaseline(xmlStream, children.at(i).toElement());
+        }
+    }
+
+    xmlStream.writeEndElement();
+}
+
+/// content as written by Petrack::saveProject before ProjectFile
+QByteArray writeBaseline(const QDomDocument &doc)
+{
+    QByteArray       byteArray;
+    QXmlStreamWriter xmlStream(&byteArray);
+    xmlStream.setAutoFormatting(true);
+    xmlStream.setAutoFormattingIndent(4);
+
+    xmlStream.writeStartDocument();
+    xmlStream.writeDTD("<!DOCTYPE PETRACK>");
+
+    QDomElement element = doc.documentElement();
+    writeXmlElementBaseline(xmlStream, element);
+
+    xmlStream.writeEndDocument();
+    return byteArray;
+}
+
+/// content as written by writing the whole document at once
+QByteArray writeAtOnce(const QDomDocument &doc)
+{
+    QByteArray       byteArray;
+    QXmlStreamWriter xmlStream(&byteArray);
+    xmlStream.setAutoFormatting(true);
+    xmlStream.setAutoFormattingIndent(4);
+    xmlStream.writeStartDocument();
+    xmlStream.writeDTD("<!DOCTYPE PETRACK>");
+    ProjectFile::writeElement(xmlStream, doc.documentElement());
+    xmlStream.writeEndDocument();
+    return byteArray;
+}
+} // namespace
+
+TEST_CASE("ProjectFile assembles the same content as a complete write", "[io]")
+{
+    ProjectFile projectFile;
+    const auto  doc = project(42);
+
+    CHECK(projectFile.update(doc) == QStringList{"MAIN", "CONTROL", "PLAYER"});
+    CHECK(projectFile.content() == writeAtOnce(doc));
+
+    QDomDocument parsed;
+    REQUIRE(parsed.setContent(projectFile.content()));
+    CHECK(parsed.documentElement().firstChildElement("CONTROL").firstChildElement("CALIBRATION").attribute(
+              "COMMENT") == "line\nbreak");
+}
+
+TEST_CASE("ProjectFile writes the same file as the previous project writer", "[io]")
+{
+    ProjectFile projectFile;
+
+    SECTION("realistic project")
+    {
+        const auto doc = realisticProject();
+        projectFile.update(doc);
+        CHECK(projectFile.content() == writeBaseline(doc));
+    }
+
+    SECTION("after updating single sections")
+    {
+        projectFile.update(realisticProject());
+
+        auto doc = realisticProject();
+        doc.documentElement().firstChildElement("PLAYER").setAttribute("FRAME", 1235);
+        doc.documentElement().firstChildElement("STEREO").setAttribute("ENABLED", 0);
+        CHECK(projectFile.update(doc) == QStringList{"STEREO", "PLAYER"});
+        CHECK(projectFile.content() == writeBaseline(doc));
+    }
+
+    SECTION("small project")
+    {
+        const auto doc = project(42);
+        projectFile.update(doc);
+        CHECK(projectFile.content() == writeBaseline(doc));
+    }
+}
+
+TEST_CASE("ProjectFile only changes modified sections", "[io]")
+{
+    ProjectFile projectFile;
+    projectFile.update(project(42));
+    const auto revision = projectFile.revision();
+
+    SECTION("unchanged project")
+    {
+        CHECK(projectFile.update(project(42)).isEmpty());
+        CHECK(projectFile.revision() == revision);
+    }
+
+    SECTION("changed section")
+    {
+        CHECK(projectFile.update(project(43)) == QStringList{"PLAYER"});
+        CHECK(projectFile.revision() == revision + 1);
+        CHECK(projectFile.content() == writeAtOnce(project(43)));
+    }
+
+    SECTION("changed root element")
+    {
+        CHECK(projectFile.update(project(42, "1.4")).size() == 3);
+        CHECK(projectFile.content() == writeAtOnce(project(42, "1.4")));
+    }
+
+    SECTION("removed section")
+    {
+        auto doc = project(42);
+        doc.documentElement().removeChild(doc.documentElement().firstChildElement("PLAYER"));
+        CHECK(projectFile.update(doc).isEmpty());
+        CHECK(projectFile.revision() == revision + 1);
+        CHECK(projectFile.content() == writeAtOnce(doc));
+    }
+}
+
+TEST_CASE("ProjectFile skips writing unchanged projects", "[io]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("project.pet");
+
+    ProjectFile projectFile;
+    projectFile.update(project(42));
+    CHECK_FALSE(projectFile.isWritten(fileName));
+    REQUIRE(projectFile.write(fileName));
+    CHECK(projectFile.isWritten(fileName));
+
+    QFile file(fileName);
+    REQUIRE(file.open(QFile::ReadOnly | QFile::Text));
+    CHECK(file.readAll() == projectFile.content());
+    file.close();
+
+    projectFile.update(project(42));
+    CHECK(projectFile.isWritten(fileName));
+
+    projectFile.update(project(43));
+    CHECK_FALSE(projectFile.isWritten(fileName));
+
+    QFile::remove(fileName);
+    projectFile.update(project(42));
+    CHECK_FALSE(projectFile.isWritten(fileName));
+}
@@ -24,6 +24,8 @@
 
 #include <QColor>
 #include <catch2/catch_test_macros.hpp>
+#include <tuple>
+#include <vector>
 
 using namespace annotationGroups;
 
@@ -318,3 +320,108 @@ TEST_CASE("deleting group cleans up assignments", "[grouping]")
     CHECK(0 == manager.getGroupsOfTlg(0).size());
     CHECK(NO_GROUP.id == petrack.getPersonStorage().getGroupList(0).getValue(0));
 }
+
+namespace
+{
+/// group entries found by scanning all group lists, as reference for the group index
+std::vector<std::tuple<int, int, int>> scanTrajectoriesOfGroup(const PersonStorage &personStorage, int groupId)
+{
+    std::vector<std::tuple<int, int, int>> result;
+    for(size_t i = 0; i < personStorage.nbPersons(); ++i)
+    {
+        const auto &entries = personStorage.getGroupList(i).getEntries();
+        for(size_t k = 0; k < entries.size(); ++k)
+        {
+            if(entries[k].data == groupId)
+            {
+                const int end = k + 1 < entries.size() ? entries[k + 1].start - 1 : -1;
+                result.emplace_back((int) i, entries[k].start, end);
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<std::tuple<int, int, int>> toTuples(const std::vector<TrajectoryGroupEntry> &entries)
+{
+    std::vector<std::tuple<int, int, int>> result;
+    for(const auto &entry : entries)
+    {
+        result.emplace_back(entry.trackPersonId, entry.frameBegin, entry.frameEnd);
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("group index follows changes of the trajectories", "[grouping]")
+{
+    Petrack                petrack{"grouping Test"};
+    auto                  &personStorage = petrack.getPersonStorage();
+    AnnotationGroupManager manager{petrack, *petrack.getAnimation(), personStorage};
+
+    const int groupOneId = manager.createGroup({"one", "type 1"});
+    const int groupTwoId = manager.createGroup({"two", "type 2"});
+
+    for(int i = 0; i < 4; ++i)
+    {
+        TrackPerson person(i + 1, 0, TrackPoint{{0., 10. * i}});
+        REQUIRE(person.insertAtFrame(20, TrackPoint{{20., 10. * i}}, i + 1, true, true));
+        personStorage.addPerson(person);
+    }
+
+    REQUIRE(manager.addTrajectoryToGroup(0, groupOneId, 0));
+    REQUIRE(manager.addTrajectoryToGroup(0, groupTwoId, 10));
+    REQUIRE(manager.addTrajectoryToGroup(1, groupOneId, 5));
+    REQUIRE(manager.addTrajectoryToGroup(2, groupTwoId, 0));
+
+    auto checkIndex = [&]()
+    {
+        for(const int groupId : {groupOneId, groupTwoId, NO_GROUP.id})
+        {
+            const auto expected = scanTrajectoriesOfGroup(personStorage, groupId);
+            CHECK(expected == toTuples(manager.getTrajectoriesOfGroup(groupId)));
+            CHECK(expected.size() == manager.getTrajectoryCountOfGroup(groupId));
+        }
+    };
+
+    checkIndex();
+    CHECK(2 == manager.getTrajectoryCountOfGroup(groupOneId));
+
+    SECTION("split")
+    {
+        personStorage.splitPerson(0, 15);
+        REQUIRE(5 == personStorage.nbPersons());
+        checkIndex();
+        CHECK(3 == manager.getTrajectoryCountOfGroup(groupTwoId));
+    }
+
+    SECTION("delete and undo")
+    {
+        personStorage.delPointOf(1, PersonStorage::TrajectorySegment::Whole, 0);
+        REQUIRE(3 == personStorage.nbPersons());
+        checkIndex();
+        CHECK(1 == manager.getTrajectoryCountOfGroup(groupOneId));
+
+        personStorage.undo();
+        checkIndex();
+        CHECK(2 == manager.getTrajectoryCountOfGroup(groupOneId));
+    }
+
+    SECTION("several trajectories at once")
+    {
+        const auto failed = manager.addTrajectoriesToGroup({1, 3, 7}, groupTwoId);
+        CHECK(std::vector<size_t>{7} == failed);
+        checkIndex();
+
+        manager.addTrajectoriesToGroup({0, 1}, NO_GROUP.id);
+        checkIndex();
+    }
+
+    SECTION("delete group")
+    {
+        manager.deleteGroup(groupTwoId);
+        checkIndex();
+        CHECK(0 == manager.getTrajectoryCountOfGroup(groupTwoId));
+        CHECK(2 == manager.getTrajectoryCountOfGroup(groupOneId));
+    }
+}
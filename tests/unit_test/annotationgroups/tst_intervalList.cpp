@@ -21,6 +21,8 @@
 #include "logger.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <utility>
+#include <vector>
 
 TEST_CASE("src/groups/intervalList", "[groups]")
 {
@@ -266,3 +268,43 @@ TEST_CASE("src/groups/intervalList", "[groups]")
         REQUIRE_THROWS(list.getEntry(0));
     }
 }
+
+TEST_CASE("src/groups/intervalList insert in arbitrary order", "[groups]")
+{
+    int               undefValue = 0;
+    IntervalList<int> list{undefValue};
+
+    const std::vector<std::pair<int, int>> inserts = {
+        {50, 1}, {70, 2}, {60, 2}, {55, 3}, {20, 1}, {90, 1}, {60, 1}, {55, 1}};
+    for(const auto &[pos, value] : inserts)
+    {
+        list.insert(pos, value);
+
+        // entries stay sorted and compact
+        const auto &entries = list.getEntries();
+        for(size_t k = 1; k < entries.size(); ++k)
+        {
+            CHECK(entries[k - 1].start < entries[k].start);
+            CHECK(entries[k - 1].data != entries[k].data);
+        }
+    }
+    // all intervals got the same value and collapsed into one
+    REQUIRE(1 == list.size());
+    CHECK(20 == list.getMinimum());
+
+    list.insert(70, 3);
+    list.insert(30, undefValue);
+    list.insert(40, 3); // merges with the interval starting at 70
+    list.insert(20, 3);
+
+    REQUIRE(3 == list.size());
+    CHECK(-1 == list.indexOf(19));
+    CHECK(0 == list.indexOf(20));
+    CHECK(1 == list.indexOf(35));
+    CHECK(2 == list.indexOf(1000));
+    CHECK(undefValue == list.getValue(19));
+    CHECK(3 == list.getValue(29));
+    CHECK(undefValue == list.getValue(30));
+    CHECK(3 == list.getValue(40));
+    CHECK(3 == list.getValue(70));
+}
@@ -0,0 +1,103 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "walkAreaField.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+using namespace walkarea;
+
+namespace
+{
+Polygon square(int id, PolygonType type, double min, double max)
+{
+    return Polygon(id, type, {{min, min}, {max, min}, {max, max}, {min, max}, {min, min}});
+}
+} // namespace
+
+TEST_CASE("src/calibration/walkAreaField", "[calibration][walkArea]")
+{
+    const QRectF                 bounds(-20, -20, 140, 140);
+    const Polygon                walkable = square(0, PolygonType::Walkable, 0, 100);
+    std::map<int, Polygon>       obstacles{{1, square(1, PolygonType::Obstacle, 40, 60)}};
+    constexpr double             margin = 1.5; // distances are accurate to about one cell
+    const std::optional<Polygon> noWalkable;
+
+    SECTION("status and signed distance")
+    {
+        const WalkAreaField field(walkable, obstacles, bounds, 1.);
+        REQUIRE_FALSE(field.isEmpty());
+
+        CHECK(field.status({20, 20}) == FieldStatus::Walkable);
+        CHECK(field.signedDistance({20, 20}) == Catch::Approx(20).margin(margin));
+        CHECK(field.signedDistance({20, 50}) == Catch::Approx(20).margin(margin));
+
+        CHECK(field.status({50, 50}) == FieldStatus::InsideObstacle);
+        CHECK(field.signedDistance({50, 50}) == Catch::Approx(-10).margin(margin));
+
+        CHECK(field.status({-10, 50}) == FieldStatus::OutsideWalkable);
+        CHECK(field.signedDistance({-10, 50}) == Catch::Approx(-10).margin(margin));
+
+        CHECK(field.status({1000, 50}) == FieldStatus::Unknown);
+        CHECK(std::isnan(field.signedDistance({1000, 50})));
+        CHECK(field.status({NAN, 50}) == FieldStatus::Unknown);
+    }
+
+    SECTION("coarse cells")
+    {
+        const WalkAreaField field(walkable, obstacles, bounds, 5.);
+        CHECK(field.getCellSize() == 5.);
+        CHECK(field.getBounds().contains(bounds));
+        CHECK(field.status({20, 20}) == FieldStatus::Walkable);
+        CHECK(field.signedDistance({20, 20}) == Catch::Approx(20).margin(5 * margin));
+    }
+
+    SECTION("disabled polygons are ignored")
+    {
+        auto disabledObstacles = obstacles;
+        disabledObstacles[1].setDisabled(true);
+        const WalkAreaField field(walkable, disabledObstacles, bounds, 1.);
+        CHECK(field.status({50, 50}) == FieldStatus::Walkable);
+
+        auto disabledWalkable = walkable;
+        disabledWalkable.setDisabled(true);
+        CHECK(WalkAreaField(disabledWalkable, disabledObstacles, bounds, 1.).isEmpty());
+        CHECK(WalkAreaField(noWalkable, {}, bounds, 1.).isEmpty());
+        CHECK(WalkAreaField().status({0, 0}) == FieldStatus::Unknown);
+    }
+
+    SECTION("only obstacles")
+    {
+        const WalkAreaField field(noWalkable, obstacles, bounds, 1.);
+        CHECK(field.status({-10, 50}) == FieldStatus::Walkable);
+        CHECK(field.signedDistance({20, 50}) == Catch::Approx(20).margin(margin));
+        CHECK(field.status({50, 50}) == FieldStatus::InsideObstacle);
+    }
+
+    SECTION("transformed polygons")
+    {
+        auto                toWorld = [](const QPointF &pixel) { return pixel * 2. + QPointF(10, 0); };
+        const WalkAreaField field(walkable, obstacles, QRectF(0, 0, 250, 250), 1., toWorld);
+        CHECK(field.status({50, 40}) == FieldStatus::Walkable);
+        CHECK(field.signedDistance({50, 40}) == Catch::Approx(40).margin(margin));
+        CHECK(field.status({110, 100}) == FieldStatus::InsideObstacle);
+        CHECK(field.status({5, 100}) == FieldStatus::OutsideWalkable);
+    }
+}
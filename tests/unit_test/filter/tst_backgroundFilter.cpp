@@ -0,0 +1,66 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "backgroundFilter.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("I learn the background only inside a region")
+{
+    pet::StereoContext *noStereo = nullptr;
+    BackgroundFilter    filter;
+    filter.setStereoContext(&noStereo);
+    filter.setUpdate(true);
+    filter.enable();
+
+    cv::Mat background(100, 120, CV_8UC3, cv::Scalar::all(100));
+    for(int i = 0; i < 5; ++i)
+    {
+        filter.apply(background);
+    }
+    REQUIRE(filter.learnedWholeImage());
+
+    // only the region is filtered, the rest of the image is black
+    const cv::Rect region{10, 10, 80, 80};
+    const cv::Rect person{25, 25, 50, 50};
+    cv::Mat        frame = cv::Mat::zeros(background.size(), background.type());
+    background(region).copyTo(frame(region));
+    frame(person).setTo(cv::Scalar::all(255));
+    const cv::Mat unchanged = frame.clone();
+
+    WHEN("I apply the filter to the partly filtered frame")
+    {
+        filter.setRegion(region);
+        const cv::Mat res = filter.apply(frame);
+
+        THEN("The frame is not changed")
+        {
+            REQUIRE(cv::norm(frame, unchanged, cv::NORM_INF) == 0);
+            REQUIRE(cv::norm(res, unchanged, cv::NORM_INF) == 0);
+        }
+        THEN("The foreground inside the region is detected")
+        {
+            REQUIRE(filter.isForeground(50, 50));
+        }
+        THEN("The black rest of the frame is no foreground")
+        {
+            REQUIRE_FALSE(filter.isForeground(110, 95));
+            REQUIRE_FALSE(filter.isForeground(5, 5));
+        }
+    }
+}
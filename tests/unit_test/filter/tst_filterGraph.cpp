@@ -0,0 +1,312 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "borderFilter.h"
+#include "brightContrastFilter.h"
+#include "calibFilter.h"
+#include "filterGraph.h"
+#include "swapFilter.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+/// adds a constant to every pixel and counts how often it was applied
+class AddFilter : public Filter
+{
+public:
+    explicit AddFilter(int summand) : mSummand(summand) {}
+
+    int nbApplied = 0;
+
+private:
+    int mSummand;
+
+    cv::Mat act(cv::Mat &img, cv::Mat &res) override
+    {
+        ++nbApplied;
+        res = img + mSummand;
+        return res;
+    }
+};
+
+/// adds a constant to every pixel of its input in place
+class AddInPlaceFilter : public Filter
+{
+public:
+    explicit AddInPlaceFilter(int summand) : mSummand(summand) { setOnCopy(false); }
+
+private:
+    int mSummand;
+
+    cv::Mat act(cv::Mat & /*img*/, cv::Mat &res) override
+    {
+        res += mSummand;
+        return res;
+    }
+};
+
+cv::Mat frameImage(int frame)
+{
+    return cv::Mat(4, 4, CV_8UC1, cv::Scalar(frame));
+}
+} // namespace
+
+SCENARIO("I filter frames with a FilterGraph")
+{
+    AddFilter   first{1};
+    AddFilter   second{10};
+    FilterGraph graph;
+    const auto  firstNode  = graph.addFilter(first, FilterGraph::SOURCE, diagnostics::Stage::SwapFilter);
+    const auto  secondNode = graph.addFilter(second, firstNode, diagnostics::Stage::BorderFilter);
+
+    for(int frame = 0; frame < 3; ++frame)
+    {
+        graph.setSource(frameImage(frame), frame);
+        REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == frame + 11);
+    }
+    REQUIRE(first.nbApplied == 3);
+    REQUIRE(second.nbApplied == 3);
+
+    GIVEN("I go back to a recent frame")
+    {
+        graph.setSource(frameImage(1), 1);
+        THEN("The result is taken from the cache")
+        {
+            REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 12);
+            REQUIRE(first.nbApplied == 3);
+            REQUIRE(second.nbApplied == 3);
+        }
+    }
+
+    GIVEN("I change the second filter")
+    {
+        second.setChanged(true);
+        THEN("Only the second filter is applied again")
+        {
+            REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 13);
+            REQUIRE(first.nbApplied == 3);
+            REQUIRE(second.nbApplied == 4);
+            REQUIRE_FALSE(second.changed());
+        }
+    }
+
+    GIVEN("I change the first filter")
+    {
+        first.setChanged(true);
+        THEN("Both filters are applied again")
+        {
+            REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 13);
+            REQUIRE(first.nbApplied == 4);
+            REQUIRE(second.nbApplied == 4);
+        }
+    }
+
+    GIVEN("I show a frame without frame number, e.g. of a live stream")
+    {
+        graph.setSource(frameImage(1), FilterCacheKey::NO_FRAME);
+        THEN("The filters are applied once for this image")
+        {
+            REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 12);
+            REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 12);
+            REQUIRE(first.nbApplied == 4);
+            REQUIRE(second.nbApplied == 4);
+        }
+    }
+
+    GIVEN("I disable the cache")
+    {
+        graph.setMemoryLimit(0);
+        REQUIRE(graph.memoryUsage() == 0);
+        graph.setSource(frameImage(0), 0);
+        THEN("The frame is filtered again")
+        {
+            REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 11);
+            REQUIRE(first.nbApplied == 4);
+            REQUIRE(second.nbApplied == 4);
+        }
+    }
+}
+
+SCENARIO("I filter frames with a filter working in place")
+{
+    AddFilter        first{1};
+    AddInPlaceFilter second{10};
+    FilterGraph      graph;
+    const auto       firstNode  = graph.addFilter(first, FilterGraph::SOURCE, diagnostics::Stage::SwapFilter);
+    const auto       secondNode = graph.addFilter(second, firstNode, diagnostics::Stage::BorderFilter);
+
+    graph.setSource(frameImage(0), 0);
+    REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 11);
+
+    THEN("The cached result of the previous filter is not changed")
+    {
+        REQUIRE(graph.result(firstNode).at<uchar>(0, 0) == 1);
+        graph.setSource(frameImage(1), 1);
+        REQUIRE(graph.result(secondNode).at<uchar>(0, 0) == 12);
+        graph.setSource(frameImage(0), 0);
+        REQUIRE(graph.result(firstNode).at<uchar>(0, 0) == 1);
+        REQUIRE(first.nbApplied == 2);
+    }
+}
+
+SCENARIO("I filter only a region of the image")
+{
+    SwapFilter           swap;
+    BrightContrastFilter brightContrast;
+    BorderFilter         border;
+    CalibFilter          calib;
+    FilterGraph          graph;
+
+    const auto swapNode     = graph.addFilter(swap, FilterGraph::SOURCE, diagnostics::Stage::SwapFilter);
+    const auto contrastNode = graph.addFilter(brightContrast, swapNode, diagnostics::Stage::BrightContrastFilter);
+    const auto borderNode   = graph.addFilter(border, contrastNode, diagnostics::Stage::BorderFilter);
+    const auto calibNode    = graph.addFilter(calib, borderNode, diagnostics::Stage::CalibFilter);
+
+    swap.getSwapHorizontally().setValue(true);
+    brightContrast.getContrast().setValue(20.);
+    border.getBorderSize().setValue(10);
+    border.getBorderColR().setValue(100);
+    IntrinsicCameraParams params;
+    params.setFx(100);
+    params.setFy(100);
+    params.setCx(60);
+    params.setCy(50);
+    params.setR2(-0.3F);
+    calib.getCamParams().setValue(params);
+
+    cv::Mat image(80, 100, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    graph.setSource(image, 0);
+    const cv::Mat  whole = graph.result(calibNode).clone();
+    const cv::Rect region{5, 40, 30, 25};
+    REQUIRE(graph.resultSize(calibNode) == cv::Size(120, 100));
+
+    WHEN("I only need the region")
+    {
+        graph.clearCache();
+        const cv::Mat partial = graph.result(calibNode, region);
+
+        THEN("The region is the same as in the whole image")
+        {
+            REQUIRE(partial.size() == whole.size());
+            REQUIRE(cv::norm(partial(region), whole(region), cv::NORM_INF) == 0);
+        }
+        THEN("The rest of the image is not computed")
+        {
+            REQUIRE(cv::countNonZero(partial.reshape(1)) < cv::countNonZero(whole.reshape(1)));
+            REQUIRE(partial.at<cv::Vec3b>(99, 119) == cv::Vec3b(0, 0, 0));
+        }
+    }
+
+    WHEN("I need other regions of the next frames")
+    {
+        graph.clearCache();
+        const cv::Rect other{70, 5, 30, 20};
+        const cv::Mat  first = graph.result(calibNode, region).clone();
+        graph.setSource(image, 1);
+        const cv::Mat second = graph.result(calibNode, other).clone();
+        graph.setSource(image, 0);
+        const cv::Mat cached = graph.result(calibNode, region).clone();
+
+        THEN("Only the current region is computed, the previous one is cleared")
+        {
+            REQUIRE(cv::norm(second(other), whole(other), cv::NORM_INF) == 0);
+            REQUIRE(cv::countNonZero(second(region).reshape(1)) == 0);
+        }
+        THEN("The region of a previous frame is restored from the cache")
+        {
+            REQUIRE(cv::norm(cached, first, cv::NORM_INF) == 0);
+            REQUIRE(cv::countNonZero(cached(other).reshape(1)) == 0);
+        }
+    }
+
+    WHEN("I keep a region result, e.g. to show it, while the next frame is filtered")
+    {
+        graph.clearCache();
+        const cv::Mat shown    = graph.result(calibNode, region);
+        const cv::Mat expected = shown.clone();
+        graph.setSource(cv::Mat::zeros(image.size(), image.type()), 1);
+        const cv::Mat next = graph.result(calibNode, region);
+
+        THEN("The kept result is not overwritten")
+        {
+            REQUIRE(shown.data != next.data);
+            REQUIRE(cv::norm(shown, expected, cv::NORM_INF) == 0);
+        }
+    }
+
+    WHEN("I need the region of a frame filtered as a whole before")
+    {
+        const cv::Mat partial = graph.result(calibNode, region);
+
+        THEN("The whole result is taken from the cache")
+        {
+            REQUIRE(cv::norm(partial, whole, cv::NORM_INF) == 0);
+        }
+    }
+}
+
+SCENARIO("I store filter results in a FilterResultCache")
+{
+    const cv::Mat     image(10, 10, CV_8UC3); // 300 bytes
+    FilterResultCache cache{700};
+
+    for(int frame = 0; frame < 3; ++frame)
+    {
+        cache.insert({frame, 0, 1}, image);
+    }
+
+    THEN("The least recently used result is dropped to stay below the limit")
+    {
+        REQUIRE(cache.size() == 2);
+        REQUIRE(cache.bytes() == 600);
+        REQUIRE_FALSE(cache.get({0, 0, 1}));
+        REQUIRE(cache.get({1, 0, 1}));
+        REQUIRE(cache.get({2, 0, 1}));
+    }
+
+    WHEN("I use a result and insert another one")
+    {
+        REQUIRE(cache.get({1, 0, 1}));
+        cache.insert({3, 0, 1}, image);
+        THEN("The used result is kept")
+        {
+            REQUIRE(cache.get({1, 0, 1}));
+            REQUIRE_FALSE(cache.get({2, 0, 1}));
+        }
+    }
+
+    WHEN("I look for a result with other parameters")
+    {
+        THEN("It is not found")
+        {
+            REQUIRE_FALSE(cache.get({2, 0, 2}));
+        }
+    }
+
+    WHEN("I lower the limit")
+    {
+        cache.setMaxBytes(300);
+        THEN("Results are dropped")
+        {
+            REQUIRE(cache.size() == 1);
+            REQUIRE(cache.bytes() == 300);
+        }
+    }
+}
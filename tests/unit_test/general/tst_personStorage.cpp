@@ -0,0 +1,198 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "personStorage.h"
+#include "petrack.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+namespace
+{
+/// person with stereo heights, every 7th point is an outlier
+TrackPerson createStereoPerson(int firstFrame, int length)
+{
+    auto zAt = [](int i) { return (i % 7 == 3) ? 250.F : 100.F + static_cast<float>(i % 3); };
+
+    TrackPerson person{0, firstFrame, TrackPoint::createStereoTrackPoint({0, 0}, 100, {0, 0, zAt(0)})};
+    for(int i = 1; i < length; ++i)
+    {
+        person.append(TrackPoint::createStereoTrackPoint({0, 0}, 100, {0, 0, zAt(i)}));
+    }
+    return person;
+}
+
+TrackPerson createPerson(int nr, int firstFrame, int lastFrame)
+{
+    TrackPerson person{nr, firstFrame, TrackPoint{{static_cast<float>(nr), 0}}};
+    for(int frame = firstFrame + 1; frame <= lastFrame; ++frame)
+    {
+        person.append(TrackPoint{{static_cast<float>(nr), static_cast<float>(frame)}});
+    }
+    return person;
+}
+
+/// compares the queries answered by the frame index with a linear scan over all persons
+void checkFrameIndex(const PersonStorage &storage)
+{
+    const auto &persons = storage.getPersons();
+    REQUIRE(!persons.empty());
+    int smallestFirst = persons.front().firstFrame();
+    int largestFirst  = persons.front().firstFrame();
+    int largestLast   = persons.front().lastFrame();
+    for(const auto &person : persons)
+    {
+        smallestFirst = std::min(smallestFirst, person.firstFrame());
+        largestFirst  = std::max(largestFirst, person.firstFrame());
+        largestLast   = std::max(largestLast, person.lastFrame());
+    }
+    CHECK(storage.smallestFirstFrame() == smallestFirst);
+    CHECK(storage.largestFirstFrame() == largestFirst);
+    CHECK(storage.largestLastFrame() == largestLast);
+
+    for(int frame = smallestFirst - 1; frame <= largestLast + 1; ++frame)
+    {
+        std::vector<size_t> expected;
+        for(size_t i = 0; i < persons.size(); ++i)
+        {
+            if(persons[i].trackPointExist(frame))
+            {
+                expected.push_back(i);
+            }
+        }
+        auto found = storage.personsInFrameRange(frame, frame);
+        std::sort(found.begin(), found.end());
+        INFO("frame " << frame);
+        CHECK(found == expected);
+        CHECK(storage.visible(frame) == static_cast<int>(expected.size()));
+    }
+}
+} // namespace
+
+TEST_CASE("PersonStorage processes all persons in parallel", "[PersonStorage]")
+{
+    Petrack   petrack{"personStorage Test"};
+    auto     &storage   = petrack.getPersonStorage();
+    const int nbPersons = 2500;
+
+    for(int i = 0; i < nbPersons; ++i)
+    {
+        TrackPerson person{0, i, TrackPoint{{0, 0}}};
+        person.setHeight(170.);
+        storage.addPerson(person);
+    }
+
+    SECTION("progress is reported from the calling thread until all persons are processed")
+    {
+        std::vector<size_t> reported;
+        CHECK(storage.resetHeight(
+            [&reported, nbPersons](size_t processed, size_t total)
+            {
+                CHECK(total == static_cast<size_t>(nbPersons));
+                reported.push_back(processed);
+                return true;
+            }));
+
+        REQUIRE(!reported.empty());
+        CHECK(std::is_sorted(reported.begin(), reported.end()));
+        CHECK(reported.back() == static_cast<size_t>(nbPersons));
+        for(const auto &person : storage.getPersons())
+        {
+            CHECK(person.height() == MIN_HEIGHT);
+        }
+    }
+
+    SECTION("cancellation restores all persons")
+    {
+        CHECK_FALSE(storage.resetHeight([](size_t, size_t) { return false; }));
+
+        REQUIRE(storage.nbPersons() == static_cast<size_t>(nbPersons));
+        for(const auto &person : storage.getPersons())
+        {
+            CHECK(person.height() == 170.);
+        }
+    }
+}
+
+TEST_CASE("Parallel height smoothing matches serial smoothing", "[PersonStorage]")
+{
+    Petrack petrack{"personStorage Test"};
+    auto   &storage = petrack.getPersonStorage();
+
+    Petrack serialPetrack{"personStorage Test"};
+    auto   &serialStorage = serialPetrack.getPersonStorage();
+
+    for(int i = 0; i < 1500; ++i)
+    {
+        auto person = createStereoPerson(i, 20 + i % 30);
+        storage.addPerson(person);
+        serialStorage.addPerson(person);
+    }
+
+    CHECK(storage.smoothHeights());
+    for(size_t i = 0; i < serialStorage.nbPersons(); ++i)
+    {
+        for(int j = 0; j < serialStorage.at(i).size(); ++j)
+        {
+            serialStorage.smoothHeight(i, j);
+        }
+    }
+
+    for(size_t i = 0; i < storage.nbPersons(); ++i)
+    {
+        REQUIRE(storage.at(i).size() == serialStorage.at(i).size());
+        for(int j = 0; j < storage.at(i).size(); ++j)
+        {
+            auto parallel = storage.at(i).at(j).getStereoMarker();
+            auto serial   = serialStorage.at(i).at(j).getStereoMarker();
+            REQUIRE(parallel.has_value() == serial.has_value());
+            CHECK(parallel->mStereoPoint.z() == serial->mStereoPoint.z());
+        }
+    }
+}
+
+TEST_CASE("PersonStorage keeps the frame index up to date when merging", "[PersonStorage]")
+{
+    Petrack petrack{"personStorage Test"};
+    auto   &storage = petrack.getPersonStorage();
+
+    storage.addPerson(createPerson(1, 0, 9));
+    storage.addPerson(createPerson(2, 15, 30));
+    storage.addPerson(createPerson(3, 5, 40));
+    storage.addPerson(createPerson(4, 35, 50));
+    checkFrameIndex(storage);
+
+    SECTION("the deleted person is before the kept one")
+    {
+        // person 3 gets the earlier frames of person 1
+        CHECK(storage.merge(2, 0) == 0);
+        REQUIRE(storage.nbPersons() == 3);
+        CHECK(storage.at(1).firstFrame() == 0);
+        checkFrameIndex(storage);
+    }
+
+    SECTION("the deleted person is after the kept one")
+    {
+        // person 3 gets the later frames of person 4
+        CHECK(storage.merge(2, 3) == 3);
+        REQUIRE(storage.nbPersons() == 3);
+        CHECK(storage.at(2).lastFrame() == 50);
+        checkFrameIndex(storage);
+    }
+}
@@ -0,0 +1,262 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "detectionCache.h"
+#include "trackPoint.h"
+
+#include <QDomDocument>
+#include <QFile>
+#include <QTemporaryDir>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <utility>
+#include <vector>
+
+using namespace reco;
+
+namespace
+{
+QList<TrackPoint> exampleDetections()
+{
+    TrackPoint code{Vec2F{10.5, 20.25}, TrackPoint::BEST_DETECTION_QUAL};
+    code.setCodeMarker({42, {0., 1., 0.}});
+    return {
+        TrackPoint::createMultiColorTrackPoint(Vec2F{1, 2}, 90, Vec2F{3, 4}, QColor(255, 0, 0)),
+        TrackPoint::createCasernTrackPoint(Vec2F{5, 6}, 75, Vec2F{7, 8}, QColor(0, 0, 255)),
+        TrackPoint::createJapanTrackPoint(Vec2F{9, 10}, 80, Vec2F{11, 12}),
+        TrackPoint::createHermesTrackPoint(Vec2F{13, 14}, 100),
+        code};
+}
+
+/// project with the layout written by Petrack::saveXml(); the filters are siblings of FILTER_BEFORE
+QDomDocument exampleProject()
+{
+    QDomDocument doc;
+    doc.setContent(QByteArray(R"(<PETRACK>
+ <CONTROL>
+  <CALIBRATION>
+   <FILTER_BEFORE IMMUTABLE="0"/>
+   <BRIGHTNESS ENABLED="0" VALUE="0"/>
+   <CONTRAST ENABLED="0" VALUE="0"/>
+   <BORDER ENABLED="0" VALUE="0" COLOR="#000000"/>
+   <SWAP ENABLED="0" HORIZONTALLY="0" VERTICALLY="0"/>
+   <BG_SUB ENABLED="0" UPDATE="0" SHOW="0" FILE="" DELETE="0" DELETE_NUMBER="0"/>
+   <INTRINSIC_PARAMETERS FX="1000" CALIB_FILES=""/>
+   <EXTRINSIC_PARAMETERS EXTR_ROT_1="0" SHOW="0"/>
+  </CALIBRATION>
+  <RECOGNITION>
+   <PERFORM ENABLED="0" METHOD="0" MLMETHOD="0"/>
+   <REGION_OF_INTEREST X="0" Y="0" WIDTH="0" HEIGHT="0" SHOW="0"/>
+   <MARKER BRIGHTNESS="0" IGNORE_WITHOUT="0"/>
+   <SIZE_COLOR DEFAULT_HEIGHT="0" SHOW="0"/>
+  </RECOGNITION>
+ </CONTROL>
+ <MULTI_COLOR_MARKER HEAD_SIZE="0" SHOW="0"/>
+</PETRACK>)"));
+    return doc;
+}
+
+QDomElement elementAt(const QDomDocument &doc, const QString &path)
+{
+    QDomElement element = doc.documentElement();
+    for(const auto &name : path.split('/'))
+    {
+        element = element.firstChildElement(name);
+    }
+    return element;
+}
+
+void checkEqual(const QList<TrackPoint> &actual, const QList<TrackPoint> &expected)
+{
+    REQUIRE(actual.size() == expected.size());
+    for(int i = 0; i < actual.size(); ++i)
+    {
+        CHECK(actual[i].x() == Catch::Approx(expected[i].x()));
+        CHECK(actual[i].y() == Catch::Approx(expected[i].y()));
+        CHECK(actual[i].qual() == expected[i].qual());
+        CHECK(actual[i].getMultiColorMarker().has_value() == expected[i].getMultiColorMarker().has_value());
+        CHECK(actual[i].getCasernMarker().has_value() == expected[i].getCasernMarker().has_value());
+        CHECK(actual[i].getJapanMarker().has_value() == expected[i].getJapanMarker().has_value());
+        CHECK(actual[i].getHermesMarker().has_value() == expected[i].getHermesMarker().has_value());
+        CHECK(actual[i].getCodeMarker().has_value() == expected[i].getCodeMarker().has_value());
+        CHECK(actual[i].getColorForHeightMap() == expected[i].getColorForHeightMap());
+        if(auto marker = expected[i].getCodeMarker())
+        {
+            CHECK(actual[i].getCodeMarker()->mMarkerId == marker->mMarkerId);
+            CHECK(actual[i].getCodeMarker()->mOrientation[1] == Catch::Approx(marker->mOrientation[1]));
+        }
+        if(auto colorPoint = expected[i].getColorPointForOrientation())
+        {
+            CHECK(actual[i].getColorPointForOrientation()->x() == Catch::Approx(colorPoint->x()));
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("DetectionCache stores detections per frame", "[recognition]")
+{
+    DetectionCache cache{"hash", 100, 199};
+    CHECK(cache.firstFrame() == 100);
+    CHECK(cache.lastFrame() == 199);
+    CHECK_FALSE(cache.contains(150));
+    CHECK_FALSE(cache.detections(150).has_value());
+
+    cache.insert(150, exampleDetections());
+    cache.insert(151, {});
+    cache.insert(250, exampleDetections()); // outside, ignored
+
+    CHECK(cache.nbDetectedFrames() == 2);
+    CHECK(cache.contains(150));
+    CHECK(cache.contains(151));
+    CHECK_FALSE(cache.contains(152));
+    CHECK_FALSE(cache.contains(250));
+    checkEqual(*cache.detections(150), exampleDetections());
+    CHECK(cache.detections(151)->isEmpty());
+
+    SECTION("merge")
+    {
+        DetectionCache other{"hash", 0, 299};
+        other.insert(10, exampleDetections());
+        other.insert(151, exampleDetections());
+        other.insert(199, exampleDetections());
+        REQUIRE(cache.merge(other));
+        CHECK(cache.nbDetectedFrames() == 3);
+        CHECK(cache.detections(151)->size() == 5);
+        CHECK(cache.contains(199));
+        CHECK_FALSE(cache.contains(10));
+
+        DetectionCache otherParameters{"other", 100, 199};
+        otherParameters.insert(160, {});
+        CHECK_FALSE(cache.merge(otherParameters));
+        CHECK_FALSE(cache.contains(160));
+    }
+
+    SECTION("save and load")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString fileName = dir.filePath("detections.det");
+        REQUIRE(cache.save(fileName));
+
+        auto loaded = DetectionCache::load(fileName);
+        REQUIRE(loaded.has_value());
+        CHECK(loaded->parameterHash() == "hash");
+        CHECK(loaded->firstFrame() == 100);
+        CHECK(loaded->lastFrame() == 199);
+        CHECK(loaded->nbDetectedFrames() == 2);
+        CHECK(loaded->detections(151)->isEmpty());
+        CHECK_FALSE(loaded->contains(152));
+        checkEqual(*loaded->detections(150), exampleDetections());
+    }
+
+    SECTION("broken files")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString fileName = dir.filePath("detections.det");
+        CHECK_FALSE(DetectionCache::load(fileName).has_value());
+
+        REQUIRE(cache.save(fileName));
+        QFile file{fileName};
+        REQUIRE(file.open(QIODevice::ReadWrite));
+        REQUIRE(file.resize(file.size() - 10));
+        file.close();
+        CHECK_FALSE(DetectionCache::load(fileName).has_value());
+
+        REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("no detection cache");
+        file.close();
+        CHECK_FALSE(DetectionCache::load(fileName).has_value());
+    }
+}
+
+TEST_CASE("DetectionCache::parameterHashOf", "[recognition]")
+{
+    const QDomDocument project = exampleProject();
+    const QByteArray   hash    = DetectionCache::parameterHashOf(project, "video.mp4");
+
+    SECTION("Every setting of the recognition changes the hash")
+    {
+        const std::vector<std::pair<QString, QString>> settings{
+            {"CONTROL/CALIBRATION/BRIGHTNESS", "ENABLED"},
+            {"CONTROL/CALIBRATION/BRIGHTNESS", "VALUE"},
+            {"CONTROL/CALIBRATION/CONTRAST", "ENABLED"},
+            {"CONTROL/CALIBRATION/CONTRAST", "VALUE"},
+            {"CONTROL/CALIBRATION/BORDER", "ENABLED"},
+            {"CONTROL/CALIBRATION/BORDER", "VALUE"},
+            {"CONTROL/CALIBRATION/BORDER", "COLOR"},
+            {"CONTROL/CALIBRATION/SWAP", "ENABLED"},
+            {"CONTROL/CALIBRATION/SWAP", "HORIZONTALLY"},
+            {"CONTROL/CALIBRATION/SWAP", "VERTICALLY"},
+            {"CONTROL/CALIBRATION/BG_SUB", "ENABLED"},
+            {"CONTROL/CALIBRATION/BG_SUB", "UPDATE"},
+            {"CONTROL/CALIBRATION/BG_SUB", "FILE"},
+            {"CONTROL/CALIBRATION/BG_SUB", "DELETE"},
+            {"CONTROL/CALIBRATION/BG_SUB", "DELETE_NUMBER"},
+            {"CONTROL/CALIBRATION/INTRINSIC_PARAMETERS", "FX"},
+            {"CONTROL/CALIBRATION/EXTRINSIC_PARAMETERS", "EXTR_ROT_1"},
+            {"CONTROL/RECOGNITION/PERFORM", "METHOD"},
+            {"CONTROL/RECOGNITION/PERFORM", "MLMETHOD"},
+            {"CONTROL/RECOGNITION/REGION_OF_INTEREST", "X"},
+            {"CONTROL/RECOGNITION/REGION_OF_INTEREST", "Y"},
+            {"CONTROL/RECOGNITION/REGION_OF_INTEREST", "WIDTH"},
+            {"CONTROL/RECOGNITION/REGION_OF_INTEREST", "HEIGHT"},
+            {"CONTROL/RECOGNITION/MARKER", "BRIGHTNESS"},
+            {"CONTROL/RECOGNITION/MARKER", "IGNORE_WITHOUT"},
+            {"CONTROL/RECOGNITION/SIZE_COLOR", "DEFAULT_HEIGHT"},
+            {"MULTI_COLOR_MARKER", "HEAD_SIZE"},
+        };
+        for(const auto &[path, attribute] : settings)
+        {
+            INFO(path.toStdString() << " " << attribute.toStdString());
+            QDomDocument changed = exampleProject();
+            elementAt(changed, path).setAttribute(attribute, "1");
+            CHECK(DetectionCache::parameterHashOf(changed, "video.mp4") != hash);
+        }
+    }
+
+    SECTION("Settings of the display do not change the hash")
+    {
+        const std::vector<std::pair<QString, QString>> settings{
+            {"CONTROL/CALIBRATION/FILTER_BEFORE", "IMMUTABLE"},
+            {"CONTROL/CALIBRATION/BG_SUB", "SHOW"},
+            {"CONTROL/CALIBRATION/INTRINSIC_PARAMETERS", "CALIB_FILES"},
+            {"CONTROL/CALIBRATION/EXTRINSIC_PARAMETERS", "SHOW"},
+            {"CONTROL/RECOGNITION/PERFORM", "ENABLED"},
+            {"CONTROL/RECOGNITION/REGION_OF_INTEREST", "SHOW"},
+            {"CONTROL/RECOGNITION/SIZE_COLOR", "SHOW"},
+            {"MULTI_COLOR_MARKER", "SHOW"},
+        };
+        for(const auto &[path, attribute] : settings)
+        {
+            INFO(path.toStdString() << " " << attribute.toStdString());
+            QDomDocument changed = exampleProject();
+            elementAt(changed, path).setAttribute(attribute, "1");
+            CHECK(DetectionCache::parameterHashOf(changed, "video.mp4") == hash);
+        }
+    }
+
+    SECTION("Another sequence changes the hash")
+    {
+        CHECK(DetectionCache::parameterHashOf(project, "other.mp4") != hash);
+    }
+
+    SECTION("The project is not changed")
+    {
+        CHECK(elementAt(project, "MULTI_COLOR_MARKER").hasAttribute("SHOW"));
+    }
+}
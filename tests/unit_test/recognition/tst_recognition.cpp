@@ -16,12 +16,17 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "intrinsicCameraParams.h"
 #include "petrack.h"
 #include "recognition.h"
+#include "trackPoint.h"
 
 #include <QSignalSpy>
+#include <QtConcurrent/QtConcurrentMap>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <numeric>
+#include <opencv2/objdetect/aruco_dictionary.hpp>
 
 using namespace reco;
 
@@ -245,3 +250,51 @@ SCENARIO("I use the setter/getter of ArucoCodeParams")
         }
     }
 }
+
+SCENARIO("I detect code markers in sub images from multiple threads")
+{
+    const cv::aruco::Dictionary dictionary = detail::codeMarkerDictionary(cv::aruco::DICT_4X4_50);
+    const ArucoCodeParams       parameters;
+    const IntrinsicCameraParams intrinsic;
+
+    // white image with marker 7 in the middle, like the crop around one color blob
+    constexpr int markerSize = 60;
+    cv::Mat       marker;
+    cv::aruco::generateImageMarker(dictionary, 7, markerSize, marker);
+    cv::Mat subImg(150, 150, CV_8UC1, cv::Scalar(255));
+    marker.copyTo(subImg(cv::Rect(45, 45, markerSize, markerSize)));
+
+    // perimeter of the marker is 240 px
+    detail::MarkerPerimeterBounds bounds;
+    bounds.minPerimeter = 100;
+    bounds.maxPerimeter = 400;
+
+    GIVEN("The same sub image for many blobs")
+    {
+        constexpr size_t                         nbBlobs = 64;
+        std::vector<QList<TrackPoint>>           codes(nbBlobs);
+        std::vector<detail::CodeMarkerDetection> detections(nbBlobs);
+        std::vector<size_t>                      indices(nbBlobs);
+        std::iota(indices.begin(), indices.end(), 0);
+
+        QtConcurrent::blockingMap(
+            indices,
+            [&](size_t i)
+            {
+                detections[i] = detail::detectCodeMarker(subImg, dictionary, parameters, bounds);
+                codes[i]      = detail::codeMarkerTrackPoints(detections[i], parameters, intrinsic, false);
+            });
+
+        THEN("Every blob gets the marker with its id and center")
+        {
+            for(size_t i = 0; i < nbBlobs; ++i)
+            {
+                REQUIRE(detections[i].ids == std::vector<int>{7});
+                REQUIRE(codes[i].size() == 1);
+                REQUIRE(codes[i].first().getCodeMarker()->mMarkerId == 7);
+                REQUIRE(codes[i].first().x() == Catch::Approx(75).margin(1));
+                REQUIRE(codes[i].first().y() == Catch::Approx(75).margin(1));
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pointKalmanFilter.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("PointKalmanFilter", "[tracking][kalman]")
+{
+    using Catch::Approx;
+
+    PointKalmanFilter filter;
+
+    SECTION("predict moves with constant velocity")
+    {
+        filter.init({0.F, 0.F}, {1.F, 2.F});
+        auto prediction = filter.predict();
+        CHECK(prediction.x == Approx(1.F));
+        CHECK(prediction.y == Approx(2.F));
+        prediction = filter.predict();
+        CHECK(prediction.x == Approx(2.F));
+        CHECK(prediction.y == Approx(4.F));
+
+        // predict is also taken as corrected state, if no measurement follows
+        CHECK(filter.statePost() == filter.statePre());
+    }
+
+    SECTION("a priori covariance")
+    {
+        filter.init({0.F, 0.F}, {1.F, 2.F});
+        filter.predict();
+        // A*P*A^T + Q with P = I and sigma_a = 0.2
+        const auto &cov = filter.errorCovPre();
+        CHECK(cov(0, 0) == Approx(2.01F));
+        CHECK(cov(1, 1) == Approx(2.01F));
+        CHECK(cov(0, 2) == Approx(1.02F));
+        CHECK(cov(2, 0) == Approx(1.02F));
+        CHECK(cov(2, 2) == Approx(1.04F));
+        CHECK(cov(0, 1) == Approx(0.F));
+    }
+
+    SECTION("correct without measurement noise takes the measurement")
+    {
+        filter.init({0.F, 0.F}, {1.F, 2.F});
+        filter.predict();
+        filter.setMeasurementNoise(0.F, 0.F);
+        const auto corrected = filter.correct({3.F, 3.F});
+        CHECK(corrected.x == Approx(3.F));
+        CHECK(corrected.y == Approx(3.F));
+        // velocity gain is P'_{vx,x} / P'_{x,x}
+        CHECK(filter.statePost()[2] == Approx(1.F + 2.F * 1.02F / 2.01F));
+        CHECK(filter.statePost()[3] == Approx(2.F + 1.F * 1.02F / 2.01F));
+    }
+
+    SECTION("correct weights prediction and measurement")
+    {
+        filter.init({0.F, 0.F}, {0.F, 0.F});
+        filter.predict();
+        filter.setMeasurementNoise(2.01F, 2.01F);
+        const auto corrected = filter.correct({2.F, 4.F});
+        CHECK(corrected.x == Approx(1.F));
+        CHECK(corrected.y == Approx(2.F));
+    }
+
+    SECTION("correct without prediction keeps the a priori state like cv::KalmanFilter")
+    {
+        filter.init({5.F, 5.F});
+        const auto corrected = filter.correct({7.F, 7.F});
+        CHECK(corrected.x == Approx(0.F));
+        CHECK(corrected.y == Approx(0.F));
+    }
+}
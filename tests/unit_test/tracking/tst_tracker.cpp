@@ -16,9 +16,109 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "personStorage.h"
+#include "petrack.h"
 #include "tracker.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <opencv2/imgproc.hpp>
+
+namespace
+{
+/// identity undistortion map as created by CalibFilter for a camera without distortion
+cv::Mat identityMap(const cv::Size &size)
+{
+    cv::Mat map(size, CV_16SC2);
+    for(int y = 0; y < size.height; ++y)
+    {
+        for(int x = 0; x < size.width; ++x)
+        {
+            map.at<cv::Vec2s>(y, x) = cv::Vec2s(static_cast<short>(x), static_cast<short>(y));
+        }
+    }
+    return map;
+}
+
+/**
+ * @brief Tracks nbPersons points on a grid over a textured image moving diagonally by one pixel per frame
+ * @return mean tracking time per frame in ms
+ */
+double trackSyntheticGrid(Petrack &petrack, int nbPersons, int nbFrames)
+{
+    constexpr int spacing = 20;
+    constexpr int margin  = 50;
+
+    const int      perRow = static_cast<int>(std::ceil(std::sqrt(nbPersons)));
+    const cv::Size size{perRow * spacing + 2 * margin, perRow * spacing + 2 * margin};
+    cv::Mat        texture(size, CV_8UC1);
+    cv::randu(texture, 0, 255);
+    cv::GaussianBlur(texture, texture, {0, 0}, 2);
+    const cv::Mat map1 = identityMap(size);
+    cv::Rect      roi{{0, 0}, size};
+
+    Tracker &tracker = *petrack.getTracker();
+    tracker.init(size);
+    for(int i = 0; i < nbPersons; ++i)
+    {
+        Vec2F pos(margin + (i % perRow) * spacing, margin + (i / perRow) * spacing);
+        petrack.getPersonStorage().addPerson(TrackPerson(i, 0, TrackPoint(pos, TrackPoint::BEST_DETECTION_QUAL)));
+    }
+    tracker.track(texture, roi, map1, 0, false, 0, 0, reco::RecognitionMethod::MultiColor);
+
+    std::chrono::duration<double, std::milli> trackingTime{0};
+    for(int frame = 1; frame <= nbFrames; ++frame)
+    {
+        cv::Mat shifted;
+        cv::Mat shift = (cv::Mat_<double>(2, 3) << 1, 0, frame, 0, 1, frame);
+        cv::warpAffine(texture, shifted, shift, size, cv::INTER_LINEAR, cv::BORDER_REFLECT);
+
+        const auto start = std::chrono::steady_clock::now();
+        tracker.track(shifted, roi, map1, frame, false, 0, 0, reco::RecognitionMethod::MultiColor);
+        trackingTime += std::chrono::steady_clock::now() - start;
+
+        CHECK(tracker.getCurrentlyTracked() == nbPersons);
+    }
+    return trackingTime.count() / nbFrames;
+}
+} // namespace
+
+TEST_CASE("TrackPoint copies keep their own markers", "[TrackPoint]")
+{
+    TrackPoint original = TrackPoint::createMultiColorTrackPoint({1, 2}, 90, {3, 4}, QColor(255, 0, 0));
+    original.setCodeMarker({7});
+    TrackPoint copy = original;
+
+    SECTION("a copy has the same markers")
+    {
+        REQUIRE(copy.getMultiColorMarker().has_value());
+        CHECK(copy.getMultiColorMarker()->mColor == QColor(255, 0, 0));
+        REQUIRE(copy.getCodeMarker().has_value());
+        CHECK(copy.getCodeMarker()->mMarkerId == 7);
+    }
+
+    SECTION("changing the markers of a copy does not change the original")
+    {
+        copy.setCodeMarker({8});
+        copy.deleteColorMarkers();
+        copy.shift({1, 1});
+
+        CHECK(original.getCodeMarker()->mMarkerId == 7);
+        REQUIRE(original.getMultiColorMarker().has_value());
+        CHECK(original.getMultiColorMarker()->mColorPoint == Vec2F(3, 4));
+        CHECK(copy.getCodeMarker()->mMarkerId == 8);
+        CHECK_FALSE(copy.getMultiColorMarker().has_value());
+    }
+
+    SECTION("clearing the markers of the original does not change a copy")
+    {
+        original.clearMarkers();
+
+        CHECK_FALSE(original.getCodeMarker().has_value());
+        CHECK(copy.getCodeMarker().has_value());
+    }
+}
 
 TEST_CASE("TrackPerson returns correct frame range", "[TrackPerson]")
 {
@@ -169,3 +269,27 @@ TEST_CASE("TrackPerson insertion, [TrackPerson]")
         }
     }
 }
+
+TEST_CASE("Tracker tracks more than 1500 persons at once", "[tracking]")
+{
+    Petrack petrack{"Unit Test"};
+    trackSyntheticGrid(petrack, 2000, 1);
+
+    const auto &storage = petrack.getPersonStorage();
+    REQUIRE(storage.nbPersons() == 2000);
+    for(size_t i = 0; i < storage.nbPersons(); ++i)
+    {
+        CHECK(storage.at(i).trackPointExist(1));
+    }
+}
+
+TEST_CASE("Tracker benchmark with many persons", "[.][benchmark][tracking]")
+{
+    for(int nbPersons : {5'000, 10'000, 20'000})
+    {
+        // a fresh Petrack per size, so the persons and tracker state of the previous size are not measured again
+        Petrack      petrack{"Unit Test"};
+        const double msPerFrame = trackSyntheticGrid(petrack, nbPersons, 5);
+        SPDLOG_INFO("Tracking {} persons: {:.1f} ms per frame", nbPersons, msPerFrame);
+    }
+}
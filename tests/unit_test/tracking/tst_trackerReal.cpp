@@ -0,0 +1,122 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trackerReal.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+namespace
+{
+/// person moving with constant velocity (in cm per frame) starting at the origin
+TrackPersonReal linearPerson(int firstFrame, int nbFrames, double vx, double vy)
+{
+    TrackPersonReal person;
+    person.init(firstFrame, 180., -1, "");
+    for(int i = 0; i < nbFrames; ++i)
+    {
+        person.addEnd(QPointF(vx * i, vy * i), firstFrame + i);
+    }
+    return person;
+}
+} // namespace
+
+TEST_CASE("computeVelocities", "[tracking][analysis]")
+{
+    QList<TrackPersonReal> persons;
+    persons.append(linearPerson(0, 5, 3., -4.));
+    persons.append(linearPerson(2, 6, -1., 2.));
+
+    VelocityOptions options;
+    options.fps = 25;
+
+    SECTION("single component")
+    {
+        options.considerX = false;
+        options.considerY = true;
+        auto series       = computeVelocities(persons, options);
+
+        REQUIRE(series.size() == 4 + 5);
+        REQUIRE(series.personStart == std::vector<size_t>{0, 4, 9});
+        CHECK(series.frames.front() == 0);
+        CHECK(series.frames[4] == 2);
+        // 4 cm per frame with 25 fps = 1 m/s
+        CHECK(series.velocities[0] == Catch::Approx(-1.));
+        CHECK(series.velocities[4] == Catch::Approx(0.5));
+
+        options.considerAbs = true;
+        series              = computeVelocities(persons, options);
+        CHECK(series.velocities[0] == Catch::Approx(1.));
+
+        options.considerAbs = false;
+        options.considerRev = true;
+        series              = computeVelocities(persons, options);
+        CHECK(series.velocities[0] == Catch::Approx(1.));
+        CHECK(series.velocities[4] == Catch::Approx(-0.5));
+    }
+
+    SECTION("absolute velocity and step")
+    {
+        options.considerX = true;
+        options.considerY = true;
+        options.step      = 2;
+        auto series       = computeVelocities(persons, options);
+
+        REQUIRE(series.size() == 3 + 4);
+        // 5 cm per frame with 25 fps = 1.25 m/s, independent of the step
+        CHECK(series.velocities[0] == Catch::Approx(1.25));
+        CHECK(series.velocities[3] == Catch::Approx(std::sqrt(5.) / 4.));
+    }
+
+    SECTION("mean per frame")
+    {
+        auto series = computeVelocities(persons, options);
+
+        CHECK(series.firstFrame == 0);
+        REQUIRE(series.meanVelocities.size() == 7);
+        CHECK(series.meanVelocities[0] == Catch::Approx(-1.));
+        // frames 2 and 3 contain both persons
+        CHECK(series.meanVelocities[2] == Catch::Approx(-0.25));
+        CHECK(series.meanVelocities[6] == Catch::Approx(0.5));
+    }
+
+    SECTION("gaps in the mean")
+    {
+        persons.clear();
+        persons.append(linearPerson(0, 3, 1., 1.));
+        persons.append(linearPerson(5, 3, 1., 1.));
+        auto series = computeVelocities(persons, options);
+
+        REQUIRE(series.meanVelocities.size() == 7);
+        CHECK(std::isnan(series.meanVelocities[2]));
+        CHECK(std::isnan(series.meanVelocities[4]));
+        CHECK_FALSE(std::isnan(series.meanVelocities[5]));
+    }
+
+    SECTION("too short trajectories")
+    {
+        persons.clear();
+        persons.append(linearPerson(0, 1, 1., 1.));
+        auto series = computeVelocities(persons, options);
+
+        CHECK(series.size() == 0);
+        CHECK(series.meanVelocities.empty());
+        CHECK(series.personStart == std::vector<size_t>{0, 0});
+    }
+}
@@ -0,0 +1,227 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trackingDiagnostics.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+using namespace diagnostics;
+
+TEST_CASE("TrackingDiagnostics records and queries events", "[tracking]")
+{
+    TrackingDiagnostics diagnostics(16);
+
+    diagnostics.record(TrackingEventKind::LostInsidePicture, 3, 1, 10.F, 20.F);
+    diagnostics.record(TrackingEventKind::Extrapolated, 4, 2, 5.F);
+    diagnostics.record(TrackingEventKind::AmbiguousAssignment, 4, 3, 1.F, 2.F, 7);
+
+    const auto events = diagnostics.events();
+    REQUIRE(events.size() == 3);
+    CHECK(events[0].kind == TrackingEventKind::LostInsidePicture);
+    CHECK(events[0].frame == 3);
+    CHECK(events[0].value2 == 20.F);
+    CHECK(events[2].otherPersonNr == 7);
+    CHECK(events[1].otherPersonNr == -1);
+
+    CHECK(diagnostics.eventsInFrame(4).size() == 2);
+    CHECK(diagnostics.events(TrackingEventKind::Extrapolated).size() == 1);
+    CHECK(diagnostics.events(TrackingEventKind::NotInserted).empty());
+
+    diagnostics.clear();
+    CHECK(diagnostics.events().empty());
+    CHECK(diagnostics.recordedCount() == 0);
+}
+
+TEST_CASE("TrackingDiagnostics overwrites the oldest events", "[tracking]")
+{
+    TrackingDiagnostics diagnostics(5);
+    REQUIRE(diagnostics.capacity() == 8);
+
+    for(int frame = 0; frame < 20; ++frame)
+    {
+        diagnostics.record(TrackingEventKind::Extrapolated, frame, 1);
+    }
+
+    const auto events = diagnostics.events();
+    REQUIRE(events.size() == 8);
+    CHECK(events.front().frame == 12);
+    CHECK(events.back().frame == 19);
+    CHECK(diagnostics.overwrittenCount() == 12);
+}
+
+TEST_CASE("TrackingDiagnostics keeps overwritten events if requested", "[tracking]")
+{
+    TrackingDiagnostics diagnostics(8);
+    diagnostics.setKeepAllEvents(true);
+
+    for(int frame = 0; frame < 100; ++frame)
+    {
+        diagnostics.record(TrackingEventKind::Extrapolated, frame, 1);
+    }
+
+    const auto events = diagnostics.events();
+    REQUIRE(events.size() == 100);
+    for(int frame = 0; frame < 100; ++frame)
+    {
+        CHECK(events[frame].frame == frame);
+    }
+    CHECK(diagnostics.overwrittenCount() == 0);
+
+    diagnostics.clear();
+    CHECK(diagnostics.events().empty());
+}
+
+TEST_CASE("TrackingDiagnostics can be written from several threads", "[tracking]")
+{
+    constexpr int       nbThreads       = 4;
+    constexpr int       eventsPerThread = 1000;
+    TrackingDiagnostics diagnostics(64);
+    diagnostics.setKeepAllEvents(true);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nbThreads; ++t)
+    {
+        threads.emplace_back(
+            [&diagnostics, t]
+            {
+                for(int i = 0; i < eventsPerThread; ++i)
+                {
+                    diagnostics.record(TrackingEventKind::AdaptiveLevelRetry, i, t + 1);
+                }
+            });
+    }
+    for(auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto events = diagnostics.events();
+    REQUIRE(events.size() == nbThreads * eventsPerThread);
+    for(int t = 0; t < nbThreads; ++t)
+    {
+        CHECK(std::count_if(
+                  events.begin(), events.end(), [t](const TrackingEvent &event) { return event.personNr == t + 1; }) ==
+              eventsPerThread);
+    }
+}
+
+TEST_CASE("TrackingDiagnostics can be read while events are recorded", "[tracking]")
+{
+    constexpr int       nbThreads       = 4;
+    constexpr int       eventsPerThread = 5000;
+    TrackingDiagnostics diagnostics(64);
+    diagnostics.setKeepAllEvents(true);
+
+    std::atomic<bool> recording{true};
+    int               nbTorn = 0;
+    std::thread       reader(
+        [&]
+        {
+            while(recording.load())
+            {
+                // the values of each event are copies of its frame and person, so a partly read event is noticed
+                const auto events = diagnostics.events();
+                nbTorn += static_cast<int>(std::count_if(
+                    events.begin(),
+                    events.end(),
+                    [](const TrackingEvent &event)
+                    { return event.value1 != event.frame || event.value2 != event.personNr; }));
+            }
+        });
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nbThreads; ++t)
+    {
+        threads.emplace_back(
+            [&diagnostics, t]
+            {
+                for(int i = 0; i < eventsPerThread; ++i)
+                {
+                    diagnostics.record(
+                        TrackingEventKind::AdaptiveLevelRetry,
+                        i,
+                        t + 1,
+                        static_cast<float>(i),
+                        static_cast<float>(t + 1));
+                }
+            });
+    }
+    for(auto &thread : threads)
+    {
+        thread.join();
+    }
+    recording.store(false);
+    reader.join();
+
+    CHECK(nbTorn == 0);
+    CHECK(diagnostics.events().size() == nbThreads * eventsPerThread);
+    CHECK(diagnostics.overwrittenCount() == 0);
+}
+
+TEST_CASE("TrackingDiagnostics export", "[tracking]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    TrackingDiagnostics diagnostics(16);
+    diagnostics.record(TrackingEventKind::ReplacementJump, 42, 5, 12.5F);
+    diagnostics.record(TrackingEventKind::AmbiguousAssignment, 43, 6, 1.5F, 2.5F, 8);
+
+    SECTION("CSV")
+    {
+        const QString filename = dir.filePath("diagnostics.csv");
+        REQUIRE(diagnostics.exportFile(filename));
+
+        QFile file(filename);
+        REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QStringList lines = QString(file.readAll()).split('\n', Qt::SkipEmptyParts);
+        REQUIRE(lines.size() == 3);
+        CHECK(lines[0] == "kind,frame,person,other_person,value1,value2");
+        CHECK(lines[1] == "replacement_jump,42,5,-1,12.5,0");
+        CHECK(lines[2] == "ambiguous_assignment,43,6,8,1.5,2.5");
+    }
+
+    SECTION("JSON")
+    {
+        const QString filename = dir.filePath("diagnostics.json");
+        REQUIRE(diagnostics.exportFile(filename));
+
+        QFile file(filename);
+        REQUIRE(file.open(QIODevice::ReadOnly));
+        const auto root   = QJsonDocument::fromJson(file.readAll()).object();
+        const auto events = root["events"].toArray();
+        REQUIRE(events.size() == 2);
+        CHECK(root["overwritten"].toInt() == 0);
+
+        const auto event = events[1].toObject();
+        CHECK(trackingEventKindFromString(event["kind"].toString()) == TrackingEventKind::AmbiguousAssignment);
+        CHECK(event["frame"].toInt() == 43);
+        CHECK(event["person"].toInt() == 6);
+        CHECK(event["otherPerson"].toInt() == 8);
+        CHECK(event["value2"].toDouble() == 2.5);
+    }
+}
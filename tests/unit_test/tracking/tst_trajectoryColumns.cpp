@@ -0,0 +1,176 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trackPerson.h"
+#include "trackPoint.h"
+#include "trajectoryColumns.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+namespace
+{
+TrackPoint pointWithMarker(double x, double y, int qual, int markerId)
+{
+    TrackPoint point{Vec2F(x, y), qual};
+    point.setCodeMarker({markerId});
+    return point;
+}
+
+std::optional<int> markerId(const TrackPoint &point)
+{
+    if(auto marker = point.getCodeMarker())
+    {
+        return marker->mMarkerId;
+    }
+    return std::nullopt;
+}
+} // namespace
+
+TEST_CASE("TrajectoryColumns", "[tracking]")
+{
+    TrajectoryColumns columns;
+    REQUIRE(columns.isEmpty());
+
+    SECTION("append and prepend")
+    {
+        columns.append(TrackPoint{Vec2F(1, 2), 50});
+        columns.append(pointWithMarker(3, 4, 100, 7));
+        for(int i = 0; i < 20; ++i)
+        {
+            columns.prepend(TrackPoint{Vec2F(-i, -i), i});
+        }
+
+        REQUIRE(columns.size() == 22);
+        CHECK(columns.first().x() == -19);
+        CHECK(columns.first().qual() == 19);
+        CHECK(columns.at(20).x() == 1);
+        CHECK(columns.last().y() == 4);
+        CHECK(columns.last().qual() == 100);
+        CHECK(markerId(columns.last()) == 7);
+        CHECK_FALSE(columns.at(20).getCodeMarker().has_value());
+        CHECK(columns.xs().size() == 22);
+        CHECK(columns.xs().front() == -19);
+        CHECK(columns.quals().back() == 100);
+        CHECK(columns.memoryUsage() >= 22 * (2 * sizeof(double) + 1));
+        CHECK_THROWS_AS(columns.at(22), std::out_of_range);
+    }
+
+    SECTION("quality is clamped to 8 bit")
+    {
+        columns.append(TrackPoint{Vec2F(0, 0), 300});
+        columns.append(TrackPoint{Vec2F(0, 0), -5});
+        CHECK(columns.qual(0) == 255);
+        CHECK(columns.qual(1) == 0);
+    }
+
+    SECTION("erase keeps the markers at their points")
+    {
+        for(int i = 0; i < 10; ++i)
+        {
+            columns.append(pointWithMarker(i, i, 0, i));
+        }
+        columns.prepend(pointWithMarker(-1, -1, 0, -1));
+
+        columns.erase(0, 3);
+        REQUIRE(columns.size() == 8);
+        CHECK(columns.x(0) == 2);
+        CHECK(markerId(columns.at(0)) == 2);
+
+        columns.erase(2, 4);
+        REQUIRE(columns.size() == 6);
+        CHECK(columns.x(2) == 6);
+
+        std::vector<int> ids;
+        for(const auto &point : columns)
+        {
+            ids.push_back(markerId(point).value_or(-1));
+        }
+        CHECK(ids == std::vector<int>{2, 3, 6, 7, 8, 9});
+
+        columns.prepend(pointWithMarker(42, 42, 0, 42));
+        CHECK(markerId(columns.at(0)) == 42);
+        CHECK(markerId(columns.at(1)) == 2);
+
+        columns.set(1, TrackPoint{Vec2F(0, 0), 1});
+        CHECK_FALSE(columns.at(1).getCodeMarker().has_value());
+    }
+
+    SECTION("clear")
+    {
+        columns.append(pointWithMarker(1, 1, 1, 1));
+        columns.clear();
+        CHECK(columns.isEmpty());
+        CHECK(columns.begin() == columns.end());
+        columns.prepend(TrackPoint{Vec2F(5, 5), 1});
+        CHECK(columns.x(0) == 5);
+        CHECK_FALSE(columns.at(0).getCodeMarker().has_value());
+    }
+}
+
+TEST_CASE("TrackPerson stores its TrackPoints in columns", "[tracking]")
+{
+    TrackPerson person{0, 10, TrackPoint{Vec2F(10, 10), TrackPoint::BEST_DETECTION_QUAL}};
+
+    // tracking forward with a gap (interpolated) and backward
+    REQUIRE(person.insertAtFrame(11, pointWithMarker(11, 10, 60, 3), 0, false, false));
+    REQUIRE(person.insertAtFrame(12, TrackPoint{Vec2F(12, 10), 50}, 0, false, false));
+    REQUIRE(person.insertAtFrame(14, TrackPoint{Vec2F(14, 10), 50}, 0, false, false));
+    REQUIRE(person.insertAtFrame(9, TrackPoint{Vec2F(9, 10), 50}, 0, false, false));
+    REQUIRE(person.insertAtFrame(6, TrackPoint{Vec2F(6, 10), 50}, 0, false, false));
+    REQUIRE(person.firstFrame() == 6);
+    REQUIRE(person.lastFrame() == 14);
+    CHECK(person.first().x() == 6);
+    CHECK(person.trackPointAt(7).x() == 7);
+    CHECK(person.trackPointAt(7).qual() == 0);
+    CHECK(person.trackPointAt(13).x() == 13);
+    CHECK(markerId(person.trackPointAt(11)) == 3);
+
+    // replacement by a better point, manually added points get the best detection quality
+    REQUIRE(person.insertAtFrame(12, TrackPoint{Vec2F(12, 11), TrackPoint::BEST_DETECTION_QUAL + 10}, 0, false, false));
+    CHECK(person.trackPointAt(12).qual() == TrackPoint::BEST_DETECTION_QUAL);
+    CHECK(person.trackPointAt(12).y() == 11);
+
+    person.updateMarkerID(7, 5);
+    person.updateStereoPoint(7, Vec3F(1, 2, 3));
+    CHECK(markerId(person.trackPointAt(7)) == 5);
+    CHECK(person.trackPointAt(7).getStereoMarker()->mStereoPoint.z() == 3);
+
+    int frame = person.firstFrame();
+    for(const auto &point : person)
+    {
+        CHECK(point.pixelPoint() == person.trackPointAt(frame).pixelPoint());
+        CHECK(point.qual() == person.at(frame - person.firstFrame()).qual());
+        CHECK(markerId(point) == markerId(person.trackPointAt(frame)));
+        ++frame;
+    }
+    CHECK(frame == person.lastFrame() + 1);
+    CHECK(person.end() - person.begin() == person.size());
+
+    person.removeFramesBetween(6, 7);
+    CHECK(person.firstFrame() == 8);
+    CHECK(person.first().x() == 8);
+    person.removeFramesBetween(13, 14);
+    CHECK(person.lastFrame() == 12);
+    CHECK_FALSE(person.last().getCodeMarker().has_value());
+
+    CHECK(person.memoryUsage() >= static_cast<size_t>(person.size()) * (2 * sizeof(double) + 1));
+
+    person.clear();
+    CHECK(person.isEmpty());
+}
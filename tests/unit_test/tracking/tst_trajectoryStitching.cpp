@@ -0,0 +1,159 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "trajectoryStitching.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace stitching;
+
+namespace
+{
+/// person walking along x with 1 pixel per frame in row y
+TrackPerson walkingPerson(int firstFrame, int lastFrame, double y, int markerID = -1)
+{
+    TrackPerson person{0, firstFrame, TrackPoint{Vec2F(firstFrame, y), TrackPoint::BEST_DETECTION_QUAL}, markerID};
+    for(int frame = firstFrame + 1; frame <= lastFrame; ++frame)
+    {
+        person.append(TrackPoint{Vec2F(frame, y), TrackPoint::BEST_DETECTION_QUAL});
+    }
+    return person;
+}
+
+/// trajectories of all persons tracked in all shards, cropped to the shards
+std::vector<std::vector<TrackPerson>>
+trackInShards(const std::vector<TrackPerson> &persons, const std::vector<FrameShard> &shards)
+{
+    std::vector<std::vector<TrackPerson>> result;
+    for(const auto &shard : shards)
+    {
+        auto shardPersons = persons;
+        cropToFrameRange(shardPersons, shard);
+        result.push_back(std::move(shardPersons));
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("splitFrameRange", "[tracking][stitching]")
+{
+    auto shards = splitFrameRange(0, 999, 4, 20);
+    REQUIRE(shards.size() == 4);
+    CHECK(shards.front().firstFrame == 0);
+    CHECK(shards.back().lastFrame == 999);
+    for(size_t i = 1; i < shards.size(); ++i)
+    {
+        CHECK(shards[i - 1].lastFrame - shards[i].firstFrame + 1 == 20);
+    }
+
+    SECTION("more shards than frames")
+    {
+        shards = splitFrameRange(10, 12, 8, 5);
+        REQUIRE(shards.size() == 3);
+        CHECK(shards[0].firstFrame == 10);
+        CHECK(shards[2].lastFrame == 12);
+    }
+
+    SECTION("empty range")
+    {
+        CHECK(splitFrameRange(5, 4, 2, 0).empty());
+    }
+}
+
+TEST_CASE("cropToFrameRange", "[tracking][stitching]")
+{
+    std::vector<TrackPerson> persons{walkingPerson(0, 100, 0), walkingPerson(150, 200, 0), walkingPerson(40, 60, 0)};
+    cropToFrameRange(persons, {50, 120});
+
+    REQUIRE(persons.size() == 2);
+    CHECK(persons[0].firstFrame() == 50);
+    CHECK(persons[0].lastFrame() == 100);
+    CHECK(persons[0].trackPointAt(50).x() == 50);
+    CHECK(persons[1].firstFrame() == 50);
+    CHECK(persons[1].lastFrame() == 60);
+}
+
+TEST_CASE("stitchShards", "[tracking][stitching]")
+{
+    const auto    shards = splitFrameRange(0, 299, 3, 20);
+    StitchOptions options;
+    StitchReport  report;
+
+    SECTION("trajectories are joined to the original ones")
+    {
+        std::vector<TrackPerson> persons{
+            walkingPerson(0, 299, 0), walkingPerson(50, 250, 100), walkingPerson(95, 110, 200)};
+        auto result = stitchShards(trackInShards(persons, shards), shards, options, report);
+
+        REQUIRE(result.size() == persons.size());
+        for(size_t i = 0; i < persons.size(); ++i)
+        {
+            CHECK(result[i].firstFrame() == persons[i].firstFrame());
+            REQUIRE(result[i].lastFrame() == persons[i].lastFrame());
+            for(int frame = persons[i].firstFrame(); frame <= persons[i].lastFrame(); ++frame)
+            {
+                CHECK(result[i].trackPointAt(frame).x() == persons[i].trackPointAt(frame).x());
+                CHECK(result[i].trackPointAt(frame).y() == persons[i].trackPointAt(frame).y());
+            }
+        }
+        CHECK(report.nbShards == 3);
+        CHECK(report.nbStitches == 4);
+        CHECK(report.nbAmbiguous == 0);
+        CHECK(report.nbUnmatched == 0);
+    }
+
+    SECTION("close trajectories are reported as ambiguous")
+    {
+        // the later shard tracked both persons half a pixel lower
+        std::vector<std::vector<TrackPerson>> shardPersons{
+            {walkingPerson(0, 159, 0), walkingPerson(0, 159, 1)},
+            {walkingPerson(140, 299, 0.5), walkingPerson(140, 299, 1.5)}};
+        const std::vector<FrameShard> twoShards{{0, 159}, {140, 299}};
+        auto                          result = stitchShards(shardPersons, twoShards, options, report);
+
+        CHECK(result.size() == 2);
+        CHECK(report.nbStitches == 2);
+        CHECK(report.nbAmbiguous == 2);
+        REQUIRE(report.ambiguous.size() == 2);
+        CHECK(report.ambiguous.front().shard == 1);
+        CHECK(report.ambiguous.front().frame == 150);
+        CHECK(report.toJson().value("ambiguousStitches").toInt() == 2);
+    }
+
+    SECTION("marker IDs prevent joining different persons")
+    {
+        std::vector<std::vector<TrackPerson>> shardPersons{
+            {walkingPerson(0, 159, 0, 1)}, {walkingPerson(140, 299, 0, 2)}};
+        const std::vector<FrameShard> twoShards{{0, 159}, {140, 299}};
+        auto                          result = stitchShards(shardPersons, twoShards, options, report);
+
+        CHECK(result.size() == 2);
+        CHECK(report.nbStitches == 0);
+        CHECK(report.nbUnmatched == 2);
+    }
+
+    SECTION("distant trajectories are not joined")
+    {
+        std::vector<std::vector<TrackPerson>> shardPersons{{walkingPerson(0, 159, 0)}, {walkingPerson(140, 299, 50)}};
+        const std::vector<FrameShard>         twoShards{{0, 159}, {140, 299}};
+        auto                                  result = stitchShards(shardPersons, twoShards, options, report);
+
+        CHECK(result.size() == 2);
+        CHECK(report.nbStitches == 0);
+    }
+}
@@ -197,3 +197,63 @@ SCENARIO("I want to get the render data with one person loaded", "[ui]")
         }
     }
 }
+
+SCENARIO("I want the render data to be cached", "[ui]")
+{
+    MoCapStorage storage;
+
+    SkeletonNode  root{0, cv::Point3f{100, 100, 0}};
+    SkeletonNode &child = root.addChild({19, cv::Point3f{200, 100, 69}});
+    child.addChild({2, cv::Point3f{150, 150, 1337}});
+
+    MoCapPerson person;
+    person.setSamplerate(1);
+    person.addSkeleton({root, cv::Vec3f{1, 0, 0}, {0, 0, 0}});
+    person.addSkeleton({root, cv::Vec3f{0, 1, 0}, {0, 0, 0}});
+    storage.addPerson(person);
+
+    Petrack       pet{"Unknown"};
+    Autosave      save{pet};
+    PersonStorage st{pet, save};
+    ExtrCalibMock extrCalib{st};
+
+    int projections = 0;
+    ALLOW_CALL(extrCalib, getImagePoint(ANY(cv::Point3f)))
+        .SIDE_EFFECT(++projections)
+        .RETURN(cv::Point2f(_1.x, _1.y));
+
+    MoCapController moCapController{storage, extrCalib};
+
+    GIVEN("the render data of one frame was computed")
+    {
+        const auto renderData = moCapController.getRenderData(0, 25);
+        REQUIRE(renderData.size() == 3);
+        // 3 joints of the sample and 2 points of the head direction arrow
+        REQUIRE(projections == 5);
+
+        THEN("the same frame does not project anything again")
+        {
+            REQUIRE(moCapController.getRenderData(0, 25) == renderData);
+            REQUIRE(projections == 5);
+        }
+        THEN("another frame between the same samples only projects the head direction arrow")
+        {
+            moCapController.getRenderData(12, 25);
+            REQUIRE(projections == 5 + 3 + 2);
+            moCapController.getRenderData(13, 25);
+            REQUIRE(projections == 5 + 3 + 2 + 2);
+        }
+        THEN("a changed calibration projects the joints again")
+        {
+            moCapController.invalidateProjections();
+            REQUIRE(moCapController.getRenderData(0, 25) == renderData);
+            REQUIRE(projections == 5 + 5);
+        }
+        THEN("a changed color computes the render data again")
+        {
+            moCapController.setColor(QColor(0, 0, 255));
+            REQUIRE(moCapController.getRenderData(0, 25).front().mColor == QColor(0, 0, 255));
+            REQUIRE(projections == 5 + 2);
+        }
+    }
+}
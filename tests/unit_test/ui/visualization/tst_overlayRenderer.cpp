@@ -0,0 +1,88 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "overlayRenderer.h"
+#include "personStorage.h"
+#include "petrack.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <opencv2/core.hpp>
+
+namespace
+{
+OverlaySettings currentPointOnly()
+{
+    OverlaySettings settings;
+    settings.showColorMarker  = false;
+    settings.showColColor     = false;
+    settings.showNumber       = false;
+    settings.showPath         = false;
+    settings.showCurrentPoint = true;
+    settings.currentPointSize = 20;
+    return settings;
+}
+} // namespace
+
+TEST_CASE("OverlayRenderer draws trajectories without a scene", "[ui][overlay]")
+{
+    Petrack petrack{"Unit Test"};
+    auto   &storage = petrack.getPersonStorage();
+    storage.addPerson(TrackPerson(0, 0, TrackPoint(Vec2F(50, 50), TrackPoint::BEST_DETECTION_QUAL)));
+
+    const cv::Mat img = cv::Mat::zeros(100, 100, CV_8UC1);
+
+    SECTION("current point is drawn in the frame of the person")
+    {
+        OverlayRenderer renderer{storage, currentPointOnly()};
+        cv::Mat         result = renderer.render(img, 0);
+
+        REQUIRE(result.size() == img.size());
+        REQUIRE(result.channels() == 3);
+        CHECK(cv::countNonZero(result.reshape(1)) > 0);
+        // circle with radius 10 around (50, 50); the center stays empty
+        CHECK(result.at<cv::Vec3b>(50, 60) != cv::Vec3b(0, 0, 0));
+        CHECK(result.at<cv::Vec3b>(50, 50) == cv::Vec3b(0, 0, 0));
+        // input is not modified
+        CHECK(cv::countNonZero(img) == 0);
+    }
+
+    SECTION("nothing is drawn in frames without the person")
+    {
+        OverlayRenderer renderer{storage, currentPointOnly()};
+        cv::Mat         result = renderer.render(img, 5);
+        CHECK(cv::countNonZero(result.reshape(1)) == 0);
+    }
+
+    SECTION("border shifts the drawing")
+    {
+        auto settings       = currentPointOnly();
+        settings.borderSize = 10;
+        OverlayRenderer renderer{storage, settings};
+        cv::Mat         result = renderer.render(img, 0);
+        CHECK(result.at<cv::Vec3b>(60, 70) != cv::Vec3b(0, 0, 0));
+    }
+
+    SECTION("unselected persons are not drawn")
+    {
+        auto settings      = currentPointOnly();
+        settings.selection = {1};
+        OverlayRenderer renderer{storage, settings};
+        cv::Mat         result = renderer.render(img, 0);
+        CHECK(cv::countNonZero(result.reshape(1)) == 0);
+    }
+}
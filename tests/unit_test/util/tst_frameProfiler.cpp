@@ -0,0 +1,207 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "frameProfiler.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+using namespace diagnostics;
+using namespace std::chrono_literals;
+
+TEST_CASE("FrameProfiler accumulates stages and counters per frame", "[util]")
+{
+    FrameProfiler profiler(4);
+
+    const auto start = Clock::now();
+    profiler.addTime(Stage::Decode, start - 3ms, start - 1ms);
+    profiler.addTime(Stage::Recognition, start, start + 2ms);
+    profiler.addTime(Stage::Recognition, start, start + 1ms);
+    profiler.count(Counter::Detections, 5);
+    profiler.count(Counter::Seeks);
+    profiler.finishFrame(7, start);
+
+    auto frames = profiler.lastFrames(10);
+    REQUIRE(frames.size() == 1);
+    CHECK(frames[0].frame == 7);
+    CHECK(frames[0].ns(Stage::Decode) == 2'000'000);
+    CHECK(frames[0].ns(Stage::Recognition) == 3'000'000);
+    CHECK(frames[0].count(Counter::Detections) == 5);
+    CHECK(frames[0].count(Counter::Seeks) == 1);
+    CHECK(frames[0].totalNs() == frames[0].processingNs + 2'000'000);
+
+    // the next frame starts from zero
+    profiler.addTime(Stage::Drawing, start, start + 1ms);
+    profiler.finishFrame(8, Clock::now());
+    frames = profiler.lastFrames(10);
+    REQUIRE(frames.size() == 2);
+    CHECK(frames[1].frame == 8);
+    CHECK(frames[1].ns(Stage::Recognition) == 0);
+    CHECK(frames[1].ns(Stage::Drawing) == 1'000'000);
+    CHECK(frames[1].count(Counter::Detections) == 0);
+
+    const auto mean = profiler.mean(2);
+    CHECK(mean.frame == 8);
+    CHECK(mean.ns(Stage::Recognition) == 1'500'000);
+    CHECK(mean.ns(Stage::Drawing) == 500'000);
+}
+
+TEST_CASE("FrameProfiler keeps only the last frames", "[util]")
+{
+    FrameProfiler profiler(4);
+    for(int frame = 0; frame < 10; ++frame)
+    {
+        profiler.count(Counter::PointsTracked, frame);
+        profiler.finishFrame(frame, Clock::now());
+    }
+
+    const auto frames = profiler.lastFrames(10);
+    REQUIRE(frames.size() == 4);
+    CHECK(frames.front().frame == 6);
+    CHECK(frames.back().frame == 9);
+    CHECK(frames.back().count(Counter::PointsTracked) == 9);
+    CHECK(profiler.lastFrames(2).front().frame == 8);
+
+    profiler.clear();
+    CHECK(profiler.lastFrames(10).empty());
+}
+
+TEST_CASE("FrameProfiler can be written from several threads", "[util]")
+{
+    constexpr int nbThreads       = 4;
+    constexpr int timersPerThread = 1000;
+    FrameProfiler profiler;
+    profiler.startRecording();
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nbThreads; ++t)
+    {
+        threads.emplace_back(
+            [&profiler]
+            {
+                for(int i = 0; i < timersPerThread; ++i)
+                {
+                    const auto start = Clock::now();
+                    profiler.addTime(Stage::OpticalFlow, start, start + 1us);
+                    profiler.count(Counter::Merges);
+                }
+            });
+    }
+    for(auto &thread : threads)
+    {
+        thread.join();
+    }
+    profiler.finishFrame(1, Clock::now());
+
+    const auto frames = profiler.lastFrames(1);
+    REQUIRE(frames.size() == 1);
+    CHECK(frames[0].ns(Stage::OpticalFlow) == nbThreads * timersPerThread * 1'000);
+    CHECK(frames[0].count(Counter::Merges) == nbThreads * timersPerThread);
+    // all timers plus the frame itself
+    CHECK(profiler.recordedTrace().size() == nbThreads * timersPerThread + 1);
+}
+
+TEST_CASE("FrameProfiler records and exports a run", "[util]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    FrameProfiler profiler;
+    // not recorded
+    profiler.finishFrame(0, Clock::now());
+
+    profiler.startRecording();
+    for(int frame = 1; frame <= 3; ++frame)
+    {
+        const auto start = Clock::now();
+        {
+            ScopedTimer timer(Stage::BorderFilter, profiler);
+        }
+        profiler.count(Counter::PointsTracked, 10 * frame);
+        profiler.finishFrame(frame, start);
+    }
+    // discarded measurements are neither in the recording nor in the next frame
+    {
+        ScopedTimer timer(Stage::Recognition, profiler);
+    }
+    profiler.discardFrame();
+    profiler.stopRecording();
+    profiler.finishFrame(4, Clock::now());
+
+    const auto frames = profiler.recordedFrames();
+    REQUIRE(frames.size() == 3);
+    CHECK(frames.front().frame == 1);
+    CHECK(frames.back().count(Counter::PointsTracked) == 30);
+    CHECK(profiler.lastFrames(1).front().ns(Stage::Recognition) == 0);
+
+    const auto trace = profiler.recordedTrace();
+    REQUIRE(trace.size() == 6);
+    CHECK(QString(trace[0].name) == "border_filter");
+    CHECK(trace[0].frame == 1);
+    CHECK(QString(trace[5].name) == "frame");
+    CHECK(trace[5].frame == 3);
+
+    SECTION("CSV")
+    {
+        const QString filename = dir.filePath("profile.csv");
+        REQUIRE(profiler.exportFile(filename));
+
+        QFile file(filename);
+        REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QStringList lines = QString(file.readAll()).split('\n', Qt::SkipEmptyParts);
+        REQUIRE(lines.size() == 4);
+        const QStringList header = lines[0].split(',');
+        CHECK(header.front() == "frame");
+        CHECK(header.contains("border_filter_ms"));
+        CHECK(header.back() == "seeks");
+        const QStringList values = lines[2].split(',');
+        REQUIRE(values.size() == header.size());
+        CHECK(values.front() == "2");
+        CHECK(values[header.indexOf("points_tracked")] == "20");
+    }
+
+    SECTION("Chrome trace")
+    {
+        const QString filename = dir.filePath("profile.json");
+        REQUIRE(profiler.exportFile(filename));
+
+        QFile file(filename);
+        REQUIRE(file.open(QIODevice::ReadOnly));
+        QJsonParseError error;
+        const auto      root = QJsonDocument::fromJson(file.readAll(), &error).object();
+        REQUIRE(error.error == QJsonParseError::NoError);
+
+        const auto events = root["traceEvents"].toArray();
+        // 6 intervals and the counters of 3 frames
+        REQUIRE(events.size() == 9);
+        const auto filter = events[0].toObject();
+        CHECK(filter["name"].toString() == "border_filter");
+        CHECK(filter["ph"].toString() == "X");
+        CHECK(filter["args"].toObject()["frame"].toInt() == 1);
+
+        const auto counters = events[2].toObject();
+        CHECK(counters["ph"].toString() == "C");
+        CHECK(counters["args"].toObject()["points_tracked"].toInt() == 10);
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * PeTrack - Software for tracking pedestrians movement in videos
+ * Copyright (C) 2026 Forschungszentrum Jülich GmbH, IAS-7
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "frameRangeIndex.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+namespace
+{
+std::vector<size_t> bruteForceFind(const std::vector<FrameRangeIndex::Range> &ranges, int from, int to)
+{
+    std::vector<size_t> result;
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+        if(ranges[i].firstFrame <= ranges[i].lastFrame && ranges[i].lastFrame >= from && ranges[i].firstFrame <= to)
+        {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("FrameRangeIndex answers frame queries", "[util]")
+{
+    FrameRangeIndex index;
+
+    CHECK(index.count(0) == 0);
+    CHECK(index.find(0).empty());
+    CHECK(index.smallestFirstFrame() == -1);
+    CHECK(index.largestFirstFrame() == -1);
+    CHECK(index.largestLastFrame() == -1);
+
+    index.pushBack(0, 10);
+    index.pushBack(5, 200);
+    index.pushBack(150, 151);
+    index.pushBack(300, 299); // empty
+
+    CHECK(index.count(0) == 1);
+    CHECK(index.count(7) == 2);
+    CHECK(index.count(151) == 2);
+    CHECK(index.count(152) == 1);
+    CHECK(index.count(299) == 0);
+    CHECK(index.find(150) == std::vector<size_t>{1, 2});
+    CHECK(index.find(11, 149) == std::vector<size_t>{1});
+    CHECK(index.find(-100, 1000) == std::vector<size_t>{0, 1, 2});
+
+    CHECK(index.smallestFirstFrame() == 0);
+    CHECK(index.largestFirstFrame() == 300);
+    CHECK(index.largestLastFrame() == 299);
+
+    SECTION("ranges grow and shrink")
+    {
+        index.update(0, 0, 11);
+        CHECK(index.count(11) == 2);
+
+        index.update(1, 180, 200);
+        CHECK(index.find(150) == std::vector<size_t>{2});
+        CHECK(index.find(190) == std::vector<size_t>{1});
+
+        index.update(3, 300, 310);
+        CHECK(index.find(305) == std::vector<size_t>{3});
+        CHECK(index.largestLastFrame() == 310);
+
+        index.update(2, 5, 4); // now empty
+        CHECK(index.find(150).empty());
+    }
+
+    SECTION("rebuild replaces all ranges")
+    {
+        index.rebuild({{-70, -65}, {1, 2}});
+        CHECK(index.size() == 2);
+        CHECK(index.find(-66) == std::vector<size_t>{0});
+        CHECK(index.count(150) == 0);
+        CHECK(index.smallestFirstFrame() == -70);
+        CHECK(index.largestLastFrame() == 2);
+    }
+}
+
+TEST_CASE("FrameRangeIndex matches a linear scan", "[util]")
+{
+    std::mt19937                        rng{42}; // NOLINT: fixed seed for reproducible test
+    std::uniform_int_distribution<int>  frameDist{-100, 2000};
+    std::uniform_int_distribution<int>  lengthDist{-1, 300};
+    std::vector<FrameRangeIndex::Range> ranges;
+    FrameRangeIndex                     index;
+
+    for(int i = 0; i < 500; ++i)
+    {
+        const int first = frameDist(rng);
+        ranges.push_back({first, first + lengthDist(rng)});
+        index.pushBack(ranges.back().firstFrame, ranges.back().lastFrame);
+    }
+    // simulate tracking and manual edits
+    std::uniform_int_distribution<size_t> personDist{0, ranges.size() - 1};
+    for(int i = 0; i < 5000; ++i)
+    {
+        auto &range = ranges[personDist(rng)];
+        switch(i % 3)
+        {
+            case 0:
+                ++range.lastFrame;
+                break;
+            case 1:
+                --range.firstFrame;
+                break;
+            default:
+                range.firstFrame = frameDist(rng);
+                range.lastFrame  = range.firstFrame + lengthDist(rng);
+                break;
+        }
+        const size_t changed = &range - ranges.data();
+        index.update(changed, range.firstFrame, range.lastFrame);
+    }
+    // simulate deleted and merged persons
+    for(int i = 0; i < 100; ++i)
+    {
+        const size_t erased = personDist(rng) % ranges.size();
+        ranges.erase(ranges.begin() + static_cast<std::ptrdiff_t>(erased));
+        index.erase(erased);
+    }
+    REQUIRE(index.size() == ranges.size());
+
+    for(int frame = -150; frame < 2500; frame += 7)
+    {
+        const auto expected = bruteForceFind(ranges, frame, frame);
+        REQUIRE(index.find(frame) == expected);
+        REQUIRE(index.count(frame) == expected.size());
+        REQUIRE(index.find(frame - 40, frame + 25) == bruteForceFind(ranges, frame - 40, frame + 25));
+    }
+}
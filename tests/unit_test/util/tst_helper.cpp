@@ -19,9 +19,12 @@
 #include "helper.h"
 #include "logger.h"
 
+#include <QColor>
+#include <QImage>
 #include <QRect>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
+#include <vector>
 
 TEST_CASE("Test qRectToCvRect", "[helper]")
 {
@@ -267,3 +270,58 @@ TEST_CASE("Test split compact string", "[helper][grouping]")
     input = "1 - 3, 4,";
     CHECK_THROWS_AS(splitCompactString(input), std::invalid_argument);
 }
+
+TEST_CASE("Test shareToQImage", "[helper]")
+{
+    cv::Mat frame(4, 6, CV_8UC3, cv::Scalar(10, 20, 30));
+    QImage  image;
+
+    SECTION("QImage shows the buffer of the cv::Mat")
+    {
+        shareToQImage(image, frame);
+        REQUIRE(image.width() == 6);
+        REQUIRE(image.height() == 4);
+        CHECK(image.format() == QImage::Format_BGR888);
+        CHECK(image.constBits() == frame.data);
+        CHECK(image.pixelColor(0, 0) == QColor(30, 20, 10));
+    }
+
+    SECTION("Buffer stays valid after the cv::Mat is released")
+    {
+        shareToQImage(image, frame);
+        const uchar *data = frame.data;
+        frame.release();
+        CHECK(image.constBits() == data);
+        CHECK(image.pixelColor(5, 3) == QColor(30, 20, 10));
+    }
+
+    SECTION("Detached producer does not change the shown frame")
+    {
+        shareToQImage(image, frame);
+        const uchar *data = frame.data;
+        detachSharedMat(frame);
+        CHECK(frame.empty());
+        frame.create(4, 6, CV_8UC3);
+        frame.setTo(cv::Scalar(0, 0, 0));
+        CHECK(frame.data != data);
+        CHECK(image.pixelColor(0, 0) == QColor(30, 20, 10));
+    }
+
+    SECTION("Unshared cv::Mat is not detached")
+    {
+        const uchar *data = frame.data;
+        detachSharedMat(frame);
+        CHECK(frame.data == data);
+    }
+
+    SECTION("Grayscale and external data")
+    {
+        std::vector<uchar> external(6 * 4, 42);
+        cv::Mat            gray(4, 6, CV_8UC1, external.data());
+        shareToQImage(image, gray);
+        CHECK(image.format() == QImage::Format_Grayscale8);
+        CHECK(image.constBits() != external.data());
+        external[0] = 0;
+        CHECK(qGray(image.pixel(0, 0)) == 42);
+    }
+}